@@ -10,6 +10,7 @@
 #include <vespa/document/repo/documenttyperepo.h>
 #include <vespa/document/serialization/vespadocumentdeserializer.h>
 #include <vespa/document/serialization/vespadocumentserializer.h>
+#include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/document/util/serializableexceptions.h>
@@ -48,6 +49,7 @@ struct DocumentTest : public CppUnit::TestFixture {
     void testGetSerializedSize();
     void testDeserializeMultiple();
     void testSizeOf();
+    void testDeserializeFromOwnedBuffer();
 
     CPPUNIT_TEST_SUITE(DocumentTest);
     CPPUNIT_TEST(testFieldPath);
@@ -72,6 +74,7 @@ struct DocumentTest : public CppUnit::TestFixture {
     CPPUNIT_TEST(testGetSerializedSize);
     CPPUNIT_TEST(testDeserializeMultiple);
     CPPUNIT_TEST(testSizeOf);
+    CPPUNIT_TEST(testDeserializeFromOwnedBuffer);
     CPPUNIT_TEST_SUITE_END();
 };
 
@@ -1438,4 +1441,26 @@ DocumentTest::testDeserializeMultiple()
     CPPUNIT_ASSERT_EQUAL(correct, sv3);
 }
 
+void
+DocumentTest::testDeserializeFromOwnedBuffer()
+{
+    TestDocMan testDocMan;
+    Document::UP orig = testDocMan.createDocument();
+    nbostream stream;
+    orig->serialize(stream);
+
+    Document::UP copy;
+    {
+        vespalib::DataBuffer buffer(stream.size());
+        buffer.writeBytes(stream.peek(), stream.size());
+        Document doc(testDocMan.getTypeRepo(), std::move(buffer));
+        CPPUNIT_ASSERT_EQUAL(*orig, doc);
+        copy.reset(doc.clone());
+    }
+    // The copy must not refer to the buffer owned by the original.
+    CPPUNIT_ASSERT_EQUAL(*orig, *copy);
+    CPPUNIT_ASSERT_EQUAL(orig->getValue("content")->toString(),
+                         copy->getValue("content")->toString());
+}
+
 } // document
@@ -0,0 +1,128 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+// Benchmark of compiled versus interpreted document selection evaluation.
+
+#include <vespa/log/log.h>
+LOG_SETUP("compiled_selection_benchmark");
+
+#include <vespa/document/base/testdocrepo.h>
+#include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/fieldvalue/floatfieldvalue.h>
+#include <vespa/document/fieldvalue/intfieldvalue.h>
+#include <vespa/document/fieldvalue/longfieldvalue.h>
+#include <vespa/document/fieldvalue/stringfieldvalue.h>
+#include <vespa/document/select/compiled_selection.h>
+#include <vespa/document/select/parser.h>
+#include <vespa/vespalib/stllike/asciistream.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+
+#include <vespa/vespalib/testkit/testapp.h>
+
+using namespace document;
+using namespace document::select;
+using vespalib::BenchmarkTimer;
+
+namespace {
+
+constexpr uint32_t numDocs = 1000;
+constexpr double budget = 2.0;
+
+struct Fixture {
+    TestDocRepo _repo;
+    BucketIdFactory _idFactory;
+    std::vector<std::unique_ptr<Document>> _docs;
+
+    Fixture();
+    ~Fixture();
+
+    std::unique_ptr<Node> parse(const vespalib::string &selection) const {
+        Parser parser(_repo.getTypeRepo(), _idFactory);
+        return parser.parse(selection);
+    }
+
+    void benchmark(const vespalib::string &selection) const;
+};
+
+Fixture::Fixture()
+    : _repo(),
+      _idFactory(),
+      _docs()
+{
+    const DataType &type = *_repo.getDocumentType("testdoctype1");
+    for (uint32_t i = 0; i < numDocs; ++i) {
+        vespalib::asciistream id;
+        id << "id:test:testdoctype1::" << i;
+        auto doc = std::make_unique<Document>(type, DocumentId(id.str()));
+        doc->setRepo(_repo.getTypeRepo());
+        doc->setValue("headerval", IntFieldValue(i));
+        doc->setValue("headerlongval", LongFieldValue(i * 1000ll));
+        doc->setValue("hfloatval", FloatFieldValue(i / 10.0));
+        if ((i % 3) != 0) {
+            vespalib::asciistream value;
+            value << "value" << (i % 10);
+            doc->setValue("hstringval", StringFieldValue(value.str()));
+        }
+        _docs.push_back(std::move(doc));
+    }
+}
+
+Fixture::~Fixture() = default;
+
+void
+Fixture::benchmark(const vespalib::string &selection) const
+{
+    std::unique_ptr<Node> root = parse(selection);
+    CompiledSelection compiled(*root);
+    EXPECT_TRUE(compiled.isCompiled());
+    uint32_t interpretedHits = 0;
+    uint32_t compiledHits = 0;
+    auto interpret = [&]() {
+        for (const auto &doc : _docs) {
+            if (root->contains(Context(*doc)).combineResults() == Result::True) {
+                ++interpretedHits;
+            }
+        }
+    };
+    auto evaluateCompiled = [&]() {
+        for (const auto &doc : _docs) {
+            if (compiled.contains(Context(*doc)) == Result::True) {
+                ++compiledHits;
+            }
+        }
+    };
+    interpret();
+    evaluateCompiled();
+    EXPECT_EQUAL(interpretedHits, compiledHits);
+    double interpretedTime = BenchmarkTimer::benchmark(interpret, budget);
+    double compiledTime = BenchmarkTimer::benchmark(evaluateCompiled, budget);
+    fprintf(stderr, "%s:\n  interpreted: %g us/doc\n  compiled:    %g us/doc (%zu instructions)\n",
+            selection.c_str(),
+            interpretedTime * 1000000.0 / numDocs,
+            compiledTime * 1000000.0 / numDocs,
+            compiled.getInstructionCount());
+}
+
+}
+
+TEST_F("benchmark single integer field comparison", Fixture)
+{
+    f.benchmark("testdoctype1.headerval > 500");
+}
+
+TEST_F("benchmark garbage collection style selection", Fixture)
+{
+    f.benchmark("testdoctype1.headerlongval > now() - 3600");
+}
+
+TEST_F("benchmark conjunction over mixed field types", Fixture)
+{
+    f.benchmark("testdoctype1.headerval >= 100 and testdoctype1.hfloatval < 80.5 and "
+                "(testdoctype1.hstringval == \"value3\" or testdoctype1.hstringval == null)");
+}
+
+TEST_F("benchmark selection mixing document id and field predicates", Fixture)
+{
+    f.benchmark("id.namespace == \"test\" and not (testdoctype1.headerlongval == 0)");
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
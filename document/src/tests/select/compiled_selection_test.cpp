@@ -0,0 +1,169 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+// Unit tests for compiled document selections.
+
+#include <vespa/log/log.h>
+LOG_SETUP("compiled_selection_test");
+
+#include <vespa/document/base/testdocrepo.h>
+#include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/fieldvalue/arrayfieldvalue.h>
+#include <vespa/document/fieldvalue/bytefieldvalue.h>
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/fieldvalue/floatfieldvalue.h>
+#include <vespa/document/fieldvalue/intfieldvalue.h>
+#include <vespa/document/fieldvalue/longfieldvalue.h>
+#include <vespa/document/fieldvalue/stringfieldvalue.h>
+#include <vespa/document/select/compiled_selection.h>
+#include <vespa/document/select/parser.h>
+
+#include <vespa/vespalib/testkit/testapp.h>
+
+using namespace document;
+using namespace document::select;
+
+namespace {
+
+struct Fixture {
+    TestDocRepo _repo;
+    BucketIdFactory _idFactory;
+    std::vector<std::unique_ptr<Document>> _docs;
+
+    Fixture();
+    ~Fixture();
+
+    Document &addDoc(const vespalib::string &type, const vespalib::string &id) {
+        _docs.push_back(std::make_unique<Document>(*_repo.getDocumentType(type), DocumentId(id)));
+        _docs.back()->setRepo(_repo.getTypeRepo());
+        return *_docs.back();
+    }
+
+    std::unique_ptr<Node> parse(const vespalib::string &selection) const {
+        Parser parser(_repo.getTypeRepo(), _idFactory);
+        return parser.parse(selection);
+    }
+
+    void assertSameAsInterpreter(const vespalib::string &selection, bool expectCompiled) const;
+};
+
+Fixture::Fixture()
+    : _repo(),
+      _idFactory(),
+      _docs()
+{
+    Document &full = addDoc("testdoctype1", "id:test:testdoctype1::full");
+    full.setValue("headerval", IntFieldValue(42));
+    full.setValue("headerlongval", LongFieldValue(1234567890123ll));
+    full.setValue("hfloatval", FloatFieldValue(2.5));
+    full.setValue("hstringval", StringFieldValue("foo"));
+    full.setValue("byteval", ByteFieldValue(7));
+    ArrayFieldValue tags(full.getField("tags").getDataType());
+    tags.add(StringFieldValue("x"));
+    tags.add(StringFieldValue("y"));
+    full.setValue("tags", tags);
+
+    Document &partial = addDoc("testdoctype1", "id:test:testdoctype1::partial");
+    partial.setValue("headerval", IntFieldValue(-3));
+    partial.setValue("hstringval", StringFieldValue("zoo"));
+
+    addDoc("testdoctype1", "id:test:testdoctype1::empty");
+
+    Document &child = addDoc("testdoctype2", "id:test:testdoctype2::child");
+    child.setValue("headerval", IntFieldValue(42));
+    child.setValue("onlyinchild", IntFieldValue(3));
+}
+
+Fixture::~Fixture() = default;
+
+void
+Fixture::assertSameAsInterpreter(const vespalib::string &selection, bool expectCompiled) const
+{
+    TEST_STATE(selection.c_str());
+    std::unique_ptr<Node> root = parse(selection);
+    CompiledSelection compiled(*root);
+    EXPECT_EQUAL(expectCompiled, compiled.isCompiled());
+    for (const auto &doc : _docs) {
+        TEST_STATE(doc->getId().toString().c_str());
+        Context context(*doc);
+        EXPECT_EQUAL(root->contains(context).combineResults().toString(),
+                     compiled.contains(context).toString());
+    }
+    Context noDocument;
+    EXPECT_EQUAL(root->contains(noDocument).combineResults().toString(),
+                 compiled.contains(noDocument).toString());
+}
+
+}
+
+TEST_F("require that plain field comparisons are compiled", Fixture)
+{
+    auto root = f.parse("testdoctype1.headerval > 10 and testdoctype1.hstringval == \"foo\"");
+    CompiledSelection compiled(*root);
+    EXPECT_TRUE(compiled.isCompiled());
+    EXPECT_EQUAL(2u, compiled.getFieldCompareCount());
+    EXPECT_EQUAL(4u, compiled.getInstructionCount());
+}
+
+TEST_F("require that compiled comparisons match the interpreter", Fixture)
+{
+    f.assertSameAsInterpreter("testdoctype1.headerval == 42", true);
+    f.assertSameAsInterpreter("testdoctype1.headerval != 42", true);
+    f.assertSameAsInterpreter("testdoctype1.headerval < 42", true);
+    f.assertSameAsInterpreter("testdoctype1.headerval <= 42.0", true);
+    f.assertSameAsInterpreter("testdoctype1.headerval > 10", true);
+    f.assertSameAsInterpreter("testdoctype1.headerval >= -3", true);
+    f.assertSameAsInterpreter("42 == testdoctype1.headerval", true);
+    f.assertSameAsInterpreter("0 > testdoctype1.headerval", true);
+    f.assertSameAsInterpreter("testdoctype1.headerlongval == 1234567890123", true);
+    f.assertSameAsInterpreter("testdoctype1.hfloatval >= 2.5", true);
+    f.assertSameAsInterpreter("testdoctype1.hfloatval < 3", true);
+    f.assertSameAsInterpreter("testdoctype1.byteval == 7", true);
+    f.assertSameAsInterpreter("testdoctype1.hstringval == \"foo\"", true);
+    f.assertSameAsInterpreter("testdoctype1.hstringval < \"m\"", true);
+    f.assertSameAsInterpreter("testdoctype1.hstringval > \"m\"", true);
+}
+
+TEST_F("require that null and invalid values propagate as in the interpreter", Fixture)
+{
+    f.assertSameAsInterpreter("testdoctype1.headerval == null", true);
+    f.assertSameAsInterpreter("testdoctype1.hstringval != null", true);
+    f.assertSameAsInterpreter("null == testdoctype1.hfloatval", true);
+    f.assertSameAsInterpreter("testdoctype1.headerval > null", true);
+    f.assertSameAsInterpreter("null <= testdoctype1.headerval", true);
+    f.assertSameAsInterpreter("testdoctype1.headerval == \"42\"", true);
+    f.assertSameAsInterpreter("testdoctype1.hstringval < 3", true);
+    f.assertSameAsInterpreter("testdoctype2.onlyinchild == 3", true);
+    f.assertSameAsInterpreter("not (testdoctype2.onlyinchild == 3)", true);
+}
+
+TEST_F("require that boolean structure matches the interpreter", Fixture)
+{
+    f.assertSameAsInterpreter("testdoctype1.headerval > 10 and testdoctype1.hstringval == \"foo\"", true);
+    f.assertSameAsInterpreter("testdoctype1.headerval < 10 or testdoctype1.hfloatval >= 2.5", true);
+    f.assertSameAsInterpreter("not (testdoctype1.headerlongval != 1234567890123)", true);
+    f.assertSameAsInterpreter("testdoctype2.onlyinchild == 3 and testdoctype1.headerval == 42", true);
+    f.assertSameAsInterpreter("testdoctype2.onlyinchild == 3 or testdoctype1.headerval == 42", true);
+    f.assertSameAsInterpreter("testdoctype1.headerval == 42 or true", true);
+    f.assertSameAsInterpreter("false and testdoctype1.headerval == 1", true);
+    f.assertSameAsInterpreter("testdoctype2 and testdoctype1.headerval == 42", true);
+    f.assertSameAsInterpreter("id.namespace == \"test\" and testdoctype1.headerval >= 0", true);
+    f.assertSameAsInterpreter("testdoctype1.headerval > now() - 3600", true);
+}
+
+TEST_F("require that unsupported field expressions fall back to the interpreter", Fixture)
+{
+    f.assertSameAsInterpreter("testdoctype1.headerval + 1 == 43", false);
+    f.assertSameAsInterpreter("testdoctype1.hstringval.lowercase() == \"foo\"", false);
+    f.assertSameAsInterpreter("testdoctype1.hstringval =~ \"f.*\"", false);
+    f.assertSameAsInterpreter("testdoctype1.headerval == testdoctype1.headerval", false);
+    f.assertSameAsInterpreter("testdoctype1.mystruct.key == 15", false);
+    f.assertSameAsInterpreter("testdoctype1.tags[$x] == \"x\"", false);
+}
+
+TEST_F("require that documents with unsupported field types are handed to the interpreter", Fixture)
+{
+    f.assertSameAsInterpreter("testdoctype1.tags == \"x\"", true);
+    f.assertSameAsInterpreter("not (testdoctype1.tags == \"z\")", true);
+    f.assertSameAsInterpreter("testdoctype1.headerval == 42 and testdoctype1.tags == \"y\"", true);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -8,6 +8,7 @@
 #include <vespa/document/serialization/vespadocumentdeserializer.h>
 #include <vespa/document/serialization/vespadocumentserializer.h>
 #include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/data/databuffer.h>
 #include <vespa/document/util/serializableexceptions.h>
 #include <vespa/document/base/exceptions.h>
 #include <vespa/document/fieldset/fieldsets.h>
@@ -59,7 +60,8 @@ Document::Document()
     : StructuredFieldValue(*DataType::DOCUMENT),
       _id(),
       _fields(getType().getFieldsType()),
-      _lastModified(0)
+      _lastModified(0),
+      _backingBuffer()
 {
     _fields.setDocumentType(getType());
 }
@@ -68,7 +70,8 @@ Document::Document(const Document& other)
     : StructuredFieldValue(other),
       _id(other._id),
       _fields(other._fields),
-      _lastModified(other._lastModified)
+      _lastModified(other._lastModified),
+      _backingBuffer()
 {
 }
 
@@ -76,7 +79,8 @@ Document::Document(const DataType &type, const DocumentId& documentId)
     : StructuredFieldValue(verifyDocumentType(&type)),
       _id(documentId),
       _fields(getType().getFieldsType()),
-      _lastModified(0)
+      _lastModified(0),
+      _backingBuffer()
 {
     _fields.setDocumentType(getType());
     if (documentId.hasDocType() && documentId.getDocType() != type.getName()) {
@@ -88,7 +92,8 @@ Document::Document(const DataType &type, DocumentId& documentId, bool iWillAllow
     : StructuredFieldValue(verifyDocumentType(&type)),
       _id(),
       _fields(getType().getFieldsType()),
-      _lastModified(0)
+      _lastModified(0),
+      _backingBuffer()
 {
     (void) iWillAllowSwap;
     _fields.setDocumentType(getType());
@@ -102,7 +107,8 @@ Document::Document(const DocumentTypeRepo& repo, ByteBuffer& buffer, const DataT
     : StructuredFieldValue(anticipatedType ?  verifyDocumentType(anticipatedType) : *DataType::DOCUMENT),
       _id(),
       _fields(static_cast<const DocumentType &>(getType()).getFieldsType()),
-      _lastModified(0)
+      _lastModified(0),
+      _backingBuffer()
 {
     deserialize(repo, buffer);
 }
@@ -116,16 +122,32 @@ Document::Document(const DocumentTypeRepo& repo, vespalib::nbostream & is, const
     : StructuredFieldValue(anticipatedType ?  verifyDocumentType(anticipatedType) : *DataType::DOCUMENT),
       _id(),
       _fields(static_cast<const DocumentType &>(getType()).getFieldsType()),
-      _lastModified(0)
+      _lastModified(0),
+      _backingBuffer()
 {
     deserialize(repo, is);
 }
 
+Document::Document(const DocumentTypeRepo& repo, vespalib::DataBuffer && backingBuffer)
+    : StructuredFieldValue(*DataType::DOCUMENT),
+      _id(),
+      _fields(static_cast<const DocumentType &>(getType()).getFieldsType()),
+      _lastModified(0),
+      _backingBuffer()
+{
+    auto buffer = std::make_unique<vespalib::DataBuffer>(std::move(backingBuffer));
+    vespalib::nbostream_longlivedbuf is(buffer->getData(), buffer->getDataLen());
+    deserialize(repo, is);
+    // Set after deserializing, as deserialization may swap the document contents.
+    _backingBuffer = std::move(buffer);
+}
+
 Document::Document(const DocumentTypeRepo& repo, ByteBuffer& buffer, bool includeContent, const DataType *anticipatedType)
     : StructuredFieldValue(anticipatedType ?  verifyDocumentType(anticipatedType) : *DataType::DOCUMENT),
       _id(),
       _fields(static_cast<const DocumentType &>(getType()).getFieldsType()),
-      _lastModified(0)
+      _lastModified(0),
+      _backingBuffer()
 {
     if (!includeContent) {
         const DocumentType *newDocType = deserializeDocHeaderAndType(repo, buffer, _id, static_cast<const DocumentType*>(anticipatedType));
@@ -142,14 +164,14 @@ Document::Document(const DocumentTypeRepo& repo, ByteBuffer& header, ByteBuffer&
     : StructuredFieldValue(anticipatedType ?  verifyDocumentType(anticipatedType) : *DataType::DOCUMENT),
       _id(),
       _fields(static_cast<const DocumentType &>(getType()).getFieldsType()),
-      _lastModified(0)
+      _lastModified(0),
+      _backingBuffer()
 {
     deserializeHeader(repo, header);
     deserializeBody(repo, body);
 }
 
-Document::~Document() {
-}
+Document::~Document() = default;
 
 void
 Document::swap(Document & rhs)
@@ -158,6 +180,7 @@ Document::swap(Document & rhs)
     _fields.swap(rhs._fields);
     _id.swap(rhs._id);
     std::swap(_lastModified, rhs._lastModified);
+    _backingBuffer.swap(rhs._backingBuffer);
 }
 
 const DocumentType&
@@ -171,6 +194,9 @@ Document& Document::operator=(const Document& doc)
     _id = doc._id;
     _fields = doc._fields;
     _lastModified = doc._lastModified;
+    if (&doc != this) {
+        _backingBuffer.reset(); // assigned fields own their data
+    }
     return *this;
 }
 
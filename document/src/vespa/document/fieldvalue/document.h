@@ -19,6 +19,8 @@
 #include <vespa/document/base/documentid.h>
 #include <vespa/document/base/field.h>
 
+namespace vespalib { class DataBuffer; }
+
 namespace document {
 
 class Document : public StructuredFieldValue
@@ -31,6 +33,11 @@ private:
         // the meta data has been added to document. This will not be serialized
         // with the document and really doesn't belong here!
     int64_t _lastModified;
+
+    // Serialized form of this document when constructed from a buffer
+    // taking ownership of it. Struct chunks reference this buffer
+    // instead of holding private copies.
+    std::unique_ptr<vespalib::DataBuffer> _backingBuffer;
 public:
     typedef std::unique_ptr<Document> UP;
     typedef std::shared_ptr<Document> SP;
@@ -43,6 +50,12 @@ public:
     Document(const DataType &, DocumentId &, bool iWillAllowSwap);
     Document(const DocumentTypeRepo& repo, ByteBuffer& buffer, const DataType *anticipatedType = 0);
     Document(const DocumentTypeRepo& repo, vespalib::nbostream& stream, const DataType *anticipatedType = 0);
+    /**
+       Constructor taking ownership of a buffer holding a serialized document.
+       The document is deserialized in place; field data is not copied, and
+       fields are only decoded when accessed.
+    */
+    Document(const DocumentTypeRepo& repo, vespalib::DataBuffer && backingBuffer);
     /**
        Constructor to deserialize only document and type from a buffer. Only relevant if includeContent is false.
     */
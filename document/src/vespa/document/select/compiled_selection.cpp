@@ -0,0 +1,560 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "compiled_selection.h"
+#include "branch.h"
+#include "compare.h"
+#include "constant.h"
+#include "doctype.h"
+#include "invalidconstant.h"
+#include "traversingvisitor.h"
+#include "valuenodes.h"
+#include <vespa/document/base/exceptions.h>
+#include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/fieldvalue/bytefieldvalue.h>
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/fieldvalue/doublefieldvalue.h>
+#include <vespa/document/fieldvalue/floatfieldvalue.h>
+#include <vespa/document/fieldvalue/intfieldvalue.h>
+#include <vespa/document/fieldvalue/longfieldvalue.h>
+#include <vespa/document/fieldvalue/stringfieldvalue.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <cassert>
+#include <typeinfo>
+
+namespace document::select {
+
+namespace {
+
+/**
+ * Allocation free stand-in for the Value types a single valued field or a
+ * literal may produce. The comparison functions below mirror the semantics
+ * of the corresponding Value operators exactly, including how invalid and
+ * missing (null) values propagate.
+ */
+struct Scalar {
+    enum class Kind : uint8_t { Invalid, Null, Integer, Float, String };
+
+    Kind               kind;
+    int64_t            intValue;
+    double             floatValue;
+    vespalib::stringref stringValue;
+
+    Scalar() : kind(Kind::Invalid), intValue(0), floatValue(0.0), stringValue() {}
+
+    static Scalar null() { Scalar s; s.kind = Kind::Null; return s; }
+    static Scalar integer(int64_t v) { Scalar s; s.kind = Kind::Integer; s.intValue = v; return s; }
+    static Scalar floating(double v) { Scalar s; s.kind = Kind::Float; s.floatValue = v; return s; }
+    static Scalar string(vespalib::stringref v) { Scalar s; s.kind = Kind::String; s.stringValue = v; return s; }
+
+    bool isNumber() const { return (kind == Kind::Integer) || (kind == Kind::Float); }
+};
+
+enum class CompareOp : uint8_t { EQ, NE, LT, LEQ, GT, GEQ };
+
+template <typename Cmp>
+const Result &
+compareNumbers(const Scalar &a, const Scalar &b, Cmp cmp)
+{
+    if (a.kind == Scalar::Kind::Integer) {
+        return (b.kind == Scalar::Kind::Integer)
+               ? Result::get(cmp(a.intValue, b.intValue))
+               : Result::get(cmp(a.intValue, b.floatValue));
+    }
+    return (b.kind == Scalar::Kind::Integer)
+           ? Result::get(cmp(a.floatValue, b.intValue))
+           : Result::get(cmp(a.floatValue, b.floatValue));
+}
+
+// Value::operator<
+const Result &
+lessThan(const Scalar &a, const Scalar &b)
+{
+    switch (a.kind) {
+    case Scalar::Kind::String:
+        return (b.kind == Scalar::Kind::String)
+               ? Result::get(a.stringValue < b.stringValue)
+               : Result::Invalid;
+    case Scalar::Kind::Integer:
+    case Scalar::Kind::Float:
+        return b.isNumber()
+               ? compareNumbers(a, b, [](auto x, auto y) { return x < y; })
+               : Result::Invalid;
+    default:
+        return Result::Invalid;
+    }
+}
+
+// Value::operator==
+const Result &
+equal(const Scalar &a, const Scalar &b)
+{
+    switch (a.kind) {
+    case Scalar::Kind::Null:
+        if (b.kind == Scalar::Kind::Null) {
+            return Result::True;
+        }
+        return (b.kind == Scalar::Kind::Invalid) ? Result::Invalid : Result::False;
+    case Scalar::Kind::String:
+        if (b.kind == Scalar::Kind::String) {
+            return Result::get(a.stringValue == b.stringValue);
+        }
+        return (b.kind == Scalar::Kind::Null) ? Result::False : Result::Invalid;
+    case Scalar::Kind::Integer:
+    case Scalar::Kind::Float:
+        if (b.isNumber()) {
+            return compareNumbers(a, b, [](auto x, auto y) { return x == y; });
+        }
+        return (b.kind == Scalar::Kind::Null) ? Result::False : Result::Invalid;
+    default:
+        return Result::Invalid;
+    }
+}
+
+const Result &
+compareScalars(const Scalar &a, CompareOp op, const Scalar &b)
+{
+    switch (op) {
+    case CompareOp::EQ:
+        return equal(a, b);
+    case CompareOp::NE:
+        return !equal(a, b);
+    case CompareOp::LT:
+        return lessThan(a, b);
+    default:
+        break;
+    }
+    // NullValue overrides the derived ordering operators to be invalid.
+    if (a.kind == Scalar::Kind::Null) {
+        return Result::Invalid;
+    }
+    switch (op) {
+    case CompareOp::GT:
+        return !lessThan(a, b) && !equal(a, b);
+    case CompareOp::GEQ:
+        return !lessThan(a, b);
+    default:
+        return lessThan(a, b) || equal(a, b);
+    }
+}
+
+bool
+toCompareOp(const Operator &op, CompareOp &result)
+{
+    if (op == FunctionOperator::EQ) {
+        result = CompareOp::EQ;
+    } else if (op == FunctionOperator::NE) {
+        result = CompareOp::NE;
+    } else if (op == FunctionOperator::LT) {
+        result = CompareOp::LT;
+    } else if (op == FunctionOperator::LEQ) {
+        result = CompareOp::LEQ;
+    } else if (op == FunctionOperator::GT) {
+        result = CompareOp::GT;
+    } else if (op == FunctionOperator::GEQ) {
+        result = CompareOp::GEQ;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Converts a value produced by a field independent expression. Returns false
+ * for value types only the interpreter handles.
+ */
+bool
+toScalar(const Value &value, Scalar &result)
+{
+    switch (value.getType()) {
+    case Value::Invalid:
+        result = Scalar();
+        return true;
+    case Value::Null:
+        result = Scalar::null();
+        return true;
+    case Value::String:
+        result = Scalar::string(static_cast<const StringValue &>(value).getValue());
+        return true;
+    case Value::Integer:
+        result = Scalar::integer(static_cast<const IntegerValue &>(value).getValue());
+        return true;
+    case Value::Float:
+        result = Scalar::floating(static_cast<const FloatValue &>(value).getValue());
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool
+documentTypeEqualsName(const DocumentType& type, vespalib::stringref name)
+{
+    if (type.getName() == name) return true;
+    for (const DocumentType * inherited : type.getInheritedTypes()) {
+        if (documentTypeEqualsName(*inherited, name)) return true;
+    }
+    return false;
+}
+
+class FieldReferenceDetector : public TraversingVisitor
+{
+    bool _found;
+    void visitFieldValueNode(const FieldValueNode &) override { _found = true; }
+    void visitVariableValueNode(const VariableValueNode &) override { _found = true; }
+public:
+    FieldReferenceDetector() : _found(false) { }
+    bool found() const { return _found; }
+};
+
+bool
+referencesFields(const Node &node)
+{
+    FieldReferenceDetector detector;
+    node.visit(detector);
+    return detector.found();
+}
+
+bool
+referencesFields(const ValueNode &node)
+{
+    FieldReferenceDetector detector;
+    node.visit(detector);
+    return detector.found();
+}
+
+/**
+ * Only plain field nodes naming a top level field are read directly;
+ * subclasses (e.g. attribute backed nodes) and field paths are left to the
+ * interpreter.
+ */
+const FieldValueNode *
+asPlainField(const ValueNode &node)
+{
+    if (typeid(node) != typeid(FieldValueNode)) {
+        return nullptr;
+    }
+    const auto &field = static_cast<const FieldValueNode &>(node);
+    return (field.getFieldName() == field.getRealFieldName()) ? &field : nullptr;
+}
+
+}
+
+struct CompiledSelection::FieldCompare {
+    vespalib::string  docType;
+    vespalib::string  fieldName;
+    CompareOp         op;
+    bool              fieldOnLeft;
+    // Either a literal known at compile time, or an expression evaluated per document (e.g. now()).
+    const ValueNode  *dynamicOperand;
+    vespalib::string  constantString;
+    Scalar            constant;
+
+    FieldCompare(const FieldValueNode &field, CompareOp op_, bool fieldOnLeft_, const ValueNode &operand);
+    FieldCompare(FieldCompare &&rhs);
+    ~FieldCompare();
+
+    /** Returns nullptr if the document must be handed to the interpreter. */
+    const Result * evaluate(const Context &context) const;
+private:
+    const Result * compareTo(const Scalar &fieldValue, const Context &context) const;
+};
+
+CompiledSelection::FieldCompare::FieldCompare(const FieldValueNode &field, CompareOp op_,
+                                              bool fieldOnLeft_, const ValueNode &operand)
+    : docType(field.getDocType()),
+      fieldName(field.getRealFieldName()),
+      op(op_),
+      fieldOnLeft(fieldOnLeft_),
+      dynamicOperand(&operand),
+      constantString(),
+      constant()
+{
+    if (auto intNode = dynamic_cast<const IntegerValueNode *>(&operand)) {
+        if (!intNode->isBucketValue()) {
+            constant = Scalar::integer(intNode->getValue());
+            dynamicOperand = nullptr;
+        }
+    } else if (auto floatNode = dynamic_cast<const FloatValueNode *>(&operand)) {
+        constant = Scalar::floating(floatNode->getValue());
+        dynamicOperand = nullptr;
+    } else if (auto stringNode = dynamic_cast<const StringValueNode *>(&operand)) {
+        constantString = stringNode->getValue();
+        constant = Scalar::string(constantString);
+        dynamicOperand = nullptr;
+    } else if (dynamic_cast<const NullValueNode *>(&operand) != nullptr) {
+        constant = Scalar::null();
+        dynamicOperand = nullptr;
+    } else if (dynamic_cast<const InvalidValueNode *>(&operand) != nullptr) {
+        dynamicOperand = nullptr;
+    }
+}
+
+CompiledSelection::FieldCompare::FieldCompare(FieldCompare &&rhs)
+    : docType(std::move(rhs.docType)),
+      fieldName(std::move(rhs.fieldName)),
+      op(rhs.op),
+      fieldOnLeft(rhs.fieldOnLeft),
+      dynamicOperand(rhs.dynamicOperand),
+      constantString(std::move(rhs.constantString)),
+      constant(rhs.constant)
+{
+    // The string reference must follow the moved string buffer.
+    if (constant.kind == Scalar::Kind::String) {
+        constant.stringValue = constantString;
+    }
+}
+
+CompiledSelection::FieldCompare::~FieldCompare() = default;
+
+const Result *
+CompiledSelection::FieldCompare::compareTo(const Scalar &fieldValue, const Context &context) const
+{
+    Scalar operand(constant);
+    Value::UP value;
+    if (dynamicOperand != nullptr) {
+        value = dynamicOperand->getValue(context);
+        if (!toScalar(*value, operand)) {
+            return nullptr;
+        }
+    }
+    return fieldOnLeft
+           ? &compareScalars(fieldValue, op, operand)
+           : &compareScalars(operand, op, fieldValue);
+}
+
+const Result *
+CompiledSelection::FieldCompare::evaluate(const Context &context) const
+{
+    if (context._doc == nullptr) {
+        return compareTo(Scalar(), context);
+    }
+    const Document &doc = *context._doc;
+    if (!documentTypeEqualsName(doc.getType(), docType)) {
+        return compareTo(Scalar(), context);
+    }
+    try {
+        const Field &field = doc.getType().getField(fieldName);
+        switch (field.getDataType().getId()) {
+        case DataType::T_INT: {
+            IntFieldValue fv;
+            return compareTo(doc.getValue(field, fv) ? Scalar::integer(fv.getAsInt()) : Scalar::null(), context);
+        }
+        case DataType::T_BYTE: {
+            ByteFieldValue fv;
+            return compareTo(doc.getValue(field, fv) ? Scalar::integer(fv.getAsByte()) : Scalar::null(), context);
+        }
+        case DataType::T_LONG: {
+            LongFieldValue fv;
+            return compareTo(doc.getValue(field, fv) ? Scalar::integer(fv.getAsLong()) : Scalar::null(), context);
+        }
+        case DataType::T_FLOAT: {
+            FloatFieldValue fv;
+            return compareTo(doc.getValue(field, fv) ? Scalar::floating(fv.getAsFloat()) : Scalar::null(), context);
+        }
+        case DataType::T_DOUBLE: {
+            DoubleFieldValue fv;
+            return compareTo(doc.getValue(field, fv) ? Scalar::floating(fv.getAsDouble()) : Scalar::null(), context);
+        }
+        case DataType::T_STRING: {
+            StringFieldValue fv;
+            return compareTo(doc.getValue(field, fv) ? Scalar::string(fv.getValueRef()) : Scalar::null(), context);
+        }
+        default:
+            return nullptr;
+        }
+    } catch (FieldNotFoundException &) {
+        return nullptr;
+    } catch (vespalib::IllegalArgumentException &) {
+        return nullptr;
+    }
+}
+
+/**
+ * Lowers a selection tree into a CompiledSelection program. Any construct not
+ * handled makes compile() return false, leaving the selection interpreted.
+ */
+class SelectionCompiler
+{
+    CompiledSelection &_target;
+
+    uint32_t emit(CompiledSelection::OpCode op, uint32_t arg = 0) {
+        _target._program.emplace_back(op, arg);
+        return _target._program.size() - 1;
+    }
+
+    void patchJump(uint32_t pos) {
+        _target._program[pos].arg = _target._program.size();
+    }
+
+    bool compileLeaf(const Node &node) {
+        if (referencesFields(node)) {
+            return false;
+        }
+        _target._nodes.push_back(&node);
+        emit(CompiledSelection::OpCode::EVAL_NODE, _target._nodes.size() - 1);
+        return true;
+    }
+
+    bool compileCompare(const Compare &node) {
+        bool leftHasFields = referencesFields(node.getLeft());
+        bool rightHasFields = referencesFields(node.getRight());
+        if (!leftHasFields && !rightHasFields) {
+            return compileLeaf(node);
+        }
+        if (leftHasFields && rightHasFields) {
+            return false;
+        }
+        CompareOp op;
+        if (!toCompareOp(node.getOperator(), op)) {
+            return false;
+        }
+        const FieldValueNode *field = asPlainField(leftHasFields ? node.getLeft() : node.getRight());
+        if (field == nullptr) {
+            return false;
+        }
+        _target._compares.emplace_back(*field, op, leftHasFields, leftHasFields ? node.getRight() : node.getLeft());
+        emit(CompiledSelection::OpCode::FIELD_COMPARE, _target._compares.size() - 1);
+        return true;
+    }
+
+    bool compileBranch(const Node &left, const Node &right, CompiledSelection::OpCode jump,
+                       CompiledSelection::OpCode op, uint32_t depth)
+    {
+        if (!compile(left, depth)) {
+            return false;
+        }
+        uint32_t jumpPos = emit(jump);
+        if (!compile(right, depth + 1)) {
+            return false;
+        }
+        emit(op);
+        patchJump(jumpPos);
+        return true;
+    }
+
+public:
+    explicit SelectionCompiler(CompiledSelection &target) : _target(target) { }
+
+    /** @param depth Number of results already on the evaluation stack. */
+    bool compile(const Node &node, uint32_t depth) {
+        if (depth >= CompiledSelection::MAX_STACK_DEPTH) {
+            return false;
+        }
+        if (auto andNode = dynamic_cast<const And *>(&node)) {
+            return compileBranch(andNode->getLeft(), andNode->getRight(),
+                                 CompiledSelection::OpCode::JUMP_IF_FALSE, CompiledSelection::OpCode::AND, depth);
+        }
+        if (auto orNode = dynamic_cast<const Or *>(&node)) {
+            return compileBranch(orNode->getLeft(), orNode->getRight(),
+                                 CompiledSelection::OpCode::JUMP_IF_TRUE, CompiledSelection::OpCode::OR, depth);
+        }
+        if (auto notNode = dynamic_cast<const Not *>(&node)) {
+            if (!compile(notNode->getChild(), depth)) {
+                return false;
+            }
+            emit(CompiledSelection::OpCode::NOT);
+            return true;
+        }
+        if (auto constant = dynamic_cast<const Constant *>(&node)) {
+            _target._results.push_back(&Result::get(constant->getConstantValue()));
+            emit(CompiledSelection::OpCode::PUSH_RESULT, _target._results.size() - 1);
+            return true;
+        }
+        if (auto compare = dynamic_cast<const Compare *>(&node)) {
+            return compileCompare(*compare);
+        }
+        if ((dynamic_cast<const DocType *>(&node) != nullptr) ||
+            (dynamic_cast<const InvalidConstant *>(&node) != nullptr))
+        {
+            return compileLeaf(node);
+        }
+        return false;
+    }
+};
+
+CompiledSelection::CompiledSelection(const Node& root)
+    : _root(root),
+      _program(),
+      _results(),
+      _nodes(),
+      _compares()
+{
+    SelectionCompiler compiler(*this);
+    if (!compiler.compile(root, 0)) {
+        _program.clear();
+        _results.clear();
+        _nodes.clear();
+        _compares.clear();
+    }
+}
+
+CompiledSelection::~CompiledSelection() = default;
+
+size_t
+CompiledSelection::getFieldCompareCount() const
+{
+    return _compares.size();
+}
+
+const Result *
+CompiledSelection::evaluate(const Context &context) const
+{
+    const Result *stack[MAX_STACK_DEPTH];
+    uint32_t sp = 0;
+    const uint32_t programSize = _program.size();
+    for (uint32_t pc = 0; pc < programSize; ++pc) {
+        const Instruction &instr = _program[pc];
+        switch (instr.op) {
+        case OpCode::PUSH_RESULT:
+            stack[sp++] = _results[instr.arg];
+            break;
+        case OpCode::EVAL_NODE:
+            stack[sp++] = &_nodes[instr.arg]->contains(context).combineResults();
+            break;
+        case OpCode::FIELD_COMPARE:
+            stack[sp] = _compares[instr.arg].evaluate(context);
+            if (stack[sp] == nullptr) {
+                return nullptr;
+            }
+            ++sp;
+            break;
+        case OpCode::JUMP_IF_FALSE:
+            if (*stack[sp - 1] == Result::False) {
+                pc = instr.arg - 1;
+            }
+            break;
+        case OpCode::JUMP_IF_TRUE:
+            if (*stack[sp - 1] == Result::True) {
+                pc = instr.arg - 1;
+            }
+            break;
+        case OpCode::AND:
+            --sp;
+            stack[sp - 1] = &(*stack[sp - 1] && *stack[sp]);
+            break;
+        case OpCode::OR:
+            --sp;
+            stack[sp - 1] = &(*stack[sp - 1] || *stack[sp]);
+            break;
+        case OpCode::NOT:
+            stack[sp - 1] = &!*stack[sp - 1];
+            break;
+        }
+    }
+    assert(sp == 1);
+    return stack[0];
+}
+
+const Result&
+CompiledSelection::contains(const Context& context) const
+{
+    if (isCompiled()) {
+        const Result *result = evaluate(context);
+        if (result != nullptr) {
+            return *result;
+        }
+    }
+    return _root.contains(context).combineResults();
+}
+
+}
@@ -0,0 +1,84 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "result.h"
+#include <vector>
+
+namespace document::select {
+
+class Context;
+class Node;
+
+/**
+ * A document selection expression compiled into a flat program.
+ *
+ * The tree interpreter (Node::contains) allocates a Value for every field and
+ * constant it touches and a ResultList for every node, per document. This
+ * class instead lowers the tree into a postfix instruction sequence with
+ * short-circuiting jumps. Comparisons between a plain document field and a
+ * field independent expression are type specialized: the field is
+ * deserialized straight from the serialized document into a stack local
+ * field value and compared without any heap allocation.
+ *
+ * Subtrees not referencing document fields are evaluated through the tree
+ * interpreter as opaque leaves. Expressions referencing fields in ways the
+ * compiler does not handle (variables, field paths, function calls on fields,
+ * field to field comparisons, regex/glob on fields) are not compiled at all,
+ * and contains() delegates the whole expression to the interpreter. If a
+ * document turns out to hold a field of a type the program does not support
+ * (e.g. a collection), that document is re-evaluated by the interpreter, so
+ * the result is always identical to Node::contains().combineResults().
+ *
+ * The referenced node tree must outlive this object. Evaluation does not
+ * mutate any state, so one instance may be shared between threads.
+ */
+class CompiledSelection
+{
+public:
+    static constexpr uint32_t MAX_STACK_DEPTH = 64;
+
+    explicit CompiledSelection(const Node& root);
+    CompiledSelection(const CompiledSelection &) = delete;
+    CompiledSelection & operator = (const CompiledSelection &) = delete;
+    ~CompiledSelection();
+
+    const Result& contains(const Context& context) const;
+
+    /** True if the expression was lowered into a program. */
+    bool isCompiled() const { return !_program.empty(); }
+    size_t getInstructionCount() const { return _program.size(); }
+    /** Number of field comparisons evaluated without the interpreter. */
+    size_t getFieldCompareCount() const;
+
+private:
+    enum class OpCode : uint8_t {
+        PUSH_RESULT,     // push _results[arg]
+        EVAL_NODE,       // push interpreted result of field independent subtree _nodes[arg]
+        FIELD_COMPARE,   // push result of _compares[arg]
+        JUMP_IF_FALSE,   // jump to arg, keeping top, if top is False
+        JUMP_IF_TRUE,    // jump to arg, keeping top, if top is True
+        AND,
+        OR,
+        NOT
+    };
+
+    struct Instruction {
+        OpCode   op;
+        uint32_t arg;
+        Instruction(OpCode op_, uint32_t arg_) : op(op_), arg(arg_) {}
+    };
+
+    struct FieldCompare;
+
+    const Node                 &_root;
+    std::vector<Instruction>    _program;
+    std::vector<const Result *> _results;
+    std::vector<const Node *>   _nodes;
+    std::vector<FieldCompare>   _compares;
+
+    const Result * evaluate(const Context &context) const;
+
+    friend class SelectionCompiler;
+};
+
+}
@@ -80,6 +80,7 @@ public:
         : _value(val), _isBucketValue(isBucketValue) {}
 
     int64_t getValue() const { return _value; }
+    bool isBucketValue() const { return _isBucketValue; }
 
     virtual std::unique_ptr<Value> getValue(const Context&) const override {
         return std::unique_ptr<Value>(new IntegerValue(_value, _isBucketValue));
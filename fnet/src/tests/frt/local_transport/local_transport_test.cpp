@@ -0,0 +1,152 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/net/crypto_engine.h>
+#include <vespa/vespalib/net/socket_spec.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/fnet/frt/frt.h>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace vespalib;
+
+CryptoEngine::SP null_crypto = std::make_shared<NullCryptoEngine>();
+
+struct SocketDir {
+    vespalib::string path;
+    SocketDir() : path() {
+        char tmpl[] = "/tmp/local_transport_test.XXXXXX";
+        path = mkdtemp(tmpl);
+    }
+    ~SocketDir() {
+        rmdir(path.c_str());
+    }
+};
+
+struct Rpc : FRT_Invokable {
+    FastOS_ThreadPool thread_pool;
+    FNET_Transport    transport;
+    FRT_Supervisor    orb;
+    Rpc(const SocketDir *dir)
+        : thread_pool(128 * 1024), transport(null_crypto, 1), orb(&transport, &thread_pool)
+    {
+        if (dir != nullptr) {
+            ASSERT_TRUE(orb.SetLocalTransport(dir->path));
+        }
+    }
+    void start() {
+        ASSERT_TRUE(transport.Start(&thread_pool));
+    }
+    ~Rpc() {
+        transport.ShutDown(true);
+        thread_pool.Close();
+    }
+};
+
+struct Server : Rpc {
+    Server(const SocketDir *dir) : Rpc(dir) {
+        ASSERT_TRUE(orb.Listen(0));
+        FRT_ReflectionBuilder rb(&orb);
+        rb.DefineMethod("inc", "l", "l", FRT_METHOD(Server::rpc_inc), this);
+        start();
+    }
+    void rpc_inc(FRT_RPCRequest *req) {
+        FRT_Values &params = *req->GetParams();
+        FRT_Values &ret    = *req->GetReturn();
+        ret.AddInt64(params[0]._intval64 + 1);
+    }
+    vespalib::string tcp_spec() const {
+        return make_string("tcp/localhost:%u", orb.GetListenPort());
+    }
+    vespalib::string local_spec(const SocketDir &dir) const {
+        return SocketSpec::from_port(orb.GetListenPort()).local_equivalent(dir.path).spec();
+    }
+};
+
+struct Client : Rpc {
+    Client(const SocketDir *dir) : Rpc(dir) { start(); }
+    // returns the spec of the connection used, or an empty string if the request failed
+    vespalib::string invoke(const vespalib::string &spec) {
+        FRT_Target *target = orb.GetTarget(spec.c_str());
+        FRT_RPCRequest *req = orb.AllocRPCRequest();
+        req->SetMethodName("inc");
+        req->GetParams()->AddInt64(41);
+        target->InvokeSync(req, 60.0);
+        vespalib::string used;
+        if (req->CheckReturnTypes("l") && (req->GetReturn()->GetValue(0)._intval64 == 42u)) {
+            used = target->GetConnection()->GetSpec();
+        }
+        req->SubRef();
+        target->SubRef();
+        return used;
+    }
+    // local targets are resolved in the background; invoke until the expected connection is used
+    bool eventually_uses(const vespalib::string &spec, const vespalib::string &expect) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+        while (invoke(spec) != expect) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+};
+
+TEST_FFF("require that local targets use the unix domain socket when both sides enable it",
+         SocketDir(), Server(&f1), Client(&f1))
+{
+    EXPECT_TRUE(f3.eventually_uses(f2.tcp_spec(), f2.local_spec(f1)));
+}
+
+TEST_FFF("require that the local socket is only accessible to the owner", SocketDir(), Server(&f1), Client(&f1)) {
+    struct stat info;
+    ASSERT_EQUAL(0, stat(SocketSpec(f2.local_spec(f1)).path().c_str(), &info));
+    EXPECT_TRUE(S_ISSOCK(info.st_mode));
+    EXPECT_EQUAL(0u, info.st_mode & (S_IRWXG | S_IRWXO));
+}
+
+TEST_FFF("require that tcp is used when the server does not listen locally", SocketDir(), Server(nullptr), Client(&f1)) {
+    EXPECT_EQUAL(f2.tcp_spec(), f3.invoke(f2.tcp_spec()));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQUAL(f2.tcp_spec(), f3.invoke(f2.tcp_spec()));
+}
+
+TEST_FFF("require that tcp is used when the client does not enable the local transport",
+         SocketDir(), Server(&f1), Client(nullptr))
+{
+    EXPECT_EQUAL(f2.tcp_spec(), f3.invoke(f2.tcp_spec()));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQUAL(f2.tcp_spec(), f3.invoke(f2.tcp_spec()));
+}
+
+TEST_FFF("require that tcp is used again when the local socket stops working", SocketDir(), Server(&f1), Client(&f1)) {
+    ASSERT_TRUE(f3.eventually_uses(f2.tcp_spec(), f2.local_spec(f1)));
+    ASSERT_EQUAL(0, unlink(SocketSpec(f2.local_spec(f1)).path().c_str()));
+    EXPECT_TRUE(f3.eventually_uses(f2.tcp_spec(), f2.tcp_spec()));
+    EXPECT_EQUAL(f2.tcp_spec(), f3.invoke(f2.tcp_spec()));
+}
+
+TEST_F("require that the local transport is not enabled with a socket directory accessible to others", SocketDir()) {
+    ASSERT_EQUAL(0, chmod(f1.path.c_str(), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH));
+    FRT_Supervisor orb;
+    EXPECT_FALSE(orb.SetLocalTransport(f1.path));
+    EXPECT_FALSE(orb.GetLocalTransport());
+    EXPECT_FALSE(orb.SetLocalTransport(f1.path + "/missing/parent"));
+    EXPECT_FALSE(orb.GetLocalTransport());
+}
+
+TEST_F("require that a missing socket directory is created", SocketDir()) {
+    vespalib::string dir = f1.path + "/sockets";
+    FRT_Supervisor orb;
+    EXPECT_TRUE(orb.SetLocalTransport(dir));
+    EXPECT_TRUE(orb.GetLocalTransport());
+    struct stat info;
+    ASSERT_EQUAL(0, stat(dir.c_str(), &info));
+    EXPECT_EQUAL(0u, info.st_mode & (S_IRWXG | S_IRWXO));
+    rmdir(dir.c_str());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,157 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vespalib/net/crypto_engine.h>
+#include <vespa/fnet/frt/frt.h>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <sys/resource.h>
+
+using namespace vespalib;
+
+CryptoEngine::SP null_crypto = std::make_shared<NullCryptoEngine>();
+
+// event loop settings applied to both client and server transports
+struct Mode {
+    const char *name;
+    bool        edgeTriggered;
+    uint32_t    busyPollUs;
+    bool        localTransport;
+};
+
+Mode level_mode = { "level triggered", false, 0, false };
+Mode edge_mode  = { "edge triggered", true, 0, false };
+Mode busy_mode  = { "edge triggered + 50us busy-poll", true, 50, false };
+Mode local_mode = { "edge triggered over unix domain socket", true, 0, true };
+
+const vespalib::string &socket_dir() {
+    static vespalib::string dir = [] {
+        char tmpl[] = "/tmp/round_trip_bench.XXXXXX";
+        return vespalib::string(mkdtemp(tmpl));
+    }();
+    return dir;
+}
+
+struct Rpc : FRT_Invokable {
+    FastOS_ThreadPool thread_pool;
+    FNET_Transport    transport;
+    FRT_Supervisor    orb;
+    Rpc(const Mode &mode)
+        : thread_pool(128 * 1024), transport(null_crypto, 1), orb(&transport, &thread_pool)
+    {
+        transport.SetEdgeTriggered(mode.edgeTriggered);
+        transport.SetBusyPollTime(mode.busyPollUs);
+        if (mode.localTransport) {
+            ASSERT_TRUE(orb.SetLocalTransport(socket_dir()));
+        }
+    }
+    void start() {
+        ASSERT_TRUE(transport.Start(&thread_pool));
+    }
+    ~Rpc() {
+        transport.ShutDown(true);
+        thread_pool.Close();
+    }
+};
+
+struct Server : Rpc {
+    uint32_t port;
+    Server(const Mode &mode) : Rpc(mode), port(0) {
+        ASSERT_TRUE(orb.Listen(0));
+        port = orb.GetListenPort();
+        FRT_ReflectionBuilder rb(&orb);
+        rb.DefineMethod("inc", "l", "l", FRT_METHOD(Server::rpc_inc), this);
+        start();
+    }
+    void rpc_inc(FRT_RPCRequest *req) {
+        FRT_Values &params = *req->GetParams();
+        FRT_Values &ret    = *req->GetReturn();
+        ret.AddInt64(params[0]._intval64 + 1);
+    }
+};
+
+struct Client : Rpc {
+    uint32_t port;
+    Client(const Mode &mode, const Server &server) : Rpc(mode), port(server.port) { start(); }
+};
+
+double cpu_seconds() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+        (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000000.0;
+}
+
+struct Result {
+    std::vector<size_t> cnt;
+    double wall_s;
+    double cpu_s;
+    Result(size_t num_threads) : cnt(num_threads, 0), wall_s(0.0), cpu_s(0.0) {}
+    void print(const Mode &mode) const {
+        size_t total = 0;
+        for (size_t value: cnt) {
+            total += value;
+        }
+        double cores = cpu_s / wall_s;
+        fprintf(stderr, "%s: %g round trips/s, %g cores used, %g round trips/s per core\n",
+                mode.name, total / wall_s, cores, total / cpu_s);
+    }
+};
+
+FRT_Target *get_target(Client &client, const Mode &mode) {
+    FRT_Target *target = client.orb.GetTarget(client.port);
+    // local targets are resolved in the background; wait until they are used
+    while (mode.localTransport && (strncmp(target->GetConnection()->GetSpec(), "ipc/", 4) != 0)) {
+        target->SubRef();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        target = client.orb.GetTarget(client.port);
+    }
+    return target;
+}
+
+void perform_test(size_t thread_id, const Mode &mode, Client &client, Result &result) {
+    uint64_t seq = 0;
+    FRT_Target *target = get_target(client, mode);
+    FRT_RPCRequest *req = client.orb.AllocRPCRequest();
+    auto invoke = [&](){
+        req = client.orb.AllocRPCRequest(req);
+        req->SetMethodName("inc");
+        req->GetParams()->AddInt64(seq);
+        target->InvokeSync(req, 60.0);
+        ASSERT_TRUE(req->CheckReturnTypes("l"));
+        seq = req->GetReturn()->GetValue(0)._intval64;
+    };
+    BenchmarkTimer::benchmark(invoke, 0.5); // warmup
+    TEST_BARRIER();
+    double cpu_before = cpu_seconds();
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + std::chrono::seconds(2);
+    while (std::chrono::steady_clock::now() < deadline) {
+        invoke();
+        ++result.cnt[thread_id];
+    }
+    TEST_BARRIER();
+    if (thread_id == 0) {
+        result.cpu_s = cpu_seconds() - cpu_before;
+        result.wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.print(mode);
+    }
+    req->SubRef();
+    target->SubRef();
+}
+
+TEST_MT_FFF("rpc round trips with 1 transport thread and 16 user threads (level triggered)",
+            16, Server(level_mode), Client(level_mode, f1), Result(num_threads)) { perform_test(thread_id, level_mode, f2, f3); }
+
+TEST_MT_FFF("rpc round trips with 1 transport thread and 16 user threads (edge triggered)",
+            16, Server(edge_mode), Client(edge_mode, f1), Result(num_threads)) { perform_test(thread_id, edge_mode, f2, f3); }
+
+TEST_MT_FFF("rpc round trips with 1 transport thread and 16 user threads (edge triggered, busy-poll)",
+            16, Server(busy_mode), Client(busy_mode, f1), Result(num_threads)) { perform_test(thread_id, busy_mode, f2, f3); }
+
+TEST_MT_FFF("rpc round trips with 1 transport thread and 16 user threads (edge triggered, local transport)",
+            16, Server(local_mode), Client(local_mode, f1), Result(num_threads)) { perform_test(thread_id, local_mode, f2, f3); }
+
+TEST_MAIN() { TEST_RUN_ALL(); }
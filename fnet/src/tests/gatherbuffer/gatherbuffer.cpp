@@ -0,0 +1,105 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/fnet/gatherbuffer.h>
+#include <vespa/fnet/packet.h>
+#include <string>
+
+struct MyPacket : public FNET_Packet
+{
+    std::string  payload;
+    int         &freeCnt;
+    MyPacket(uint32_t len, char c, int &freeCnt_in) : payload(len, c), freeCnt(freeCnt_in) {}
+    void Free() override { ++freeCnt; delete this; }
+    uint32_t GetPCODE() override { return 1; }
+    uint32_t GetLength() override { return payload.size(); }
+    void Encode(FNET_DataBuffer *dst) override { dst->WriteBytes(payload.data(), payload.size()); }
+    bool Decode(FNET_DataBuffer *, uint32_t) override { return false; }
+    void EncodeGather(FNET_GatherBuffer *dst) override { dst->WriteReference(payload.data(), payload.size()); }
+};
+
+std::string flatten(FNET_GatherBuffer &buf) {
+    struct iovec iov[16];
+    int cnt = buf.FillIOVec(iov, 16);
+    std::string result;
+    for (int i = 0; i < cnt; ++i) {
+        result.append(static_cast<const char *>(iov[i].iov_base), iov[i].iov_len);
+    }
+    return result;
+}
+
+TEST("require that small payloads are copied") {
+    int freeCnt = 0;
+    FNET_GatherBuffer buf(64);
+    auto *packet = new MyPacket(100, 'a', freeCnt);
+    buf.WriteBytes("hdr", 3);
+    packet->EncodeGather(&buf);
+    buf.PacketDone(packet);
+    EXPECT_EQUAL(1, freeCnt);
+    EXPECT_EQUAL(103u, buf.GetDataLen());
+    EXPECT_EQUAL(103u, buf.GetBytesCopied());
+    EXPECT_EQUAL(0u, buf.GetBytesReferenced());
+    struct iovec iov[4];
+    EXPECT_EQUAL(1, buf.FillIOVec(iov, 4));
+    EXPECT_EQUAL("hdr" + std::string(100, 'a'), flatten(buf));
+    buf.Consume(103);
+    EXPECT_EQUAL(0u, buf.GetDataLen());
+}
+
+TEST("require that large payloads are referenced in place") {
+    int freeCnt = 0;
+    FNET_GatherBuffer buf(64);
+    auto *packet = new MyPacket(10000, 'b', freeCnt);
+    buf.WriteBytes("hdr", 3);
+    packet->EncodeGather(&buf);
+    buf.WriteBytes("tail", 4);
+    buf.PacketDone(packet);
+    EXPECT_EQUAL(0, freeCnt);
+    EXPECT_EQUAL(10007u, buf.GetDataLen());
+    EXPECT_EQUAL(7u, buf.GetBytesCopied());
+    EXPECT_EQUAL(10000u, buf.GetBytesReferenced());
+    struct iovec iov[4];
+    ASSERT_EQUAL(3, buf.FillIOVec(iov, 4));
+    EXPECT_TRUE(iov[1].iov_base == packet->payload.data());
+    EXPECT_EQUAL(1, buf.FillIOVec(iov, 1));
+    EXPECT_EQUAL("hdr" + std::string(10000, 'b') + "tail", flatten(buf));
+    buf.Consume(10007);
+    EXPECT_EQUAL(1, freeCnt);
+}
+
+TEST("require that partial writes are handled") {
+    int freeCnt = 0;
+    FNET_GatherBuffer buf(64);
+    std::string expect;
+    for (char c = 'a'; c < 'd'; ++c) {
+        auto *packet = new MyPacket(5000, c, freeCnt);
+        buf.WriteBytes(&c, 1);
+        packet->EncodeGather(&buf);
+        buf.PacketDone(packet);
+        expect.append(1, c);
+        expect.append(5000, c);
+    }
+    uint32_t pos = 0;
+    while (buf.GetDataLen() > 0) {
+        EXPECT_EQUAL(expect.substr(pos), flatten(buf));
+        uint32_t len = std::min(uint64_t(3333), buf.GetDataLen());
+        buf.Consume(len);
+        pos += len;
+        EXPECT_EQUAL(int(pos / 5001), freeCnt);
+    }
+    EXPECT_EQUAL(3, freeCnt);
+}
+
+TEST("require that held packets are freed on destruction") {
+    int freeCnt = 0;
+    {
+        FNET_GatherBuffer buf(64);
+        auto *packet = new MyPacket(5000, 'x', freeCnt);
+        packet->EncodeGather(&buf);
+        buf.PacketDone(packet);
+        buf.Consume(100);
+        EXPECT_EQUAL(0, freeCnt);
+    }
+    EXPECT_EQUAL(1, freeCnt);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,89 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/fnet/mpscpacketqueue.h>
+#include <vespa/fnet/packetqueue.h>
+#include <vespa/fnet/packet.h>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Posts packets from many threads into a single consumer, comparing
+// the lock-free queue with a mutex protected queue flushed the way
+// the transport thread used to do it.
+
+constexpr uint32_t numPackets = 1000000; // in total, for all producers
+
+struct MyPacket : public FNET_Packet
+{
+    void Free() override {}
+    uint32_t GetPCODE() override { return 0; }
+    uint32_t GetLength() override { return 0; }
+    void Encode(FNET_DataBuffer *) override {}
+    bool Decode(FNET_DataBuffer *, uint32_t) override { return true; }
+};
+
+struct LockedQueue {
+    std::mutex              lock;
+    FNET_PacketQueue_NoLock queue;
+    void post(FNET_Packet *packet, FNET_Context context) {
+        std::lock_guard<std::mutex> guard(lock);
+        queue.QueuePacket_NoLock(packet, context);
+    }
+    void flush(FNET_PacketQueue_NoLock *target) {
+        std::lock_guard<std::mutex> guard(lock);
+        queue.FlushPackets_NoLock(target);
+    }
+};
+
+struct LockFreeQueue {
+    FNET_MPSCPacketQueue queue;
+    void post(FNET_Packet *packet, FNET_Context context) {
+        bool wasEmpty;
+        queue.QueuePacket(packet, context, wasEmpty);
+    }
+    void flush(FNET_PacketQueue_NoLock *target) {
+        queue.FlushPackets(target);
+    }
+};
+
+template <typename Q>
+double measure(uint32_t numThreads) {
+    MyPacket packet;
+    Q q;
+    uint32_t perThread = numPackets / numThreads;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> producers;
+    for (uint32_t t = 0; t < numThreads; ++t) {
+        producers.emplace_back([&q, &packet, perThread]() {
+                                   for (uint32_t i = 0; i < perThread; ++i) {
+                                       q.post(&packet, FNET_Context(i));
+                                   }
+                               });
+    }
+    FNET_PacketQueue_NoLock target;
+    uint32_t received = 0;
+    while (received < perThread * numThreads) {
+        q.flush(&target);
+        FNET_Context context;
+        while (target.DequeuePacket_NoLock(&context) != nullptr) {
+            ++received;
+        }
+    }
+    for (auto &producer: producers) {
+        producer.join();
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / received;
+}
+
+TEST("benchmark packet posting under contention") {
+    for (uint32_t numThreads: {1, 2, 4, 8, 16}) {
+        double locked = measure<LockedQueue>(numThreads);
+        double lockFree = measure<LockFreeQueue>(numThreads);
+        fprintf(stderr, "%2u posting threads: locked: %6.1f ns/packet, lock-free: %6.1f ns/packet\n",
+                numThreads, locked, lockFree);
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
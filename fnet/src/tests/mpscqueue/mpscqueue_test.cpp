@@ -0,0 +1,120 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/fnet/mpscpacketqueue.h>
+#include <vespa/fnet/packetqueue.h>
+#include <vespa/fnet/packet.h>
+#include <thread>
+#include <vector>
+
+struct MyPacket : public FNET_Packet
+{
+    int &freeCnt;
+    MyPacket(int &freeCnt_in) : freeCnt(freeCnt_in) {}
+    void Free() override { ++freeCnt; }
+    uint32_t GetPCODE() override { return 0; }
+    uint32_t GetLength() override { return 0; }
+    void Encode(FNET_DataBuffer *) override {}
+    bool Decode(FNET_DataBuffer *, uint32_t) override { return true; }
+};
+
+TEST("require that packets are flushed in queue order") {
+    int freeCnt = 0;
+    MyPacket packet(freeCnt);
+    FNET_MPSCPacketQueue queue;
+    FNET_PacketQueue_NoLock target;
+    bool wasEmpty = false;
+    EXPECT_TRUE(queue.IsEmpty());
+    EXPECT_TRUE(queue.QueuePacket(&packet, FNET_Context(1u), wasEmpty));
+    EXPECT_TRUE(wasEmpty);
+    EXPECT_TRUE(queue.QueuePacket(&packet, FNET_Context(2u), wasEmpty));
+    EXPECT_FALSE(wasEmpty);
+    EXPECT_TRUE(queue.QueuePacket(&packet, FNET_Context(3u), wasEmpty));
+    EXPECT_FALSE(wasEmpty);
+    EXPECT_FALSE(queue.IsEmpty());
+    EXPECT_TRUE(queue.FlushPackets(&target));
+    EXPECT_TRUE(queue.IsEmpty());
+    EXPECT_EQUAL(3u, target.GetPacketCnt_NoLock());
+    FNET_Context context;
+    for (uint32_t i = 1; i <= 3; ++i) {
+        EXPECT_EQUAL(&packet, target.DequeuePacket_NoLock(&context));
+        EXPECT_EQUAL(i, context._value.INT);
+    }
+    EXPECT_TRUE(queue.QueuePacket(&packet, FNET_Context(4u), wasEmpty));
+    EXPECT_TRUE(wasEmpty);
+    EXPECT_TRUE(queue.FlushPackets(&target));
+    EXPECT_EQUAL(1u, target.GetPacketCnt_NoLock());
+    target.DiscardPackets_NoLock();
+    EXPECT_EQUAL(1, freeCnt);
+}
+
+TEST("require that a closed queue rejects packets") {
+    int freeCnt = 0;
+    MyPacket packet(freeCnt);
+    FNET_MPSCPacketQueue queue;
+    FNET_PacketQueue_NoLock target;
+    bool wasEmpty = false;
+    EXPECT_TRUE(queue.QueuePacket(&packet, FNET_Context(1u), wasEmpty));
+    EXPECT_FALSE(queue.IsClosed());
+    EXPECT_FALSE(queue.Close());
+    EXPECT_TRUE(queue.IsClosed());
+    EXPECT_FALSE(queue.QueuePacket(&packet, FNET_Context(2u), wasEmpty));
+    EXPECT_TRUE(queue.FlushPackets(&target));
+    EXPECT_TRUE(queue.IsEmpty());
+    EXPECT_EQUAL(1u, target.GetPacketCnt_NoLock());
+    target.DiscardPackets_NoLock();
+    EXPECT_TRUE(FNET_MPSCPacketQueue().Close());
+}
+
+TEST("require that unflushed packets are discarded by the destructor") {
+    int freeCnt = 0;
+    MyPacket packet(freeCnt);
+    {
+        FNET_MPSCPacketQueue queue;
+        bool wasEmpty = false;
+        EXPECT_TRUE(queue.QueuePacket(&packet, FNET_Context(1u), wasEmpty));
+        EXPECT_TRUE(queue.QueuePacket(&packet, FNET_Context(2u), wasEmpty));
+    }
+    EXPECT_EQUAL(2, freeCnt);
+}
+
+TEST("require that concurrent producers keep their own packet order") {
+    constexpr uint32_t numThreads = 8;
+    constexpr uint32_t numPackets = 100000;
+    int freeCnt = 0;
+    MyPacket packet(freeCnt);
+    FNET_MPSCPacketQueue queue;
+    std::vector<std::thread> producers;
+    for (uint32_t t = 0; t < numThreads; ++t) {
+        producers.emplace_back([&queue, &packet, t]() {
+                                   bool wasEmpty = false;
+                                   for (uint32_t i = 0; i < numPackets; ++i) {
+                                       queue.QueuePacket(&packet, FNET_Context((t << 24) | i), wasEmpty);
+                                   }
+                               });
+    }
+    FNET_PacketQueue_NoLock target;
+    std::vector<uint32_t> next(numThreads, 0);
+    uint32_t received = 0;
+    bool inOrder = true;
+    while (received < numThreads * numPackets) {
+        queue.FlushPackets(&target);
+        FNET_Context context;
+        while (target.DequeuePacket_NoLock(&context) != nullptr) {
+            uint32_t t = context._value.INT >> 24;
+            uint32_t i = context._value.INT & 0xffffff;
+            inOrder = inOrder && (i == next[t]);
+            next[t] = i + 1;
+            ++received;
+        }
+    }
+    for (auto &producer: producers) {
+        producer.join();
+    }
+    EXPECT_TRUE(inOrder);
+    EXPECT_TRUE(queue.FlushPackets(&target));
+    EXPECT_TRUE(queue.IsEmpty());
+    EXPECT_TRUE(target.IsEmpty_NoLock());
+    EXPECT_EQUAL(0, freeCnt);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -15,6 +15,8 @@ public:
     uint32_t  _maxInputBufferSize;
     uint32_t  _maxOutputBufferSize;
     bool      _tcpNoDelay;
+    bool      _edgeTriggered;
+    uint32_t  _busyPollUs;
 
     FNET_Config();
 };
@@ -304,6 +304,8 @@ bool
 FNET_Connection::Read()
 {
     size_t   chunk_size  = std::max(size_t(FNET_READ_SIZE), _socket->min_read_buffer_size());
+    bool     edge        = EdgeTriggered();
+    int      maxReadCnt  = edge ? FNET_READ_REDO_EDGE : FNET_READ_REDO;
     int      readCnt     = 0;     // read count
     bool     broken      = false; // is this conn broken ?
     int      my_errno    = 0;     // sample and preserve errno
@@ -318,7 +320,7 @@ FNET_Connection::Read()
         _input.FreeToData((uint32_t)res);
         broken = !handle_packets();
         _input.resetIfEmpty();
-        if (broken || ((_input.GetFreeLen() > 0) && !_flags._framed) || (readCnt >= FNET_READ_REDO)) {
+        if (broken || ((_input.GetFreeLen() > 0) && !_flags._framed) || (readCnt >= maxReadCnt)) {
             goto done_read;
         }
         _input.EnsureFree(chunk_size);
@@ -343,6 +345,10 @@ done_read:
         }
     }
 
+    if (edge && !broken && (readCnt >= maxReadCnt)) {
+        RearmEvents(); // stopped before the socket would block
+    }
+
     UpdateTimeOut();
     uint32_t maxSize = GetConfig()->_maxInputBufferSize;
     if (maxSize > 0 && _input.GetBufSize() > maxSize)
@@ -376,9 +382,11 @@ FNET_Connection::Write()
     bool     broken         = false; // is this conn broken ?
     int      my_errno       = 0;     // sample and preserve errno
     ssize_t  res;                    // single write result
+    uint64_t written        = 0;     // bytes written by this call
 
     FNET_Packet     *packet;
     FNET_Context     context;
+    struct iovec     iov[FNET_WRITE_IOV];
 
     do {
 
@@ -390,9 +398,11 @@ FNET_Connection::Write()
 
             packet = _myQueue.DequeuePacket_NoLock(&context);
             if (packet->IsRegularPacket()) { // ignore non-regular packets
-                _streamer->Encode(packet, context._value.INT, &_output);
+                _streamer->EncodeGather(packet, context._value.INT, &_output);
+                _output.PacketDone(packet);
+            } else {
+                packet->Free();
             }
-            packet->Free();
         }
 
         if (_output.GetDataLen() == 0) {
@@ -402,12 +412,12 @@ FNET_Connection::Write()
 
         // write data
 
-        res = _socket->write(_output.GetData(), _output.GetDataLen());
+        res = _socket->writev(iov, _output.FillIOVec(iov, FNET_WRITE_IOV));
         my_errno = errno;
         writeCnt++;
         if (res > 0) {
-            _output.DataToDead((uint32_t)res);
-            _output.resetIfEmpty();
+            _output.Consume((uint64_t)res);
+            written += res;
         }
     } while (res > 0 &&
              _output.GetDataLen() == 0 &&
@@ -432,6 +442,10 @@ FNET_Connection::Write()
         _output.Shrink(maxSize);
     }
 
+    _bytesWritten.fetch_add(written, std::memory_order_relaxed);
+    _bytesCopied.store(_output.GetBytesCopied(), std::memory_order_relaxed);
+    _bytesReferenced.store(_output.GetBytesReferenced(), std::memory_order_relaxed);
+
     if (res < 0) {
         if ((my_errno == EWOULDBLOCK) || (my_errno == EAGAIN)) {
             ++my_write_work; // incomplete write/flush
@@ -450,8 +464,11 @@ FNET_Connection::Write()
     bool writePending = (_writeWork > 0);
 
     guard.unlock();
-    if (!writePending)
+    if (!writePending) {
         EnableWriteEvent(false);
+    } else if (!broken && (writeCnt >= FNET_WRITE_REDO) && EdgeTriggered()) {
+        RearmEvents(); // stopped before the socket would block
+    }
 
     return !broken;
 }
@@ -486,7 +503,10 @@ FNET_Connection::FNET_Connection(FNET_TransportThread *owner,
       _output(FNET_WRITE_SIZE * 2),
       _channels(),
       _callbackTarget(nullptr),
-      _cleanup(nullptr)
+      _cleanup(nullptr),
+      _bytesWritten(0),
+      _bytesCopied(0),
+      _bytesReferenced(0)
 {
     assert(_socket && (_socket->get_fd() >= 0));
 }
@@ -519,7 +539,10 @@ FNET_Connection::FNET_Connection(FNET_TransportThread *owner,
       _output(FNET_WRITE_SIZE * 2),
       _channels(),
       _callbackTarget(nullptr),
-      _cleanup(nullptr)
+      _cleanup(nullptr),
+      _bytesWritten(0),
+      _bytesCopied(0),
+      _bytesReferenced(0)
 {
     if (adminHandler != nullptr) {
         FNET_Channel::UP admin(new FNET_Channel(FNET_NOID, this, adminHandler, adminContext));
@@ -529,6 +552,17 @@ FNET_Connection::FNET_Connection(FNET_TransportThread *owner,
 }
 
 
+FNET_Connection::Stats
+FNET_Connection::GetStats() const
+{
+    Stats stats;
+    stats.bytesWritten = _bytesWritten.load(std::memory_order_relaxed);
+    stats.bytesCopied = _bytesCopied.load(std::memory_order_relaxed);
+    stats.bytesReferenced = _bytesReferenced.load(std::memory_order_relaxed);
+    return stats;
+}
+
+
 FNET_Connection::~FNET_Connection()
 {
     if (_adminChannel != nullptr) {
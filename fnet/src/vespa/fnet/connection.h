@@ -4,12 +4,14 @@
 
 #include "iocomponent.h"
 #include "databuffer.h"
+#include "gatherbuffer.h"
 #include "context.h"
 #include "channellookup.h"
 #include "packetqueue.h"
 #include <vespa/vespalib/net/socket_handle.h>
 #include <vespa/vespalib/net/async_resolver.h>
 #include <vespa/vespalib/net/crypto_socket.h>
+#include <atomic>
 
 class FNET_IPacketStreamer;
 class FNET_IServerAdapter;
@@ -60,8 +62,23 @@ public:
     enum {
         FNET_READ_SIZE  = 8192,
         FNET_READ_REDO  = 10,
+        FNET_READ_REDO_EDGE = 64,
         FNET_WRITE_SIZE = 8192,
-        FNET_WRITE_REDO = 10
+        FNET_WRITE_REDO = 10,
+        FNET_WRITE_IOV  = 64
+    };
+
+    /**
+     * Output statistics for a single connection. Bytes copied counts
+     * all data copied into the output buffer (packet headers and small
+     * payloads); bytes referenced counts large payloads written
+     * directly from packet memory.
+     **/
+    struct Stats {
+        uint64_t bytesWritten;
+        uint64_t bytesCopied;
+        uint64_t bytesReferenced;
+        Stats() : bytesWritten(0), bytesCopied(0), bytesReferenced(0) {}
     };
 
 private:
@@ -105,12 +122,16 @@ private:
     FNET_DataBuffer          _input;           // input buffer
     FNET_PacketQueue_NoLock  _queue;           // outer output queue
     FNET_PacketQueue_NoLock  _myQueue;         // inner output queue
-    FNET_DataBuffer          _output;          // output buffer
+    FNET_GatherBuffer        _output;          // output buffer
     FNET_ChannelLookup       _channels;        // channel 'DB'
     FNET_Channel            *_callbackTarget;  // target of current callback
 
     FNET_IConnectionCleanupHandler *_cleanup;  // cleanup handler
 
+    std::atomic<uint64_t>    _bytesWritten;    // output stats
+    std::atomic<uint64_t>    _bytesCopied;
+    std::atomic<uint64_t>    _bytesReferenced;
+
     FNET_Connection(const FNET_Connection &);
     FNET_Connection &operator=(const FNET_Connection &);
 
@@ -338,6 +359,15 @@ public:
     State GetState() { return _state; }
 
 
+    /**
+     * Obtain output statistics for this connection. May be called
+     * from any thread.
+     *
+     * @return output statistics
+     **/
+    Stats GetStats() const;
+
+
     /**
      * Initialize connection. This method should be called directly
      * after creation, before the object is shared. If this method
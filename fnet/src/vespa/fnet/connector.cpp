@@ -43,8 +43,9 @@ FNET_Connector::Close()
 bool
 FNET_Connector::HandleReadEvent()
 {
-    SocketHandle handle = _server_socket.accept();
-    if (handle.valid()) {
+    // with edge triggered events, accept until the backlog is empty
+    bool acceptAll = EdgeTriggered();
+    for (SocketHandle handle = _server_socket.accept(); handle.valid(); handle = _server_socket.accept()) {
         FNET_Transport &transport = Owner()->owner();
         FNET_TransportThread *thread = transport.select_thread(&handle, sizeof(handle));
         if (thread->tune(handle)) {
@@ -55,6 +56,9 @@ FNET_Connector::HandleReadEvent()
                 LOG(debug, "Connector(%s): failed to init incoming connection", GetSpec());
             }
         }
+        if (!acceptAll) {
+            break;
+        }
     }
     return true;
 }
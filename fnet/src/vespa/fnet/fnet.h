@@ -28,6 +28,7 @@ class FNET_DataBuffer;
 class FNET_DummyPacket;
 class FNET_Info;
 class FNET_IOComponent;
+class FNET_MPSCPacketQueue;
 class FNET_Packet;
 class FNET_PacketQueue;
 class FNET_Scheduler;
@@ -55,6 +56,7 @@ class FNET_TransportThread;
 #include "dummypacket.h"
 #include "controlpacket.h"
 #include "packetqueue.h"
+#include "mpscpacketqueue.h"
 #include "channel.h"
 #include "channellookup.h"
 #include "simplepacketstreamer.h"
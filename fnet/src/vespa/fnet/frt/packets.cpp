@@ -4,6 +4,7 @@
 #include "rpcrequest.h"
 #include <vespa/fnet/info.h>
 #include <vespa/fnet/databuffer.h>
+#include <vespa/fnet/gatherbuffer.h>
 #include <vespa/vespalib/util/stringfmt.h>
 
 
@@ -59,6 +60,23 @@ FRT_RPCRequestPacket::Encode(FNET_DataBuffer *dst)
 }
 
 
+void
+FRT_RPCRequestPacket::EncodeGather(FNET_GatherBuffer *dst)
+{
+    uint32_t packet_endian = ((_flags & FLAG_FRT_RPC_LITTLE_ENDIAN) != 0)
+                             ? FNET_Info::ENDIAN_LITTLE : FNET_Info::ENDIAN_BIG;
+
+    if (packet_endian == FNET_Info::GetEndian()) {
+        uint32_t tmp = _req->GetMethodNameLen();
+        dst->WriteBytes(&tmp, sizeof(tmp));
+        dst->WriteBytes(_req->GetMethodName(), _req->GetMethodNameLen());
+        _req->GetParams()->EncodeGather(dst);
+    } else {
+        FNET_Packet::EncodeGather(dst);
+    }
+}
+
+
 bool
 FRT_RPCRequestPacket::Decode(FNET_DataBuffer *src, uint32_t len)
 {
@@ -134,6 +152,20 @@ FRT_RPCReplyPacket::Encode(FNET_DataBuffer *dst)
 }
 
 
+void
+FRT_RPCReplyPacket::EncodeGather(FNET_GatherBuffer *dst)
+{
+    uint32_t packet_endian = ((_flags & FLAG_FRT_RPC_LITTLE_ENDIAN) != 0)
+                             ? FNET_Info::ENDIAN_LITTLE : FNET_Info::ENDIAN_BIG;
+
+    if (packet_endian == FNET_Info::GetEndian()) {
+        _req->GetReturn()->EncodeGather(dst);
+    } else {
+        FNET_Packet::EncodeGather(dst);
+    }
+}
+
+
 bool
 FRT_RPCReplyPacket::Decode(FNET_DataBuffer *src, uint32_t len)
 {
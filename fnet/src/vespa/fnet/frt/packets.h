@@ -60,6 +60,7 @@ public:
     uint32_t GetPCODE() override;
     uint32_t GetLength() override;
     void Encode(FNET_DataBuffer *dst) override;
+    void EncodeGather(FNET_GatherBuffer *dst) override;
     bool Decode(FNET_DataBuffer *src, uint32_t len) override;
     vespalib::string Print(uint32_t indent = 0) override;
 };
@@ -76,6 +77,7 @@ public:
     uint32_t GetPCODE() override;
     uint32_t GetLength() override;
     void Encode(FNET_DataBuffer *dst) override;
+    void EncodeGather(FNET_GatherBuffer *dst) override;
     bool Decode(FNET_DataBuffer *src, uint32_t len) override;
     vespalib::string Print(uint32_t indent = 0) override;
 };
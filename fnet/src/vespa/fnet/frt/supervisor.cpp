@@ -7,7 +7,157 @@
 #include <vespa/fnet/transport.h>
 #include <vespa/fnet/transport_thread.h>
 #include <vespa/fnet/connector.h>
+#include <vespa/vespalib/net/socket_spec.h>
+#include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/fastos/thread.h>
+#include <cerrno>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".fnet.frt.supervisor");
+
+/**
+ * Keeps track of which local targets can be reached through the unix
+ * domain socket equivalent of their spec. Each spec is probed in the
+ * background and connected with tcp in the meantime. A spec is probed
+ * again when a local connection to it is lost, and a while after a
+ * probe failed.
+ **/
+class FRT_Supervisor::LocalTransport : public std::enable_shared_from_this<LocalTransport>
+{
+public:
+    using clock = std::chrono::steady_clock;
+    static constexpr std::chrono::seconds REPROBE_INTERVAL{60};
+
+    LocalTransport(FNET_Transport &transport, const vespalib::string &socketDir)
+        : _transport(transport), _socketDir(socketDir), _lock(), _resolved() {}
+
+    const vespalib::string &socketDir() const { return _socketDir; }
+
+    /**
+     * Returns the local spec to connect to, or an empty string to
+     * connect to the given spec with tcp.
+     **/
+    vespalib::string resolve(const vespalib::string &spec) {
+        vespalib::SocketSpec local = localSpec(spec);
+        if (local.valid() && (startProbe(spec, false) == State::LOCAL)) {
+            return local.spec();
+        }
+        return vespalib::string();
+    }
+
+    /**
+     * Checks the given spec again after a local connection to it was
+     * lost. tcp is used until the check succeeds.
+     **/
+    void lost(const vespalib::string &spec) { startProbe(spec, true); }
+
+private:
+    enum class State { UNKNOWN, PROBING, LOCAL, TCP };
+    struct Entry {
+        State             state;
+        clock::time_point probed;
+        Entry() : state(State::UNKNOWN), probed() {}
+    };
+
+    vespalib::SocketSpec localSpec(const vespalib::string &spec) const {
+        vespalib::SocketSpec remote(spec);
+        if (!remote.is_local()) {
+            return vespalib::SocketSpec(vespalib::string()); // invalid
+        }
+        return remote.local_equivalent(_socketDir);
+    }
+
+    State startProbe(const vespalib::string &spec, bool force);
+
+    void probe(const vespalib::string &spec) {
+        // A connect to a unix domain socket completes (or fails)
+        // right away; only use the socket when a server is listening.
+        bool ok = localSpec(spec).client_address().connect().valid();
+        std::lock_guard<std::mutex> guard(_lock);
+        Entry &entry = _resolved[spec];
+        entry.state = ok ? State::LOCAL : State::TCP;
+        entry.probed = clock::now();
+    }
+
+    FNET_Transport                   &_transport;
+    vespalib::string                  _socketDir;
+    std::mutex                        _lock;
+    std::map<vespalib::string, Entry> _resolved;
+};
+
+constexpr std::chrono::seconds FRT_Supervisor::LocalTransport::REPROBE_INTERVAL;
+
+FRT_Supervisor::LocalTransport::State
+FRT_Supervisor::LocalTransport::startProbe(const vespalib::string &spec, bool force)
+{
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        Entry &entry = _resolved[spec];
+        if (entry.state == State::PROBING) {
+            return entry.state;
+        }
+        if (!force && ((entry.state == State::LOCAL) ||
+                       ((entry.state == State::TCP) && (clock::now() < entry.probed + REPROBE_INTERVAL))))
+        {
+            return entry.state;
+        }
+        entry.state = State::PROBING;
+    }
+    std::shared_ptr<LocalTransport> self = shared_from_this();
+    _transport.post_or_perform(vespalib::makeLambdaTask([self, spec]() { self->probe(spec); }));
+    return State::PROBING;
+}
+
+namespace {
+
+/**
+ * Admin channel handler of a local connection, telling the local
+ * transport when the connection is lost so that tcp is used until the
+ * local socket is found to work again (e.g. if the connection failed
+ * because the server is gone). Deletes itself when done.
+ **/
+class LocalConnectionWatch : public FNET_IPacketHandler
+{
+public:
+    LocalConnectionWatch(std::weak_ptr<FRT_Supervisor::LocalTransport> owner, const vespalib::string &spec)
+        : _owner(std::move(owner)), _spec(spec) {}
+
+    HP_RetCode HandlePacket(FNET_Packet *packet, FNET_Context) override {
+        if (!packet->IsChannelLostCMD()) {
+            packet->Free();
+            return FNET_KEEP_CHANNEL;
+        }
+        if (auto owner = _owner.lock()) {
+            owner->lost(_spec);
+        }
+        delete this;
+        return FNET_FREE_CHANNEL;
+    }
+
+private:
+    std::weak_ptr<FRT_Supervisor::LocalTransport> _owner;
+    vespalib::string                              _spec;
+};
+
+bool
+isPrivateDirectory(const vespalib::string &dir)
+{
+    struct stat info;
+    if ((lstat(dir.c_str(), &info) != 0) && (errno == ENOENT)) {
+        mkdir(dir.c_str(), S_IRWXU);
+    }
+    return ((lstat(dir.c_str(), &info) == 0) &&
+            S_ISDIR(info.st_mode) &&
+            (info.st_uid == geteuid()) &&
+            ((info.st_mode & (S_IRWXG | S_IRWXO)) == 0));
+}
+
+} // namespace <unnamed>
 
 FRT_Supervisor::FRT_Supervisor(FNET_Transport *transport,
                                FastOS_ThreadPool *threadPool)
@@ -17,6 +167,8 @@ FRT_Supervisor::FRT_Supervisor(FNET_Transport *transport,
       _packetFactory(),
       _packetStreamer(&_packetFactory),
       _connector(nullptr),
+      _localConnector(nullptr),
+      _localTransport(),
       _reflectionManager(),
       _rpcHooks(&_reflectionManager),
       _connHooks(*this),
@@ -35,6 +187,8 @@ FRT_Supervisor::FRT_Supervisor(vespalib::CryptoEngine::SP crypto,
       _packetFactory(),
       _packetStreamer(&_packetFactory),
       _connector(nullptr),
+      _localConnector(nullptr),
+      _localTransport(),
       _reflectionManager(),
       _rpcHooks(&_reflectionManager),
       _connHooks(*this),
@@ -59,6 +213,9 @@ FRT_Supervisor::~FRT_Supervisor()
     if (_connector != nullptr) {
         _connector->SubRef();
     }
+    if (_localConnector != nullptr) {
+        _localConnector->SubRef();
+    }
     delete _methodMismatchHook;
 }
 
@@ -71,6 +228,17 @@ FRT_Supervisor::Listen(const char *spec)
     if (_connector != nullptr)
         return false;
     _connector = _transport->Listen(spec, &_packetStreamer, this);
+    if ((_connector != nullptr) && _localTransport && (vespalib::SocketSpec(spec).port() >= 0)) {
+        vespalib::SocketSpec local = vespalib::SocketSpec::from_port(GetListenPort())
+                                     .local_equivalent(_localTransport->socketDir());
+        _localConnector = _transport->Listen(local.spec().c_str(), &_packetStreamer, this);
+        if (_localConnector == nullptr) {
+            LOG(debug, "could not listen on local transport '%s', using '%s' only",
+                local.spec().c_str(), spec);
+        } else {
+            chmod(local.path().c_str(), S_IRUSR | S_IWUSR);
+        }
+    }
     return (_connector != nullptr);
 }
 
@@ -91,12 +259,49 @@ FRT_Supervisor::GetListenPort() const
 }
 
 
+bool
+FRT_Supervisor::SetLocalTransport(const vespalib::string &socketDir)
+{
+    _localTransport.reset();
+    if (socketDir.empty()) {
+        return false;
+    }
+    if (!isPrivateDirectory(socketDir)) {
+        LOG(warning, "local transport disabled: '%s' is not a directory accessible only to this user",
+            socketDir.c_str());
+        return false;
+    }
+    _localTransport = std::make_shared<LocalTransport>(*_transport, socketDir);
+    return true;
+}
+
+
+FNET_Connection *
+FRT_Supervisor::Connect(FNET_TransportThread &thread, const char *spec,
+                        FNET_IServerAdapter *serverAdapter, FNET_Context connContext)
+{
+    if (_localTransport) {
+        vespalib::string local = _localTransport->resolve(spec);
+        if (!local.empty()) {
+            auto watch = std::make_unique<LocalConnectionWatch>(_localTransport, spec);
+            FNET_Connection *conn = thread.Connect(local.c_str(), &_packetStreamer, watch.get(), FNET_Context(),
+                                                   serverAdapter, connContext);
+            if (conn != nullptr) {
+                watch.release(); // deleted by itself when the connection is lost
+                return conn;
+            }
+            _localTransport->lost(spec);
+        }
+    }
+    return thread.Connect(spec, &_packetStreamer, nullptr, FNET_Context(), serverAdapter, connContext);
+}
+
+
 FRT_Target *
 FRT_Supervisor::GetTarget(const char *spec)
 {
     FNET_TransportThread *thread = _transport->select_thread(spec, strlen(spec));
-    return new FRT_Target(thread->GetScheduler(),
-                          thread->Connect(spec, &_packetStreamer));
+    return new FRT_Target(thread->GetScheduler(), Connect(*thread, spec, nullptr, FNET_Context()));
 }
 
 
@@ -104,10 +309,7 @@ FRT_Target *
 FRT_Supervisor::Get2WayTarget(const char *spec, FNET_Context connContext)
 {
     FNET_TransportThread *thread = _transport->select_thread(spec, strlen(spec));
-    return new FRT_Target(thread->GetScheduler(),
-                          thread->Connect(spec, &_packetStreamer,
-                                  nullptr, FNET_Context(),
-                                  this, connContext));
+    return new FRT_Target(thread->GetScheduler(), Connect(*thread, spec, this, connContext));
 }
 
 
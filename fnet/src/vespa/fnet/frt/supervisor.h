@@ -12,6 +12,7 @@
 #include <vespa/vespalib/net/crypto_engine.h>
 
 class FNET_Transport;
+class FNET_TransportThread;
 class FRT_Target;
 class FastOS_ThreadPool;
 class FNET_Scheduler;
@@ -66,6 +67,8 @@ public:
         void Cleanup(FNET_Connection *conn) override;
     };
 
+    class LocalTransport; // see SetLocalTransport
+
 private:
     FNET_Transport            *_transport;
     FastOS_ThreadPool         *_threadPool;
@@ -74,6 +77,8 @@ private:
     FRT_PacketFactory          _packetFactory;
     FNET_SimplePacketStreamer  _packetStreamer;
     FNET_Connector            *_connector;
+    FNET_Connector            *_localConnector;
+    std::shared_ptr<LocalTransport> _localTransport;
     FRT_ReflectionManager      _reflectionManager;
     RPCHooks                   _rpcHooks;
     ConnHooks                  _connHooks;
@@ -82,6 +87,9 @@ private:
     FRT_Supervisor(const FRT_Supervisor &);
     FRT_Supervisor &operator=(const FRT_Supervisor &);
 
+    FNET_Connection *Connect(FNET_TransportThread &thread, const char *spec,
+                             FNET_IServerAdapter *serverAdapter, FNET_Context connContext);
+
 public:
     FRT_Supervisor(FNET_Transport *transport, FastOS_ThreadPool *threadPool);
     FRT_Supervisor(vespalib::CryptoEngine::SP crypto, uint32_t threadStackSize = 65000, uint32_t maxThreads = 0);
@@ -95,6 +103,31 @@ public:
     FastOS_ThreadPool *GetThreadPool() { return _threadPool; }
     FRT_ReflectionManager *GetReflectionManager() { return &_reflectionManager; }
 
+    /**
+     * Enable or disable the local transport. When enabled, listening
+     * on a tcp port will also listen on a unix domain socket named
+     * after the port in the given directory, and targets on the local
+     * host are connected through such a socket when one is
+     * present. This bypasses the tcp stack for co-located
+     * processes. It must be set before calling Listen to have any
+     * effect on the server side.
+     *
+     * Only processes running as the same user can use the local
+     * transport: the directory is created if needed and must be owned
+     * by the current user and not be accessible to anyone else,
+     * otherwise the local transport stays disabled.
+     *
+     * Whether a target can be reached locally is checked once per
+     * spec, in the background. Targets are connected with tcp until
+     * the check has succeeded, and again after a local connection is
+     * lost until a new check succeeds.
+     *
+     * @return whether the local transport is enabled
+     * @param socketDir directory of the local sockets, empty to disable
+     **/
+    bool SetLocalTransport(const vespalib::string &socketDir);
+    bool GetLocalTransport() const { return static_cast<bool>(_localTransport); }
+
     bool Listen(const char *spec);
     bool Listen(int port);
     uint32_t GetListenPort() const;
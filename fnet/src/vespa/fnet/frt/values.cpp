@@ -2,6 +2,7 @@
 
 #include "values.h"
 #include <vespa/fnet/databuffer.h>
+#include <vespa/fnet/gatherbuffer.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <cassert>
 
@@ -1222,21 +1223,43 @@ error:
 }
 
 
+namespace {
+
+// Host order encoding sinks. 'fixed' is used for value headers and
+// scalars, 'payload' for array, string and data contents.
+
+struct CopySink {
+    FNET_DataBuffer *dst;
+    explicit CopySink(FNET_DataBuffer *dst_in) : dst(dst_in) {}
+    void fixed(const void *src, uint32_t len) { dst->WriteBytesFast(src, len); }
+    void payload(const void *src, uint32_t len) { dst->WriteBytesFast(src, len); }
+};
+
+struct GatherSink {
+    FNET_GatherBuffer *dst;
+    explicit GatherSink(FNET_GatherBuffer *dst_in) : dst(dst_in) {}
+    void fixed(const void *src, uint32_t len) { dst->WriteBytes(src, len); }
+    void payload(const void *src, uint32_t len) { dst->WriteReference(src, len); }
+};
+
+}
+
+template <typename SINK>
 void
-FRT_Values::EncodeCopy(FNET_DataBuffer *dst)
+FRT_Values::EncodeHostOrder(SINK &dst)
 {
     uint32_t numValues = _numValues;
     const char *p = _typeString;
 
-    dst->WriteBytesFast(&numValues, sizeof(numValues));
-    dst->WriteBytesFast(p, numValues);
+    dst.fixed(&numValues, sizeof(numValues));
+    dst.fixed(p, numValues);
 
     for (uint32_t i = 0; i < numValues; i++, p++) {
 
         switch (*p) {
 
         case FRT_VALUE_INT8:
-            dst->WriteInt8Fast(_values[i]._intval8);
+            dst.fixed(&(_values[i]._intval8), sizeof(uint8_t));
             break;
 
         case FRT_VALUE_INT8_ARRAY:
@@ -1244,13 +1267,13 @@ FRT_Values::EncodeCopy(FNET_DataBuffer *dst)
             uint32_t  len = _values[i]._int8_array._len;
             uint8_t  *pt  = _values[i]._int8_array._pt;
 
-            dst->WriteBytesFast(&len, sizeof(len));
-            dst->WriteBytesFast(pt, len);
+            dst.fixed(&len, sizeof(len));
+            dst.payload(pt, len);
         }
         break;
 
         case FRT_VALUE_INT16:
-            dst->WriteBytesFast(&(_values[i]._intval16), sizeof(uint16_t));
+            dst.fixed(&(_values[i]._intval16), sizeof(uint16_t));
             break;
 
         case FRT_VALUE_INT16_ARRAY:
@@ -1258,13 +1281,13 @@ FRT_Values::EncodeCopy(FNET_DataBuffer *dst)
             uint32_t  len = _values[i]._int16_array._len;
             uint16_t *pt  = _values[i]._int16_array._pt;
 
-            dst->WriteBytesFast(&len, sizeof(len));
-            dst->WriteBytesFast(pt, len * sizeof(uint16_t));
+            dst.fixed(&len, sizeof(len));
+            dst.payload(pt, len * sizeof(uint16_t));
         }
         break;
 
         case FRT_VALUE_INT32:
-            dst->WriteBytesFast(&(_values[i]._intval32), sizeof(uint32_t));
+            dst.fixed(&(_values[i]._intval32), sizeof(uint32_t));
             break;
 
         case FRT_VALUE_INT32_ARRAY:
@@ -1272,13 +1295,13 @@ FRT_Values::EncodeCopy(FNET_DataBuffer *dst)
             uint32_t  len = _values[i]._int32_array._len;
             uint32_t *pt  = _values[i]._int32_array._pt;
 
-            dst->WriteBytesFast(&len, sizeof(len));
-            dst->WriteBytesFast(pt, len * sizeof(uint32_t));
+            dst.fixed(&len, sizeof(len));
+            dst.payload(pt, len * sizeof(uint32_t));
         }
         break;
 
         case FRT_VALUE_INT64:
-            dst->WriteBytesFast(&(_values[i]._intval64), sizeof(uint64_t));
+            dst.fixed(&(_values[i]._intval64), sizeof(uint64_t));
             break;
 
         case FRT_VALUE_INT64_ARRAY:
@@ -1286,13 +1309,13 @@ FRT_Values::EncodeCopy(FNET_DataBuffer *dst)
             uint32_t  len = _values[i]._int64_array._len;
             uint64_t *pt  = _values[i]._int64_array._pt;
 
-            dst->WriteBytesFast(&len, sizeof(len));
-            dst->WriteBytesFast(pt, len * sizeof(uint64_t));
+            dst.fixed(&len, sizeof(len));
+            dst.payload(pt, len * sizeof(uint64_t));
         }
         break;
 
         case FRT_VALUE_FLOAT:
-            dst->WriteBytesFast(&(_values[i]._intval32), sizeof(uint32_t));
+            dst.fixed(&(_values[i]._intval32), sizeof(uint32_t));
             break;
 
         case FRT_VALUE_FLOAT_ARRAY:
@@ -1300,13 +1323,13 @@ FRT_Values::EncodeCopy(FNET_DataBuffer *dst)
             uint32_t  len = _values[i]._float_array._len;
             uint32_t *pt  = (uint32_t *) _values[i]._float_array._pt;
 
-            dst->WriteBytesFast(&len, sizeof(len));
-            dst->WriteBytesFast(pt, len * sizeof(uint32_t));
+            dst.fixed(&len, sizeof(len));
+            dst.payload(pt, len * sizeof(uint32_t));
         }
         break;
 
         case FRT_VALUE_DOUBLE:
-            dst->WriteBytesFast(&(_values[i]._intval64), sizeof(uint64_t));
+            dst.fixed(&(_values[i]._intval64), sizeof(uint64_t));
             break;
 
         case FRT_VALUE_DOUBLE_ARRAY:
@@ -1314,14 +1337,14 @@ FRT_Values::EncodeCopy(FNET_DataBuffer *dst)
             uint32_t  len = _values[i]._double_array._len;
             uint64_t *pt  = (uint64_t *) _values[i]._double_array._pt;
 
-            dst->WriteBytesFast(&len, sizeof(len));
-            dst->WriteBytesFast(pt, len * sizeof(uint64_t));
+            dst.fixed(&len, sizeof(len));
+            dst.payload(pt, len * sizeof(uint64_t));
         }
         break;
 
         case FRT_VALUE_STRING:
-            dst->WriteBytesFast(&(_values[i]._string._len), sizeof(uint32_t));
-            dst->WriteBytesFast(_values[i]._string._str,
+            dst.fixed(&(_values[i]._string._len), sizeof(uint32_t));
+            dst.payload(_values[i]._string._str,
                                 _values[i]._string._len);
             break;
 
@@ -1330,17 +1353,17 @@ FRT_Values::EncodeCopy(FNET_DataBuffer *dst)
             uint32_t         len = _values[i]._string_array._len;
             FRT_StringValue *pt  = _values[i]._string_array._pt;
 
-            dst->WriteBytesFast(&len, sizeof(len));
+            dst.fixed(&len, sizeof(len));
             for (; len > 0; len--, pt++) {
-                dst->WriteBytesFast(&(pt->_len), sizeof(uint32_t));
-                dst->WriteBytesFast(pt->_str, pt->_len);
+                dst.fixed(&(pt->_len), sizeof(uint32_t));
+                dst.payload(pt->_str, pt->_len);
             }
         }
         break;
 
         case FRT_VALUE_DATA:
-            dst->WriteBytesFast(&(_values[i]._data._len), sizeof(uint32_t));
-            dst->WriteBytesFast(_values[i]._data._buf,
+            dst.fixed(&(_values[i]._data._len), sizeof(uint32_t));
+            dst.payload(_values[i]._data._buf,
                                 _values[i]._data._len);
             break;
 
@@ -1349,10 +1372,10 @@ FRT_Values::EncodeCopy(FNET_DataBuffer *dst)
             uint32_t       len = _values[i]._data_array._len;
             FRT_DataValue *pt  = _values[i]._data_array._pt;
 
-            dst->WriteBytesFast(&len, sizeof(len));
+            dst.fixed(&len, sizeof(len));
             for (; len > 0; len--, pt++) {
-                dst->WriteBytesFast(&(pt->_len), sizeof(uint32_t));
-                dst->WriteBytesFast(pt->_buf, pt->_len);
+                dst.fixed(&(pt->_len), sizeof(uint32_t));
+                dst.payload(pt->_buf, pt->_len);
             }
         }
         break;
@@ -1364,6 +1387,22 @@ FRT_Values::EncodeCopy(FNET_DataBuffer *dst)
 }
 
 
+void
+FRT_Values::EncodeCopy(FNET_DataBuffer *dst)
+{
+    CopySink sink(dst);
+    EncodeHostOrder(sink);
+}
+
+
+void
+FRT_Values::EncodeGather(FNET_GatherBuffer *dst)
+{
+    GatherSink sink(dst);
+    EncodeHostOrder(sink);
+}
+
+
 void
 FRT_Values::EncodeBig(FNET_DataBuffer *dst)
 {
@@ -12,6 +12,7 @@ namespace fnet {
     struct BlobRef;
 }
 class FNET_DataBuffer;
+class FNET_GatherBuffer;
 
 template <typename T>
 struct FRT_Array {
@@ -91,6 +92,9 @@ private:
     fnet::BlobRef *_blobs;
     Stash         &_stash;
 
+    template <typename SINK>
+    void EncodeHostOrder(SINK &dst);
+
 public:
     FRT_Values(const FRT_Values &) = delete;
     FRT_Values &operator=(const FRT_Values &) = delete;
@@ -238,6 +242,7 @@ public:
     bool DecodeBig(FNET_DataBuffer *dst, uint32_t len);
     bool DecodeLittle(FNET_DataBuffer *dst, uint32_t len);
     void EncodeCopy(FNET_DataBuffer *dst);
+    void EncodeGather(FNET_GatherBuffer *dst);
     void EncodeBig(FNET_DataBuffer *dst);
     bool Equals(FRT_Values *values);
     static void Print(FRT_Value value, uint32_t type, uint32_t indent = 0);
@@ -0,0 +1,124 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "gatherbuffer.h"
+#include "packet.h"
+#include <algorithm>
+#include <cassert>
+
+FNET_GatherBuffer::FNET_GatherBuffer(uint32_t len)
+    : _inline(len),
+      _segments(),
+      _held(),
+      _inlineTracked(0),
+      _refPending(0),
+      _queuedPos(0),
+      _consumedPos(0),
+      _packetRefs(0),
+      _bytesCopied(0),
+      _bytesReferenced(0)
+{
+}
+
+
+FNET_GatherBuffer::~FNET_GatherBuffer()
+{
+    for (const HeldPacket &held : _held) {
+        held.packet->Free();
+    }
+}
+
+
+void
+FNET_GatherBuffer::syncInline()
+{
+    uint32_t total = _inline.GetDataLen();
+    if (total > _inlineTracked) {
+        uint32_t len = total - _inlineTracked;
+        if (!_segments.empty() && _segments.back().ref == nullptr) {
+            _segments.back().len += len;
+        } else {
+            _segments.emplace_back(nullptr, len);
+        }
+        _inlineTracked = total;
+        _queuedPos += len;
+        _bytesCopied += len;
+    }
+}
+
+
+void
+FNET_GatherBuffer::WriteReference(const void *src, uint32_t len)
+{
+    if (len < MIN_REFERENCE_SIZE) {
+        _inline.WriteBytes(src, len);
+        return;
+    }
+    syncInline();
+    _segments.emplace_back(static_cast<const char *>(src), len);
+    _refPending += len;
+    _queuedPos += len;
+    _bytesReferenced += len;
+    ++_packetRefs;
+}
+
+
+void
+FNET_GatherBuffer::PacketDone(FNET_Packet *packet)
+{
+    syncInline();
+    if (_packetRefs > 0) {
+        _held.emplace_back(_queuedPos, packet);
+        _packetRefs = 0;
+    } else {
+        packet->Free();
+    }
+}
+
+
+int
+FNET_GatherBuffer::FillIOVec(struct iovec *iov, int maxCnt)
+{
+    syncInline();
+    const char *inlineData = _inline.GetData();
+    int cnt = 0;
+    for (auto it = _segments.begin(); it != _segments.end() && cnt < maxCnt; ++it, ++cnt) {
+        if (it->ref == nullptr) {
+            iov[cnt].iov_base = const_cast<char *>(inlineData);
+            inlineData += it->len;
+        } else {
+            iov[cnt].iov_base = const_cast<char *>(it->ref);
+        }
+        iov[cnt].iov_len = it->len;
+    }
+    return cnt;
+}
+
+
+void
+FNET_GatherBuffer::Consume(uint64_t len)
+{
+    syncInline();
+    assert(len <= GetDataLen());
+    _consumedPos += len;
+    while (len > 0) {
+        Segment &seg = _segments.front();
+        uint32_t n = std::min(len, uint64_t(seg.len));
+        if (seg.ref == nullptr) {
+            _inline.DataToDead(n);
+            _inlineTracked -= n;
+        } else {
+            seg.ref += n;
+            _refPending -= n;
+        }
+        seg.len -= n;
+        len -= n;
+        if (seg.len == 0) {
+            _segments.pop_front();
+        }
+    }
+    _inline.resetIfEmpty();
+    while (!_held.empty() && _held.front().endPos <= _consumedPos) {
+        _held.front().packet->Free();
+        _held.pop_front();
+    }
+}
@@ -0,0 +1,140 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "databuffer.h"
+#include <deque>
+#include <sys/uio.h>
+
+class FNET_Packet;
+
+/**
+ * Output buffer supporting scatter/gather writes. Small pieces of
+ * encoded packets (headers, integers, short strings) are copied into
+ * an inline data buffer, while large payloads may be referenced in
+ * place. The resulting byte stream is presented as an iovec list to
+ * be written with a single writev call. Packets that have payload
+ * referenced by this buffer are kept alive (not freed) until all of
+ * their bytes have been consumed.
+ **/
+class FNET_GatherBuffer
+{
+public:
+    enum {
+        MIN_REFERENCE_SIZE = 4096 // payloads smaller than this are copied
+    };
+
+private:
+    struct Segment {
+        const char *ref; // nullptr for inline data
+        uint32_t    len;
+        Segment(const char *ref_in, uint32_t len_in) : ref(ref_in), len(len_in) {}
+    };
+    struct HeldPacket {
+        uint64_t     endPos; // stream position after the last byte of the packet
+        FNET_Packet *packet;
+        HeldPacket(uint64_t endPos_in, FNET_Packet *packet_in) : endPos(endPos_in), packet(packet_in) {}
+    };
+
+    FNET_DataBuffer        _inline;
+    std::deque<Segment>    _segments;
+    std::deque<HeldPacket> _held;
+    uint32_t               _inlineTracked;  // inline bytes covered by _segments
+    uint64_t               _refPending;     // referenced bytes not yet consumed
+    uint64_t               _queuedPos;      // total bytes ever added
+    uint64_t               _consumedPos;    // total bytes ever consumed
+    uint32_t               _packetRefs;     // references made by the current packet
+    uint64_t               _bytesCopied;
+    uint64_t               _bytesReferenced;
+
+    FNET_GatherBuffer(const FNET_GatherBuffer &);
+    FNET_GatherBuffer &operator=(const FNET_GatherBuffer &);
+
+    void syncInline();
+
+public:
+    FNET_GatherBuffer(uint32_t len);
+    ~FNET_GatherBuffer();
+
+    /**
+     * @return buffer used for data that should be copied. Data
+     *         written here is placed in the output stream after any
+     *         data added earlier.
+     **/
+    FNET_DataBuffer &GetInline() { return _inline; }
+
+    /**
+     * Copy the given bytes into the output stream.
+     *
+     * @param src source bytes
+     * @param len number of bytes
+     **/
+    void WriteBytes(const void *src, uint32_t len) {
+        _inline.WriteBytes(src, len);
+    }
+
+    /**
+     * Add the given bytes to the output stream. Large payloads are
+     * referenced rather than copied; the memory must stay valid until
+     * the packet currently being encoded is released by this buffer
+     * (see @ref PacketDone).
+     *
+     * @param src payload bytes
+     * @param len number of bytes
+     **/
+    void WriteReference(const void *src, uint32_t len);
+
+    /**
+     * Signal that the given packet has been fully encoded into this
+     * buffer. The packet is freed right away if none of its memory is
+     * referenced, otherwise it is freed when its last byte has been
+     * consumed.
+     *
+     * @param packet the packet just encoded
+     **/
+    void PacketDone(FNET_Packet *packet);
+
+    /**
+     * @return number of bytes not yet consumed
+     **/
+    uint64_t GetDataLen() const { return _inline.GetDataLen() + _refPending; }
+
+    /**
+     * Describe the unconsumed data as an iovec list.
+     *
+     * @return number of iovec entries used
+     * @param iov target iovec array
+     * @param maxCnt capacity of the iovec array
+     **/
+    int FillIOVec(struct iovec *iov, int maxCnt);
+
+    /**
+     * Mark the given number of bytes from the front of the stream as
+     * written. Packets whose data has been completely written are
+     * freed.
+     *
+     * @param len number of bytes written
+     **/
+    void Consume(uint64_t len);
+
+    /**
+     * Try to shrink the inline buffer to the given size.
+     *
+     * @return true if the buffer was shrunk
+     * @param newsize wanted size of the inline buffer
+     **/
+    bool Shrink(uint32_t newsize) { return _inline.Shrink(newsize); }
+
+    uint32_t GetBufSize() const { return _inline.GetBufSize(); }
+
+    /**
+     * @return total number of bytes copied into the inline buffer
+     **/
+    uint64_t GetBytesCopied() const { return _bytesCopied + _inline.GetDataLen() - _inlineTracked; }
+
+    /**
+     * @return total number of payload bytes written by reference
+     **/
+    uint64_t GetBytesReferenced() const { return _bytesReferenced; }
+};
+
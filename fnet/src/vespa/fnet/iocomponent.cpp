@@ -133,6 +133,15 @@ FNET_IOComponent::EnableWriteEvent(bool enabled)
 }
 
 
+void
+FNET_IOComponent::RearmEvents()
+{
+    if (_ioc_selector != nullptr) {
+        _ioc_selector->update(_ioc_socket_fd, *this, _flags._ioc_readEnabled, _flags._ioc_writeEnabled);
+    }
+}
+
+
 bool
 FNET_IOComponent::handle_add_event()
 {
@@ -182,6 +182,23 @@ public:
     void EnableWriteEvent(bool enabled);
 
 
+    /**
+     * @return true if the attached selector uses edge triggered events.
+     **/
+    bool EdgeTriggered() const {
+        return (_ioc_selector != nullptr) && _ioc_selector->edge_triggered();
+    }
+
+
+    /**
+     * Re-register the currently enabled events with the attached
+     * selector. With edge triggered events this makes the selector
+     * report readiness that is already present; used when a handler
+     * stops before the socket would block.
+     **/
+    void RearmEvents();
+
+
     //----------- virtual methods below ----------------------//
 
     /**
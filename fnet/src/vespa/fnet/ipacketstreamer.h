@@ -3,6 +3,7 @@
 #pragma once
 
 #include "context.h"
+#include "gatherbuffer.h"
 
 class FNET_DataBuffer;
 class FNET_Packet;
@@ -81,5 +82,22 @@ public:
      **/
     virtual void Encode(FNET_Packet *packet, uint32_t chid,
                         FNET_DataBuffer *dst) = 0;
+
+    /**
+     * This method is called to stream a packet to the given gather
+     * buffer. Streamers able to pass large packet payloads by
+     * reference should override this method. The default
+     * implementation copies the packet into the inline buffer using
+     * @ref Encode.
+     *
+     * @param packet the packet to stream
+     * @param chid channel id for packet
+     * @param dst the target buffer for streaming
+     **/
+    virtual void EncodeGather(FNET_Packet *packet, uint32_t chid,
+                              FNET_GatherBuffer *dst)
+    {
+        Encode(packet, chid, &dst->GetInline());
+    }
 };
 
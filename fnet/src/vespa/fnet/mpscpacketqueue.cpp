@@ -0,0 +1,119 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "mpscpacketqueue.h"
+#include "packet.h"
+#include "packetqueue.h"
+
+FNET_MPSCPacketQueue::Node *
+FNET_MPSCPacketQueue::AllocNode(FNET_Packet *packet, FNET_Context context)
+{
+    uint64_t top = _free.load(std::memory_order_acquire);
+    while (untag(top) != nullptr) {
+        Node *node = untag(top);
+        // node may be taken by someone else at this point, but its
+        // memory stays valid and the tag will make our swap fail
+        uint64_t next = reinterpret_cast<uint64_t>(node->_next.load(std::memory_order_relaxed));
+        uint64_t tag = (top & ~PTR_MASK) + TAG_ONE;
+        if (_free.compare_exchange_weak(top, tag | next,
+                                        std::memory_order_acquire,
+                                        std::memory_order_acquire))
+        {
+            node->_next.store(nullptr, std::memory_order_relaxed);
+            node->_packet = packet;
+            node->_context = context;
+            return node;
+        }
+    }
+    return new Node(packet, context);
+}
+
+
+void
+FNET_MPSCPacketQueue::FreeNodes(Node *first, Node *last)
+{
+    uint64_t top = _free.load(std::memory_order_relaxed);
+    uint64_t tagged;
+    do {
+        last->_next.store(untag(top), std::memory_order_relaxed);
+        tagged = ((top & ~PTR_MASK) + TAG_ONE) | reinterpret_cast<uint64_t>(first);
+    } while (!_free.compare_exchange_weak(top, tagged,
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed));
+}
+
+
+FNET_MPSCPacketQueue::FNET_MPSCPacketQueue()
+    : _head(nullptr),
+      _state(0),
+      _free(0),
+      _tail(new Node(nullptr, FNET_Context()))
+{
+    _head.store(_tail, std::memory_order_relaxed);
+}
+
+
+FNET_MPSCPacketQueue::~FNET_MPSCPacketQueue()
+{
+    Node *node = _tail->_next.load(std::memory_order_acquire);
+    delete _tail;
+    while (node != nullptr) {
+        Node *next = node->_next.load(std::memory_order_acquire);
+        node->_packet->Free(); // discard packet
+        delete node;
+        node = next;
+    }
+    node = untag(_free.load(std::memory_order_acquire));
+    while (node != nullptr) {
+        Node *next = node->_next.load(std::memory_order_relaxed);
+        delete node;
+        node = next;
+    }
+}
+
+
+bool
+FNET_MPSCPacketQueue::QueuePacket(FNET_Packet *packet, FNET_Context context, bool &wasEmpty)
+{
+    uint64_t old = _state.fetch_add(1, std::memory_order_acq_rel);
+    if ((old & CLOSED) != 0) {
+        _state.fetch_sub(1, std::memory_order_acq_rel);
+        return false;
+    }
+    wasEmpty = (old == 0);
+    Node *node = AllocNode(packet, context);
+    Node *prev = _head.exchange(node, std::memory_order_acq_rel);
+    prev->_next.store(node, std::memory_order_release);
+    return true;
+}
+
+
+bool
+FNET_MPSCPacketQueue::FlushPackets(FNET_PacketQueue_NoLock *target)
+{
+    uint64_t cnt = 0;
+    Node *first = _tail;
+    Node *last = nullptr;
+    Node *next = _tail->_next.load(std::memory_order_acquire);
+    while (next != nullptr) {
+        target->QueuePacket_NoLock(next->_packet, next->_context);
+        next->_packet = nullptr;  // next becomes the new stub node
+        last = _tail;
+        _tail = next;
+        ++cnt;
+        next = _tail->_next.load(std::memory_order_acquire);
+    }
+    if (cnt == 0) {
+        return ((_state.load(std::memory_order_acquire) & ~CLOSED) == 0);
+    }
+    FreeNodes(first, last);
+    uint64_t old = _state.fetch_sub(cnt, std::memory_order_acq_rel);
+    return ((old & ~CLOSED) == cnt);
+}
+
+
+bool
+FNET_MPSCPacketQueue::Close()
+{
+    uint64_t old = _state.fetch_or(CLOSED, std::memory_order_acq_rel);
+    return ((old & ~CLOSED) == 0);
+}
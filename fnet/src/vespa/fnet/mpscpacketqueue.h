@@ -0,0 +1,125 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "context.h"
+#include <atomic>
+
+class FNET_Packet;
+class FNET_PacketQueue_NoLock;
+
+/**
+ * Lock-free multi-producer/single-consumer queue of packets. Any
+ * number of threads may queue packets concurrently without taking a
+ * lock, while a single consumer thread periodically moves the queued
+ * packets into a private @ref FNET_PacketQueue_NoLock for
+ * processing. Packets queued by a single thread are delivered in the
+ * order they were queued.
+ *
+ * The queue keeps a count of packets that have been accepted but not
+ * yet flushed. Producers are told when they make the queue non-empty,
+ * which is when the consumer needs to be woken up. A producer may be
+ * preempted between accepting a packet and linking it into the queue;
+ * such packets are counted but not yet visible to the consumer, and
+ * are reported as pending by @ref FlushPackets.
+ *
+ * Queue nodes are recycled through a lock-free free list, so
+ * posting a packet does not allocate memory once the queue has
+ * warmed up.
+ *
+ * The queue may be closed, after which all new packets are rejected
+ * and handed back to the producer. This lets the consumer drain the
+ * queue for the last time knowing that nothing will be added later.
+ **/
+class FNET_MPSCPacketQueue
+{
+private:
+    FNET_MPSCPacketQueue(const FNET_MPSCPacketQueue &);
+    FNET_MPSCPacketQueue &operator=(const FNET_MPSCPacketQueue &);
+
+    static constexpr uint64_t CLOSED = uint64_t(1) << 63;
+
+#ifndef IAM_DOXYGEN
+    struct Node
+    {
+        std::atomic<Node*>  _next;
+        FNET_Packet        *_packet;
+        FNET_Context        _context;
+        Node(FNET_Packet *packet, FNET_Context context)
+            : _next(nullptr), _packet(packet), _context(context) {}
+    };
+#endif // DOXYGEN
+
+    // free nodes are kept in a stack with an ABA tag in the upper
+    // pointer bits; nodes are never returned to the allocator until
+    // the queue is destructed.
+    static constexpr uint64_t PTR_MASK = (uint64_t(1) << 48) - 1;
+    static constexpr uint64_t TAG_ONE  = uint64_t(1) << 48;
+
+    alignas(64) std::atomic<Node*>    _head;  // last linked node (producers)
+    alignas(64) std::atomic<uint64_t> _state; // accepted packet count | CLOSED
+    alignas(64) std::atomic<uint64_t> _free;  // tagged free node stack
+    alignas(64) Node                 *_tail;  // consumed stub node (consumer)
+
+    static Node *untag(uint64_t tagged) {
+        return reinterpret_cast<Node*>(tagged & PTR_MASK);
+    }
+    Node *AllocNode(FNET_Packet *packet, FNET_Context context);
+    void FreeNodes(Node *first, Node *last);
+
+public:
+    FNET_MPSCPacketQueue();
+    ~FNET_MPSCPacketQueue();
+
+
+    /**
+     * Queue a packet. This method may be called by any thread. If the
+     * queue has been closed, the packet is rejected and ownership
+     * stays with the caller. NOTE: packet handover (caller TO invoked
+     * object) if the packet was accepted.
+     *
+     * @return false if the queue was closed.
+     * @param packet the packet you want to queue.
+     * @param context the context for the packet.
+     * @param wasEmpty set to true if the queue was empty before this
+     *                 packet was queued (the consumer should be woken up).
+     **/
+    bool QueuePacket(FNET_Packet *packet, FNET_Context context, bool &wasEmpty);
+
+
+    /**
+     * Move all visible packets into the given queue. This method may
+     * only be called by the consumer thread.
+     *
+     * @return false if some accepted packets were not yet visible
+     *         and the flush should be retried later.
+     * @param target where to flush the packets.
+     **/
+    bool FlushPackets(FNET_PacketQueue_NoLock *target);
+
+
+    /**
+     * Close the queue. All packets queued after this call are
+     * rejected. Closing a closed queue has no effect.
+     *
+     * @return true if the queue was empty when it was closed.
+     **/
+    bool Close();
+
+
+    /**
+     * @return true if the queue has been closed.
+     **/
+    bool IsClosed() const {
+        return ((_state.load(std::memory_order_acquire) & CLOSED) != 0);
+    }
+
+
+    /**
+     * @return true if no accepted packets are waiting to be flushed.
+     **/
+    bool IsEmpty() const {
+        return ((_state.load(std::memory_order_acquire) & ~CLOSED) == 0);
+    }
+};
+
@@ -5,6 +5,7 @@
 #include <vespa/vespalib/stllike/string.h>
 
 class FNET_DataBuffer;
+class FNET_GatherBuffer;
 
 /**
  * This is a general superclass of all packets. Packets are used to
@@ -136,6 +137,19 @@ public:
     virtual void Encode(FNET_DataBuffer *dst) = 0;
 
 
+    /**
+     * Encode this packet into a GatherBuffer. Packets with large
+     * payloads may override this method to have the payload written
+     * by reference instead of being copied. Memory referenced this
+     * way must stay valid until the packet is freed. The default
+     * implementation copies the packet using @ref Encode. This method
+     * may only be called on regular packets. See @ref IsRegularPacket.
+     *
+     * @param dst the target gather buffer
+     **/
+    virtual void EncodeGather(FNET_GatherBuffer *dst);
+
+
     /**
      * Decode data from the given DataBuffer and store that information
      * in this object. This method may only be called on regular
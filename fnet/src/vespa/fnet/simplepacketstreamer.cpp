@@ -66,3 +66,19 @@ FNET_SimplePacketStreamer::Encode(FNET_Packet *packet, uint32_t chid,
     packet->Encode(dst);
     dst->AssertValid();
 }
+
+
+void
+FNET_SimplePacketStreamer::EncodeGather(FNET_Packet *packet, uint32_t chid,
+                                        FNET_GatherBuffer *dst)
+{
+    uint32_t len   = packet->GetLength();
+    uint32_t pcode = packet->GetPCODE();
+    FNET_DataBuffer &buf = dst->GetInline();
+    buf.EnsureFree(3 * sizeof(uint32_t));
+    buf.WriteInt32Fast(len + 2 * sizeof(uint32_t));
+    buf.WriteInt32Fast(pcode);
+    buf.WriteInt32Fast(chid);
+    packet->EncodeGather(dst);
+    buf.AssertValid();
+}
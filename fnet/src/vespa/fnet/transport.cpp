@@ -131,6 +131,22 @@ FNET_Transport::SetTCPNoDelay(bool noDelay)
     }
 }
 
+void
+FNET_Transport::SetEdgeTriggered(bool edgeTriggered)
+{
+    for (const auto &thread: _threads) {
+        thread->SetEdgeTriggered(edgeTriggered);
+    }
+}
+
+void
+FNET_Transport::SetBusyPollTime(uint32_t us)
+{
+    for (const auto &thread: _threads) {
+        thread->SetBusyPollTime(us);
+    }
+}
+
 void
 FNET_Transport::sync()
 {
@@ -208,6 +208,23 @@ public:
      **/
     void SetTCPNoDelay(bool noDelay);
 
+    /**
+     * Enable or disable edge triggered I/O events in all transport
+     * threads. Should be set before the transport is started.
+     *
+     * @param edgeTriggered true if edge triggered events should be used.
+     **/
+    void SetEdgeTriggered(bool edgeTriggered);
+
+    /**
+     * Set the amount of time transport threads should keep polling
+     * for I/O events without blocking after having handled
+     * events. 0 (the default) disables busy-polling.
+     *
+     * @param us busy-poll time in microseconds.
+     **/
+    void SetBusyPollTime(uint32_t us);
+
     /**
      * Synchronize with all transport threads. This method will block
      * until all events posted before this method was invoked has been
@@ -10,6 +10,8 @@
 #include <vespa/vespalib/util/sync.h>
 #include <vespa/vespalib/net/socket_spec.h>
 #include <vespa/vespalib/net/server_socket.h>
+#include <chrono>
+#include <thread>
 #include <csignal>
 
 #include <vespa/log/log.h>
@@ -109,20 +111,32 @@ FNET_TransportThread::FlushDeleteList()
 }
 
 
+void
+FNET_TransportThread::PollEvents(int msTimeout)
+{
+    bool busyPoll = (_gotEvents && (_config._busyPollUs > 0));
+    if (busyPoll) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(_config._busyPollUs);
+        do {
+            _selector.poll(0);
+        } while (_selector.num_events() == 0 &&
+                 std::chrono::steady_clock::now() < deadline);
+    }
+    if (!busyPoll || (_selector.num_events() == 0)) {
+        _selector.poll(msTimeout);
+    }
+    _gotEvents = (_selector.num_events() > 0);
+}
+
+
 bool
 FNET_TransportThread::PostEvent(FNET_ControlPacket *cpacket,
                                 FNET_Context context)
 {
-    bool wasEmpty;
-    {
-        std::unique_lock<std::mutex> guard(_lock);
-        if (IsShutDown()) {
-            guard.unlock();
-            SafeDiscardEvent(cpacket, context);
-            return false;
-        }
-        wasEmpty = _queue.IsEmpty_NoLock();
-        _queue.QueuePacket_NoLock(cpacket, context);
+    bool wasEmpty = false;
+    if (!_queue.QueuePacket(cpacket, context, wasEmpty)) {
+        SafeDiscardEvent(cpacket, context);
+        return false;
     }
     if (wasEmpty) {
         _selector.wakeup();
@@ -228,7 +242,8 @@ FNET_TransportThread::FNET_TransportThread(FNET_Transport &owner_in)
       _shutdown(false),
       _finished(false),
       _waitFinished(false),
-      _deleted(false)
+      _deleted(false),
+      _gotEvents(false)
 {
     _now.SetNow();
     trapsigpipe();
@@ -392,8 +407,10 @@ FNET_TransportThread::ShutDown(bool waitFinished)
     {
         std::lock_guard<std::mutex> guard(_lock);
         if (!IsShutDown()) {
-            _shutdown.store(true, std::memory_order_relaxed);
-            wasEmpty  = _queue.IsEmpty_NoLock();
+            // close the event queue before the event loop may see the
+            // shutdown flag, so that its final flush sees all events
+            wasEmpty = _queue.Close();
+            _shutdown.store(true, std::memory_order_release);
         }
     }
     if (wasEmpty) {
@@ -448,9 +465,8 @@ FNET_TransportThread::InitEventLoop()
 void
 FNET_TransportThread::handle_wakeup()
 {
-    {
-        std::lock_guard<std::mutex> guard(_lock);
-        _queue.FlushPackets_NoLock(&_myQueue);
+    if (!_queue.FlushPackets(&_myQueue)) {
+        _selector.wakeup(); // some events are still being posted
     }
 
     FNET_Context context;
@@ -547,7 +563,7 @@ FNET_TransportThread::EventLoopIteration()
 #endif
 
         // obtain I/O events
-        _selector.poll(msTimeout);
+        PollEvents(msTimeout);
 
         // sample current time (performed once per event loop iteration)
         _now.SetNow();
@@ -592,9 +608,8 @@ FNET_TransportThread::EventLoopIteration()
         return false;
 
     // flush event queue
-    {
-        std::lock_guard<std::mutex> guard(_lock);
-        _queue.FlushPackets_NoLock(&_myQueue);
+    while (!_queue.FlushPackets(&_myQueue)) {
+        std::this_thread::yield();
     }
 
     // discard remaining events
@@ -622,7 +637,7 @@ FNET_TransportThread::EventLoopIteration()
            _componentsTail == nullptr &&
            _timeOutHead    == nullptr &&
            _componentCnt   == 0    &&
-           _queue.IsEmpty_NoLock() &&
+           _queue.IsClosed() &&
            _myQueue.IsEmpty_NoLock());
 
     {
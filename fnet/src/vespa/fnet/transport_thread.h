@@ -6,6 +6,7 @@
 #include "config.h"
 #include "task.h"
 #include "packetqueue.h"
+#include "mpscpacketqueue.h"
 #include <vespa/fastos/thread.h>
 #include <vespa/fastos/time.h>
 #include <vespa/vespalib/net/socket_handle.h>
@@ -43,7 +44,7 @@ private:
     uint32_t                 _componentCnt;   // # of components
     FNET_IOComponent        *_deleteList;     // IOC delete list
     Selector                 _selector;       // I/O event generator
-    FNET_PacketQueue_NoLock  _queue;          // outer event queue
+    FNET_MPSCPacketQueue     _queue;          // outer event queue (lock-free)
     FNET_PacketQueue_NoLock  _myQueue;        // inner event queue
     std::mutex               _lock;           // used for synchronization
     std::condition_variable  _cond;           // used for synchronization
@@ -53,6 +54,7 @@ private:
     bool                     _finished;       // event loop stopped ?
     bool                     _waitFinished;   // someone is waiting for _finished
     bool                     _deleted;        // destructor called ?
+    bool                     _gotEvents;      // last poll produced events ?
 
     FNET_TransportThread(const FNET_TransportThread &);
     FNET_TransportThread &operator=(const FNET_TransportThread &);
@@ -107,6 +109,17 @@ private:
     void FlushDeleteList();
 
 
+    /**
+     * Obtain I/O events from the selector. If busy-polling is
+     * enabled and the previous poll produced events, the selector is
+     * polled without blocking for up to the configured busy-poll time
+     * before falling back to a blocking poll.
+     *
+     * @param msTimeout max time to block, in milliseconds.
+     **/
+    void PollEvents(int msTimeout);
+
+
     /**
      * Post an event (ControlPacket) on the transport thread event
      * queue. This is done to tell the transport thread that it needs to
@@ -173,7 +186,7 @@ private:
     bool EventLoopIteration();
 
     bool IsShutDown() const noexcept {
-        return _shutdown.load(std::memory_order_relaxed);
+        return _shutdown.load(std::memory_order_acquire);
     }
 
 public:
@@ -323,6 +336,32 @@ public:
     void SetTCPNoDelay(bool noDelay) { _config._tcpNoDelay = noDelay; }
 
 
+    /**
+     * Enable or disable edge triggered I/O events. With edge
+     * triggered events, connections read until the socket would
+     * block (bounded by a larger batch limit) and only get a new
+     * event when more data arrives. This should be set before any
+     * I/O components are added.
+     *
+     * @param edgeTriggered true if edge triggered events should be used.
+     **/
+    void SetEdgeTriggered(bool edgeTriggered) {
+        _config._edgeTriggered = edgeTriggered;
+        _selector.set_edge_triggered(edgeTriggered);
+    }
+
+
+    /**
+     * Set the amount of time the event loop should keep polling for
+     * I/O events without blocking after having handled some
+     * events. This trades CPU for lower latency under load. 0 means
+     * never busy-poll.
+     *
+     * @param us busy-poll time in microseconds.
+     **/
+    void SetBusyPollTime(uint32_t us) { _config._busyPollUs = us; }
+
+
     /**
      * Add an I/O component to the working set of this transport
      * object. Note that the actual work is performed by the transport
@@ -0,0 +1,104 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/messagebus/network/adaptivecompression.h>
+#include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/testkit/testapp.h>
+#include <chrono>
+#include <random>
+
+using namespace mbus;
+using vespalib::compression::CompressionConfig;
+using vespalib::ConstBufferRef;
+using vespalib::DataBuffer;
+
+namespace {
+
+CompressionConfig base(CompressionConfig::LZ4, 6, 90, 0);
+
+void
+sendPayloads(AdaptiveCompression &adaptive, const std::vector<char> &payload, uint32_t cnt, double wireNanosPerByte)
+{
+    ConstBufferRef input(&payload[0], payload.size());
+    for (uint32_t i = 0; i < cnt; ++i) {
+        uint32_t candidate = adaptive.select(payload.size(), wireNanosPerByte);
+        DataBuffer output;
+        auto start = std::chrono::steady_clock::now();
+        vespalib::compression::compress(AdaptiveCompression::candidateConfig(candidate, base), input, output, false);
+        auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        adaptive.report(candidate, payload.size(), output.getDataLen(), nanos);
+    }
+}
+
+std::vector<char>
+makeRandom(size_t size)
+{
+    std::mt19937 rng(1234);
+    std::vector<char> data(size);
+    for (char &c : data) {
+        c = rng();
+    }
+    return data;
+}
+
+std::vector<char>
+makeRepetitive(size_t size)
+{
+    std::vector<char> data(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = "abcdefgh"[i % 8];
+    }
+    return data;
+}
+
+}
+
+TEST("require that all candidates are sampled before any is trusted") {
+    AdaptiveCompression adaptive;
+    std::vector<uint32_t> selected;
+    for (uint32_t i = 0; i < (AdaptiveCompression::NUM_CANDIDATES - 1) * AdaptiveCompression::MIN_SAMPLES; ++i) {
+        uint32_t candidate = adaptive.select(10000, 1.0);
+        EXPECT_NOT_EQUAL(0u, candidate);
+        adaptive.report(candidate, 10000, 5000, 1000);
+        selected.push_back(candidate);
+    }
+    auto stats = adaptive.getStats();
+    for (uint32_t i = 1; i < AdaptiveCompression::NUM_CANDIDATES; ++i) {
+        EXPECT_EQUAL(AdaptiveCompression::MIN_SAMPLES, stats.selected[i]);
+    }
+}
+
+TEST("require that incompressible payloads are sent uncompressed") {
+    AdaptiveCompression adaptive;
+    sendPayloads(adaptive, makeRandom(32768), 256, 1.0);
+    auto stats = adaptive.getStats();
+    uint32_t sampled = (AdaptiveCompression::NUM_CANDIDATES - 1) * AdaptiveCompression::MIN_SAMPLES;
+    EXPECT_GREATER(stats.selected[0], 256u - sampled - 256u / AdaptiveCompression::EXPLORE_INTERVAL - 1);
+    EXPECT_EQUAL(256u, stats.payloads);
+    EXPECT_EQUAL(256u * 32768, stats.inputBytes);
+}
+
+TEST("require that compressible payloads are compressed when bandwidth is expensive") {
+    AdaptiveCompression adaptive;
+    sendPayloads(adaptive, makeRepetitive(32768), 256, 100.0);
+    auto stats = adaptive.getStats();
+    EXPECT_EQUAL(0u, stats.selected[0]);
+    EXPECT_GREATER(stats.bytesSaved(), 200u * 32000);
+    EXPECT_GREATER(stats.compressNanos, 0u);
+}
+
+TEST("require that size classes are tracked separately") {
+    AdaptiveCompression adaptive;
+    sendPayloads(adaptive, makeRepetitive(32768), 64, 100.0);
+    // small payloads have their own estimates and are sampled again
+    uint32_t candidate = adaptive.select(100, 100.0);
+    EXPECT_EQUAL(1u, candidate);
+}
+
+TEST("require that only compression types understood by all peers are candidates") {
+    for (uint32_t i = 0; i < AdaptiveCompression::NUM_CANDIDATES; ++i) {
+        CompressionConfig::Type type = AdaptiveCompression::candidateConfig(i, base).type;
+        EXPECT_TRUE((type == CompressionConfig::NONE) || (type == CompressionConfig::LZ4));
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
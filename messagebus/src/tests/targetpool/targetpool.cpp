@@ -92,6 +92,58 @@ Test::Main()
     pool.flushTargets(false);
     EXPECT_EQUAL(0u, pool.size());
 
+    // Assert that round robin selection spreads over all connections.
+    {
+        RPCTargetPool rrPool(std::make_unique<PoolTimer>(), 0.666, 3, RPCTargetPool::Selection::ROUND_ROBIN);
+        RPCTarget::SP t1 = rrPool.getTarget(orb, adr1);
+        RPCTarget::SP t2 = rrPool.getTarget(orb, adr1);
+        RPCTarget::SP t3 = rrPool.getTarget(orb, adr1);
+        EXPECT_TRUE(t1.get() != t2.get());
+        EXPECT_TRUE(t1.get() != t3.get());
+        EXPECT_TRUE(t2.get() != t3.get());
+        EXPECT_EQUAL(t1.get(), rrPool.getTarget(orb, adr1).get());
+        EXPECT_EQUAL(t2.get(), rrPool.getTarget(orb, adr1).get());
+        EXPECT_EQUAL(1u, rrPool.size());
+        EXPECT_EQUAL(3u, rrPool.getStats().size());
+    }
+
+    // Assert that least loaded selection picks the connection with fewest pending requests.
+    {
+        RPCTargetPool llPool(std::make_unique<PoolTimer>(), 0.666, 2, RPCTargetPool::Selection::LEAST_LOADED);
+        RPCTarget::SP t1 = llPool.getTarget(orb, adr1);
+        RPCTarget::SP t2 = llPool.getTarget(orb, adr1);
+        EXPECT_TRUE(t1.get() != t2.get());
+        t1->requestSent();
+        t1->requestSent();
+        t2->requestSent();
+        EXPECT_EQUAL(t2.get(), llPool.getTarget(orb, adr1).get());
+        EXPECT_EQUAL(t2.get(), llPool.getTarget(orb, adr1).get());
+        t2->requestSent();
+        t2->requestSent();
+        EXPECT_EQUAL(t1.get(), llPool.getTarget(orb, adr1).get());
+        t1->requestCompleted(2000);
+        t1->requestCompleted(4000);
+        RPCTarget::Stats stats = t1->getStats();
+        EXPECT_EQUAL(0u, stats.pending);
+        EXPECT_EQUAL(2u, stats.completed);
+        EXPECT_APPROX(3.0, stats.avgLatencyMs, 0.0001);
+        auto poolStats = llPool.getStats();
+        ASSERT_EQUAL(2u, poolStats.size());
+        EXPECT_EQUAL(adr1.getConnectionSpec(), poolStats[0].spec);
+        EXPECT_EQUAL(3u, poolStats[1].stats.pending);
+        t1->requestCompleted(0);
+        t2->requestCompleted(0);
+        t2->requestCompleted(0);
+        t2->requestCompleted(0);
+        // expire only when no connection is in use
+        t1.reset();
+        llPool.flushTargets(true);
+        EXPECT_EQUAL(1u, llPool.size());
+        t2.reset();
+        llPool.flushTargets(true);
+        EXPECT_EQUAL(0u, llPool.size());
+    }
+
     orb.ShutDown(true);
 
     TEST_DONE();
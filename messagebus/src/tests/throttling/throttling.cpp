@@ -3,6 +3,7 @@
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/messagebus/destinationsession.h>
 #include <vespa/messagebus/dynamicthrottlepolicy.h>
+#include <vespa/messagebus/latencythrottlepolicy.h>
 #include <vespa/messagebus/messagebus.h>
 #include <vespa/messagebus/routablequeue.h>
 #include <vespa/messagebus/routing/retrytransienterrorspolicy.h>
@@ -15,6 +16,7 @@
 #include <vespa/messagebus/testlib/simpleprotocol.h>
 #include <vespa/messagebus/testlib/simplereply.h>
 #include <vespa/messagebus/testlib/testserver.h>
+#include <limits>
 
 using namespace mbus;
 
@@ -76,6 +78,7 @@ bool waitPending(SourceSession& session, uint32_t size)
 class Test : public vespalib::TestApp {
 private:
     uint32_t getWindowSize(DynamicThrottlePolicy &policy, DynamicTimer &timer, uint32_t maxPending);
+    uint32_t getLatencyWindowSize(LatencyThrottlePolicy &policy, DynamicTimer &timer, uint32_t maxPending);
 
 protected:
     void testMaxPendingCount();
@@ -85,6 +88,10 @@ protected:
     void testIdleTimePeriod();
     void testMinWindowSize();
     void testMaxWindowSize();
+    void testLatencyWindowSize();
+    void testLatencyEstimates();
+    void testLatencyIdleTimePeriod();
+    void testLatencyProbeRtt();
 
 public:
     int Main() override;
@@ -102,6 +109,10 @@ Test::Main()
     testIdleTimePeriod();    TEST_FLUSH();
     testMinWindowSize();     TEST_FLUSH();
     testMaxWindowSize();     TEST_FLUSH();
+    testLatencyWindowSize(); TEST_FLUSH();
+    testLatencyEstimates();  TEST_FLUSH();
+    testLatencyIdleTimePeriod(); TEST_FLUSH();
+    testLatencyProbeRtt();   TEST_FLUSH();
 
     TEST_DONE();
 }
@@ -334,6 +345,126 @@ Test::testMaxWindowSize()
 
 }
 
+void
+Test::testLatencyWindowSize()
+{
+    std::unique_ptr<DynamicTimer> ptr(new DynamicTimer());
+    DynamicTimer *timer = ptr.get();
+    LatencyThrottlePolicy policy(std::move(ptr));
+
+    // every round trip is a sample period here, so neither idle retraction nor rtt probing applies
+    policy.setMinWindowSize(5);
+    policy.setQueueDelayBudget(50);
+    policy.setIdleTimePeriod(std::numeric_limits<uint64_t>::max());
+    policy.setMinRttWindow(std::numeric_limits<uint64_t>::max());
+
+    // target is 1.05 times the capacity; bandwidth probing moves it up or down by 25% at times
+    double windowSize = getLatencyWindowSize(policy, *timer, 100);
+    ASSERT_TRUE(windowSize >= 80 && windowSize <= 135);
+
+    windowSize = getLatencyWindowSize(policy, *timer, 200);
+    ASSERT_TRUE(windowSize >= 160 && windowSize <= 265);
+
+    windowSize = getLatencyWindowSize(policy, *timer, 50);
+    ASSERT_TRUE(windowSize >= 40 && windowSize <= 67);
+
+    windowSize = getLatencyWindowSize(policy, *timer, 500);
+    ASSERT_TRUE(windowSize >= 400 && windowSize <= 660);
+
+    windowSize = getLatencyWindowSize(policy, *timer, 100);
+    ASSERT_TRUE(windowSize >= 80 && windowSize <= 135);
+}
+
+void
+Test::testLatencyEstimates()
+{
+    std::unique_ptr<DynamicTimer> ptr(new DynamicTimer());
+    DynamicTimer *timer = ptr.get();
+    LatencyThrottlePolicy policy(std::move(ptr));
+
+    policy.setMinWindowSize(5);
+    policy.setQueueDelayBudget(50);
+    policy.setIdleTimePeriod(std::numeric_limits<uint64_t>::max());
+    policy.setMinRttWindow(std::numeric_limits<uint64_t>::max());
+
+    getLatencyWindowSize(policy, *timer, 100);
+    EXPECT_APPROX(1000.0, policy.getMinRtt(), 1.0);
+    EXPECT_APPROX(0.1, policy.getMaxDeliveryRate(), 0.01);
+}
+
+void
+Test::testLatencyIdleTimePeriod()
+{
+    ITimer::UP ptr(new DynamicTimer());
+    DynamicTimer *timer = static_cast<DynamicTimer*>(ptr.get());
+    LatencyThrottlePolicy policy(std::move(ptr));
+
+    policy.setMinWindowSize(5);
+    policy.setQueueDelayBudget(50);
+    policy.setMinRttWindow(std::numeric_limits<uint64_t>::max());
+
+    double windowSize = getLatencyWindowSize(policy, *timer, 20);
+    ASSERT_TRUE(windowSize >= 18 && windowSize <= 22);
+
+    SimpleMessage msg("foo");
+    timer->_millis += 30001;
+    ASSERT_TRUE(policy.canSend(msg, 0));
+    EXPECT_EQUAL((uint32_t)windowSize, policy.getMaxPendingCount());
+
+    timer->_millis += 60001;
+    ASSERT_TRUE(policy.canSend(msg, 10));
+    EXPECT_EQUAL(15u, policy.getMaxPendingCount());
+
+    timer->_millis += 60001;
+    ASSERT_TRUE(policy.canSend(msg, 0));
+    EXPECT_EQUAL(5u, policy.getMaxPendingCount());
+}
+
+void
+Test::testLatencyProbeRtt()
+{
+    std::unique_ptr<DynamicTimer> ptr(new DynamicTimer());
+    DynamicTimer *timer = ptr.get();
+    LatencyThrottlePolicy policy(std::move(ptr));
+
+    policy.setMinWindowSize(5);
+    policy.setQueueDelayBudget(5);
+    policy.setIdleTimePeriod(std::numeric_limits<uint64_t>::max());
+    policy.setMinRttWindow(10000);
+
+    // 10 ms base round trip, with the receiver delivering 10 messages per ms
+    SimpleMessage msg("foo");
+    SimpleReply reply("bar");
+    uint32_t numProbes = 0;
+    uint32_t numRestored = 0;
+    uint32_t prevWindow = policy.getMaxPendingCount();
+    bool probing = false;
+    for (uint32_t i = 0; i < 10000; ++i) {
+        uint32_t numPending = 0;
+        while (policy.canSend(msg, numPending)) {
+            policy.processMessage(msg);
+            ++numPending;
+        }
+        timer->_millis += std::max(10u, numPending / 10);
+        for( ; numPending > 0 ; --numPending) {
+            policy.processReply(reply);
+        }
+        uint32_t window = policy.getMaxPendingCount();
+        if (window * 2 <= prevWindow + 1) {
+            ++numProbes;
+            probing = true;
+        } else if (probing) {
+            numRestored += (window >= prevWindow * 2 && window <= prevWindow * 2 + 1) ? 1 : 0;
+            probing = false;
+        }
+        prevWindow = window;
+    }
+    EXPECT_TRUE(numProbes > 0);
+    EXPECT_EQUAL(numProbes, numRestored);
+    EXPECT_APPROX(10.0, policy.getMinRtt(), 1.0);
+    EXPECT_TRUE(policy.getMaxPendingCount() >= 115 && policy.getMaxPendingCount() <= 190);
+}
+
 uint32_t
 Test::getWindowSize(DynamicThrottlePolicy &policy, DynamicTimer &timer, uint32_t maxPending)
 {
@@ -358,3 +489,29 @@ Test::getWindowSize(DynamicThrottlePolicy &policy, DynamicTimer &timer, uint32_t
     printf("getWindowSize() = %d\n", ret);
     return ret;
 }
+
+uint32_t
+Test::getLatencyWindowSize(LatencyThrottlePolicy &policy, DynamicTimer &timer, uint32_t maxPending)
+{
+    SimpleMessage msg("foo");
+    SimpleReply reply("bar");
+
+    // the receiver delivers maxPending messages per second, with a base round trip time of one second
+    for (uint32_t i = 0; i < 999; ++i) {
+        uint32_t numPending = 0;
+        while (policy.canSend(msg, numPending)) {
+            policy.processMessage(msg);
+            ++numPending;
+        }
+
+        uint64_t tripTime = (numPending < maxPending) ? 1000 : (numPending * 1000) / maxPending;
+        timer._millis += tripTime;
+
+        for( ; numPending > 0 ; --numPending) {
+            policy.processReply(reply);
+        }
+    }
+    uint32_t ret = policy.getMaxPendingCount();
+    printf("getLatencyWindowSize() = %d\n", ret);
+    return ret;
+}
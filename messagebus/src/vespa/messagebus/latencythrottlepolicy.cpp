@@ -0,0 +1,204 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include "latencythrottlepolicy.h"
+#include "systemtimer.h"
+#include <algorithm>
+#include <climits>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".latencythrottlepolicy");
+
+namespace mbus {
+
+LatencyThrottlePolicy::LatencyThrottlePolicy() :
+    LatencyThrottlePolicy(ITimer::UP(new SystemTimer()))
+{ }
+
+LatencyThrottlePolicy::LatencyThrottlePolicy(ITimer::UP timer) :
+    _timer(std::move(timer)),
+    _numPending(0),
+    _maxPendingInSample(0),
+    _numReplies(0),
+    _numOk(0),
+    _sampleStart(_timer->getMilliTime()),
+    _lastEvent(_sampleStart),
+    _timeOfLastMessage(_sampleStart),
+    _idleTimePeriod(60000),
+    _pendingTime(0),
+    _queueDelayBudget(10),
+    _probeGain(1.25),
+    _windowSize(20),
+    _maxWindowSize(INT_MAX),
+    _minWindowSize(20),
+    _minRtt(0),
+    _minRttStamp(_sampleStart),
+    _minRttWindow(10000),
+    _probingRtt(false),
+    _windowBeforeProbe(0),
+    _inStartup(true),
+    _cycleIdx(0),
+    _rates(),
+    _rateIdx(0)
+{
+    _rates.fill(0.0);
+}
+
+LatencyThrottlePolicy::~LatencyThrottlePolicy() = default;
+
+LatencyThrottlePolicy &
+LatencyThrottlePolicy::setQueueDelayBudget(double budget)
+{
+    _queueDelayBudget = budget;
+    return *this;
+}
+
+LatencyThrottlePolicy &
+LatencyThrottlePolicy::setProbeGain(double gain)
+{
+    _probeGain = gain;
+    return *this;
+}
+
+LatencyThrottlePolicy &
+LatencyThrottlePolicy::setMinRttWindow(uint64_t window)
+{
+    _minRttWindow = window;
+    return *this;
+}
+
+LatencyThrottlePolicy &
+LatencyThrottlePolicy::setIdleTimePeriod(uint64_t period)
+{
+    _idleTimePeriod = period;
+    return *this;
+}
+
+LatencyThrottlePolicy &
+LatencyThrottlePolicy::setMaxWindowSize(double max)
+{
+    _maxWindowSize = max;
+    return *this;
+}
+
+LatencyThrottlePolicy &
+LatencyThrottlePolicy::setMinWindowSize(double min)
+{
+    _minWindowSize = min;
+    _windowSize = std::max(_minWindowSize, _windowSize);
+    return *this;
+}
+
+LatencyThrottlePolicy &
+LatencyThrottlePolicy::setMaxPendingCount(uint32_t maxCount)
+{
+    StaticThrottlePolicy::setMaxPendingCount(maxCount);
+    _maxWindowSize = maxCount;
+    return *this;
+}
+
+double
+LatencyThrottlePolicy::getMaxDeliveryRate() const
+{
+    return *std::max_element(_rates.begin(), _rates.end());
+}
+
+void
+LatencyThrottlePolicy::advance(uint64_t time)
+{
+    if (time > _lastEvent) {
+        _pendingTime += (double)_numPending * (time - _lastEvent);
+        _lastEvent = time;
+    }
+}
+
+void
+LatencyThrottlePolicy::endSample(uint64_t time)
+{
+    double elapsed = time - _sampleStart;
+    double rtt = _pendingTime / _numReplies; // Little's law
+    _rates[_rateIdx] = _numOk / elapsed;
+    _rateIdx = (_rateIdx + 1) % _rates.size();
+    bool wasProbing = _probingRtt;
+
+    if (_minRtt == 0 || rtt <= _minRtt || wasProbing) {
+        _minRtt = rtt;
+        _minRttStamp = time;
+    }
+    double maxRate = getMaxDeliveryRate();
+    double target = maxRate * (_minRtt + _queueDelayBudget);
+    double queueDelay = rtt - _minRtt;
+    LOG(debug, "WindowSize = %.2f, Rtt = %.2f, MinRtt = %.2f, MaxRate = %f, Target = %.2f",
+        _windowSize, rtt, _minRtt, maxRate, target);
+
+    _probingRtt = false;
+    if (wasProbing) {
+        _windowSize = _windowBeforeProbe;
+    } else if (time - _minRttStamp > _minRttWindow) {
+        // drain the queues for one sample period to see the base rtt again
+        _probingRtt = true;
+        _windowBeforeProbe = _windowSize;
+        _windowSize *= 0.5;
+    } else if (_inStartup) {
+        if (queueDelay > _queueDelayBudget) {
+            _inStartup = false;
+            _windowSize = target;
+        } else if (_maxPendingInSample + 1 >= _windowSize) {
+            _windowSize *= _probeGain;
+        }
+    } else {
+        // probe for more bandwidth in one sample period, then drain what it queued
+        _cycleIdx = (_cycleIdx + 1) % PROBE_CYCLE;
+        double gain = (_cycleIdx == 0) ? _probeGain : (_cycleIdx == 1) ? (1.0 / _probeGain) : 1.0;
+        _windowSize = target * gain;
+    }
+    _windowSize = std::max(_minWindowSize, _windowSize);
+    _windowSize = std::min(_maxWindowSize, _windowSize);
+
+    _sampleStart = time;
+    _pendingTime = 0;
+    _numReplies = 0;
+    _numOk = 0;
+    _maxPendingInSample = _numPending;
+}
+
+bool
+LatencyThrottlePolicy::canSend(const Message &msg, uint32_t pendingCount)
+{
+    if (!StaticThrottlePolicy::canSend(msg, pendingCount)) {
+        return false;
+    }
+    uint64_t time = _timer->getMilliTime();
+    if (time - _timeOfLastMessage > _idleTimePeriod) {
+        _windowSize = std::max(_minWindowSize, std::min(_windowSize, (double) pendingCount + _minWindowSize));
+    }
+    _timeOfLastMessage = time;
+    return pendingCount < _windowSize;
+}
+
+void
+LatencyThrottlePolicy::processMessage(Message &msg)
+{
+    StaticThrottlePolicy::processMessage(msg);
+    advance(_timer->getMilliTime());
+    ++_numPending;
+    _maxPendingInSample = std::max(_maxPendingInSample, _numPending);
+}
+
+void
+LatencyThrottlePolicy::processReply(Reply &reply)
+{
+    StaticThrottlePolicy::processReply(reply);
+    uint64_t time = _timer->getMilliTime();
+    advance(time);
+    if (_numPending > 0) {
+        --_numPending;
+    }
+    ++_numReplies;
+    if (!reply.hasErrors()) {
+        ++_numOk;
+    }
+    if (_numReplies >= _windowSize && time > _sampleStart) {
+        endSample(time);
+    }
+}
+
+} // namespace mbus
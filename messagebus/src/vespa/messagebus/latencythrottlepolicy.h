@@ -0,0 +1,179 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "itimer.h"
+#include "staticthrottlepolicy.h"
+#include <array>
+
+namespace mbus {
+
+/**
+ * This is an implementation of the {@link ThrottlePolicy} that sizes the window of pending messages from
+ * measured latency and delivery rate, in the spirit of BBR congestion control. Instead of searching for the
+ * window size that maximizes throughput, it estimates the bottleneck delivery rate (the max rate seen over
+ * the last few sample periods) and the base round trip time (the min round trip time seen over a longer
+ * period), and keeps the window at the size that delivers at the bottleneck rate while adding at most the
+ * configured queueing delay budget on top of the base round trip time.
+ *
+ * Round trip times are estimated per sample period, which is roughly one round trip, using Little's law as
+ * the time averaged number of pending messages divided by the reply rate, so no per message state is needed.
+ * On startup the window grows by a constant gain each sample period until the queueing delay exceeds the
+ * budget. After that the window follows the target, except that one sample period out of every eight uses a
+ * window scaled up by the gain, to discover more bandwidth, followed by one scaled down by it, to drain what
+ * the probe queued. When the base round trip time has not been observed for a while, the window is halved
+ * for one sample period to drain the queues and measure it again, and then restored.
+ *
+ * Since the window of each client is its own delivery rate times the base round trip time plus the budget,
+ * many feeding clients together add about one budget of queueing delay on the receiving nodes, instead of
+ * each growing its window until throughput stops increasing.
+ *
+ * <b>NOTE:</b> By context, "pending" is refering to the number of sent messages that have not been replied to
+ * yet.
+ */
+class LatencyThrottlePolicy : public StaticThrottlePolicy {
+private:
+    static constexpr size_t RATE_SAMPLES = 10;
+    static constexpr uint32_t PROBE_CYCLE = 8;
+
+    ITimer::UP  _timer;
+    uint32_t    _numPending;
+    uint32_t    _maxPendingInSample;
+    uint32_t    _numReplies;
+    uint32_t    _numOk;
+    uint64_t    _sampleStart;
+    uint64_t    _lastEvent;
+    uint64_t    _timeOfLastMessage;
+    uint64_t    _idleTimePeriod;
+    double      _pendingTime;
+    double      _queueDelayBudget;
+    double      _probeGain;
+    double      _windowSize;
+    double      _maxWindowSize;
+    double      _minWindowSize;
+    double      _minRtt;
+    uint64_t    _minRttStamp;
+    uint64_t    _minRttWindow;
+    bool        _probingRtt;
+    double      _windowBeforeProbe;
+    bool        _inStartup;
+    uint32_t    _cycleIdx;
+    std::array<double, RATE_SAMPLES> _rates;
+    size_t      _rateIdx;
+
+    void advance(uint64_t time);
+    void endSample(uint64_t time);
+
+public:
+    /**
+     * Convenience typedefs.
+     */
+    typedef std::unique_ptr<LatencyThrottlePolicy> UP;
+    typedef std::shared_ptr<LatencyThrottlePolicy> SP;
+
+    /**
+     * Constructs a new instance of this policy and sets the appropriate default values of member data.
+     */
+    LatencyThrottlePolicy();
+
+    /**
+     * Constructs a new instance of this class using the given clock to measure latency.
+     *
+     * @param timer The timer to use.
+     */
+    LatencyThrottlePolicy(ITimer::UP timer);
+
+    ~LatencyThrottlePolicy();
+
+    /**
+     * Sets the amount of queueing delay, in milliseconds, this client accepts on top of the base round trip
+     * time. A larger budget gives more headroom for bursts at the cost of higher latency.
+     *
+     * @param budget The budget to set.
+     * @return This, to allow chaining.
+     */
+    LatencyThrottlePolicy &setQueueDelayBudget(double budget);
+
+    /**
+     * Sets the factor the window size is scaled by when probing for more bandwidth. This is also the growth
+     * per sample period on startup.
+     *
+     * @param gain The gain to set, must be larger than 1.
+     * @return This, to allow chaining.
+     */
+    LatencyThrottlePolicy &setProbeGain(double gain);
+
+    /**
+     * Sets for how long, in milliseconds, a measured minimum round trip time is trusted before the window
+     * is reduced to measure it again.
+     *
+     * @param window The time period to set.
+     * @return This, to allow chaining.
+     */
+    LatencyThrottlePolicy &setMinRttWindow(uint64_t window);
+
+    /**
+     * Sets the idle time period for this client. If nothing is sent throughout
+     * this time period, the window will retract.
+     *
+     * @param period The time period to set.
+     * @return This, to allow chaining.
+     */
+    LatencyThrottlePolicy &setIdleTimePeriod(uint64_t period);
+
+    /**
+     * Sets the maximium number of pending operations allowed at any time, in
+     * order to avoid using too much resources.
+     *
+     * @param max The max to set.
+     * @return This, to allow chaining.
+     */
+    LatencyThrottlePolicy &setMaxWindowSize(double max);
+
+    /**
+     * Sets the minimium number of pending operations allowed at any time, in
+     * order to keep a level of performance.
+     *
+     * @param min The min to set.
+     * @return This, to allow chaining.
+     */
+    LatencyThrottlePolicy &setMinWindowSize(double min);
+
+    /**
+     * Sets the maximum number of pending messages allowed.
+     *
+     * @param maxCount The max count.
+     * @return This, to allow chaining.
+     */
+    LatencyThrottlePolicy &setMaxPendingCount(uint32_t maxCount);
+
+    double getMaxWindowSize() const { return _maxWindowSize; }
+    double getMinWindowSize() const { return _minWindowSize; }
+
+    /**
+     * Returns the smallest round trip time, in milliseconds, measured within the min rtt window, or 0 if
+     * nothing has been measured yet.
+     *
+     * @return The base round trip time.
+     */
+    double getMinRtt() const { return _minRtt; }
+
+    /**
+     * Returns the estimated bottleneck delivery rate, in successful replies per millisecond.
+     *
+     * @return The delivery rate.
+     */
+    double getMaxDeliveryRate() const;
+
+    /**
+     * Returns the maximum number of pending messages allowed.
+     *
+     * @return The max limit.
+     */
+    uint32_t getMaxPendingCount() const { return (uint32_t)_windowSize; }
+
+    bool canSend(const Message &msg, uint32_t pendingCount) override;
+    void processMessage(Message &msg) override;
+    void processReply(Reply &reply) override;
+};
+
+} // namespace mbus
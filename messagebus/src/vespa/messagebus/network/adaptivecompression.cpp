@@ -0,0 +1,114 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include "adaptivecompression.h"
+
+namespace mbus {
+
+namespace {
+
+constexpr double ESTIMATE_WEIGHT = 0.25; // weight of a new sample in the moving averages
+
+} // namespace <unnamed>
+
+AdaptiveCompression::Stats::Stats() :
+    payloads(0),
+    inputBytes(0),
+    outputBytes(0),
+    compressNanos(0),
+    selected()
+{
+    selected.fill(0);
+}
+
+AdaptiveCompression::AdaptiveCompression() :
+    _lock(),
+    _classes(),
+    _stats()
+{
+    for (SizeClass &sc : _classes) {
+        sc.estimates[0].samples = MIN_SAMPLES; // not compressing is fully known
+    }
+}
+
+AdaptiveCompression::~AdaptiveCompression() = default;
+
+uint32_t
+AdaptiveCompression::sizeClass(size_t size)
+{
+    // < 1k, < 4k, < 16k, < 64k, < 256k, larger
+    uint32_t sc = 0;
+    for (size_t limit = 1024; (size >= limit) && (sc + 1 < NUM_SIZE_CLASSES); limit *= 4) {
+        ++sc;
+    }
+    return sc;
+}
+
+AdaptiveCompression::CompressionConfig
+AdaptiveCompression::candidateConfig(uint32_t candidate, const CompressionConfig &base)
+{
+    switch (candidate) {
+    case 1:  return CompressionConfig(CompressionConfig::LZ4, 1, base.threshold, base.minSize);
+    case 2:  return CompressionConfig(CompressionConfig::LZ4, 9, base.threshold, base.minSize); // high compression
+    default: return CompressionConfig(CompressionConfig::NONE, 0, base.threshold, base.minSize);
+    }
+}
+
+uint32_t
+AdaptiveCompression::select(size_t size, double wireNanosPerByte)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    SizeClass &sc = _classes[sizeClass(size)];
+    uint32_t count = sc.count++;
+    for (uint32_t i = 0; i < NUM_CANDIDATES; ++i) {
+        if (sc.estimates[i].samples < MIN_SAMPLES) {
+            return i;
+        }
+    }
+    if ((count % EXPLORE_INTERVAL) == 0) {
+        return 1 + (count / EXPLORE_INTERVAL) % (NUM_CANDIDATES - 1);
+    }
+    uint32_t best = 0;
+    double bestCost = 0.0;
+    for (uint32_t i = 0; i < NUM_CANDIDATES; ++i) {
+        const Estimate &e = sc.estimates[i];
+        double cost = e.nanosPerByte + e.ratio * wireNanosPerByte;
+        if ((i == 0) || (cost < bestCost)) {
+            best = i;
+            bestCost = cost;
+        }
+    }
+    return best;
+}
+
+void
+AdaptiveCompression::report(uint32_t candidate, size_t inputSize, size_t outputSize, uint64_t nanos)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _stats.payloads++;
+    _stats.inputBytes += inputSize;
+    _stats.outputBytes += outputSize;
+    _stats.compressNanos += nanos;
+    _stats.selected[candidate]++;
+    if ((candidate == 0) || (inputSize == 0)) {
+        return;
+    }
+    Estimate &e = _classes[sizeClass(inputSize)].estimates[candidate];
+    double ratio = double(outputSize) / inputSize;
+    double nanosPerByte = double(nanos) / inputSize;
+    if (e.samples == 0) {
+        e.ratio = ratio;
+        e.nanosPerByte = nanosPerByte;
+    } else {
+        e.ratio += (ratio - e.ratio) * ESTIMATE_WEIGHT;
+        e.nanosPerByte += (nanosPerByte - e.nanosPerByte) * ESTIMATE_WEIGHT;
+    }
+    e.samples++;
+}
+
+AdaptiveCompression::Stats
+AdaptiveCompression::getStats() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _stats;
+}
+
+} // namespace mbus
@@ -0,0 +1,109 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/vespalib/util/compressionconfig.h>
+#include <array>
+#include <mutex>
+
+namespace mbus {
+
+/**
+ * Chooses how to compress message payloads sent to a single target, based on
+ * what compression has achieved for earlier payloads of similar size.
+ *
+ * Payloads are grouped in size classes. For each class, the compression ratio
+ * and the compression time per input byte of each candidate (none, lz4 and
+ * lz4 high compression) are tracked as moving averages. The candidate with the
+ * lowest estimated cost is used, where cost is compression time plus the time
+ * to transfer the resulting bytes given a configured cost per wire byte. A
+ * small fraction of payloads are used to re-sample the other candidates so that
+ * the estimates follow changes in the data.
+ *
+ * Only compression types that all message bus implementations can decode are
+ * candidates; zstd is not understood by the Java implementation.
+ *
+ * This class is thread safe.
+ */
+class AdaptiveCompression {
+public:
+    using CompressionConfig = vespalib::compression::CompressionConfig;
+
+    static constexpr uint32_t NUM_CANDIDATES = 3;
+    static constexpr uint32_t NUM_SIZE_CLASSES = 6;
+    static constexpr uint32_t MIN_SAMPLES = 4;       // samples before a candidate is trusted
+    static constexpr uint32_t EXPLORE_INTERVAL = 64; // re-sample one candidate every N payloads
+
+    /**
+     * Aggregated result of all payloads compressed through this.
+     */
+    struct Stats {
+        uint64_t payloads;
+        uint64_t inputBytes;
+        uint64_t outputBytes;
+        uint64_t compressNanos;
+        std::array<uint64_t, NUM_CANDIDATES> selected;
+
+        Stats();
+        uint64_t bytesSaved() const { return (inputBytes > outputBytes) ? (inputBytes - outputBytes) : 0; }
+    };
+
+private:
+    struct Estimate {
+        double   ratio;       // output bytes per input byte
+        double   nanosPerByte;
+        uint32_t samples;
+        Estimate() : ratio(1.0), nanosPerByte(0.0), samples(0) {}
+    };
+    struct SizeClass {
+        std::array<Estimate, NUM_CANDIDATES> estimates;
+        uint32_t                             count;
+        SizeClass() : estimates(), count(0) {}
+    };
+
+    mutable std::mutex                        _lock;
+    std::array<SizeClass, NUM_SIZE_CLASSES>   _classes;
+    Stats                                     _stats;
+
+    static uint32_t sizeClass(size_t size);
+
+public:
+    AdaptiveCompression();
+    ~AdaptiveCompression();
+
+    /**
+     * Returns the compression config of the given candidate.
+     *
+     * @param candidate The candidate index.
+     * @param base      The configured compression, providing threshold and minimum size.
+     * @return The config to compress with.
+     */
+    static CompressionConfig candidateConfig(uint32_t candidate, const CompressionConfig &base);
+
+    /**
+     * Selects the candidate to use for a payload of the given size.
+     *
+     * @param size            The uncompressed payload size.
+     * @param wireNanosPerByte The estimated cost of sending one byte.
+     * @return The candidate index.
+     */
+    uint32_t select(size_t size, double wireNanosPerByte);
+
+    /**
+     * Reports the outcome of compressing a payload with the given candidate.
+     *
+     * @param candidate  The candidate index used.
+     * @param inputSize  The uncompressed payload size.
+     * @param outputSize The size of the data sent.
+     * @param nanos      The time spent compressing.
+     */
+    void report(uint32_t candidate, size_t inputSize, size_t outputSize, uint64_t nanos);
+
+    /**
+     * Returns the aggregated statistics.
+     *
+     * @return The statistics.
+     */
+    Stats getStats() const;
+};
+
+} // namespace mbus
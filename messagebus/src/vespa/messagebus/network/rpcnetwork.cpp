@@ -10,6 +10,8 @@
 #include <vespa/messagebus/tracelevel.h>
 #include <vespa/messagebus/emptyreply.h>
 #include <vespa/messagebus/routing/routingnode.h>
+#include <vespa/messagebus/systemtimer.h>
+#include <vespa/defaults.h>
 #include <vespa/slobrok/sbregister.h>
 #include <vespa/slobrok/sbmirror.h>
 #include <vespa/vespalib/component/vtag.h>
@@ -114,7 +116,8 @@ RPCNetwork::RPCNetwork(const RPCNetworkParams &params) :
     _transport(std::make_unique<FNET_Transport>()),
     _orb(std::make_unique<FRT_Supervisor>(_transport.get(), nullptr)),
     _scheduler(*_transport->GetScheduler()),
-    _targetPool(std::make_unique<RPCTargetPool>(params.getConnectionExpireSecs())),
+    _targetPool(std::make_unique<RPCTargetPool>(std::make_unique<SystemTimer>(), params.getConnectionExpireSecs(),
+                                                params.getNumTargetsPerSpec(), params.getTargetSelection())),
     _targetPoolTask(_scheduler, *_targetPool),
     _servicePool(std::make_unique<RPCServicePool>(*this, 4096)),
     _slobrokCfgFactory(std::make_unique<slobrok::ConfiguratorFactory>(params.getSlobrokConfig())),
@@ -127,10 +130,15 @@ RPCNetwork::RPCNetwork(const RPCNetworkParams &params) :
     _sendAdapters(),
     _compressionConfig(params.getCompressionConfig()),
     _allowDispatchForEncode(params.getDispatchOnEncode()),
-    _allowDispatchForDecode(params.getDispatchOnDecode())
+    _allowDispatchForDecode(params.getDispatchOnDecode()),
+    _adaptiveCompression(params.getAdaptiveCompression()),
+    _wireNanosPerByte(params.getWireNanosPerByte())
 {
     _transport->SetMaxInputBufferSize(params.getMaxInputBufferSize());
     _transport->SetMaxOutputBufferSize(params.getMaxOutputBufferSize());
+    if (params.getLocalTransport()) {
+        _orb->SetLocalTransport(vespa::Defaults::underVespaHome("var/run/mbus"));
+    }
 }
 
 RPCNetwork::~RPCNetwork()
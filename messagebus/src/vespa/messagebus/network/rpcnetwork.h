@@ -79,6 +79,8 @@ private:
     CompressionConfig                               _compressionConfig;
     bool                                            _allowDispatchForEncode;
     bool                                            _allowDispatchForDecode;
+    bool                                            _adaptiveCompression;
+    double                                          _wireNanosPerByte;
 
 
     /**
@@ -157,6 +159,14 @@ public:
      */
     const Identity &getIdentity() const { return _ident; }
 
+    /**
+     * Returns the pool of connections to other services, e.g. to sample
+     * per connection statistics.
+     *
+     * @return The target pool.
+     */
+    RPCTargetPool &getTargetPool() { return *_targetPool; }
+
     /**
      * Obtain the port number this network is listening to. This method will
      * return 0 until the start method has been invoked.
@@ -234,6 +244,8 @@ public:
     vespalib::Executor & getExecutor() const { return *_executor; }
     bool allowDispatchForEncode() const { return _allowDispatchForEncode; }
     bool allowDispatchForDecode() const { return _allowDispatchForDecode; }
+    bool useAdaptiveCompression() const { return _adaptiveCompression; }
+    double getWireNanosPerByte() const { return _wireNanosPerByte; }
 
 };
 
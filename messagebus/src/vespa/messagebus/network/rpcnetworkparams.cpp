@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "rpcnetworkparams.h"
+#include "rpctargetpool.h"
 
 namespace mbus {
 
@@ -18,6 +19,11 @@ RPCNetworkParams::RPCNetworkParams(config::ConfigUri configUri) :
     _dispatchOnEncode(true),
     _dispatchOnDecode(false),
     _connectionExpireSecs(600),
+    _numTargetsPerSpec(1),
+    _targetSelection(TargetSelection::ROUND_ROBIN),
+    _adaptiveCompression(false),
+    _wireNanosPerByte(1.0),
+    _localTransport(false),
     _compressionConfig(CompressionConfig::LZ4, 6, 90, 1024)
 { }
 
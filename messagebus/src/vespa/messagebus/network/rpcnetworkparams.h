@@ -7,6 +7,8 @@
 
 namespace mbus {
 
+enum class RPCTargetSelection : uint8_t; // defined in rpctargetpool.h
+
 /**
  * To facilitate several configuration parameters to the {@link RPCNetwork} constructor, all parameters are
  * held by this class. This class has reasonable default values for each parameter.
@@ -14,6 +16,7 @@ namespace mbus {
 class RPCNetworkParams {
 private:
     using CompressionConfig = vespalib::compression::CompressionConfig;
+    using TargetSelection = RPCTargetSelection;
     Identity          _identity;
     config::ConfigUri _slobrokConfig;
     int               _listenPort;
@@ -23,6 +26,11 @@ private:
     bool              _dispatchOnEncode;
     bool              _dispatchOnDecode;
     double            _connectionExpireSecs;
+    uint32_t          _numTargetsPerSpec;
+    TargetSelection   _targetSelection;
+    bool              _adaptiveCompression;
+    double            _wireNanosPerByte;
+    bool              _localTransport;
     CompressionConfig _compressionConfig;
 
 public:
@@ -126,6 +134,48 @@ public:
         return *this;
     }
 
+    /**
+     * Returns the number of connections used for each service address.
+     *
+     * @return The number of connections.
+     */
+    uint32_t getNumTargetsPerSpec() const {
+        return _numTargetsPerSpec;
+    }
+
+    /**
+     * Sets the number of connections used for each service address. Messages
+     * to a service are spread across its connections, allowing the traffic to
+     * use several transport threads.
+     *
+     * @param numTargetsPerSpec The number of connections.
+     * @return This, to allow chaining.
+     */
+    RPCNetworkParams &setNumTargetsPerSpec(uint32_t numTargetsPerSpec) {
+        _numTargetsPerSpec = numTargetsPerSpec;
+        return *this;
+    }
+
+    /**
+     * Returns how a connection is selected when several are used per service.
+     *
+     * @return The selection policy.
+     */
+    TargetSelection getTargetSelection() const {
+        return _targetSelection;
+    }
+
+    /**
+     * Sets how a connection is selected when several are used per service.
+     *
+     * @param targetSelection The selection policy.
+     * @return This, to allow chaining.
+     */
+    RPCNetworkParams &setTargetSelection(TargetSelection targetSelection) {
+        _targetSelection = targetSelection;
+        return *this;
+    }
+
     /**
      * Returns the maximum input buffer size allowed for the underlying FNET connection.
      *
@@ -176,6 +226,52 @@ public:
     }
     CompressionConfig getCompressionConfig() const { return _compressionConfig; }
 
+    /**
+     * Sets whether message payloads should be compressed adaptively, choosing
+     * between no compression and lz4 per target and payload size based on
+     * observed compression ratio and cost. The configured compression config
+     * still decides the minimum payload size and the required compression
+     * ratio, and is used for replies.
+     *
+     * @param adaptiveCompression True to enable adaptive compression.
+     * @return This, to allow chaining.
+     */
+    RPCNetworkParams &setAdaptiveCompression(bool adaptiveCompression) {
+        _adaptiveCompression = adaptiveCompression;
+        return *this;
+    }
+    bool getAdaptiveCompression() const { return _adaptiveCompression; }
+
+    /**
+     * Sets the estimated cost of sending a single byte, used by adaptive
+     * compression to weigh bandwidth against compression time. The default of
+     * 1ns corresponds to a link speed of about 8 Gbit/s.
+     *
+     * @param nanos The cost in nanoseconds per byte.
+     * @return This, to allow chaining.
+     */
+    RPCNetworkParams &setWireNanosPerByte(double nanos) {
+        _wireNanosPerByte = nanos;
+        return *this;
+    }
+    double getWireNanosPerByte() const { return _wireNanosPerByte; }
+
+    /**
+     * Sets whether to talk to services on the same host through unix domain
+     * sockets instead of tcp. This requires both sides to enable it and to
+     * run as the same user, as the sockets are kept in a private directory
+     * under $VESPA_HOME/var/run/mbus; a service that does not listen locally
+     * is still reached over tcp.
+     *
+     * @param localTransport True to enable the local transport.
+     * @return This, to allow chaining.
+     */
+    RPCNetworkParams &setLocalTransport(bool localTransport) {
+        _localTransport = localTransport;
+        return *this;
+    }
+    bool getLocalTransport() const { return _localTransport; }
+
 
     RPCNetworkParams &setDispatchOnDecode(bool dispatchOnDecode) {
         _dispatchOnDecode = dispatchOnDecode;
@@ -141,6 +141,7 @@ RPCSend::send(RoutingNode &recipient, const vespalib::Version &version,
     } else {
         SendContext *ptr = ctx.release();
         req->SetContext(FNET_Context(ptr));
+        address.getTarget().requestSent();
         address.getTarget().getFRTTarget().InvokeAsync(req, ptr->getTimeout(), this);
     }
 }
@@ -154,7 +155,9 @@ RPCSend::RequestDone(FRT_RPCRequest *req)
 void
 RPCSend::doRequestDone(FRT_RPCRequest *req) {
     SendContext::UP ctx(static_cast<SendContext*>(req->GetContext()._value.VOIDP));
-    const string &serviceName = static_cast<RPCServiceAddress&>(ctx->getRecipient().getServiceAddress()).getServiceName();
+    RPCServiceAddress &address = static_cast<RPCServiceAddress&>(ctx->getRecipient().getServiceAddress());
+    address.getTarget().requestCompleted(ctx->getElapsedMicros());
+    const string &serviceName = address.getServiceName();
     Reply::UP reply;
     Error error;
     Trace & trace = ctx->getTrace();
@@ -3,6 +3,7 @@
 
 #include <vespa/messagebus/trace.h>
 #include <vespa/messagebus/routing/routingnode.h>
+#include <chrono>
 
 namespace mbus::network::internal {
 /**
@@ -14,6 +15,7 @@ private:
     mbus::RoutingNode &_recipient;
     mbus::Trace        _trace;
     double             _timeout;
+    std::chrono::steady_clock::time_point _sendTime;
 
 public:
     typedef std::unique_ptr<SendContext> UP;
@@ -22,10 +24,14 @@ public:
     SendContext(mbus::RoutingNode &recipient, uint64_t timeRemaining)
             : _recipient(recipient),
               _trace(recipient.getTrace().getLevel()),
-              _timeout(timeRemaining * 0.001) { }
+              _timeout(timeRemaining * 0.001),
+              _sendTime(std::chrono::steady_clock::now()) { }
     mbus::RoutingNode &getRecipient() { return _recipient; }
     mbus::Trace &getTrace() { return _trace; }
     double getTimeout() { return _timeout; }
+    uint64_t getElapsedMicros() const {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _sendTime).count();
+    }
 };
 
 /**
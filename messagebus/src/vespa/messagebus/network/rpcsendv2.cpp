@@ -10,6 +10,7 @@
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/compressor.h>
 #include <vespa/fnet/frt/reflection.h>
+#include <chrono>
 
 using vespalib::make_string;
 using vespalib::compression::CompressionConfig;
@@ -61,16 +62,16 @@ RPCSendV2::build(FRT_ReflectionBuilder & builder)
 {
     builder.DefineMethod(METHOD_NAME, METHOD_PARAMS, METHOD_RETURN, FRT_METHOD(RPCSendV2::invoke), this);
     builder.MethodDesc("Send a message bus slime request and get a reply back.");
-    builder.ParamDesc("header_encoding", "0=raw, 6=lz4");
+    builder.ParamDesc("header_encoding", "0=raw, 6=lz4, 7=zstd");
     builder.ParamDesc("header_decoded_size", "Uncompressed header blob size");
     builder.ParamDesc("header_payload", "The message header blob in slime");
-    builder.ParamDesc("body_encoding", "0=raw, 6=lz4");
+    builder.ParamDesc("body_encoding", "0=raw, 6=lz4, 7=zstd");
     builder.ParamDesc("body_decoded_size", "Uncompressed body blob size");
     builder.ParamDesc("body_payload", "The message body blob in slime");
-    builder.ReturnDesc("header_encoding",  "0=raw, 6=lz4");
+    builder.ReturnDesc("header_encoding",  "0=raw, 6=lz4, 7=zstd");
     builder.ReturnDesc("header_decoded_size", "Uncompressed header blob size");
     builder.ReturnDesc("header_payload", "The reply header blob in slime.");
-    builder.ReturnDesc("body_encoding",  "0=raw, 6=lz4");
+    builder.ReturnDesc("body_encoding",  "0=raw, 6=lz4, 7=zstd");
     builder.ReturnDesc("body_decoded_size", "Uncompressed body blob size");
     builder.ReturnDesc("body_payload", "The reply body blob in slime.");
 }
@@ -127,7 +128,18 @@ RPCSendV2::encodeRequest(FRT_RPCRequest &req, const Version &version, const Rout
     BinaryFormat::encode(slime, rBuf);
     ConstBufferRef toCompress(rBuf.getBuf().getData(), rBuf.getBuf().getDataLen());
     DataBuffer buf(vespalib::roundUp2inN(rBuf.getBuf().getDataLen()));
-    CompressionConfig::Type type = compress(_net->getCompressionConfig(), toCompress, buf, false);
+    CompressionConfig config = _net->getCompressionConfig();
+    CompressionConfig::Type type;
+    if (_net->useAdaptiveCompression() && (toCompress.size() >= config.minSize)) {
+        AdaptiveCompression &adaptive = address.getTarget().getCompression();
+        uint32_t candidate = adaptive.select(toCompress.size(), _net->getWireNanosPerByte());
+        auto start = std::chrono::steady_clock::now();
+        type = compress(AdaptiveCompression::candidateConfig(candidate, config), toCompress, buf, false);
+        auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        adaptive.report(candidate, toCompress.size(), buf.getDataLen(), nanos);
+    } else {
+        type = compress(config, toCompress, buf, false);
+    }
 
     args.AddInt8(type);
     args.AddInt32(toCompress.size());
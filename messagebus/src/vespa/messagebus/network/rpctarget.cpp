@@ -12,7 +12,11 @@ RPCTarget::RPCTarget(const string &spec, FRT_Supervisor &orb) :
     _target(*_orb.GetTarget(spec.c_str())),
     _state(VERSION_NOT_RESOLVED),
     _version(),
-    _versionHandlers()
+    _versionHandlers(),
+    _pending(0),
+    _completed(0),
+    _totalLatencyUs(0),
+    _compression()
 {
     // empty
 }
@@ -64,6 +68,27 @@ RPCTarget::isValid() const
     return false;
 }
 
+void
+RPCTarget::requestCompleted(uint64_t latencyUs)
+{
+    _totalLatencyUs.fetch_add(latencyUs, std::memory_order_relaxed);
+    _completed.fetch_add(1, std::memory_order_relaxed);
+    _pending.fetch_sub(1, std::memory_order_relaxed);
+}
+
+RPCTarget::Stats
+RPCTarget::getStats() const
+{
+    Stats stats;
+    stats.pending = _pending.load(std::memory_order_relaxed);
+    stats.completed = _completed.load(std::memory_order_relaxed);
+    if (stats.completed > 0) {
+        stats.avgLatencyMs = _totalLatencyUs.load(std::memory_order_relaxed) / (1000.0 * stats.completed);
+    }
+    stats.compression = _compression.getStats();
+    return stats;
+}
+
 void
 RPCTarget::RequestDone(FRT_RPCRequest *req)
 {
@@ -1,11 +1,13 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include "adaptivecompression.h"
 #include <vespa/messagebus/common.h>
 #include <vespa/fnet/frt/invoker.h>
 #include <vespa/fnet/frt/target.h>
 #include <vespa/vespalib/component/version.h>
 #include <vespa/vespalib/util/sync.h>
+#include <atomic>
 
 namespace mbus {
 
@@ -50,13 +52,19 @@ private:
     };
     typedef std::unique_ptr<vespalib::Version> Version_UP;
 
-    vespalib::Monitor _lock;
-    FRT_Supervisor   &_orb;
-    string            _name;
-    FRT_Target       &_target;
-    ResolveState      _state;
-    Version_UP        _version;
-    HandlerList       _versionHandlers;
+    vespalib::Monitor     _lock;
+    FRT_Supervisor       &_orb;
+    string                _name;
+    FRT_Target           &_target;
+    ResolveState          _state;
+    Version_UP            _version;
+    HandlerList           _versionHandlers;
+    std::atomic<uint32_t> _pending;
+    std::atomic<uint64_t> _completed;
+    std::atomic<uint64_t> _totalLatencyUs;
+    // Updated when encoding requests, which only have const access to the
+    // target. AdaptiveCompression does its own locking.
+    mutable AdaptiveCompression _compression;
 
 public:
     /**
@@ -64,6 +72,17 @@ public:
      */
     typedef std::shared_ptr<RPCTarget> SP;
 
+    /**
+     * Snapshot of the requests sent through this target.
+     */
+    struct Stats {
+        uint32_t pending;   // requests sent but not yet completed
+        uint64_t completed; // requests completed (ok or failed)
+        double   avgLatencyMs;
+        AdaptiveCompression::Stats compression;
+        Stats() : pending(0), completed(0), avgLatencyMs(0.0), compression() {}
+    };
+
     /**
      * Constructs a new instance of this class. This object creates and
      * takes ownership of a corresponding FRT target, and will deref it
@@ -112,6 +131,40 @@ public:
      */
     const vespalib::Version &getVersion() const { return *_version; }
 
+    /**
+     * Registers that a request has been sent through this target.
+     */
+    void requestSent() { _pending.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * Registers that a request sent through this target has completed.
+     *
+     * @param latencyUs The time from send to completion in microseconds.
+     */
+    void requestCompleted(uint64_t latencyUs);
+
+    /**
+     * Returns the number of requests sent through this target that have not
+     * yet completed. Used to pick the least loaded connection to a service.
+     *
+     * @return The number of pending requests.
+     */
+    uint32_t getPendingCount() const { return _pending.load(std::memory_order_relaxed); }
+
+    /**
+     * Returns the adaptive compression state for payloads sent to this target.
+     *
+     * @return The compression selector.
+     */
+    AdaptiveCompression &getCompression() const { return _compression; }
+
+    /**
+     * Returns a snapshot of the request statistics of this target.
+     *
+     * @return The statistics.
+     */
+    Stats getStats() const;
+
     // Implements FRT_IRequestWait.
     void RequestDone(FRT_RPCRequest *req) override;
 };
@@ -1,26 +1,44 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include "rpctargetpool.h"
 #include <vespa/messagebus/systemtimer.h>
+#include <algorithm>
 
 namespace mbus {
 
-RPCTargetPool::Entry::Entry(RPCTarget::SP target, uint64_t lastUse) :
-    _target(target),
+RPCTargetPool::Entry::Entry(uint64_t lastUse) :
+    _targets(),
+    _next(0),
     _lastUse(lastUse)
 { }
 
+RPCTargetPool::Entry::~Entry() = default;
+
+bool
+RPCTargetPool::Entry::inUse() const
+{
+    for (const RPCTarget::SP &target : _targets) {
+        if (target.use_count() > 1) {
+            return true;
+        }
+    }
+    return false;
+}
+
 RPCTargetPool::RPCTargetPool(double expireSecs) :
-    _lock(),
-    _targets(),
-    _timer(new SystemTimer()),
-    _expireMillis(static_cast<uint64_t>(expireSecs * 1000))
+    RPCTargetPool(std::make_unique<SystemTimer>(), expireSecs)
 { }
 
 RPCTargetPool::RPCTargetPool(ITimer::UP timer, double expireSecs) :
+    RPCTargetPool(std::move(timer), expireSecs, 1, Selection::ROUND_ROBIN)
+{ }
+
+RPCTargetPool::RPCTargetPool(ITimer::UP timer, double expireSecs, uint32_t numTargetsPerSpec, Selection selection) :
     _lock(),
     _targets(),
     _timer(std::move(timer)),
-    _expireMillis(static_cast<uint64_t>(expireSecs * 1000))
+    _expireMillis(static_cast<uint64_t>(expireSecs * 1000)),
+    _numTargetsPerSpec(std::max(numTargetsPerSpec, 1u)),
+    _selection(selection)
 { }
 
 RPCTargetPool::~RPCTargetPool()
@@ -36,8 +54,8 @@ RPCTargetPool::flushTargets(bool force)
     TargetMap::iterator it = _targets.begin();
     while (it != _targets.end()) {
         Entry &entry = it->second;
-        if (entry._target.get() != nullptr) {
-            if (entry._target.use_count() > 1) {
+        if (!entry._targets.empty()) {
+            if (entry.inUse()) {
                 entry._lastUse = currentTime;
                 ++it;
                 continue; // someone is using this
@@ -60,23 +78,56 @@ RPCTargetPool::size()
     return _targets.size();
 }
 
+std::vector<RPCTargetPool::TargetStats>
+RPCTargetPool::getStats()
+{
+    std::vector<TargetStats> result;
+    vespalib::LockGuard guard(_lock);
+    for (const auto &entry : _targets) {
+        for (uint32_t i = 0; i < entry.second._targets.size(); ++i) {
+            result.emplace_back(entry.first, i, entry.second._targets[i]->getStats());
+        }
+    }
+    return result;
+}
+
+uint32_t
+RPCTargetPool::selectSlot(Entry &entry) const
+{
+    uint32_t numTargets = entry._targets.size();
+    if (numTargets < _numTargetsPerSpec) {
+        return numTargets; // open another connection
+    }
+    if (_selection == Selection::LEAST_LOADED) {
+        uint32_t best = entry._next++ % numTargets; // rotate ties
+        for (uint32_t i = 0; i < numTargets; ++i) {
+            if (entry._targets[i]->getPendingCount() < entry._targets[best]->getPendingCount()) {
+                best = i;
+            }
+        }
+        return best;
+    }
+    return entry._next++ % numTargets;
+}
+
 RPCTarget::SP
 RPCTargetPool::getTarget(FRT_Supervisor &orb, const RPCServiceAddress &address)
 {
     vespalib::LockGuard guard(_lock);
     string spec = address.getConnectionSpec();
     TargetMap::iterator it = _targets.find(spec);
-    if (it != _targets.end()) {
-        Entry &entry = it->second;
-        if (entry._target->isValid()) {
-            entry._lastUse = _timer->getMilliTime();
-            return entry._target;
-        }
-        _targets.erase(it);
+    if (it == _targets.end()) {
+        it = _targets.insert(TargetMap::value_type(spec, Entry(_timer->getMilliTime()))).first;
+    }
+    Entry &entry = it->second;
+    entry._lastUse = _timer->getMilliTime();
+    uint32_t slot = selectSlot(entry);
+    if (slot == entry._targets.size()) {
+        entry._targets.push_back(std::make_shared<RPCTarget>(spec, orb));
+    } else if (!entry._targets[slot]->isValid()) {
+        entry._targets[slot] = std::make_shared<RPCTarget>(spec, orb);
     }
-    RPCTarget::SP ret(new RPCTarget(spec, orb));
-    _targets.insert(TargetMap::value_type(spec, Entry(ret, _timer->getMilliTime())));
-    return ret;
+    return entry._targets[slot];
 }
 
 } // namespace mbus
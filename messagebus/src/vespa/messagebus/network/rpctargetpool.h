@@ -6,16 +6,41 @@
 #include <vespa/messagebus/itimer.h>
 #include <vespa/vespalib/util/sync.h>
 #include <map>
+#include <vector>
 
 class FRT_Supervisor;
 
 namespace mbus {
 
+/**
+ * How to pick among the connections to the same address.
+ */
+enum class RPCTargetSelection : uint8_t {
+    ROUND_ROBIN,
+    LEAST_LOADED  // fewest pending requests
+};
+
 /**
  * Class used to reuse targets for the same address when sending messages over
- * the rpc network.
+ * the rpc network. Each address may be served by several targets (connections),
+ * in which case requests are spread across them to avoid serializing all traffic
+ * to a service over a single connection and transport thread.
  */
 class RPCTargetPool {
+public:
+    using Selection = RPCTargetSelection;
+
+    /**
+     * Statistics for a single target held by this pool.
+     */
+    struct TargetStats {
+        string            spec;
+        uint32_t          connection;
+        RPCTarget::Stats  stats;
+        TargetStats(const string &spec_in, uint32_t connection_in, const RPCTarget::Stats &stats_in)
+            : spec(spec_in), connection(connection_in), stats(stats_in) {}
+    };
+
 private:
     /**
      * Implements a helper class holds the necessary reference and token counter
@@ -23,10 +48,13 @@ private:
      * time to time.
      */
     struct Entry {
-        RPCTarget::SP _target;
-        uint64_t      _lastUse;
+        std::vector<RPCTarget::SP> _targets;
+        uint32_t                   _next;
+        uint64_t                   _lastUse;
 
-        Entry(RPCTarget::SP target, uint64_t lastUse);
+        Entry(uint64_t lastUse);
+        ~Entry();
+        bool inUse() const;
     };
     typedef std::map<string, Entry> TargetMap;
 
@@ -34,6 +62,10 @@ private:
     TargetMap      _targets;
     ITimer::UP     _timer;
     uint64_t       _expireMillis;
+    uint32_t       _numTargetsPerSpec;
+    Selection      _selection;
+
+    uint32_t selectSlot(Entry &entry) const;
 
 public:
     RPCTargetPool(const RPCTargetPool &) = delete;
@@ -59,6 +91,18 @@ public:
      */
     RPCTargetPool(ITimer::UP timer, double expireSecs);
 
+    /**
+     * Constructs a new instance of this class that keeps up to the given number
+     * of connections to each address.
+     *
+     * @param timer             The timer to use for connection expiration.
+     * @param expireSecs        The number of seconds until an idle connection is
+     *                          closed.
+     * @param numTargetsPerSpec The number of connections to use per address.
+     * @param selection         How to select among the connections.
+     */
+    RPCTargetPool(ITimer::UP timer, double expireSecs, uint32_t numTargetsPerSpec, Selection selection);
+
     /**
      * Destructor. Frees any allocated resources.
      */
@@ -68,7 +112,9 @@ public:
      * This method will return a target for the given address. If a target does
      * not currently exist for the given address, it will be created and added
      * to the internal map. Each target is also reference counted so that the
-     * tokens of targets that are currently active is never decremented.
+     * tokens of targets that are currently active is never decremented. When
+     * several connections are used per address, connections are created on
+     * demand until the configured number is reached.
      *
      * @param orb     The supervisor to use to connect to the target.
      * @param address The address to resolve to a target.
@@ -92,6 +138,21 @@ public:
      * @return The size of the internal map.
      */
     size_t size();
+
+    /**
+     * Returns the number of connections used per address.
+     *
+     * @return The number of connections.
+     */
+    uint32_t getNumTargetsPerSpec() const { return _numTargetsPerSpec; }
+
+    /**
+     * Returns pending request and latency statistics for all targets currently
+     * contained in this.
+     *
+     * @return The statistics, ordered by spec and connection.
+     */
+    std::vector<TargetStats> getStats();
 };
 
 } // namespace mbus
@@ -888,5 +888,41 @@ TEST("require that attributes are used")
     TEST_DO(checkEntry(res3, 1, expected6, Timestamp(12)));
 } 
 
+TEST("require that docid only iteration with attribute selection returns document ids")
+{
+    UnitDR::reset();
+    DocumentIterator itr(bucket(5), document::DocIdOnly(), selectDocs("foo.aa == 45"), docV(), -1, false);
+    itr.add(doc_with_attr_fields("doc:foo:xx1", Timestamp(1), bucket(5),
+                                 45, 46, 27, 4.5, 2.7, "x45", "x27"));
+    itr.add(doc_with_attr_fields("doc:foo:xx2", Timestamp(2), bucket(5),
+                                 27, 28, 45, 2.7, 4.5, "x27", "x45"));
+
+    IterateResult res = itr.iterate(largeNum);
+    EXPECT_TRUE(res.isCompleted());
+    ASSERT_EQUAL(1u, res.getEntries().size());
+    DocEntry expect(Timestamp(2), storage::spi::NONE, DocumentId("doc:foo:xx2"));
+    EXPECT_EQUAL(expect, *res.getEntries()[0]);
+    EXPECT_TRUE(res.getEntries()[0]->getDocument() == nullptr);
+}
+
+TEST("require that docid only iteration with non-attribute field in selection retrieves full documents")
+{
+    UnitDR::reset();
+    DocumentIterator itr(bucket(5), document::DocIdOnly(), selectDocs("foo.aa == 45 and foo.ab == 46"), docV(), -1, false);
+    itr.add(doc_with_attr_fields("doc:foo:xx1", Timestamp(1), bucket(5),
+                                 45, 46, 27, 4.5, 2.7, "x45", "x27"));
+    itr.add(doc_with_attr_fields("doc:foo:xx2", Timestamp(2), bucket(5),
+                                 27, 28, 45, 2.7, 4.5, "x27", "x45"));
+    itr.add(doc_with_attr_fields("doc:foo:xx3", Timestamp(3), bucket(5),
+                                 27, 46, 45, 2.7, 4.5, "x27", "x45"));
+
+    IterateResult res = itr.iterate(largeNum);
+    EXPECT_TRUE(res.isCompleted());
+    ASSERT_EQUAL(1u, res.getEntries().size());
+    ASSERT_TRUE(res.getEntries()[0]->getDocumentId() != nullptr);
+    EXPECT_EQUAL(DocumentId("doc:foo:xx3"), *res.getEntries()[0]->getDocumentId());
+    EXPECT_EQUAL(Timestamp(3), res.getEntries()[0]->getTimestamp());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
 
@@ -234,6 +234,22 @@ TEST_F("require that session manager can be explored", Fixture)
     EXPECT_TRUE(DocumentDBExplorer(f._db).get_child("session"));
 }
 
+TEST_F("require that threading service can be explored", Fixture)
+{
+    auto explorer = DocumentDBExplorer(f._db).get_child("threadingservice");
+    ASSERT_TRUE(explorer);
+    Slime slime;
+    SlimeInserter inserter(slime);
+    explorer->get_state(inserter, true);
+    for (const char *name : {"indexFieldInverter", "indexFieldWriter", "attributeFieldWriter"}) {
+        const auto &executor = slime.get()[name];
+        EXPECT_EQUAL(0, executor["rebalances"].asLong());
+        EXPECT_TRUE(executor["executedTasks"].valid());
+        EXPECT_TRUE(executor["busyTime"].valid());
+        EXPECT_TRUE(executor["executors"].valid());
+    }
+}
+
 TEST_F("require that document db registers reference", Fixture)
 {
     auto &registry = f._myDBOwner._registry;
@@ -0,0 +1,178 @@
+// Copyright 2019 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcore/proton/common/feedtoken.h>
+#include <vespa/searchcore/proton/feedoperation/putoperation.h>
+#include <vespa/searchcore/proton/persistenceengine/i_resource_write_filter.h>
+#include <vespa/searchcore/proton/persistenceengine/transport_latch.h>
+#include <vespa/searchcore/proton/server/ddbstate.h>
+#include <vespa/searchcore/proton/server/executorthreadingservice.h>
+#include <vespa/searchcore/proton/server/feedhandler.h>
+#include <vespa/searchcore/proton/server/i_feed_handler_owner.h>
+#include <vespa/searchcore/proton/server/ireplayconfig.h>
+#include <vespa/searchcore/proton/server/tlcproxy.h>
+#include <vespa/searchcore/proton/test/bucketfactory.h>
+#include <vespa/searchcore/proton/test/dummy_feed_view.h>
+#include <vespa/searchlib/index/docbuilder.h>
+#include <vespa/searchlib/index/dummyfileheadercontext.h>
+#include <vespa/searchlib/transactionlog/translogserver.h>
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <chrono>
+#include <thread>
+
+using document::Document;
+using search::SerialNum;
+using search::index::DocBuilder;
+using search::index::DummyFileHeaderContext;
+using search::index::Schema;
+using search::index::schema::CollectionType;
+using search::index::schema::DataType;
+using search::transactionlog::TransLogServer;
+using storage::spi::Timestamp;
+using vespalib::make_string;
+
+using namespace proton;
+
+//-----------------------------------------------------------------------------
+
+// Measures how many puts per second the feed handler hands through the
+// master write thread when the client threads feeding it do or do not
+// serialize the operations ahead of time, as the persistence threads do
+// via PersistenceHandlerProxy. The feed view does no work, so the master
+// write thread is busy with what the feed handler does itself, mainly
+// writing each operation to the transaction log.
+
+constexpr uint32_t num_fields = 10;
+constexpr uint32_t num_words = 100;
+constexpr uint32_t num_docs = 20000;
+
+struct MyOwner : IFeedHandlerOwner {
+    void onTransactionLogReplayDone() override {}
+    void enterRedoReprocessState() override {}
+    void onPerformPrune(SerialNum) override {}
+    bool getAllowPrune() const override { return false; }
+};
+
+struct MyResourceWriteFilter : IResourceWriteFilter {
+    bool acceptWriteOperation() const override { return true; }
+    State getAcceptState() const override { return State(); }
+};
+
+struct MyReplayConfig : IReplayConfig {
+    void replayConfig(SerialNum) override {}
+};
+
+// Serializes operations the same way as the transaction log writer, but drops the packets.
+struct MyWriter : search::transactionlog::Writer {
+    void commit(const vespalib::string &, const search::transactionlog::Packet &, DoneCallback) override {}
+};
+
+struct MyTlsWriter : TlsWriter {
+    MyWriter writer;
+    TlcProxy proxy;
+    MyTlsWriter() : writer(), proxy("bench", writer) {}
+    void storeOperation(const FeedOperation &op, DoneCallback onDone) override {
+        proxy.storeOperation(op, std::move(onDone));
+    }
+    bool erase(SerialNum) override { return true; }
+    SerialNum sync(SerialNum syncTo) override { return syncTo; }
+};
+
+struct Documents {
+    Schema schema;
+    std::unique_ptr<DocBuilder> builder;
+    std::vector<Document::SP> docs;
+    Documents() : schema(), builder(), docs() {
+        for (uint32_t i = 0; i < num_fields; ++i) {
+            schema.addIndexField(Schema::IndexField(make_string("f%u", i), DataType::STRING, CollectionType::SINGLE));
+        }
+        builder = std::make_unique<DocBuilder>(schema);
+        for (uint32_t i = 0; i < num_docs; ++i) {
+            builder->startDocument(make_string("id:test:searchdocument::%u", i));
+            for (uint32_t field = 0; field < num_fields; ++field) {
+                builder->startIndexField(make_string("f%u", field));
+                for (uint32_t word = 0; word < num_words; ++word) {
+                    builder->addStr(make_string("word%u", (i + field * word) % 1000));
+                }
+                builder->endField();
+            }
+            docs.emplace_back(builder->endDocument().release());
+        }
+    }
+};
+
+struct Fixture {
+    DummyFileHeaderContext fileHeaderContext;
+    TransLogServer tls;
+    ExecutorThreadingService writeService;
+    MyOwner owner;
+    MyResourceWriteFilter writeFilter;
+    DDBState state;
+    MyReplayConfig replayConfig;
+    test::DummyFeedView feedView;
+    MyTlsWriter tlsWriter;
+    FeedHandler handler;
+    Fixture(const Documents &documents)
+        : fileHeaderContext(),
+          tls("benchtls", 9018, "benchtlsdir", fileHeaderContext, 0x10000),
+          writeService(),
+          owner(),
+          writeFilter(),
+          state(),
+          replayConfig(),
+          feedView(documents.builder->getDocumentTypeRepo()),
+          tlsWriter(),
+          handler(writeService, "tcp/localhost:9018", DocTypeName("searchdocument"), state, owner,
+                  writeFilter, replayConfig, tls, &tlsWriter)
+    {
+        state.enterLoadState();
+        state.enterReplayTransactionLogState();
+        handler.setActiveFeedView(&feedView);
+        handler.init(1);
+        handler.changeToNormalFeedState();
+    }
+    ~Fixture() {
+        writeService.sync();
+    }
+};
+
+double feed_docs_per_second(const Documents &documents, uint32_t clientThreads, bool preSerialize) {
+    Fixture f(documents);
+    TransportLatch latch(documents.docs.size());
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> clients;
+    for (uint32_t client = 0; client < clientThreads; ++client) {
+        clients.emplace_back([&f, &documents, &latch, client, clientThreads, preSerialize]() {
+            for (uint32_t i = client; i < documents.docs.size(); i += clientThreads) {
+                const auto &doc = documents.docs[i];
+                auto op = std::make_unique<PutOperation>(BucketFactory::getBucketId(doc->getId()), Timestamp(i + 1), doc);
+                if (preSerialize) {
+                    op->preSerialize();
+                }
+                f.handler.handleOperation(feedtoken::make(latch), std::move(op));
+            }
+        });
+    }
+    for (auto &client : clients) {
+        client.join();
+    }
+    latch.await();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return documents.docs.size() / elapsed.count();
+}
+
+TEST("measure put throughput with and without serializing in the client threads") {
+    Documents documents;
+    for (uint32_t clientThreads : {1, 2, 4, 8}) {
+        double best[2] = {0.0, 0.0};
+        for (bool preSerialize : {false, true}) {
+            for (uint32_t run = 0; run < 3; ++run) {
+                best[preSerialize] = std::max(best[preSerialize], feed_docs_per_second(documents, clientThreads, preSerialize));
+            }
+        }
+        fprintf(stderr, "client threads %u: %.0f puts/s, pre-serialized %.0f puts/s (%.2fx)\n",
+                clientThreads, best[0], best[1], best[1] / best[0]);
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -816,6 +816,19 @@ TEST_F("require that put with different document type repo is ok", FeedHandlerFi
     EXPECT_EQUAL(1, f.tls_writer.store_count);
 }
 
+TEST_F("require that pre-serialized put with different document type repo is ok", FeedHandlerFixture)
+{
+    TwoFieldsSchemaContext schema;
+    DocumentContext doc_context("doc:test:foo", *schema.builder);
+    auto op = std::make_unique<PutOperation>(doc_context.bucketId,
+                                             Timestamp(10), doc_context.doc);
+    op->preSerialize();
+    FeedTokenContext token_context;
+    f.handler.performOperation(std::move(token_context.token), std::move(op));
+    EXPECT_EQUAL(1, f.feedView.put_count);
+    EXPECT_EQUAL(1, f.tls_writer.store_count);
+}
+
 }  // namespace
 
 TEST_MAIN()
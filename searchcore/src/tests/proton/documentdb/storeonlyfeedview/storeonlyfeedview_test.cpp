@@ -11,6 +11,7 @@
 #include <vespa/searchcore/proton/server/storeonlyfeedview.h>
 #include <vespa/searchcore/proton/feedoperation/moveoperation.h>
 #include <vespa/searchcore/proton/feedoperation/pruneremoveddocumentsoperation.h>
+#include <vespa/searchcore/proton/feedoperation/putoperation.h>
 #include <vespa/searchcore/proton/reference/dummy_gid_to_lid_change_handler.h>
 #include <vespa/searchcore/proton/test/mock_summary_adapter.h>
 #include <vespa/searchcore/proton/test/thread_utils.h>
@@ -42,16 +43,18 @@ class MySummaryAdapter : public test::MockSummaryAdapter {
 private:
     int &_rmCount;
     int &_putCount;
+    int &_putStreamCount;
     int &_heartbeatCount;
 
 public:
-    MySummaryAdapter(int &removeCount, int &putCount, int &heartbeatCount)
+    MySummaryAdapter(int &removeCount, int &putCount, int &putStreamCount, int &heartbeatCount)
         : _rmCount(removeCount),
           _putCount(putCount),
+          _putStreamCount(putStreamCount),
           _heartbeatCount(heartbeatCount) {
     }
     void put(SerialNum, DocumentIdT, const Document &) override { ++ _putCount; }
-    void put(SerialNum, DocumentIdT, const vespalib::nbostream &) override { ++ _putCount; }
+    void put(SerialNum, DocumentIdT, const vespalib::nbostream &) override { ++ _putCount; ++_putStreamCount; }
 
     void remove(SerialNum, DocumentIdT) override { ++_rmCount; }
     void heartBeat(SerialNum) override { ++_heartbeatCount; }
@@ -198,6 +201,7 @@ template <typename FeedViewType>
 struct FixtureBase {
     int removeCount;
     int putCount;
+    int putStreamCount;
     int heartbeatCount;
     int outstandingMoveOps;
     DocumentMetaStore::SP metaStore;
@@ -209,6 +213,7 @@ struct FixtureBase {
     FixtureBase(SubDbType subDbType = SubDbType::READY)
         : removeCount(0),
           putCount(0),
+          putStreamCount(0),
           heartbeatCount(0),
           outstandingMoveOps(0),
           metaStore(new DocumentMetaStore(std::make_shared<BucketDBOwner>(),
@@ -224,7 +229,7 @@ struct FixtureBase {
     {
         StoreOnlyFeedView::PersistentParams params(0, 0, DocTypeName("foo"), subdb_id, subDbType);
         metaStore->constructFreeList();
-        ISummaryAdapter::SP adapter = std::make_unique<MySummaryAdapter>(removeCount, putCount, heartbeatCount);
+        ISummaryAdapter::SP adapter = std::make_unique<MySummaryAdapter>(removeCount, putCount, putStreamCount, heartbeatCount);
         feedview = std::make_unique<FeedViewType>(adapter, metaStore, writeService, lidReuseDelayer,
                                                   commitTimeTracker, params, outstandingMoveOps);
     }
@@ -363,6 +368,41 @@ TEST_F("require that handleMove() handles move within same subdb and propagates
     EXPECT_TRUE(f.metaStore->validLid(lid));
 }
 
+PutOperation::UP
+makePutOp(const vespalib::string &docId, bool preSerialize)
+{
+    Schema schema;
+    DocBuilder builder(schema);
+    Document::SP doc(builder.startDocument(docId).endDocument().release());
+    auto result = std::make_unique<PutOperation>(doc->getId().getGlobalId().convertToBucketId(), Timestamp(10), doc);
+    if (preSerialize) {
+        result->preSerialize();
+    }
+    result->setSerialNum(1);
+    return result;
+}
+
+TEST_F("require that put stores a pre-serialized document without serializing it again", Fixture)
+{
+    PutOperation::UP op = makePutOp("id:test:searchdocument::1", true);
+    f.runInMaster([&] () { f.feedview->preparePut(*op); });
+    f.runInMaster([&] () { f.feedview->handlePut(FeedToken(), *op); });
+    f.writeService.sync();
+    EXPECT_EQUAL(1, f.putCount);
+    EXPECT_EQUAL(1, f.putStreamCount);
+    EXPECT_TRUE(f.metaStore->validLid(op->getLid()));
+}
+
+TEST_F("require that put serializes the document when it was not pre-serialized", Fixture)
+{
+    PutOperation::UP op = makePutOp("id:test:searchdocument::1", false);
+    f.runInMaster([&] () { f.feedview->preparePut(*op); });
+    f.runInMaster([&] () { f.feedview->handlePut(FeedToken(), *op); });
+    f.writeService.sync();
+    EXPECT_EQUAL(1, f.putCount);
+    EXPECT_EQUAL(0, f.putStreamCount);
+}
+
 TEST_F("require that prune removed documents removes documents",
        Fixture(SubDbType::REMOVED))
 {
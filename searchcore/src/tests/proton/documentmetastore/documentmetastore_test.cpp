@@ -17,6 +17,8 @@
 #include <vespa/searchcore/proton/server/itlssyncer.h>
 #include <vespa/searchcore/proton/common/hw_info.h>
 #include <vespa/searchlib/query/queryterm.h>
+#include <atomic>
+#include <thread>
 #include <vespa/log/log.h>
 LOG_SETUP("documentmetastore_test");
 
@@ -654,6 +656,124 @@ TEST("requireThatGidsCanBeSavedAndLoaded")
     }
 }
 
+TEST("requireThatGidToLidHashGivesSameLookupsAsTree")
+{
+    DocumentMetaStore dms(createBucketDB());
+    dms.enableGidToLidHash();
+    EXPECT_TRUE(dms.hasGidToLidHash());
+    uint32_t numLids = 1000;
+    dms.constructFreeList();
+    for (uint32_t lid = 1; lid <= numLids; ++lid) {
+        GlobalId gid = createGid(lid);
+        BucketId bucketId(gid.convertToBucketId());
+        bucketId.setUsedBits(numBucketBits);
+        uint32_t addLid = addGid(dms, gid, bucketId, Timestamp(lid + timestampBias));
+        EXPECT_EQUAL(lid, addLid);
+    }
+    for (uint32_t lid = 1; lid <= numLids; lid += 2) {
+        EXPECT_TRUE(dms.remove(lid));
+        dms.removeComplete(lid);
+    }
+    for (uint32_t lid = 1; lid <= numLids; ++lid) {
+        GlobalId gid = createGid(lid);
+        uint32_t myLid = 0;
+        if ((lid % 2) == 0) {
+            EXPECT_TRUE(assertLid(lid, gid, dms));
+            EXPECT_TRUE(dms.inspectExisting(gid).ok());
+        } else {
+            EXPECT_FALSE(dms.getLid(gid, myLid));
+            EXPECT_FALSE(dms.inspectExisting(gid).ok());
+        }
+    }
+    // re-use of removed lids
+    uint32_t addLid = addGid(dms, createGid(numLids + 1), Timestamp(numLids + 1 + timestampBias));
+    EXPECT_EQUAL(1u, addLid);
+    EXPECT_TRUE(assertLid(1, createGid(numLids + 1), dms));
+    // gid already present
+    EXPECT_EQUAL(2u, dms.inspect(createGid(2)).getLid());
+}
+
+TEST("requireThatGidToLidHashFollowsMovedLids")
+{
+    DocumentMetaStore dms(createBucketDB());
+    dms.enableGidToLidHash();
+    dms.constructFreeList();
+    EXPECT_TRUE(assertPut(bucketId1, time1, 1u, gid1, dms));
+    EXPECT_TRUE(assertPut(bucketId2, time2, 2u, gid2, dms));
+    EXPECT_TRUE(dms.remove(1));
+    dms.removeComplete(1u);
+    dms.move(2u, 1u);
+    dms.removeComplete(2u);
+    EXPECT_TRUE(assertLid(1u, gid2, dms));
+    uint32_t lid = 0;
+    EXPECT_FALSE(dms.getLid(gid1, lid));
+    EXPECT_TRUE(assertPut(bucketId1, time1, 2u, gid1, dms));
+    EXPECT_TRUE(assertLid(2u, gid1, dms));
+}
+
+TEST("requireThatReadersDoNotSeeUncommittedPutsWithGidToLidHash")
+{
+    DocumentMetaStore dms(createBucketDB());
+    dms.enableGidToLidHash();
+    dms.constructFreeList();
+    uint32_t numLids = 20000;
+    std::atomic<uint32_t> putLid(1);
+    std::atomic<bool> done(false);
+    std::atomic<uint32_t> uncommittedLookups(0);
+    std::thread reader([&]() {
+        while (!done.load(std::memory_order_relaxed)) {
+            GenerationHandler::Guard guard(dms.getGenerationHandler().takeGuard());
+            GlobalId gid = createGid(putLid.load(std::memory_order_acquire));
+            uint32_t lid = 0;
+            if (dms.getLid(gid, lid) && !dms.validLid(lid)) {
+                ++uncommittedLookups;
+            }
+        }
+    });
+    for (uint32_t lid = 1; lid <= numLids; ++lid) {
+        putLid.store(lid, std::memory_order_release);
+        EXPECT_EQUAL(lid, addGid(dms, createGid(lid), Timestamp(lid + timestampBias)));
+    }
+    done = true;
+    reader.join();
+    EXPECT_EQUAL(0u, uncommittedLookups.load());
+    for (uint32_t lid = 1; lid <= numLids; ++lid) {
+        EXPECT_TRUE(assertLid(lid, createGid(lid), dms));
+    }
+}
+
+TEST("requireThatGidToLidHashIsRebuiltOnLoad")
+{
+    DocumentMetaStore dms1(createBucketDB());
+    uint32_t numLids = 100;
+    dms1.constructFreeList();
+    for (uint32_t lid = 1; lid <= numLids; ++lid) {
+        addGid(dms1, createGid(lid), Timestamp(lid + timestampBias));
+    }
+    EXPECT_TRUE(dms1.remove(10));
+    dms1.removeComplete(10);
+    TuneFileAttributes tuneFileAttributes;
+    DummyFileHeaderContext fileHeaderContext;
+    AttributeFileSaveTarget saveTarget(tuneFileAttributes, fileHeaderContext);
+    EXPECT_TRUE(dms1.save(saveTarget, "documentmetastore3"));
+
+    DocumentMetaStore dms2(createBucketDB(), "documentmetastore3");
+    dms2.enableGidToLidHash();
+    EXPECT_TRUE(dms2.load());
+    dms2.constructFreeList();
+    for (uint32_t lid = 1; lid <= numLids; ++lid) {
+        GlobalId gid = createGid(lid);
+        uint32_t myLid = 0;
+        if (lid != 10) {
+            EXPECT_TRUE(assertLid(lid, gid, dms2));
+        } else {
+            EXPECT_FALSE(dms2.getLid(gid, myLid));
+        }
+    }
+    EXPECT_EQUAL(10u, addGid(dms2, createGid(10), Timestamp(10 + timestampBias)));
+    EXPECT_TRUE(assertLid(10u, createGid(10), dms2));
+}
+
 TEST("requireThatStatsAreUpdated")
 {
     DocumentMetaStore dms(createBucketDB());
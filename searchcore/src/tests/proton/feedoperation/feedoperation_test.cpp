@@ -307,6 +307,78 @@ TEST_F("require that we can serialize and deserialize put operations", Fixture)
     }
 }
 
+TEST_F("require that pre-serialized put operations serialize the same way", Fixture)
+{
+    vespalib::nbostream expStream;
+    vespalib::nbostream stream;
+    BucketId bucket(toBucket(docId.getGlobalId()));
+    auto doc(f.makeDoc());
+    uint32_t expSerializedDocSize = getDocSize(*doc);
+    {
+        PutOperation op(bucket, Timestamp(10), doc);
+        op.serialize(expStream);
+    }
+    {
+        PutOperation op(bucket, Timestamp(10), doc);
+        op.preSerialize();
+        op.serialize(stream);
+        EXPECT_EQUAL(expSerializedDocSize, op.getSerializedDocSize());
+    }
+    ASSERT_EQUAL(expStream.size(), stream.size());
+    EXPECT_EQUAL(0, memcmp(expStream.peek(), stream.peek(), stream.size()));
+    {
+        PutOperation op(bucket, Timestamp(10), doc);
+        op.preSerialize();
+        ASSERT_TRUE(op.getPreSerializedTail() != nullptr);
+        EXPECT_EQUAL(op.getSerializedDocument().get(), op.getPreSerializedTail());
+        vespalib::nbostream headStream;
+        op.serializeHead(headStream);
+        headStream.write(op.getPreSerializedTail()->peek(), op.getPreSerializedTail()->size());
+        EXPECT_EQUAL(expSerializedDocSize, op.getSerializedDocSize());
+        ASSERT_EQUAL(expStream.size(), headStream.size());
+        EXPECT_EQUAL(0, memcmp(expStream.peek(), headStream.peek(), headStream.size()));
+    }
+    {
+        PutOperation op;
+        op.deserialize(stream, *f._repo);
+        EXPECT_EQUAL(*doc, *op.getDocument());
+    }
+}
+
+TEST_F("require that pre-serialized update operations serialize the same way", Fixture)
+{
+    vespalib::nbostream expStream;
+    vespalib::nbostream stream;
+    BucketId bucket(toBucket(docId.getGlobalId()));
+    auto upd(f.makeUpdate());
+    {
+        UpdateOperation op(bucket, Timestamp(10), upd);
+        op.serialize(expStream);
+    }
+    {
+        UpdateOperation op(bucket, Timestamp(10), upd);
+        op.preSerialize();
+        op.serialize(stream);
+    }
+    ASSERT_EQUAL(expStream.size(), stream.size());
+    EXPECT_EQUAL(0, memcmp(expStream.peek(), stream.peek(), stream.size()));
+    {
+        UpdateOperation op(bucket, Timestamp(10), upd);
+        op.preSerialize();
+        ASSERT_TRUE(op.getPreSerializedTail() != nullptr);
+        vespalib::nbostream headStream;
+        op.serializeHead(headStream);
+        headStream.write(op.getPreSerializedTail()->peek(), op.getPreSerializedTail()->size());
+        ASSERT_EQUAL(expStream.size(), headStream.size());
+        EXPECT_EQUAL(0, memcmp(expStream.peek(), headStream.peek(), headStream.size()));
+    }
+    {
+        UpdateOperation op;
+        op.deserialize(stream, *f._repo);
+        EXPECT_EQUAL(*upd, *op.getUpdate());
+    }
+}
+
 TEST_F("require that we can serialize and deserialize move operations", Fixture)
 {
     vespalib::nbostream stream;
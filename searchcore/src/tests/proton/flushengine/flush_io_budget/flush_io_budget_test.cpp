@@ -0,0 +1,83 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/testapp.h>
+
+#include <vespa/searchcore/proton/flushengine/flush_io_budget.h>
+
+using proton::flushengine::FlushIoBudget;
+using std::chrono::milliseconds;
+using std::chrono::seconds;
+
+struct Fixture
+{
+    FlushIoBudget::TimePoint _now;
+    FlushIoBudget _budget;
+
+    Fixture(uint64_t bytesPerSecond, uint64_t burstBytes)
+        : _now(FlushIoBudget::Clock::now()),
+          _budget(bytesPerSecond, burstBytes, _now)
+    {
+    }
+
+    void advance(milliseconds delta) { _now += delta; }
+    bool canStart(uint64_t bytes) { return _budget.canStart(bytes, _now); }
+    void acquire(uint64_t bytes) { _budget.acquire(bytes, _now); }
+    int64_t available() { return _budget.getAvailableBytes(_now); }
+    int64_t timeUntilStartMS(uint64_t bytes) { return _budget.timeUntilStart(bytes, _now).count(); }
+};
+
+TEST_F("require that budget starts full", Fixture(1000, 5000))
+{
+    EXPECT_FALSE(f._budget.unlimited());
+    EXPECT_EQUAL(5000, f.available());
+    EXPECT_TRUE(f.canStart(5000));
+    EXPECT_TRUE(f.canStart(5001));
+}
+
+TEST_F("require that flushes larger than burst can start when budget is full", Fixture(1000, 5000))
+{
+    EXPECT_TRUE(f.canStart(20000));
+    f.acquire(20000);
+    EXPECT_EQUAL(-15000, f.available());
+    EXPECT_FALSE(f.canStart(0));
+    EXPECT_EQUAL(20000u, f._budget.getAcquiredBytes());
+}
+
+TEST_F("require that budget is refilled at configured rate up to burst", Fixture(1000, 5000))
+{
+    f.acquire(5000);
+    EXPECT_EQUAL(0, f.available());
+    EXPECT_FALSE(f.canStart(2000));
+    EXPECT_EQUAL(2000, f.timeUntilStartMS(2000));
+    f.advance(milliseconds(1500));
+    EXPECT_EQUAL(1500, f.available());
+    EXPECT_FALSE(f.canStart(2000));
+    EXPECT_EQUAL(500, f.timeUntilStartMS(2000));
+    f.advance(milliseconds(500));
+    EXPECT_TRUE(f.canStart(2000));
+    EXPECT_EQUAL(0, f.timeUntilStartMS(2000));
+    f.advance(seconds(100));
+    EXPECT_EQUAL(5000, f.available());
+}
+
+TEST_F("require that debt must be paid back before next flush", Fixture(1000, 5000))
+{
+    f.acquire(8000);
+    EXPECT_EQUAL(-3000, f.available());
+    EXPECT_EQUAL(4000, f.timeUntilStartMS(1000));
+    f.advance(milliseconds(3000));
+    EXPECT_FALSE(f.canStart(1000));
+    EXPECT_TRUE(f.canStart(0));
+    f.advance(milliseconds(1000));
+    EXPECT_TRUE(f.canStart(1000));
+}
+
+TEST_F("require that zero rate means no limit", Fixture(0, 0))
+{
+    EXPECT_TRUE(f._budget.unlimited());
+    f.acquire(1000000);
+    EXPECT_TRUE(f.canStart(1000000));
+    EXPECT_EQUAL(0, f.timeUntilStartMS(1000000));
+    EXPECT_EQUAL(1000000u, f._budget.getAcquiredBytes());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
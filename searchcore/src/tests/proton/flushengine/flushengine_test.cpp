@@ -239,6 +239,8 @@ class SimpleTarget : public test::DummyFlushTarget {
 public:
     search::SerialNum _flushedSerial;
     search::SerialNum _currentSerial;
+    uint64_t          _approxBytesToWrite;
+    bool              _urgentFlush;
     vespalib::Gate    _proceed;
     vespalib::Gate    _initDone;
     vespalib::Gate    _taskStart;
@@ -249,6 +251,8 @@ protected:
     SimpleTarget(const std::string &name, const Type &type, search::SerialNum flushedSerial = 0, bool proceedImmediately = true) :
         test::DummyFlushTarget(name, type, Component::OTHER),
         _flushedSerial(flushedSerial),
+        _approxBytesToWrite(0),
+        _urgentFlush(false),
         _proceed(),
         _initDone(),
         _taskStart(),
@@ -268,6 +272,8 @@ public:
         test::DummyFlushTarget(name),
         _flushedSerial(0),
         _currentSerial(0),
+        _approxBytesToWrite(0),
+        _urgentFlush(false),
         _proceed(),
         _initDone(),
         _taskStart(),
@@ -295,6 +301,9 @@ public:
         return _flushedSerial;
     }
 
+    uint64_t getApproxBytesToWriteToDisk() const override { return _approxBytesToWrite; }
+    bool needUrgentFlush() const override { return _urgentFlush; }
+
     virtual Task::UP
     initFlush(SerialNum currentSerial) override
     {
@@ -444,10 +453,11 @@ struct Fixture
     SimpleStrategy::SP strategy;
     FlushEngine engine;
 
-    Fixture(uint32_t numThreads, uint32_t idleIntervalMS, SimpleStrategy::SP strategy_)
+    Fixture(uint32_t numThreads, uint32_t idleIntervalMS, SimpleStrategy::SP strategy_,
+            uint64_t ioBytesPerSecond = 0, uint64_t ioBurstBytes = 0)
         : tlsStatsFactory(std::make_shared<SimpleTlsStatsFactory>()),
           strategy(strategy_),
-          engine(tlsStatsFactory, strategy, numThreads, idleIntervalMS)
+          engine(tlsStatsFactory, strategy, numThreads, idleIntervalMS, ioBytesPerSecond, ioBurstBytes)
     {
     }
 
@@ -782,6 +792,83 @@ TEST_F("require that oldest serial is updated when finishing priority flush stra
 }
 
 
+// The io budget is refilled with 1 byte per second, so only the burst can be used during a test
+struct IoBudgetFixture : public Fixture
+{
+    IoBudgetFixture()
+        : Fixture(1, IINTERVAL, std::make_shared<SimpleStrategy>(), 1, 1000)
+    {
+    }
+
+    std::shared_ptr<SimpleTarget>
+    addTarget(const std::string &name, uint64_t bytesToWrite)
+    {
+        auto target = std::make_shared<SimpleTarget>(name, 1);
+        target->_approxBytesToWrite = bytesToWrite;
+        addTargetToStrategy(target);
+        return target;
+    }
+};
+
+TEST_F("require that target over io budget is delayed while next target that fits is flushed", IoBudgetFixture)
+{
+    auto foo = f.addTarget("foo", 800);
+    auto bar = f.addTarget("bar", 800);
+    auto baz = f.addTarget("baz", 100);
+    f.addSimpleHandler({foo, bar, baz});
+
+    EXPECT_TRUE(foo->_taskDone.await(LONG_TIMEOUT));
+    EXPECT_TRUE(baz->_taskDone.await(LONG_TIMEOUT));
+    EXPECT_FALSE(bar->_initDone.await(SHORT_TIMEOUT));
+    EXPECT_EQUAL(900u, f.engine.getIoStats().totalBytes);
+}
+
+TEST_F("require that target over io budget is not kept waiting by a stream of smaller targets", IoBudgetFixture)
+{
+    auto foo = f.addTarget("foo", 800);
+    auto bar = f.addTarget("bar", 800);
+    std::vector<std::shared_ptr<SimpleTarget>> small;
+    for (uint32_t i = 0; i <= FlushEngine::MAX_IO_HEAD_OVERTAKES; ++i) {
+        small.push_back(f.addTarget("small" + std::to_string(i), 10));
+    }
+    Targets targets({foo, bar});
+    targets.insert(targets.end(), small.begin(), small.end());
+    f.addSimpleHandler(targets);
+
+    EXPECT_TRUE(foo->_taskDone.await(LONG_TIMEOUT));
+    for (uint32_t i = 0; i < FlushEngine::MAX_IO_HEAD_OVERTAKES; ++i) {
+        EXPECT_TRUE(small[i]->_taskDone.await(LONG_TIMEOUT));
+    }
+    // The budget is now saved for the higher priority targets delayed by it
+    EXPECT_FALSE(small.back()->_initDone.await(SHORT_TIMEOUT));
+    EXPECT_FALSE(bar->_initDone.await(SHORT_TIMEOUT));
+    EXPECT_EQUAL(800u + 10u * FlushEngine::MAX_IO_HEAD_OVERTAKES, f.engine.getIoStats().totalBytes);
+}
+
+TEST_F("require that target needing urgent flush is not delayed by io budget", IoBudgetFixture)
+{
+    auto foo = f.addTarget("foo", 800);
+    auto bar = f.addTarget("bar", 800);
+    bar->_urgentFlush = true;
+    f.addSimpleHandler({foo, bar});
+
+    EXPECT_TRUE(foo->_taskDone.await(LONG_TIMEOUT));
+    EXPECT_TRUE(bar->_taskDone.await(LONG_TIMEOUT));
+    EXPECT_EQUAL(1600u, f.engine.getIoStats().totalBytes);
+}
+
+TEST_F("require that triggered flush is not delayed by io budget", IoBudgetFixture)
+{
+    auto foo = f.addTarget("foo", 800);
+    auto bar = f.addTarget("bar", 800);
+    f.addSimpleHandler({foo, bar});
+
+    EXPECT_TRUE(foo->_taskDone.await(LONG_TIMEOUT));
+    EXPECT_FALSE(bar->_initDone.await(SHORT_TIMEOUT));
+    f.engine.triggerFlush();
+    EXPECT_TRUE(bar->_taskDone.await(LONG_TIMEOUT));
+}
+
 TEST_MAIN()
 {
     TEST_RUN_ALL();
@@ -22,6 +22,8 @@ class Test : public vespalib::TestApp {
     void requireThatInvalidFlushIndexesAreRemoved();
     void requireThatInvalidFusionIndexesAreRemoved();
     void requireThatRemoveDontTouchNewIndexes();
+    void requireThatTiersOnTopOfLastFusionAreKept();
+    void requireThatTiersReplacedByNewerTierAreRemoved();
 
 public:
     int Main() override;
@@ -45,6 +47,8 @@ Test::Main()
     TEST_DO(requireThatInvalidFlushIndexesAreRemoved());
     TEST_DO(requireThatInvalidFusionIndexesAreRemoved());
     TEST_DO(requireThatRemoveDontTouchNewIndexes());
+    TEST_DO(requireThatTiersOnTopOfLastFusionAreKept());
+    TEST_DO(requireThatTiersReplacedByNewerTierAreRemoved());
 
     TEST_DO(removeTestData());
 
@@ -153,6 +157,45 @@ void Test::requireThatRemoveDontTouchNewIndexes() {
     EXPECT_TRUE(contains(indexes, "index.flush.4"));
 }
 
+void createTierIndexes() {
+    createIndex("index.fusion.1");
+    createIndex("index.tier.0.1");
+    createIndex("index.flush.2");
+    createIndex("index.flush.3");
+    createIndex("index.tier.1.3");
+    createIndex("index.flush.4");
+    createIndex("index.flush.5");
+    createIndex("index.tier.3.5");
+    createIndex("index.flush.6");
+}
+
+void Test::requireThatTiersOnTopOfLastFusionAreKept() {
+    removeTestData();
+    createTierIndexes();
+    ActiveDiskIndexes active_indexes;
+    DiskIndexCleaner::clean(index_dir, active_indexes);
+    vector<string> indexes = readIndexes();
+    EXPECT_EQUAL(4u, indexes.size());
+    EXPECT_TRUE(contains(indexes, "index.fusion.1"));
+    EXPECT_TRUE(contains(indexes, "index.tier.1.3"));
+    EXPECT_TRUE(contains(indexes, "index.tier.3.5"));
+    EXPECT_TRUE(contains(indexes, "index.flush.6"));
+}
+
+void Test::requireThatTiersReplacedByNewerTierAreRemoved() {
+    removeTestData();
+    createTierIndexes();
+    createIndex("index.flush.7");
+    createIndex("index.tier.1.7");
+    ActiveDiskIndexes active_indexes;
+    DiskIndexCleaner::removeOldIndexes(index_dir, active_indexes);
+    vector<string> indexes = readIndexes();
+    EXPECT_EQUAL(2u, indexes.size());
+    EXPECT_TRUE(contains(indexes, "index.fusion.1"));
+    EXPECT_TRUE(contains(indexes, "index.tier.1.7"));
+    removeTestData();
+}
+
 }  // namespace
 
 TEST_APPHOOK(Test);
@@ -70,6 +70,7 @@ class Test : public vespalib::TestApp {
 
     void createIndex(const string &dir, uint32_t id, bool fusion = false);
     void checkResults(uint32_t fusion_id, const uint32_t *ids, size_t size);
+    void checkResults(const vespalib::string &index_dir, const uint32_t *ids, size_t size, bool expect_hits);
 
     void requireThatNoDiskIndexesGiveId0();
     void requireThatOneDiskIndexCausesCopy();
@@ -77,6 +78,7 @@ class Test : public vespalib::TestApp {
     void requireThatFusionCanRunOnMultipleDiskIndexes();
     void requireThatOldFusionIndexCanBePartOfNewFusion();
     void requireThatSelectorsCanBeRebased();
+    void requireThatTierFusionLeavesKeptIndexesAsTheyAre();
 
 public:
     Test()
@@ -107,6 +109,7 @@ Test::Main()
     TEST_CALL(requireThatFusionCanRunOnMultipleDiskIndexes());
     TEST_CALL(requireThatOldFusionIndexCanBePartOfNewFusion());
     TEST_CALL(requireThatSelectorsCanBeRebased());
+    TEST_CALL(requireThatTierFusionLeavesKeptIndexesAsTheyAre());
 
     TEST_DONE();
 }
@@ -222,8 +225,12 @@ vespalib::string getFusionIndexName(uint32_t fusion_id) {
 }
 
 void Test::checkResults(uint32_t fusion_id, const uint32_t *ids, size_t size) {
+    checkResults(getFusionIndexName(fusion_id), ids, size, true);
+}
+
+void Test::checkResults(const vespalib::string &index_dir, const uint32_t *ids, size_t size, bool expect_hits) {
     FakeRequestContext requestContext;
-    DiskIndex disk_index(getFusionIndexName(fusion_id));
+    DiskIndex disk_index(index_dir);
     ASSERT_TRUE(disk_index.setup(TuneFileSearch()));
     uint32_t fieldId = 0;
 
@@ -242,7 +249,7 @@ void Test::checkResults(uint32_t fusion_id, const uint32_t *ids, size_t size) {
     SearchIterator::UP search = blueprint->createSearch(*match_data, true);
     search->initFullRange();
     for (size_t i = 0; i < size; ++i) {
-        EXPECT_TRUE(search->seek(ids[i]));
+        EXPECT_EQUAL(expect_hits, search->seek(ids[i]));
     }
 }
 
@@ -318,6 +325,23 @@ void Test::requireThatSelectorsCanBeRebased() {
     checkResults(fusion_id, disk_id, 3);
 }
 
+void Test::requireThatTierFusionLeavesKeptIndexesAsTheyAre() {
+    createIndex(base_dir, disk_id[0], true);
+    createIndex(base_dir, disk_id[1]);
+    createIndex(base_dir, disk_id[2]);
+    _fusion_spec.kept_tiers = 1;
+    uint32_t fusion_id = _fusion_runner->fuse(_fusion_spec, 0u, _ops);
+    EXPECT_EQUAL(disk_id[2], fusion_id);
+    set<uint32_t> fusion_ids = readFusionIds(base_dir);
+    EXPECT_EQUAL(1u, fusion_ids.size());
+    EXPECT_EQUAL(disk_id[0], *fusion_ids.begin());
+
+    vespalib::asciistream ost;
+    ost << base_dir << "/index.tier." << disk_id[0] << "." << fusion_id;
+    checkResults(ost.str(), disk_id, 1, false);
+    checkResults(ost.str(), disk_id + 1, 2, true);
+}
+
 }  // namespace
 
 TEST_APPHOOK(Test);
@@ -6,3 +6,4 @@ $VALGRIND ./searchcore_diskindexcleaner_test_app
 $VALGRIND ./searchcore_fusionrunner_test_app
 $VALGRIND ./searchcore_indexcollection_test_app
 $VALGRIND ./searchcore_indexmanager_test_app
+$VALGRIND ./searchcore_tiered_fusion_policy_test_app
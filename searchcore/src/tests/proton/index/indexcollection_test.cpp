@@ -30,6 +30,7 @@ class Test : public vespalib::TestApp,
     void requireThatSearchablesCanBeAppended(IndexCollection::UP fsc);
     void requireThatSearchablesCanBeReplaced(IndexCollection::UP fsc);
     void requireThatReplaceAndRenumberUpdatesCollectionAfterFusion();
+    void requireThatReplaceAndMergeUpdatesCollectionAfterTieredFusion();
     IndexCollection::UP createWarmup(const IndexCollection::SP & prev, const IndexCollection::SP & next);
     virtual void warmupDone(ISearchableIndexCollection::SP current) override {
         (void) current;
@@ -63,6 +64,7 @@ Test::Main()
     TEST_DO(requireThatSearchablesCanBeAppended(IndexCollection::UP(new IndexCollection(_selector))));
     TEST_DO(requireThatSearchablesCanBeReplaced(IndexCollection::UP(new IndexCollection(_selector))));
     TEST_DO(requireThatReplaceAndRenumberUpdatesCollectionAfterFusion());
+    TEST_DO(requireThatReplaceAndMergeUpdatesCollectionAfterTieredFusion());
     {
         IndexCollection::SP prev(new IndexCollection(_selector));
         IndexCollection::SP next(new IndexCollection(_selector));
@@ -123,6 +125,29 @@ void Test::requireThatReplaceAndRenumberUpdatesCollectionAfterFusion() {
     EXPECT_EQUAL(_source2.get(), &new_fsc->getSearchable(1));
 }
 
+void Test::requireThatReplaceAndMergeUpdatesCollectionAfterTieredFusion() {
+    IndexCollection fsc(_selector);
+
+    fsc.append(0, _source1);
+    fsc.append(1, _source1);
+    fsc.append(2, _source1);
+    fsc.append(3, _source2);
+    fsc.setCurrentIndex(3);
+    EXPECT_EQUAL(4u, fsc.getSourceCount());
+
+    IndexCollection::UP new_fsc =
+        IndexCollection::replaceAndMerge(
+                _selector, fsc, 1, 2, _fusion_source);
+    EXPECT_EQUAL(3u, new_fsc->getSourceCount());
+    EXPECT_EQUAL(0u, new_fsc->getSourceId(0));
+    EXPECT_EQUAL(_source1.get(), &new_fsc->getSearchable(0));
+    EXPECT_EQUAL(2u, new_fsc->getSourceId(1));
+    EXPECT_EQUAL(_fusion_source.get(), &new_fsc->getSearchable(1));
+    EXPECT_EQUAL(3u, new_fsc->getSourceId(2));
+    EXPECT_EQUAL(_source2.get(), &new_fsc->getSearchable(2));
+    EXPECT_EQUAL(3u, new_fsc->getCurrentIndex());
+}
+
 }  // namespace
 
 TEST_APPHOOK(Test);
@@ -609,6 +609,73 @@ TEST_F("requireThatDiskIndexesAreLoadedOnStartup", Fixture) {
     fsc.reset();
 }
 
+bool tierExists(uint32_t keptId, uint32_t id) {
+    FastOS_StatInfo stat;
+    vespalib::asciistream ost;
+    ost << index_dir << "/index.tier." << keptId << "." << id;
+    return FastOS_File::Stat(ost.str().c_str(), &stat) && stat._isDirectory;
+}
+
+TEST_F("requireThatTierFusionKeepsFusionIndexAndRemapsSourceSelector", Fixture) {
+    for (uint32_t i = 0; i < 4; ++i) {
+        f.addDocument(docid + i);
+        f.flushIndexManager();
+    }
+    IndexMaintainer &maintainer = f._index_manager->getMaintainer();
+    FusionSpec fusion_spec;
+    fusion_spec.flush_ids = {1, 2};
+    EXPECT_EQUAL(2u, maintainer.runFusion(fusion_spec));
+
+    // The flush of the next memory index is started before the tier fusion
+    // and saves a source selector where documents select the flushed indexes.
+    f.addDocument(docid + 4);
+    vespalib::Executor::Task::UP flushTask;
+    SerialNum serialNum = f._index_manager->getCurrentSerialNum();
+    f.runAsMaster([&]() { flushTask = maintainer.initFlush(serialNum, NULL); });
+    ASSERT_TRUE(flushTask.get() != nullptr);
+
+    FusionSpec tier_spec;
+    tier_spec.last_fusion_id = 2;
+    tier_spec.flush_ids = {3, 4};
+    tier_spec.kept_tiers = 1;
+    EXPECT_EQUAL(4u, maintainer.runFusion(tier_spec));
+    EXPECT_TRUE(indexExists("fusion", 2));
+    EXPECT_TRUE(tierExists(2, 4));
+
+    IIndexCollection::SP fsc = maintainer.getSourceCollection();
+    EXPECT_TRUE(contains(*fsc, 0u));
+    EXPECT_FALSE(contains(*fsc, 1u));
+    EXPECT_TRUE(contains(*fsc, 2u));
+    EXPECT_EQUAL(0u, getSource(*fsc, docid));
+    EXPECT_EQUAL(0u, getSource(*fsc, docid + 1));
+    EXPECT_EQUAL(2u, getSource(*fsc, docid + 2));
+    EXPECT_EQUAL(2u, getSource(*fsc, docid + 3));
+    EXPECT_EQUAL(3u, getSource(*fsc, docid + 4));
+    fsc.reset();
+
+    flushTask->run();
+    ASSERT_TRUE(indexExists("flush", 5));
+    f.resetIndexManager();
+
+    FusionSpec spec = f._index_manager->getMaintainer().getFusionSpec();
+    EXPECT_EQUAL(2u, spec.last_fusion_id);
+    EXPECT_EQUAL(std::vector<uint32_t>({4}), spec.tier_ids);
+    EXPECT_EQUAL(std::vector<uint32_t>({5}), spec.flush_ids);
+    // The fusion index, the tier and the flushed index are all fusioned next
+    EXPECT_EQUAL(3u, f._index_manager->getMaintainer().getFusionStats().numUnfused);
+
+    fsc = f._index_manager->getMaintainer().getSourceCollection();
+    EXPECT_EQUAL(4u, fsc->getSourceCount());
+    EXPECT_TRUE(contains(*fsc, 0u));
+    EXPECT_TRUE(contains(*fsc, 2u));
+    EXPECT_TRUE(contains(*fsc, 3u));
+    EXPECT_EQUAL(0u, getSource(*fsc, docid));
+    EXPECT_EQUAL(0u, getSource(*fsc, docid + 1));
+    EXPECT_EQUAL(2u, getSource(*fsc, docid + 2));
+    EXPECT_EQUAL(2u, getSource(*fsc, docid + 3));
+    EXPECT_EQUAL(3u, getSource(*fsc, docid + 4));
+}
+
 TEST_F("requireThatExistingIndexesAreToBeFusionedOnStartup", Fixture) {
     f.addDocument(docid);
     f.flushIndexManager();
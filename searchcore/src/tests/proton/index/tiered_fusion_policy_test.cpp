@@ -0,0 +1,59 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+// Unit tests for tiered fusion policy.
+
+#include <vespa/searchcorespi/index/tiered_fusion_policy.h>
+#include <vespa/vespalib/testkit/testapp.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP("tiered_fusion_policy_test");
+
+using searchcorespi::index::TieredFusionPolicy;
+
+using Sizes = std::vector<uint64_t>;
+
+TEST("require that all indexes are fusioned when max tiers is 1")
+{
+    TieredFusionPolicy policy(1);
+    EXPECT_EQUAL(0u, policy.selectKeptTiers(Sizes(), 10));
+    EXPECT_EQUAL(0u, policy.selectKeptTiers(Sizes({1000}), 10));
+    EXPECT_EQUAL(0u, policy.selectKeptTiers(Sizes({1000, 500}), 10));
+}
+
+TEST("require that max tiers is at least 1")
+{
+    TieredFusionPolicy policy(0);
+    EXPECT_EQUAL(1u, policy.getMaxTiers());
+    EXPECT_EQUAL(0u, policy.selectKeptTiers(Sizes({1000}), 10));
+}
+
+TEST("require that large old indexes are kept")
+{
+    TieredFusionPolicy policy(3);
+    EXPECT_EQUAL(1u, policy.selectKeptTiers(Sizes({1000}), 10));
+    EXPECT_EQUAL(2u, policy.selectKeptTiers(Sizes({1000, 100}), 10));
+}
+
+TEST("require that indexes of similar size are fusioned")
+{
+    TieredFusionPolicy policy(3);
+    EXPECT_EQUAL(1u, policy.selectKeptTiers(Sizes({1000, 40}), 10));
+    EXPECT_EQUAL(0u, policy.selectKeptTiers(Sizes({200, 40}), 10));
+    EXPECT_EQUAL(0u, policy.selectKeptTiers(Sizes({40}), 10));
+}
+
+TEST("require that fusion cascades down the tiers")
+{
+    TieredFusionPolicy policy(4);
+    // 10 + 30 = 40, 40 + 150 = 190, 190 * 4 >= 700
+    EXPECT_EQUAL(0u, policy.selectKeptTiers(Sizes({700, 150, 30}), 10));
+    EXPECT_EQUAL(1u, policy.selectKeptTiers(Sizes({800, 150, 30}), 10));
+}
+
+TEST("require that number of tiers is bounded by max tiers")
+{
+    TieredFusionPolicy policy(2);
+    EXPECT_EQUAL(1u, policy.selectKeptTiers(Sizes({1000, 100}), 10));
+    EXPECT_EQUAL(1u, policy.selectKeptTiers(Sizes({10000, 1000, 100}), 10));
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -5,6 +5,7 @@
 #include "select_utils.h"
 #include "selectcontext.h"
 #include "selectpruner.h"
+#include <vespa/document/select/compiled_selection.h>
 #include <vespa/document/select/parser.h>
 #include <vespa/searchlib/attribute/attributevector.h>
 #include <vespa/searchlib/attribute/iattributemanager.h>
@@ -114,10 +115,16 @@ CachedSelect::Session::Session(std::unique_ptr<document::select::Node> docSelect
                                std::unique_ptr<document::select::Node> preDocSelect)
     : _docSelect(std::move(docSelect)),
       _preDocOnlySelect(std::move(preDocOnlySelect)),
-      _preDocSelect(std::move(preDocSelect))
+      _preDocSelect(std::move(preDocSelect)),
+      _compiledDocSelect()
 {
+    if (_docSelect) {
+        _compiledDocSelect = std::make_unique<document::select::CompiledSelection>(*_docSelect);
+    }
 }
 
+CachedSelect::Session::~Session() = default;
+
 bool
 CachedSelect::Session::contains(const SelectContext &context) const
 {
@@ -132,7 +139,7 @@ bool
 CachedSelect::Session::contains(const document::Document &doc) const
 {
     return (_preDocOnlySelect) ||
-            (_docSelect && (_docSelect->contains(doc) == document::select::Result::True));
+            (_compiledDocSelect && (_compiledDocSelect->contains(doc) == document::select::Result::True));
 }
 
 const document::select::Node &
@@ -8,7 +8,10 @@
 namespace document {
     class DocumentTypeRepo;
     class Document;
-    namespace select { class Node; }
+    namespace select {
+        class CompiledSelection;
+        class Node;
+    }
 }
 namespace search {
     class AttributeVector;
@@ -34,11 +37,14 @@ public:
         std::unique_ptr<document::select::Node> _docSelect;
         std::unique_ptr<document::select::Node> _preDocOnlySelect;
         std::unique_ptr<document::select::Node> _preDocSelect;
+        // Flat program for _docSelect, evaluated once per retrieved document.
+        std::unique_ptr<document::select::CompiledSelection> _compiledDocSelect;
 
     public:
         Session(std::unique_ptr<document::select::Node> docSelect,
                 std::unique_ptr<document::select::Node> preDocOnlySelect,
                 std::unique_ptr<document::select::Node> preDocSelect);
+        ~Session();
         bool contains(const SelectContext &context) const;
         bool contains(const document::Document &doc) const;
         const document::select::Node &selectNode() const;
@@ -89,6 +95,11 @@ public:
     bool allFalse() const { return _allFalse; }
     bool allTrue() const { return _allTrue; }
     bool allInvalid() const { return _allInvalid; }
+    /**
+     * True if the selection can be fully evaluated using single value
+     * attributes and document metadata, without retrieving the document.
+     */
+    bool preDocOnly() const { return static_cast<bool>(_preDocOnlySelect); }
 
     // Should only be used for unit testing
     const std::unique_ptr<document::select::Node> &docSelect() const { return _docSelect; }
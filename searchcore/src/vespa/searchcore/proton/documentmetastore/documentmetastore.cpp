@@ -180,6 +180,9 @@ DocumentMetaStore::insert(DocId lid, const RawDocumentMetaData &metaData)
     if (!_gidToLidMap.insert(lid, BTreeNoLeafData(), comp)) {
         return false;
     }
+    if (_gidToLidHash) {
+        _gidToLidHash->insert(lid);
+    }
     // flush writes to meta store rcu vector before new entry is visible
     // from frozen root or lid based scan
     std::atomic_thread_fence(std::memory_order_release);
@@ -206,6 +209,9 @@ DocumentMetaStore::onUpdateStat()
     usage.incAllocatedBytes(bvSize);
     usage.incUsedBytes(bvSize);
     usage.merge(_gidToLidMap.getMemoryUsage());
+    if (_gidToLidHash) {
+        usage.merge(_gidToLidHash->getMemoryUsage());
+    }
     // the free lists are not taken into account here
     updateStatistics(_metaDataStore.size(),
                      _metaDataStore.size(),
@@ -293,6 +299,7 @@ DocumentMetaStore::onLoad()
     _gidToLidMap.getAllocator().freeze(); // create initial frozen tree
     generation_t generation = getGenerationHandler().getCurrentGeneration();
     _gidToLidMap.getAllocator().transferHoldLists(generation);
+    rebuildGidToLidHash();
 
     setNumDocs(_metaDataStore.size());
     setCommittedDocIdLimit(_metaDataStore.size());
@@ -301,11 +308,11 @@ DocumentMetaStore::onLoad()
 }
 
 bool
-DocumentMetaStore::checkBuckets(const GlobalId &gid, const BucketId &bucketId,
-                                const TreeType::Iterator &itr, bool found)
+DocumentMetaStore::checkBuckets(const GlobalId &gid, const BucketId &bucketId, bool found)
 {
     bool success = true;
 #if 0
+    TreeType::Iterator itr = lowerBound(gid);
     TreeType::Iterator p = itr;
     --p;
     if (p.valid()) {
@@ -346,7 +353,6 @@ DocumentMetaStore::checkBuckets(const GlobalId &gid, const BucketId &bucketId,
 #else
     (void) gid;
     (void) bucketId;
-    (void) itr;
     (void) found;
 #endif
     return success;
@@ -443,6 +449,7 @@ DocumentMetaStore::DocumentMetaStore(BucketDBOwner::SP bucketDB,
                      grow.getDocsGrowDelta(),
                      getGenerationHolder()),
       _gidToLidMap(),
+      _gidToLidHash(),
       _lidAlloc(_metaDataStore.size(),
                 _metaDataStore.capacity(),
                 getGenerationHolder()),
@@ -474,12 +481,9 @@ DocumentMetaStore::inspectExisting(const GlobalId &gid) const
 {
     assert(_lidAlloc.isFreeListConstructed());
     Result res;
-    KeyComp comp(gid, _metaDataStore, *_gidCompare);
-    TreeType::Iterator itr = _gidToLidMap.lowerBound(KeyComp::FIND_DOC_ID,
-            comp);
-    bool found = itr.valid() && !comp(KeyComp::FIND_DOC_ID, itr.getKey());
-    if (found) {
-        res.setLid(itr.getKey());
+    DocId lid = 0;
+    if (findLid(gid, lid)) {
+        res.setLid(lid);
         res.fillPrev(_metaDataStore[res.getLid()].getTimestamp());
         res.markSuccess();
     }
@@ -491,16 +495,13 @@ DocumentMetaStore::inspect(const GlobalId &gid)
 {
     assert(_lidAlloc.isFreeListConstructed());
     Result res;
-    KeyComp comp(gid, _metaDataStore, *_gidCompare);
-    TreeType::Iterator itr = _gidToLidMap.lowerBound(KeyComp::FIND_DOC_ID,
-            comp);
-    bool found = itr.valid() && !comp(KeyComp::FIND_DOC_ID, itr.getKey());
-    if (!found) {
+    DocId lid = 0;
+    if (!findLid(gid, lid)) {
         DocId myLid = peekFreeLid();
         res.setLid(myLid);
         res.markSuccess();
     } else {
-        res.setLid(itr.getKey());
+        res.setLid(lid);
         res.fillPrev(_metaDataStore[res.getLid()].getTimestamp());
         res.markSuccess();
     }
@@ -516,11 +517,9 @@ DocumentMetaStore::put(const GlobalId &gid,
 {
     Result res;
     RawDocumentMetaData metaData(gid, bucketId, timestamp, docSize);
-    KeyComp comp(metaData, _metaDataStore, *_gidCompare);
-    TreeType::Iterator itr = _gidToLidMap.lowerBound(KeyComp::FIND_DOC_ID,
-            comp);
-    bool found = itr.valid() && !comp(KeyComp::FIND_DOC_ID, itr.getKey());
-    if (!checkBuckets(gid, bucketId, itr, found)) {
+    DocId foundLid = 0;
+    bool found = findLid(gid, foundLid);
+    if (!checkBuckets(gid, bucketId, found)) {
         // Failure
     } else if (!found) {
         if (validLid(lid)) {
@@ -545,7 +544,7 @@ DocumentMetaStore::put(const GlobalId &gid,
             res.setLid(lid);
             res.markSuccess();
         }
-    } else if (lid != itr.getKey()) {
+    } else if (lid != foundLid) {
         throw IllegalStateException(
                 make_string(
                         "document meta data store"
@@ -555,7 +554,7 @@ DocumentMetaStore::put(const GlobalId &gid,
                         " gid found, but using another lid '%u'",
                         lid,
                         gid.toString().c_str(),
-                        itr.getKey()));
+                        foundLid));
     } else {
         res.setLid(lid);
         res.fillPrev(_metaDataStore[lid].getTimestamp());
@@ -603,6 +602,9 @@ DocumentMetaStore::remove(DocId lid, BucketDBOwner::Guard &bucketGuard)
                         " document with lid '%u' and gid '%s'",
                         lid, gid.toString().c_str()));
     }
+    if (_gidToLidHash) {
+        _gidToLidHash->remove(lid);
+    }
     _lidAlloc.unregisterLid(lid);
     RawDocumentMetaData &oldMetaData = _metaDataStore[lid];
     bucketGuard->remove(oldMetaData.getGid(),
@@ -648,6 +650,9 @@ DocumentMetaStore::move(DocId fromLid, DocId toLid)
     assert(it.getKey() == fromLid);
     _gidToLidMap.thaw(it);
     it.writeKey(toLid);
+    if (_gidToLidHash) {
+        _gidToLidHash->move(fromLid, toLid);
+    }
     _lidAlloc.moveLidEnd(fromLid, toLid);
     incGeneration();
 }
@@ -714,6 +719,45 @@ DocumentMetaStore::getLid(const GlobalId &gid, DocId &lid) const
     return true;
 }
 
+bool
+DocumentMetaStore::findLid(const GlobalId &gid, DocId &lid) const
+{
+    if (_gidToLidHash) {
+        lid = _gidToLidHash->find(gid);
+        return (lid != 0);
+    }
+    KeyComp comp(gid, _metaDataStore, *_gidCompare);
+    TreeType::Iterator itr = _gidToLidMap.lowerBound(KeyComp::FIND_DOC_ID, comp);
+    if (!itr.valid() || comp(KeyComp::FIND_DOC_ID, itr.getKey())) {
+        return false;
+    }
+    lid = itr.getKey();
+    return true;
+}
+
+void
+DocumentMetaStore::rebuildGidToLidHash()
+{
+    if (!_gidToLidHash) {
+        return;
+    }
+    _gidToLidHash->clear(_lidAlloc.getNumUsedLids());
+    for (TreeType::Iterator itr = _gidToLidMap.begin(); itr.valid(); ++itr) {
+        _gidToLidHash->insert(itr.getKey());
+    }
+}
+
+void
+DocumentMetaStore::enableGidToLidHash()
+{
+    if (_gidToLidHash) {
+        return;
+    }
+    _gidToLidHash = std::make_unique<documentmetastore::GidToLidHash>(_metaDataStore);
+    rebuildGidToLidHash();
+    incGeneration();
+}
+
 void
 DocumentMetaStore::constructFreeList()
 {
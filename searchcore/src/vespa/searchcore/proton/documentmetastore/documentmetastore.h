@@ -3,6 +3,7 @@
 #pragma once
 
 #include "gid_compare.h"
+#include "gid_to_lid_hash.h"
 #include "document_meta_store_adapter.h"
 #include "documentmetastoreattribute.h"
 #include "lid_allocator.h"
@@ -65,6 +66,8 @@ private:
 
     MetaDataStore       _metaDataStore;
     TreeType            _gidToLidMap;
+    // optional index for exact gid lookups, the tree is still used for bucket order
+    std::unique_ptr<documentmetastore::GidToLidHash> _gidToLidHash;
     documentmetastore::LidAllocator _lidAlloc;
     IGidCompare::SP     _gidCompare;
     BucketDBOwner::SP   _bucketDB;
@@ -76,6 +79,8 @@ private:
     DocId peekFreeLid();
     VESPA_DLL_LOCAL void ensureSpace(DocId lid);
     bool insert(DocId lid, const RawDocumentMetaData &metaData);
+    bool findLid(const GlobalId &gid, DocId &lid) const;
+    void rebuildGidToLidHash();
 
     const GlobalId & getRawGid(DocId lid) const { return getRawMetaData(lid).getGid(); }
 
@@ -90,7 +95,6 @@ private:
     bool
     checkBuckets(const GlobalId &gid,
                  const BucketId &bucketId,
-                 const TreeType::Iterator &itr,
                  bool found);
 
     template <typename TreeView>
@@ -263,6 +267,17 @@ public:
     uint64_t getEstimatedSaveByteSize() const override;
     uint32_t getVersion() const override;
     void setTrackDocumentSizes(bool trackDocumentSizes) { _trackDocumentSizes = trackDocumentSizes; }
+
+    /**
+     * Use a hash table for exact gid lookups done by the writer thread,
+     * e.g. in inspect() and put(), instead of searching the gid ordered
+     * btree. This trades some memory for less cpu per feed operation.
+     * getLid() still uses the frozen btree, so readers only see
+     * committed puts and moves. Only the write path is sped up, the
+     * latency of lookups from readers is unchanged.
+     */
+    void enableGidToLidHash();
+    bool hasGidToLidHash() const { return static_cast<bool>(_gidToLidHash); }
     void foreach(const search::IGidToLidMapperVisitor &visitor) const override;
 };
 
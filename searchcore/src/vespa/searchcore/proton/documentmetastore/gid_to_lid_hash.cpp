@@ -0,0 +1,165 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "gid_to_lid_hash.h"
+#include <cassert>
+#include <cstring>
+
+namespace proton::documentmetastore {
+
+namespace {
+
+size_t
+calcCapacity(size_t minUsed, size_t minCapacity)
+{
+    // Keep the load factor below 1/4 after a resize, resize when above 1/2
+    size_t capacity = minCapacity;
+    while (capacity < minUsed * 4) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+uint32_t
+calcShift(size_t capacity)
+{
+    uint32_t bits = 0;
+    while ((size_t(1) << bits) < capacity) {
+        ++bits;
+    }
+    return 64 - bits;
+}
+
+}
+
+GidToLidHash::GidToLidHash(const MetaDataStore &metaDataStore)
+    : _slots(),
+      _shift(0),
+      _mask(0),
+      _metaDataStore(metaDataStore),
+      _used(0),
+      _removed(0)
+{
+    reset(MIN_CAPACITY);
+}
+
+GidToLidHash::~GidToLidHash() = default;
+
+uint64_t
+GidToLidHash::hashGid(const GlobalId &gid)
+{
+    // The first bytes of a gid are location bits, which are shared by
+    // all documents in the same group, so mix in the rest of the gid.
+    uint64_t first;
+    uint32_t last;
+    memcpy(&first, gid.get(), sizeof(first));
+    memcpy(&last, gid.get() + sizeof(first), sizeof(last));
+    return (first ^ (uint64_t(last) << 32) ^ last) * 0x9E3779B97F4A7C15ul;
+}
+
+size_t
+GidToLidHash::findSlot(DocId lid) const
+{
+    size_t idx = hashGid(_metaDataStore[lid].getGid()) >> _shift;
+    for (;;) {
+        DocId slotLid = _slots[idx];
+        assert(slotLid != EMPTY);
+        if (slotLid == lid) {
+            return idx;
+        }
+        idx = (idx + 1) & _mask;
+    }
+}
+
+GidToLidHash::DocId
+GidToLidHash::find(const GlobalId &gid) const
+{
+    size_t idx = hashGid(gid) >> _shift;
+    for (;;) {
+        DocId lid = _slots[idx];
+        if (lid == EMPTY) {
+            return 0;
+        }
+        if (lid != REMOVED && _metaDataStore[lid].getGid() == gid) {
+            return lid;
+        }
+        idx = (idx + 1) & _mask;
+    }
+}
+
+void
+GidToLidHash::insert(DocId lid)
+{
+    assert(lid != EMPTY && lid != REMOVED);
+    if ((_used + _removed + 1) * 2 > _slots.size()) {
+        resize(_used + 1);
+    }
+    size_t idx = hashGid(_metaDataStore[lid].getGid()) >> _shift;
+    while (_slots[idx] != EMPTY && _slots[idx] != REMOVED) {
+        idx = (idx + 1) & _mask;
+    }
+    if (_slots[idx] == REMOVED) {
+        --_removed;
+    }
+    _slots[idx] = lid;
+    ++_used;
+}
+
+void
+GidToLidHash::remove(DocId lid)
+{
+    _slots[findSlot(lid)] = REMOVED;
+    --_used;
+    ++_removed;
+}
+
+void
+GidToLidHash::move(DocId fromLid, DocId toLid)
+{
+    _slots[findSlot(fromLid)] = toLid;
+}
+
+void
+GidToLidHash::reset(size_t capacity)
+{
+    std::vector<DocId>(capacity, EMPTY).swap(_slots);
+    _shift = calcShift(capacity);
+    _mask = capacity - 1;
+    _removed = 0;
+}
+
+void
+GidToLidHash::resize(size_t minUsed)
+{
+    std::vector<DocId> oldSlots;
+    oldSlots.swap(_slots);
+    reset(calcCapacity(minUsed, MIN_CAPACITY));
+    for (DocId lid : oldSlots) {
+        if (lid == EMPTY || lid == REMOVED) {
+            continue;
+        }
+        size_t idx = hashGid(_metaDataStore[lid].getGid()) >> _shift;
+        while (_slots[idx] != EMPTY) {
+            idx = (idx + 1) & _mask;
+        }
+        _slots[idx] = lid;
+    }
+}
+
+void
+GidToLidHash::clear(size_t expectedLids)
+{
+    reset(calcCapacity(expectedLids, MIN_CAPACITY));
+    _used = 0;
+}
+
+search::MemoryUsage
+GidToLidHash::getMemoryUsage() const
+{
+    constexpr size_t slotSize = sizeof(DocId);
+    return search::MemoryUsage(_slots.capacity() * slotSize,
+                               (_used + _removed) * slotSize,
+                               _removed * slotSize,
+                               0);
+}
+
+}
@@ -0,0 +1,86 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "raw_document_meta_data.h"
+#include <vespa/searchlib/common/rcuvector.h>
+#include <vespa/searchlib/util/memoryusage.h>
+#include <vector>
+
+namespace proton::documentmetastore {
+
+/**
+ * Open addressed hash table mapping from gid to lid, used for exact
+ * gid lookups in the document meta store instead of searching the
+ * gid ordered btree. Only lids are stored in the table. The gid for
+ * a lid is found in the meta data store, as for the btree.
+ *
+ * The table is only used by the writer thread. A lid is added to the
+ * table before the put that allocated it is committed, so readers
+ * must keep using the frozen btree, which only exposes committed state.
+ * Only the write path (feed operations looking up their lid) is sped
+ * up. Lookups from readers, e.g. get and docsum requests, cost the same
+ * with or without the table.
+ */
+class GidToLidHash
+{
+public:
+    using DocId = uint32_t;
+    using GlobalId = document::GlobalId;
+    using MetaDataStore = search::attribute::RcuVectorBase<RawDocumentMetaData>;
+
+private:
+    static constexpr DocId EMPTY = 0; // lid 0 is reserved
+    static constexpr DocId REMOVED = static_cast<DocId>(-1);
+    static constexpr size_t MIN_CAPACITY = 16;
+
+    std::vector<DocId>   _slots;
+    uint32_t             _shift;
+    size_t               _mask;
+    const MetaDataStore &_metaDataStore;
+    size_t               _used;
+    size_t               _removed;
+
+    static uint64_t hashGid(const GlobalId &gid);
+    size_t findSlot(DocId lid) const;
+    void reset(size_t capacity);
+    void resize(size_t minUsed);
+
+public:
+    GidToLidHash(const MetaDataStore &metaDataStore);
+    ~GidToLidHash();
+
+    /**
+     * Returns the lid for the given gid, or 0 if not found.
+     */
+    DocId find(const GlobalId &gid) const;
+
+    /**
+     * Adds lid to the table, using the gid stored for it in the meta
+     * data store. The gid must not already be present.
+     */
+    void insert(DocId lid);
+
+    /**
+     * Removes lid from the table. The gid for the lid must still be
+     * stored in the meta data store.
+     */
+    void remove(DocId lid);
+
+    /**
+     * Replaces fromLid with toLid. The meta data for fromLid must have
+     * been copied to toLid.
+     */
+    void move(DocId fromLid, DocId toLid);
+
+    /**
+     * Replaces the table with an empty one, sized for the given
+     * number of lids.
+     */
+    void clear(size_t expectedLids);
+
+    size_t size() const { return _used; }
+    search::MemoryUsage getMemoryUsage() const;
+};
+
+}
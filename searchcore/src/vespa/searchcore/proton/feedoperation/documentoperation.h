@@ -84,6 +84,16 @@ public:
 
     uint32_t getSerializedDocSize() const { return _serializedDocSize; }
 
+    /**
+     * Serialize the document or document update carried by this
+     * operation ahead of time. The transaction log then stores the bytes
+     * as they are (see getPreSerializedTail()), and a put reuses them for
+     * the document store. This lets the cost of serialization be paid in
+     * the persistence thread receiving the operation instead of in the
+     * master and summary write threads.
+     */
+    virtual void preSerialize() { }
+
     // Provided as a hook for tests.
     void serializeDocumentOperationOnly(vespalib::nbostream &os) const;
 };
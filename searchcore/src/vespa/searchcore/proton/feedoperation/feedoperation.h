@@ -52,6 +52,15 @@ public:
     virtual void serialize(vespalib::nbostream &os) const = 0;
     virtual void deserialize(vespalib::nbostream &is, const document::DocumentTypeRepo &repo) = 0;
     virtual vespalib::string toString() const = 0;
+
+    /**
+     * Returns the tail of the serialized operation if it was serialized
+     * ahead of time (see DocumentOperation::preSerialize), else nullptr.
+     * serializeHead() followed by the tail gives the same bytes as
+     * serialize(), so a writer can store the two without joining them.
+     */
+    virtual const vespalib::nbostream *getPreSerializedTail() const { return nullptr; }
+    virtual void serializeHead(vespalib::nbostream &os) const { serialize(os); }
 };
 
 } // namespace proton
@@ -2,6 +2,7 @@
 
 #include "putoperation.h"
 #include <vespa/document/fieldvalue/document.h>
+#include <vespa/vespalib/objects/nbostream.h>
 
 using document::BucketId;
 using document::Document;
@@ -13,7 +14,8 @@ namespace proton {
 
 PutOperation::PutOperation()
     : DocumentOperation(FeedOperation::PUT),
-      _doc()
+      _doc(),
+      _serializedDoc()
 { }
 
 
@@ -23,18 +25,31 @@ PutOperation::PutOperation(const BucketId &bucketId,
     : DocumentOperation(FeedOperation::PUT,
                         bucketId,
                         timestamp),
-      _doc(doc)
+      _doc(doc),
+      _serializedDoc()
 { }
 
 PutOperation::~PutOperation() { }
 
+void
+PutOperation::serializeHead(vespalib::nbostream &os) const
+{
+    assertValidBucketId(_doc->getId());
+    DocumentOperation::serialize(os);
+    _serializedDocSize = _serializedDoc ? _serializedDoc->size() : 0;
+}
+
 void
 PutOperation::serialize(vespalib::nbostream &os) const
 {
     assertValidBucketId(_doc->getId());
     DocumentOperation::serialize(os);
     size_t oldSize = os.size();
-    _doc->serialize(os);
+    if (_serializedDoc) {
+        os.write(_serializedDoc->peek(), _serializedDoc->size());
+    } else {
+        _doc->serialize(os);
+    }
     _serializedDocSize = os.size() - oldSize;
 }
 
@@ -47,17 +62,30 @@ PutOperation::deserialize(vespalib::nbostream &is,
     size_t oldSize = is.size();
     _doc.reset(new Document(repo, is));
     _serializedDocSize = oldSize - is.size();
+    _serializedDoc.reset();
 }
 
 void
 PutOperation::deserializeDocument(const DocumentTypeRepo &repo)
 {
     vespalib::nbostream stream;
-    _doc->serialize(stream);
+    if (_serializedDoc) {
+        stream.write(_serializedDoc->peek(), _serializedDoc->size());
+    } else {
+        _doc->serialize(stream);
+    }
     auto fixedDoc = std::make_shared<Document>(repo, stream);
     _doc = std::move(fixedDoc);
 }
 
+void
+PutOperation::preSerialize()
+{
+    auto stream = std::make_shared<vespalib::nbostream>();
+    _doc->serialize(*stream);
+    _serializedDoc = std::move(stream);
+}
+
 vespalib::string
 PutOperation::toString() const
 {
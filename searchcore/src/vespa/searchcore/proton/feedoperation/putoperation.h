@@ -9,6 +9,7 @@ class PutOperation : public DocumentOperation
 {
     using DocumentSP = std::shared_ptr<document::Document>;
     DocumentSP _doc;
+    std::shared_ptr<const vespalib::nbostream> _serializedDoc; // Set by preSerialize()
 
 public:
     PutOperation();
@@ -22,6 +23,14 @@ public:
     virtual void deserialize(vespalib::nbostream &is,
                              const document::DocumentTypeRepo &repo) override;
     void deserializeDocument(const document::DocumentTypeRepo &repo);
+    void preSerialize() override;
+    /**
+     * Returns the document serialized by preSerialize(), or nullptr. The
+     * bytes are shared, e.g. with the document store write of the put.
+     */
+    const std::shared_ptr<const vespalib::nbostream> &getSerializedDocument() const { return _serializedDoc; }
+    const vespalib::nbostream *getPreSerializedTail() const override { return _serializedDoc.get(); }
+    void serializeHead(vespalib::nbostream &os) const override;
     virtual vespalib::string toString() const override;
 };
 
@@ -3,6 +3,7 @@
 #include <vespa/document/base/exceptions.h>
 #include <vespa/document/update/documentupdate.h>
 #include <vespa/document/util/bytebuffer.h>
+#include <vespa/vespalib/objects/nbostream.h>
 #include <cassert>
 
 #include <vespa/log/log.h>
@@ -25,7 +26,8 @@ UpdateOperation::UpdateOperation()
 
 UpdateOperation::UpdateOperation(Type type)
     : DocumentOperation(type),
-      _upd()
+      _upd(),
+      _serializedUpdate()
 {
 }
 
@@ -33,7 +35,8 @@ UpdateOperation::UpdateOperation(Type type)
 UpdateOperation::UpdateOperation(Type type, const BucketId &bucketId,
                                  const Timestamp &timestamp, const DocumentUpdate::SP &upd)
     : DocumentOperation(type, bucketId, timestamp),
-      _upd(upd)
+      _upd(upd),
+      _serializedUpdate()
 {
 }
 
@@ -43,11 +46,17 @@ UpdateOperation::UpdateOperation(const BucketId &bucketId, const Timestamp &time
 {
 }
 
+UpdateOperation::~UpdateOperation() = default;
+
 void
 UpdateOperation::serializeUpdate(vespalib::nbostream &os) const
 {
     assert(getType() == UPDATE);
-     _upd->serializeHEAD(os);
+    if (_serializedUpdate) {
+        os.write(_serializedUpdate->peek(), _serializedUpdate->size());
+    } else {
+        _upd->serializeHEAD(os);
+    }
 }
 
 void
@@ -56,6 +65,14 @@ UpdateOperation::deserializeUpdate(vespalib::nbostream && is, const document::Do
     _upd = (getType() == UPDATE_42)
            ? DocumentUpdate::create42(repo, is)
            : DocumentUpdate::createHEAD(repo, std::move(is));
+    _serializedUpdate.reset();
+}
+
+void
+UpdateOperation::serializeHead(vespalib::nbostream &os) const
+{
+    assertValidBucketId(_upd->getId());
+    DocumentOperation::serialize(os);
 }
 
 void
@@ -90,6 +107,17 @@ UpdateOperation::verifyUpdate(const DocumentTypeRepo &repo)
     _upd->eagerDeserialize();  // Will trigger exceptions if incompatible
 }
 
+void
+UpdateOperation::preSerialize()
+{
+    if (getType() != UPDATE) {
+        return;
+    }
+    auto stream = std::make_unique<vespalib::nbostream>();
+    _upd->serializeHEAD(*stream);
+    _serializedUpdate = std::move(stream);
+}
+
 vespalib::string
 UpdateOperation::toString() const {
     return make_string("%s(%s, %s)",
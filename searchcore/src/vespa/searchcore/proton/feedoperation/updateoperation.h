@@ -15,6 +15,7 @@ class UpdateOperation : public DocumentOperation
 private:
     using DocumentUpdateSP = std::shared_ptr<document::DocumentUpdate>;
     DocumentUpdateSP _upd;
+    std::unique_ptr<vespalib::nbostream> _serializedUpdate; // Set by preSerialize()
     UpdateOperation(Type type, const document::BucketId &bucketId,
                     const storage::spi::Timestamp &timestamp,
                     const DocumentUpdateSP &upd);
@@ -26,11 +27,14 @@ public:
     UpdateOperation(const document::BucketId &bucketId,
                     const storage::spi::Timestamp &timestamp,
                     const DocumentUpdateSP &upd);
-    ~UpdateOperation() override {}
+    ~UpdateOperation() override;
     const DocumentUpdateSP &getUpdate() const { return _upd; }
     void serialize(vespalib::nbostream &os) const override;
     void deserialize(vespalib::nbostream &is, const document::DocumentTypeRepo &repo) override;
     void verifyUpdate(const document::DocumentTypeRepo &repo);
+    void preSerialize() override;
+    const vespalib::nbostream *getPreSerializedTail() const override { return _serializedUpdate.get(); }
+    void serializeHead(vespalib::nbostream &os) const override;
     vespalib::string toString() const override;
 };
 
@@ -25,9 +25,21 @@ convertToSlime(const FlushEngine::FlushMetaSet &flushingTargets,
         object.setString("startTime", target.getStart().toString());
         fastos::TimeStamp elapsedTime = now - target.getStart();
         object.setDouble("elapsedTime", elapsedTime.sec());
+        object.setLong("bytesToWrite", target.getBytesToWrite());
     }
 }
 
+void
+convertToSlime(const FlushEngine::IoStats &stats, Cursor &object)
+{
+    object.setLong("bytesPerSecond", stats.bytesPerSecond);
+    object.setLong("availableBytes", stats.availableBytes);
+    object.setLong("activeBytes", stats.activeBytes);
+    object.setLong("queuedTargets", stats.queuedTargets);
+    object.setLong("queuedBytes", stats.queuedBytes);
+    object.setLong("totalBytes", stats.totalBytes);
+}
+
 void
 sortTargetList(FlushContext::List &allTargets)
 {
@@ -71,6 +83,7 @@ FlushEngineExplorer::get_state(const Inserter &inserter, bool full) const
     if (full) {
         fastos::TimeStamp now = fastos::ClockSystem::now();
         convertToSlime(_engine.getCurrentlyFlushingSet(), now, object.setArray("flushingTargets"));
+        convertToSlime(_engine.getIoStats(), object.setObject("io"));
         FlushContext::List allTargets = _engine.getTargetList(true);
         sortTargetList(allTargets);
         convertToSlime(allTargets, now, object.setArray("allTargets"));
@@ -0,0 +1,79 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "flush_io_budget.h"
+#include <algorithm>
+#include <cmath>
+
+namespace proton {
+namespace flushengine {
+
+FlushIoBudget::FlushIoBudget(uint64_t bytesPerSecond, uint64_t burstBytes, TimePoint now)
+    : _bytesPerSecond(bytesPerSecond),
+      _burstBytes(burstBytes),
+      _tokens(burstBytes),
+      _lastRefill(now),
+      _acquiredBytes(0)
+{
+}
+
+FlushIoBudget::~FlushIoBudget() = default;
+
+void
+FlushIoBudget::refill(TimePoint now)
+{
+    if (now <= _lastRefill) {
+        return;
+    }
+    double elapsed = std::chrono::duration<double>(now - _lastRefill).count();
+    _tokens = std::min(_burstBytes, _tokens + elapsed * _bytesPerSecond);
+    _lastRefill = now;
+}
+
+double
+FlushIoBudget::requiredTokens(uint64_t bytes) const
+{
+    return std::min(static_cast<double>(bytes), _burstBytes);
+}
+
+bool
+FlushIoBudget::canStart(uint64_t bytes, TimePoint now)
+{
+    if (unlimited()) {
+        return true;
+    }
+    refill(now);
+    return _tokens >= requiredTokens(bytes);
+}
+
+void
+FlushIoBudget::acquire(uint64_t bytes, TimePoint now)
+{
+    _acquiredBytes += bytes;
+    if (unlimited()) {
+        return;
+    }
+    refill(now);
+    _tokens -= bytes;
+}
+
+std::chrono::milliseconds
+FlushIoBudget::timeUntilStart(uint64_t bytes, TimePoint now)
+{
+    if (canStart(bytes, now)) {
+        return std::chrono::milliseconds(0);
+    }
+    double seconds = (requiredTokens(bytes) - _tokens) / _bytesPerSecond;
+    return std::chrono::milliseconds(static_cast<int64_t>(std::ceil(seconds * 1000.0)));
+}
+
+int64_t
+FlushIoBudget::getAvailableBytes(TimePoint now)
+{
+    if (!unlimited()) {
+        refill(now);
+    }
+    return _tokens;
+}
+
+} // namespace proton::flushengine
+} // namespace proton
@@ -0,0 +1,71 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace proton {
+namespace flushengine {
+
+/*
+ * Token bucket limiting the rate of bytes written to disk by flushes.
+ *
+ * Tokens (bytes) are added at a fixed rate, up to the burst size. A
+ * flush estimated to write a given number of bytes can start when the
+ * bucket holds that many tokens, or is full if the flush is larger than
+ * the burst size. The bytes are then drawn from the bucket, which can go
+ * into debt that later flushes must wait for. A rate of 0 means no limit.
+ *
+ * This class is not thread safe.
+ */
+class FlushIoBudget
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+
+private:
+    const double _bytesPerSecond;
+    const double _burstBytes;
+    double       _tokens;
+    TimePoint    _lastRefill;
+    uint64_t     _acquiredBytes;
+
+    void refill(TimePoint now);
+    double requiredTokens(uint64_t bytes) const;
+
+public:
+    FlushIoBudget(uint64_t bytesPerSecond, uint64_t burstBytes, TimePoint now);
+    ~FlushIoBudget();
+
+    bool unlimited() const { return _bytesPerSecond <= 0.0; }
+    uint64_t getBytesPerSecond() const { return _bytesPerSecond; }
+    uint64_t getBurstBytes() const { return _burstBytes; }
+
+    /*
+     * Returns true if a flush writing the given number of bytes can
+     * start now.
+     */
+    bool canStart(uint64_t bytes, TimePoint now);
+
+    /*
+     * Draw the given number of bytes from the bucket.
+     */
+    void acquire(uint64_t bytes, TimePoint now);
+
+    /*
+     * Returns the time until a flush writing the given number of bytes
+     * can start.
+     */
+    std::chrono::milliseconds timeUntilStart(uint64_t bytes, TimePoint now);
+
+    /*
+     * Returns the number of tokens in the bucket, negative if in debt.
+     */
+    int64_t getAvailableBytes(TimePoint now);
+
+    uint64_t getAcquiredBytes() const { return _acquiredBytes; }
+};
+
+} // namespace proton::flushengine
+} // namespace proton
@@ -16,6 +16,7 @@ LOG_SETUP(".proton.flushengine.flushengine");
 typedef vespalib::Executor::Task Task;
 using searchcorespi::IFlushTarget;
 using searchcorespi::FlushStats;
+using proton::flushengine::FlushIoBudget;
 using namespace std::chrono_literals;
 
 namespace proton {
@@ -51,15 +52,17 @@ logTarget(const char * text, const FlushContext & ctx) {
 
 }
 
-FlushEngine::FlushMeta::FlushMeta(const vespalib::string & name, fastos::TimeStamp start, uint32_t id)
+FlushEngine::FlushMeta::FlushMeta(const vespalib::string & name, fastos::TimeStamp start, uint32_t id,
+                                  uint64_t bytesToWrite)
     : _name(name),
       _start(start),
-      _id(id)
+      _id(id),
+      _bytesToWrite(bytesToWrite)
 { }
 FlushEngine::FlushMeta::~FlushMeta() = default;
 
 FlushEngine::FlushInfo::FlushInfo()
-    : FlushMeta("", fastos::ClockSystem::now(), 0),
+    : FlushMeta("", fastos::ClockSystem::now(), 0, 0),
       _target()
 {
 }
@@ -67,14 +70,26 @@ FlushEngine::FlushInfo::FlushInfo()
 FlushEngine::FlushInfo::~FlushInfo() = default;
 
 
-FlushEngine::FlushInfo::FlushInfo(uint32_t taskId, const IFlushTarget::SP &target, const vespalib::string & destination)
-    : FlushMeta(destination, fastos::ClockSystem::now(), taskId),
+FlushEngine::FlushInfo::FlushInfo(uint32_t taskId, const IFlushTarget::SP &target, const vespalib::string & destination,
+                                  uint64_t bytesToWrite)
+    : FlushMeta(destination, fastos::ClockSystem::now(), taskId, bytesToWrite),
       _target(target)
 {
 }
 
+FlushEngine::IoStats::IoStats()
+    : bytesPerSecond(0),
+      availableBytes(0),
+      activeBytes(0),
+      queuedTargets(0),
+      queuedBytes(0),
+      totalBytes(0)
+{
+}
+
 FlushEngine::FlushEngine(std::shared_ptr<flushengine::ITlsStatsFactory> tlsStatsFactory,
-                         IFlushStrategy::SP strategy, uint32_t numThreads, uint32_t idleIntervalMS)
+                         IFlushStrategy::SP strategy, uint32_t numThreads, uint32_t idleIntervalMS,
+                         uint64_t ioBytesPerSecond, uint64_t ioBurstBytes)
     : _closed(false),
       _maxConcurrent(numThreads),
       _idleIntervalMS(idleIntervalMS),
@@ -91,7 +106,13 @@ FlushEngine::FlushEngine(std::shared_ptr<flushengine::ITlsStatsFactory> tlsStats
       _strategyLock(),
       _strategyCond(),
       _tlsStatsFactory(std::move(tlsStatsFactory)),
-      _pendingPrune()
+      _pendingPrune(),
+      _ioBudget(ioBytesPerSecond, ioBurstBytes, FlushIoBudget::Clock::now()),
+      _queuedIoTargets(0),
+      _queuedIoBytes(0),
+      _ioWait(0),
+      _ioHeadTarget(),
+      _ioHeadOvertakes(0)
 { }
 
 FlushEngine::~FlushEngine()
@@ -162,7 +183,7 @@ FlushEngine::Run(FastOS_ThreadInterface *, void *)
 {
     bool shouldIdle = false;
     vespalib::string prevFlushName;
-    while (wait(shouldIdle ? _idleIntervalMS : 0)) {
+    while (wait(shouldIdle ? getIdleWaitMS() : 0)) {
         shouldIdle = false;
         if (prune()) {
             continue; // Prune attempted on one or more handlers
@@ -176,7 +197,7 @@ FlushEngine::Run(FastOS_ThreadInterface *, void *)
             shouldIdle = true;
         }
         LOG(debug, "Making another wait(idle=%s, timeMS=%d) last was '%s'",
-            shouldIdle ? "true" : "false", shouldIdle ? _idleIntervalMS : 0, prevFlushName.c_str());
+            shouldIdle ? "true" : "false", shouldIdle ? getIdleWaitMS() : 0, prevFlushName.c_str());
     }
     _executor.sync();
     prune();
@@ -270,7 +291,24 @@ FlushContext::SP
 FlushEngine::initNextFlush(const FlushContext::List &lst)
 {
     FlushContext::SP ctx;
+    const FlushContext *ioHead = nullptr;
+    bool ioHeadBlocks = false;
+    uint32_t delayedTargets = 0;
+    uint64_t delayedBytes = 0;
+    std::chrono::milliseconds ioWait(0);
     for (const FlushContext::SP & it : lst) {
+        uint64_t bytesToWrite = it->getTarget()->getApproxBytesToWriteToDisk();
+        // Once the head target has been overtaken too often, the budget is saved for it.
+        bool blocked = ioHeadBlocks && !it->getTarget()->needUrgentFlush();
+        if (blocked || ! hasIoBudget(*it, bytesToWrite, ioWait)) {
+            ++delayedTargets;
+            delayedBytes += bytesToWrite;
+            if (ioHead == nullptr) {
+                ioHead = it.get();
+                ioHeadBlocks = isIoHeadOvertakenTooOften(it->getName());
+            }
+            continue;
+        }
         if (LOG_WOULD_LOG(event)) {
             EventLogger::flushInit(it->getName());
         }
@@ -279,6 +317,24 @@ FlushEngine::initNextFlush(const FlushContext::List &lst)
             break;
         }
     }
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _queuedIoTargets = delayedTargets;
+        _queuedIoBytes = delayedBytes;
+        _ioWait = ctx ? std::chrono::milliseconds(0) : ioWait;
+        if (ioHead == nullptr) {
+            _ioHeadTarget.clear();
+            _ioHeadOvertakes = 0;
+        } else {
+            if (ioHead->getName() != _ioHeadTarget) {
+                _ioHeadTarget = ioHead->getName();
+                _ioHeadOvertakes = 0;
+            }
+            if (ctx) {
+                ++_ioHeadOvertakes;
+            }
+        }
+    }
     if (ctx) {
         logTarget("initiated", *ctx);
     }
@@ -321,7 +377,7 @@ FlushEngine::flushNextTarget(const vespalib::string & name)
     }
     FlushContext::SP ctx = initNextFlush(lst.first);
     if ( ! ctx) {
-        LOG(debug, "All targets refused to flush.");
+        LOG(debug, "All targets refused to flush or were delayed by the io budget.");
         return "";
     }
     if ( name == ctx->getName()) {
@@ -334,6 +390,46 @@ FlushEngine::flushNextTarget(const vespalib::string & name)
     return ctx->getName();
 }
 
+bool
+FlushEngine::hasIoBudget(const FlushContext &ctx, uint64_t bytesToWrite, std::chrono::milliseconds &ioWait)
+{
+    if (ctx.getTarget()->needUrgentFlush()) {
+        return true;
+    }
+    FlushIoBudget::TimePoint now = FlushIoBudget::Clock::now();
+    std::chrono::milliseconds wait;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        if (_ioBudget.canStart(bytesToWrite, now)) {
+            return true;
+        }
+        wait = _ioBudget.timeUntilStart(bytesToWrite, now);
+    }
+    if (ioWait.count() == 0 || wait < ioWait) {
+        ioWait = wait;
+    }
+    LOG(debug, "Flush of target '%s' (%" PRIu64 " bytes to write) delayed %" PRId64 " ms by io budget.",
+        ctx.getName().c_str(), bytesToWrite, static_cast<int64_t>(wait.count()));
+    return false;
+}
+
+bool
+FlushEngine::isIoHeadOvertakenTooOften(const vespalib::string &name) const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return (name == _ioHeadTarget) && (_ioHeadOvertakes >= MAX_IO_HEAD_OVERTAKES);
+}
+
+uint32_t
+FlushEngine::getIdleWaitMS() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if (_ioWait.count() > 0) {
+        return std::min(static_cast<int64_t>(_idleIntervalMS), static_cast<int64_t>(_ioWait.count()));
+    }
+    return _idleIntervalMS;
+}
+
 uint32_t
 FlushEngine::initFlush(const FlushContext &ctx)
 {
@@ -400,16 +496,34 @@ FlushEngine::getCurrentlyFlushingSet() const
     return s;
 }
 
+FlushEngine::IoStats
+FlushEngine::getIoStats() const
+{
+    IoStats stats;
+    std::lock_guard<std::mutex> guard(_lock);
+    stats.bytesPerSecond = _ioBudget.getBytesPerSecond();
+    stats.availableBytes = _ioBudget.getAvailableBytes(FlushIoBudget::Clock::now());
+    for (const auto & it : _flushing) {
+        stats.activeBytes += it.second.getBytesToWrite();
+    }
+    stats.queuedTargets = _queuedIoTargets;
+    stats.queuedBytes = _queuedIoBytes;
+    stats.totalBytes = _ioBudget.getAcquiredBytes();
+    return stats;
+}
+
 uint32_t
 FlushEngine::initFlush(const IFlushHandler::SP &handler, const IFlushTarget::SP &target)
 {
     uint32_t taskId(0);
+    uint64_t bytesToWrite = target->getApproxBytesToWriteToDisk();
     {
         std::lock_guard<std::mutex> guard(_lock);
         taskId = _taskId++;
         vespalib::string name(FlushContext::createName(*handler, *target));
-        FlushInfo flush(taskId, target, name);
+        FlushInfo flush(taskId, target, name, bytesToWrite);
         _flushing[taskId] = flush;
+        _ioBudget.acquire(bytesToWrite, FlushIoBudget::Clock::now());
     }
     LOG(debug, "FlushEngine::initFlush(handler='%s', target='%s') => taskId='%d'",
         handler->getName().c_str(), target->getName().c_str(), taskId);
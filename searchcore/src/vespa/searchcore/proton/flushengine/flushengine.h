@@ -2,6 +2,7 @@
 #pragma once
 
 #include "flushcontext.h"
+#include "flush_io_budget.h"
 #include "iflushstrategy.h"
 #include <vespa/searchcore/proton/common/handlermap.hpp>
 #include <vespa/searchcore/proton/common/doctypename.h>
@@ -20,24 +21,47 @@ class FlushEngine final : public FastOS_Runnable
 public:
     class FlushMeta {
     public:
-        FlushMeta(const vespalib::string & name, fastos::TimeStamp start, uint32_t id);
+        FlushMeta(const vespalib::string & name, fastos::TimeStamp start, uint32_t id, uint64_t bytesToWrite);
         ~FlushMeta();
         const vespalib::string & getName() const { return _name; }
         fastos::TimeStamp getStart() const { return _start; }
         uint32_t getId() const { return _id; }
+        uint64_t getBytesToWrite() const { return _bytesToWrite; }
         bool operator < (const FlushMeta & rhs) const { return _id < rhs._id; }
     private:
         vespalib::string  _name;
         fastos::TimeStamp _start;
         uint32_t          _id;
+        uint64_t          _bytesToWrite;
     };
     typedef std::set<FlushMeta> FlushMetaSet;
+
+    /**
+     * Estimated bytes written to disk by flushes, and the budget used
+     * to throttle them.
+     */
+    struct IoStats {
+        uint64_t bytesPerSecond; // 0 means no limit
+        int64_t  availableBytes; // negative when flushes have used more than the budget
+        uint64_t activeBytes;    // to be written by ongoing flushes
+        uint32_t queuedTargets;  // targets waiting for budget
+        uint64_t queuedBytes;    // to be written by targets waiting for budget
+        uint64_t totalBytes;     // to be written by all started flushes
+        IoStats();
+    };
+    /**
+     * How many times lower priority targets may be flushed ahead of the
+     * highest priority target delayed by the io budget. After that, only
+     * urgent targets are flushed until it has been started.
+     */
+    static constexpr uint32_t MAX_IO_HEAD_OVERTAKES = 3;
 private:
     using IFlushTarget = searchcorespi::IFlushTarget;
     struct FlushInfo : public FlushMeta
     {
         FlushInfo();
-        FlushInfo(uint32_t taskId, const IFlushTarget::SP &target, const vespalib::string &destination);
+        FlushInfo(uint32_t taskId, const IFlushTarget::SP &target, const vespalib::string &destination,
+                  uint64_t bytesToWrite);
         ~FlushInfo();
 
         IFlushTarget::SP  _target;
@@ -61,10 +85,21 @@ private:
     std::condition_variable        _strategyCond;
     std::shared_ptr<flushengine::ITlsStatsFactory> _tlsStatsFactory;
     std::set<IFlushHandler::SP>    _pendingPrune;
+    mutable flushengine::FlushIoBudget _ioBudget;
+    uint32_t                       _queuedIoTargets;
+    uint64_t                       _queuedIoBytes;
+    std::chrono::milliseconds      _ioWait;
+    // The highest priority target delayed by the io budget, and how many times
+    // other targets have been flushed ahead of it.
+    vespalib::string               _ioHeadTarget;
+    uint32_t                       _ioHeadOvertakes;
 
     FlushContext::List getTargetList(bool includeFlushingTargets) const;
     std::pair<FlushContext::List,bool> getSortedTargetList();
     FlushContext::SP initNextFlush(const FlushContext::List &lst);
+    bool hasIoBudget(const FlushContext &ctx, uint64_t bytesToWrite, std::chrono::milliseconds &ioWait);
+    bool isIoHeadOvertakenTooOften(const vespalib::string &name) const;
+    uint32_t getIdleWaitMS() const;
     vespalib::string flushNextTarget(const vespalib::string & name);
     void flushAll(const FlushContext::List &lst);
     bool prune();
@@ -93,9 +128,13 @@ public:
      * @param strategy   The flushing strategy to use.
      * @param numThreads The number of worker threads to use.
      * @param idleInterval The interval between when flushes are checked whne there are no one progressing.
+     * @param ioBytesPerSecond The max rate of estimated bytes written to disk by flushes, 0 means no limit.
+     *                         Targets needing urgent flush and triggered flushes are not delayed.
+     * @param ioBurstBytes The max estimated bytes that can be written at once before throttling starts.
      */
     FlushEngine(std::shared_ptr<flushengine::ITlsStatsFactory> tlsStatsFactory,
-                IFlushStrategy::SP strategy, uint32_t numThreads, uint32_t idleIntervalMS);
+                IFlushStrategy::SP strategy, uint32_t numThreads, uint32_t idleIntervalMS,
+                uint64_t ioBytesPerSecond = 0, uint64_t ioBurstBytes = 0);
 
     /**
      * Destructor. Waits for all pending tasks to complete.
@@ -158,6 +197,8 @@ public:
 
     FlushMetaSet getCurrentlyFlushingSet() const;
 
+    IoStats getIoStats() const;
+
     void setStrategy(IFlushStrategy::SP strategy);
 };
 
@@ -13,13 +13,21 @@ struct IndexConfig {
     using WarmupConfig = searchcorespi::index::WarmupConfig;
     IndexConfig() : IndexConfig(WarmupConfig(), 2, 0) { }
     IndexConfig(WarmupConfig warmup_, size_t maxFlushed_, size_t cacheSize_)
+        : IndexConfig(warmup_, maxFlushed_, 1, 1, cacheSize_)
+    { }
+    IndexConfig(WarmupConfig warmup_, size_t maxFlushed_, uint32_t maxFusionTiers_,
+                uint32_t fusionThreads_, size_t cacheSize_)
         : warmup(warmup_),
           maxFlushed(maxFlushed_),
+          maxFusionTiers(maxFusionTiers_),
+          fusionThreads(fusionThreads_),
           cacheSize(cacheSize_)
     { }
 
     const WarmupConfig warmup;
     const size_t       maxFlushed;
+    const uint32_t     maxFusionTiers;
+    const uint32_t     fusionThreads;
     const size_t       cacheSize;
 };
 
@@ -37,6 +45,7 @@ public:
         using IDiskIndex = searchcorespi::index::IDiskIndex;
         using IMemoryIndex = searchcorespi::index::IMemoryIndex;
         const size_t _cacheSize;
+        const uint32_t _fusionThreads;
         const search::common::FileHeaderContext &_fileHeaderContext;
         const search::TuneFileIndexing _tuneFileIndexing;
         const search::TuneFileSearch _tuneFileSearch;
@@ -46,6 +55,7 @@ public:
         MaintainerOperations(const search::common::FileHeaderContext &fileHeaderContext,
                              const search::TuneFileIndexManager &tuneFileIndexManager,
                              size_t cacheSize,
+                             uint32_t fusionThreads,
                              searchcorespi::index::IThreadingService &threadingService);
 
         IMemoryIndex::SP createMemoryIndex(const Schema &schema, SerialNum serialNum) override;
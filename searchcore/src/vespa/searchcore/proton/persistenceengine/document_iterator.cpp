@@ -84,6 +84,7 @@ DocumentIterator::DocumentIterator(const storage::spi::Bucket &bucket,
       _defaultSerializedSize((readConsistency == ReadConsistency::WEAK) ? defaultSerializedSize : -1),
       _readConsistency(readConsistency),
       _metaOnly(fields.getType() == document::FieldSet::NONE),
+      _docIdOnly(fields.getType() == document::FieldSet::DOCID),
       _ignoreMaxBytes((readConsistency == ReadConsistency::WEAK) && ignoreMaxBytes),
       _fetchedData(false),
       _sources(),
@@ -161,6 +162,14 @@ public:
 
     bool willAlwaysFail() const { return _willAlwaysFail; }
 
+    /**
+     * True if match(meta) alone decides whether a document matches, i.e. the
+     * selection only references document metadata and single value attributes.
+     */
+    bool decidedByMetaData() const {
+        return (_dscTrue || _metaOnly || _cachedSelect->preDocOnly());
+    }
+
     bool match(const search::DocumentMetaData & meta) const {
         if (meta.lid >= _docidLimit) {
             return false;
@@ -235,6 +244,38 @@ private:
     bool                                     _allowVisitCaching;
 };
 
+/**
+ * Creates id only entries for documents already matched on meta data and attributes.
+ */
+class DocIdVisitor : public search::IDocumentIdVisitor
+{
+public:
+    DocIdVisitor(const search::DocumentMetaData::Vector &metaData, const LidIndexMap &lidIndexMap,
+                 IterateResult::List &list, bool allowVisitCaching) :
+        _metaData(metaData),
+        _lidIndexMap(lidIndexMap),
+        _list(list),
+        _allowVisitCaching(allowVisitCaching)
+    { }
+    void visit(uint32_t lid, const document::DocumentId &id) override {
+        const search::DocumentMetaData & meta = _metaData[_lidIndexMap[lid]];
+        assert(lid == meta.lid);
+        if (id.getGlobalId() == meta.gid) {
+            int flags = meta.removed ? storage::spi::REMOVE_ENTRY : storage::spi::NONE;
+            _list.emplace_back(new DocEntry(meta.timestamp, flags, id));
+        }
+    }
+    bool allowVisitCaching() const override {
+        return _allowVisitCaching;
+    }
+
+private:
+    const search::DocumentMetaData::Vector & _metaData;
+    const LidIndexMap                      & _lidIndexMap;
+    IterateResult::List                    & _list;
+    bool                                     _allowVisitCaching;
+};
+
 }
 
 void
@@ -273,6 +314,12 @@ DocumentIterator::fetchCompleteSource(const IDocumentRetriever & source, Iterate
             assert(lid == meta.lid);
             list.emplace_back(createDocEntry(meta.timestamp, meta.removed));
         }
+    } else if (_docIdOnly && matcher.decidedByMetaData()) {
+        // Selection was fully evaluated against attributes above; only the ids
+        // are read, without deserializing the documents.
+        // Selections referencing other document fields take the path below.
+        DocIdVisitor visitor(metaData, lidIndexMap, list, isWeakRead());
+        source.visitDocumentIds(lidsToFetch, visitor, _readConsistency);
     } else {
         MatchVisitor visitor(matcher, metaData, lidIndexMap, _fields.get(), list, _defaultSerializedSize);
         visitor.allowVisitCaching(isWeakRead());
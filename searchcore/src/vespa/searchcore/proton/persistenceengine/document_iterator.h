@@ -25,6 +25,7 @@ private:
     const ssize_t                         _defaultSerializedSize;
     const ReadConsistency                 _readConsistency;
     const bool                            _metaOnly;
+    const bool                            _docIdOnly;
     const bool                            _ignoreMaxBytes;
     bool                                  _fetchedData;
     std::vector<IDocumentRetriever::SP>   _sources;
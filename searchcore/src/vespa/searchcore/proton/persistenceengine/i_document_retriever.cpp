@@ -6,6 +6,28 @@
 
 namespace proton {
 
+namespace {
+
+class DocumentIdVisitorAdapter : public search::IDocumentVisitor {
+public:
+    DocumentIdVisitorAdapter(search::IDocumentIdVisitor &visitor) : _visitor(visitor) { }
+    void visit(uint32_t lid, DocumentUP doc) override {
+        if (doc) {
+            _visitor.visit(lid, doc->getId());
+        }
+    }
+    bool allowVisitCaching() const override { return _visitor.allowVisitCaching(); }
+private:
+    search::IDocumentIdVisitor &_visitor;
+};
+
+}
+
+void IDocumentRetriever::visitDocumentIds(const LidVector &lids, search::IDocumentIdVisitor &visitor, ReadConsistency readConsistency) const {
+    DocumentIdVisitorAdapter adapter(visitor);
+    visitDocuments(lids, adapter, readConsistency);
+}
+
 void DocumentRetrieverBaseForTest::visitDocuments(const LidVector &lids, search::IDocumentVisitor &visitor, ReadConsistency readConsistency) const {
     (void) readConsistency;
     for (uint32_t lid : lids) {
@@ -45,6 +45,12 @@ public:
      * @param Visitor to receive callback for each document found.
      */
     virtual void visitDocuments(const LidVector &lids, search::IDocumentVisitor &visitor, ReadConsistency readConsistency) const = 0;
+    /**
+     * As visitDocuments, but only the ids of the documents are visited. The
+     * documents are not deserialized, which makes this cheaper when only ids
+     * are needed (e.g. garbage collection).
+     */
+    virtual void visitDocumentIds(const LidVector &lids, search::IDocumentIdVisitor &visitor, ReadConsistency readConsistency) const;
 
     virtual CachedSelect::SP parseSelect(const vespalib::string &selection) const = 0;
 };
@@ -48,6 +48,12 @@ public:
         _commit.commitAndWait();
         _retriever->visitDocuments(lids, visitor, readConsistency);
     }
+    void visitDocumentIds(const LidVector &lids, search::IDocumentIdVisitor &visitor,
+                          ReadConsistency readConsistency) const override
+    {
+        _commit.commitAndWait();
+        _retriever->visitDocumentIds(lids, visitor, readConsistency);
+    }
 
     CachedSelect::SP parseSelect(const vespalib::string &selection) const override {
         return _retriever->parseSelect(selection);
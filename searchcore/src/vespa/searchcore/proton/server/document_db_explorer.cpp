@@ -4,6 +4,7 @@
 
 #include "document_meta_store_read_guards.h"
 #include "document_subdb_collection_explorer.h"
+#include "executor_threading_service_explorer.h"
 #include "maintenance_controller_explorer.h"
 #include <vespa/searchcore/proton/common/state_reporter_utils.h>
 #include <vespa/searchcore/proton/bucketdb/bucket_db_explorer.h>
@@ -45,11 +46,12 @@ const vespalib::string SUB_DB = "subdb";
 const vespalib::string BUCKET_DB = "bucketdb";
 const vespalib::string MAINTENANCE_CONTROLLER = "maintenancecontroller";
 const vespalib::string SESSION = "session";
+const vespalib::string THREADING_SERVICE = "threadingservice";
 
 std::vector<vespalib::string>
 DocumentDBExplorer::get_children_names() const
 {
-    return {SUB_DB, BUCKET_DB, MAINTENANCE_CONTROLLER, SESSION};
+    return {SUB_DB, BUCKET_DB, MAINTENANCE_CONTROLLER, SESSION, THREADING_SERVICE};
 }
 
 std::unique_ptr<StateExplorer>
@@ -68,6 +70,9 @@ DocumentDBExplorer::get_child(vespalib::stringref name) const
     } else if (name == SESSION) {
         return std::unique_ptr<StateExplorer>
             (new matching::SessionManagerExplorer(_docDb->session_manager()));
+    } else if (name == THREADING_SERVICE) {
+        return std::unique_ptr<StateExplorer>
+            (new ExecutorThreadingServiceExplorer(_docDb->getWriteService()));
     }
     return std::unique_ptr<StateExplorer>(nullptr);
 }
@@ -264,6 +264,14 @@ public:
         return *_sessionManager;
     }
 
+    /**
+     * Expose a const view of the write service. This is used by the
+     * document db explorer.
+     **/
+    const ExecutorThreadingService &getWriteService() const {
+        return _writeService;
+    }
+
     /**
      * Frees any allocated resources. This will also stop the internal thread
      * and wait for it to finish. All pending tasks are deleted.
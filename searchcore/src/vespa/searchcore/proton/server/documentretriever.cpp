@@ -129,6 +129,11 @@ void DocumentRetriever::visitDocuments(const LidVector & lids, search::IDocument
     _doc_store.visit(lids, getDocumentTypeRepo(), populater);
 }
 
+void DocumentRetriever::visitDocumentIds(const LidVector & lids, search::IDocumentIdVisitor & visitor, ReadConsistency) const
+{
+    _doc_store.visitDocumentIds(lids, getDocumentTypeRepo(), visitor);
+}
+
 void DocumentRetriever::populate(DocumentIdT lid, Document & doc) const
 {
     for (const auto &field : _attributeFields) {
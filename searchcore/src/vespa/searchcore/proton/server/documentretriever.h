@@ -26,6 +26,7 @@ public:
 
     document::Document::UP getDocument(search::DocumentIdT lid) const override;
     void visitDocuments(const LidVector & lids, search::IDocumentVisitor & visitor, ReadConsistency) const override;
+    void visitDocumentIds(const LidVector & lids, search::IDocumentIdVisitor & visitor, ReadConsistency) const override;
     void populate(search::DocumentIdT lid, document::Document & doc) const;
 private:
     const search::index::Schema     &_schema;
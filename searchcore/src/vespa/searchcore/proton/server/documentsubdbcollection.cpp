@@ -20,12 +20,14 @@ using vespalib::makeLambdaTask;
 namespace proton {
 
 DocumentSubDBCollection::Config::Config(GrowStrategy ready, GrowStrategy notReady, GrowStrategy removed,
-                                        size_t fixedAttributeTotalSkew, size_t numSearchThreads)
+                                        size_t fixedAttributeTotalSkew, size_t numSearchThreads,
+                                        bool gidToLidHash)
     : _readyGrowth(ready),
       _notReadyGrowth(notReady),
       _removedGrowth(removed),
       _fixedAttributeTotalSkew(fixedAttributeTotalSkew),
-      _numSearchThreads(numSearchThreads)
+      _numSearchThreads(numSearchThreads),
+      _gidToLidHash(gidToLidHash)
 { }
 
 DocumentSubDBCollection::DocumentSubDBCollection(
@@ -68,7 +70,7 @@ DocumentSubDBCollection::DocumentSubDBCollection(
                     FastAccessDocSubDB::Config(
                             StoreOnlyDocSubDB::Config(docTypeName, "0.ready", baseDir,
                                     cfg.getReadyGrowth(), cfg.getFixedAttributeTotalSkew(),
-                                    _readySubDbId, SubDbType::READY),
+                                    _readySubDbId, SubDbType::READY, cfg.getGidToLidHash()),
                             true, true, false),
                     cfg.getNumSearchThreads()),
                 SearchableDocSubDB::Context(
@@ -78,7 +80,8 @@ DocumentSubDBCollection::DocumentSubDBCollection(
     _subDBs.push_back
         (new StoreOnlyDocSubDB(
                 StoreOnlyDocSubDB::Config(docTypeName, "1.removed", baseDir, cfg.getRemovedGrowth(),
-                        cfg.getFixedAttributeTotalSkew(), _remSubDbId, SubDbType::REMOVED),
+                        cfg.getFixedAttributeTotalSkew(), _remSubDbId, SubDbType::REMOVED,
+                        cfg.getGidToLidHash()),
                 context));
 
     _subDBs.push_back
@@ -86,7 +89,7 @@ DocumentSubDBCollection::DocumentSubDBCollection(
                 FastAccessDocSubDB::Config(
                         StoreOnlyDocSubDB::Config(docTypeName, "2.notready", baseDir,
                                 cfg.getNotReadyGrowth(), cfg.getFixedAttributeTotalSkew(),
-                                _notReadySubDbId, SubDbType::NOTREADY),
+                                _notReadySubDbId, SubDbType::NOTREADY, cfg.getGidToLidHash()),
                         true, true, true),
                 FastAccessDocSubDB::Context(context, metrics.notReady.attributes, metricsWireService)));
 }
@@ -60,18 +60,20 @@ public:
     public:
         using GrowStrategy = search::GrowStrategy;
         Config(GrowStrategy ready, GrowStrategy notReady, GrowStrategy removed,
-               size_t fixedAttributeTotalSkew, size_t numSearchThreads);
+               size_t fixedAttributeTotalSkew, size_t numSearchThreads, bool gidToLidHash = false);
         GrowStrategy getReadyGrowth() const { return _readyGrowth; }
         GrowStrategy getNotReadyGrowth() const { return _notReadyGrowth; }
         GrowStrategy getRemovedGrowth() const { return _removedGrowth; }
         size_t getNumSearchThreads() const { return _numSearchThreads; }
         size_t getFixedAttributeTotalSkew() const { return _fixedAttributeTotalSkew; }
+        bool getGidToLidHash() const { return _gidToLidHash; }
     private:
         const GrowStrategy _readyGrowth;
         const GrowStrategy _notReadyGrowth;
         const GrowStrategy _removedGrowth;
         const size_t       _fixedAttributeTotalSkew;
         const size_t       _numSearchThreads;
+        const bool         _gidToLidHash;
     };
 
 private:
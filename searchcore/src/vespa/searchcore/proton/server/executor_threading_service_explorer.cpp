@@ -0,0 +1,54 @@
+// Copyright 2019 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "executor_threading_service_explorer.h"
+#include "executorthreadingservice.h"
+#include <vespa/searchlib/common/sequencedtaskexecutor.h>
+#include <vespa/vespalib/data/slime/cursor.h>
+
+using search::SequencedTaskExecutor;
+using vespalib::slime::Cursor;
+using vespalib::slime::Inserter;
+
+namespace proton {
+
+namespace {
+
+void
+convertExecutorLoadsToSlime(const SequencedTaskExecutor &executor, bool full, Cursor &object)
+{
+    object.setLong("rebalances", executor.getRebalanceCount());
+    auto loads = executor.getExecutorLoads();
+    uint64_t executedTasks = 0;
+    double busyTime = 0.0;
+    Cursor *array = full ? &object.setArray("executors") : nullptr;
+    for (const auto &load : loads) {
+        double loadBusyTime = std::chrono::duration<double>(load.busyTime).count();
+        executedTasks += load.executedTasks;
+        busyTime += loadBusyTime;
+        if (array != nullptr) {
+            Cursor &entry = array->addObject();
+            entry.setLong("executedTasks", load.executedTasks);
+            entry.setDouble("busyTime", loadBusyTime);
+        }
+    }
+    object.setLong("executedTasks", executedTasks);
+    object.setDouble("busyTime", busyTime);
+}
+
+}
+
+ExecutorThreadingServiceExplorer::ExecutorThreadingServiceExplorer(const ExecutorThreadingService &service)
+    : _service(service)
+{
+}
+
+void
+ExecutorThreadingServiceExplorer::get_state(const Inserter &inserter, bool full) const
+{
+    Cursor &object = inserter.insertObject();
+    convertExecutorLoadsToSlime(_service.getIndexFieldInverterExecutor(), full, object.setObject("indexFieldInverter"));
+    convertExecutorLoadsToSlime(_service.getIndexFieldWriterExecutor(), full, object.setObject("indexFieldWriter"));
+    convertExecutorLoadsToSlime(_service.getAttributeFieldWriterExecutor(), full, object.setObject("attributeFieldWriter"));
+}
+
+} // namespace proton
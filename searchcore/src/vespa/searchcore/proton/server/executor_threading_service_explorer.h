@@ -0,0 +1,26 @@
+// Copyright 2019 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/net/state_explorer.h>
+
+namespace proton {
+
+class ExecutorThreadingService;
+
+/**
+ * Class used to explore the load of the sequenced executors in the
+ * threading service of a document db.
+ */
+class ExecutorThreadingServiceExplorer : public vespalib::StateExplorer
+{
+private:
+    const ExecutorThreadingService &_service;
+
+public:
+    ExecutorThreadingServiceExplorer(const ExecutorThreadingService &service);
+
+    void get_state(const vespalib::slime::Inserter &inserter, bool full) const override;
+};
+
+} // namespace proton
@@ -59,6 +59,15 @@ public:
     vespalib::ThreadStackExecutorBase &getSummaryExecutor() {
         return _summaryExecutor;
     }
+    const search::SequencedTaskExecutor &getIndexFieldInverterExecutor() const {
+        return *_indexFieldInverter;
+    }
+    const search::SequencedTaskExecutor &getIndexFieldWriterExecutor() const {
+        return *_indexFieldWriter;
+    }
+    const search::SequencedTaskExecutor &getAttributeFieldWriterExecutor() const {
+        return *_attributeFieldWriter;
+    }
 
     /**
      * Implements IThreadingService
@@ -41,14 +41,16 @@ PersistenceHandlerProxy::initialize()
 void
 PersistenceHandlerProxy::handlePut(FeedToken token, const Bucket &bucket, Timestamp timestamp, const DocumentSP &doc)
 {
-    FeedOperation::UP op(new PutOperation(bucket.getBucketId().stripUnused(), timestamp, doc));
+    auto op = std::make_unique<PutOperation>(bucket.getBucketId().stripUnused(), timestamp, doc);
+    op->preSerialize();
     _feedHandler.handleOperation(token, std::move(op));
 }
 
 void
 PersistenceHandlerProxy::handleUpdate(FeedToken token, const Bucket &bucket, Timestamp timestamp, const DocumentUpdateSP &upd)
 {
-    FeedOperation::UP op(new UpdateOperation(bucket.getBucketId().stripUnused(), timestamp, upd));
+    auto op = std::make_unique<UpdateOperation>(bucket.getBucketId().stripUnused(), timestamp, upd);
+    op->preSerialize();
     _feedHandler.handleOperation(token, std::move(op));
 }
 
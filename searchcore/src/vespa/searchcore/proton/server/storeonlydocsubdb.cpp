@@ -61,14 +61,15 @@ IIndexWriter::SP nullIndexWriter;
 StoreOnlyDocSubDB::Config::Config(const DocTypeName &docTypeName, const vespalib::string &subName,
                                   const vespalib::string &baseDir,
                                   const search::GrowStrategy &attributeGrow, size_t attributeGrowNumDocs,
-                                  uint32_t subDbId, SubDbType subDbType)
+                                  uint32_t subDbId, SubDbType subDbType, bool gidToLidHash)
     : _docTypeName(docTypeName),
       _subName(subName),
       _baseDir(baseDir + "/" + subName),
       _attributeGrow(attributeGrow),
       _attributeGrowNumDocs(attributeGrowNumDocs),
       _subDbId(subDbId),
-      _subDbType(subDbType)
+      _subDbType(subDbType),
+      _gidToLidHash(gidToLidHash)
 { }
 StoreOnlyDocSubDB::Config::~Config() = default;
 
@@ -107,6 +108,7 @@ StoreOnlyDocSubDB::StoreOnlyDocSubDB(const Config &cfg, const Context &ctx)
       _metaStoreCtx(),
       _attributeGrow(cfg._attributeGrow),
       _attributeGrowNumDocs(cfg._attributeGrowNumDocs),
+      _gidToLidHash(cfg._gidToLidHash),
       _flushedDocumentMetaStoreSerialNum(0u),
       _flushedDocumentStoreSerialNum(0u),
       _dms(),
@@ -264,8 +266,11 @@ createDocumentMetaStoreInitializer(const search::TuneFileAttributes &tuneFile,
     // make preliminary result visible early, allowing dependent
     // initializers to get hold of document meta store instance in
     // their constructors.
-    *result = std::make_shared<DocumentMetaStoreInitializerResult>
-              (std::make_shared<DocumentMetaStore>(_bucketDB, attrFileName, grow, gidCompare, _subDbType), tuneFile);
+    auto dms = std::make_shared<DocumentMetaStore>(_bucketDB, attrFileName, grow, gidCompare, _subDbType);
+    if (_gidToLidHash) {
+        dms->enableGidToLidHash();
+    }
+    *result = std::make_shared<DocumentMetaStoreInitializerResult>(dms, tuneFile);
     return std::make_shared<documentmetastore::DocumentMetaStoreInitializer>
         (baseDir, getSubDbName(), _docTypeName.toString(), (*result)->documentMetaStore());
 }
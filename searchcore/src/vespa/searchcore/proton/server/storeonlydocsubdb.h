@@ -96,10 +96,12 @@ public:
         const size_t _attributeGrowNumDocs;
         const uint32_t _subDbId;
         const SubDbType _subDbType;
+        const bool _gidToLidHash;
 
         Config(const DocTypeName &docTypeName, const vespalib::string &subName,
                const vespalib::string &baseDir, const search::GrowStrategy &attributeGrow,
-               size_t attributeGrowNumDocs, uint32_t subDbId, SubDbType subDbType);
+               size_t attributeGrowNumDocs, uint32_t subDbId, SubDbType subDbType,
+               bool gidToLidHash = false);
         ~Config();
     };
 
@@ -141,6 +143,7 @@ protected:
     IDocumentMetaStoreContext::SP _metaStoreCtx;
     const search::GrowStrategy    _attributeGrow;
     const size_t                  _attributeGrowNumDocs;
+    const bool                    _gidToLidHash;
     // The following two serial numbers reflect state at program startup
     // and are used by replay logic.
     SerialNum                     _flushedDocumentMetaStoreSerialNum;
@@ -291,7 +291,11 @@ StoreOnlyFeedView::internalPut(FeedToken token, const PutOperation &putOp)
         std::shared_ptr<PutDoneContext> onWriteDone =
             createPutDoneContext(std::move(token), _gidToLidChangeHandler, doc, gid, putOp.getLid(), serialNum,
                                  putOp.changedDbdId() && useDocumentMetaStore(serialNum));
-        putSummary(serialNum, putOp.getLid(), doc, onWriteDone);
+        if (putOp.getSerializedDocument()) {
+            putSummary(serialNum, putOp.getLid(), putOp.getSerializedDocument(), onWriteDone);
+        } else {
+            putSummary(serialNum, putOp.getLid(), doc, onWriteDone);
+        }
         putAttributes(serialNum, putOp.getLid(), *doc, immediateCommit, onWriteDone);
         putIndexedFields(serialNum, putOp.getLid(), doc, immediateCommit, onWriteDone);
     }
@@ -376,6 +380,20 @@ void StoreOnlyFeedView::putSummary(SerialNum serialNum, Lid lid, Document::SP do
             }));
 #pragma GCC diagnostic pop
 }
+void StoreOnlyFeedView::putSummary(SerialNum serialNum, Lid lid, std::shared_ptr<const vespalib::nbostream> serializedDoc,
+                                   OnOperationDoneType onDone)
+{
+    _pendingLidTracker.produce(lid);
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winline" // Avoid spurious inlining warning from GCC related to lambda destructor.
+    summaryExecutor().execute(
+            makeLambdaTask([serialNum, serializedDoc = std::move(serializedDoc), onDone, lid, this] {
+                (void) onDone;
+                _summaryAdapter->put(serialNum, lid, *serializedDoc);
+                _pendingLidTracker.consume(lid);
+            }));
+#pragma GCC diagnostic pop
+}
 void StoreOnlyFeedView::removeSummary(SerialNum serialNum, Lid lid, OnWriteDoneType onDone) {
     _pendingLidTracker.produce(lid);
     summaryExecutor().execute(
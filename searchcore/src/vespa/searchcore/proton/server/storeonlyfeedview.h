@@ -160,6 +160,8 @@ private:
     }
     void putSummary(SerialNum serialNum,  Lid lid, FutureStream doc, OnOperationDoneType onDone);
     void putSummary(SerialNum serialNum,  Lid lid, DocumentSP doc, OnOperationDoneType onDone);
+    void putSummary(SerialNum serialNum,  Lid lid, std::shared_ptr<const vespalib::nbostream> serializedDoc,
+                    OnOperationDoneType onDone);
     void removeSummary(SerialNum serialNum,  Lid lid, OnWriteDoneType onDone);
     void heartBeatSummary(SerialNum serialNum);
 
@@ -12,11 +12,11 @@ using search::transactionlog::Packet;
 namespace proton {
 
 void TlcProxy::commit(search::SerialNum serialNum, search::transactionlog::Type type,
-                      const vespalib::nbostream &buf, DoneCallback onDone)
+                      const vespalib::nbostream &buf, const vespalib::nbostream *tail, DoneCallback onDone)
 {
-    Packet::Entry entry(serialNum, type, vespalib::ConstBufferRef(buf.c_str(), buf.size()));
     Packet packet;
-    packet.add(entry);
+    packet.add(serialNum, type, vespalib::ConstBufferRef(buf.c_str(), buf.size()),
+               (tail != nullptr) ? vespalib::ConstBufferRef(tail->peek(), tail->size()) : vespalib::ConstBufferRef());
     packet.close();
     _tlsDirectWriter.commit(_domain, packet, std::move(onDone));
 }
@@ -25,10 +25,16 @@ void
 TlcProxy::storeOperation(const FeedOperation &op, DoneCallback onDone)
 {
     nbostream stream;
-    op.serialize(stream);
+    // A pre-serialized document is written straight into the packet.
+    const nbostream *tail = op.getPreSerializedTail();
+    if (tail != nullptr) {
+        op.serializeHead(stream);
+    } else {
+        op.serialize(stream);
+    }
     LOG(debug, "storeOperation(): serialNum(%" PRIu64 "), type(%u), size(%zu)",
-        op.getSerialNum(), (uint32_t)op.getType(), stream.size());
-    commit(op.getSerialNum(), (uint32_t)op.getType(), stream, std::move(onDone));
+        op.getSerialNum(), (uint32_t)op.getType(), stream.size() + ((tail != nullptr) ? tail->size() : 0));
+    commit(op.getSerialNum(), (uint32_t)op.getType(), stream, tail, std::move(onDone));
 }
 
 }  // namespace proton
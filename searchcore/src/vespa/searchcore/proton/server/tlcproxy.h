@@ -14,7 +14,7 @@ class TlcProxy {
     Writer            & _tlsDirectWriter;
 
     void commit(search::SerialNum serialNum, search::transactionlog::Type type,
-                const vespalib::nbostream &buf, DoneCallback onDone);
+                const vespalib::nbostream &buf, const vespalib::nbostream *tail, DoneCallback onDone);
 public:
     typedef std::unique_ptr<TlcProxy> UP;
 
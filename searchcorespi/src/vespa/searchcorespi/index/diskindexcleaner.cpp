@@ -4,6 +4,8 @@
 #include "activediskindexes.h"
 #include <vespa/fastos/file.h>
 #include <vespa/vespalib/io/fileutil.h>
+#include <map>
+#include <set>
 #include <sstream>
 #include <vector>
 
@@ -66,14 +68,53 @@ void removeDir(const string &dir) {
     vespalib::rmdir(dir, true);
 }
 
-bool isOldIndex(const string &index, uint32_t last_fusion_id) {
+/**
+ * Returns the tiers following the last fusion index, i.e. the chain
+ * of valid tier indexes where each tier is named by the id of the
+ * index below it and its own id. For each index only the newest tier
+ * on top of it is part of the chain.
+ **/
+std::set<string> findTiers(const string &base_dir, const vector<string> &indexes,
+                           uint32_t last_fusion_id, uint32_t &last_id) {
+    const string prefix = "index.tier.";
+    std::map<uint32_t, std::pair<uint32_t, string>> tiers;
+    for (size_t i = 0; i < indexes.size(); ++i) {
+        if (indexes[i].find(prefix) != 0) {
+            continue;
+        }
+        if (!isValidIndex(base_dir + "/" + indexes[i])) {
+            continue;
+        }
+        uint32_t kept_id = 0;
+        uint32_t id = 0;
+        char dot;
+        istringstream ist(indexes[i].substr(prefix.size()));
+        ist >> kept_id >> dot >> id;
+        auto &tier = tiers[kept_id];
+        if (id > tier.first) {
+            tier = std::make_pair(id, indexes[i]);
+        }
+    }
+    std::set<string> chain;
+    last_id = last_fusion_id;
+    for (auto itr = tiers.find(last_id); itr != tiers.end(); itr = tiers.find(last_id)) {
+        last_id = itr->second.first;
+        chain.insert(itr->second.second);
+    }
+    return chain;
+}
+
+bool isOldIndex(const string &index, uint32_t last_fusion_id,
+                uint32_t last_id, const std::set<string> &tiers) {
     string::size_type pos = index.rfind(".");
     istringstream ist(index.substr(pos + 1));
     uint32_t id = last_fusion_id;
     ist >> id;
     if (id < last_fusion_id) {
         return true;
-    } else if (id == last_fusion_id) {
+    } else if (index.find("tier") != string::npos) {
+        return tiers.find(index) == tiers.end();
+    } else if (id <= last_id) {
         return index.find("flush") != string::npos;
     }
     return false;
@@ -82,9 +123,11 @@ bool isOldIndex(const string &index, uint32_t last_fusion_id) {
 void removeOld(const string &base_dir, const vector<string> &indexes,
                const ActiveDiskIndexes &active_indexes, bool remove) {
     uint32_t last_fusion_id = findLastFusionId(base_dir, indexes);
+    uint32_t last_id = 0;
+    std::set<string> tiers = findTiers(base_dir, indexes, last_fusion_id, last_id);
     for (size_t i = 0; i < indexes.size(); ++i) {
         const string index_dir = base_dir + "/" + indexes[i];
-        if (isOldIndex(indexes[i], last_fusion_id) &&
+        if (isOldIndex(indexes[i], last_fusion_id, last_id, tiers) &&
             !active_indexes.isActive(index_dir))
         {
             if (remove) {
@@ -42,6 +42,9 @@ FusionRunner::~FusionRunner() {
 
 namespace {
 
+// Selector value for documents that are not part of any of the fusion sources.
+constexpr uint8_t NO_SOURCE = 255;
+
 void readSelectorArray(const string &selector_name, SelectorArray &selector_array,
                        const vector<uint8_t> &id_map, uint32_t base_id, uint32_t fusion_id) {
     FixedSourceSelector::UP selector =
@@ -82,6 +85,28 @@ writeFusionSelector(const IndexDiskLayout &diskLayout, uint32_t fusion_id,
     }
     return true;
 }
+
+bool
+writeTierSelector(const IndexDiskLayout &diskLayout, const FusionSpec &fusion_spec, uint32_t fusion_id,
+                  const TuneFileAttributes &tuneFileAttributes,
+                  const FileHeaderContext &fileHeaderContext)
+{
+    const uint32_t base_id = fusion_spec.last_fusion_id;
+    const uint32_t kept_id = fusion_spec.getKeptId();
+    const string flush_selector_name = IndexDiskLayout::getSelectorFileName(diskLayout.getFlushDir(fusion_id));
+    FixedSourceSelector::UP selector = FixedSourceSelector::load(flush_selector_name, fusion_id);
+    if (base_id != selector->getBaseId()) {
+        selector = selector->cloneAndSubtract("tmp_for_fusion", base_id - selector->getBaseId());
+    }
+    selector = selector->cloneAndMerge("tier_selector", kept_id - base_id + 1, fusion_id - base_id);
+    string selector_name = IndexDiskLayout::getSelectorFileName(diskLayout.getTierDir(kept_id, fusion_id));
+    if (!selector->extractSaveInfo(selector_name)->save(tuneFileAttributes, fileHeaderContext)) {
+        LOG(warning, "Unable to write source selector data for tier.%u.%u.", kept_id, fusion_id);
+        return false;
+    }
+    return true;
+}
+
 }  // namespace
 
 uint32_t
@@ -94,16 +119,27 @@ FusionRunner::fuse(const FusionSpec &fusion_spec,
         return 0;
     }
     const uint32_t fusion_id = ids.back();
-    const string fusion_dir = _diskLayout.getFusionDir(fusion_id);
+    const uint32_t base_id = fusion_spec.last_fusion_id;
+    const uint32_t kept_id = fusion_spec.getKeptId();
+    const string fusion_dir = _diskLayout.getFusionOutputDir(kept_id, fusion_id);
 
     vector<string> sources;
-    vector<uint8_t> id_map(fusion_id + 1);
-    if (fusion_spec.last_fusion_id != 0) {
-        id_map[0] = sources.size();
-        sources.push_back(_diskLayout.getFusionDir(fusion_spec.last_fusion_id));
+    // Documents selecting a source in a kept tier are left out of a tier fusion.
+    vector<uint8_t> id_map(fusion_id + 1, (kept_id != 0) ? NO_SOURCE : 0);
+    const vector<uint32_t> fusion_ids = fusion_spec.getFusionIds();
+    uint32_t prev_id = 0;
+    for (size_t i = 0; i < fusion_ids.size(); ++i) {
+        const uint32_t id = fusion_ids[i];
+        if (i >= fusion_spec.kept_tiers) {
+            // A fusioned index owns the documents selecting any of the indexes it replaced.
+            const uint32_t first = (i == 0) ? 0 : prev_id - base_id + 1;
+            std::fill(id_map.begin() + first, id_map.begin() + (id - base_id + 1), sources.size());
+            sources.push_back((i == 0) ? _diskLayout.getFusionDir(id) : _diskLayout.getTierDir(prev_id, id));
+        }
+        prev_id = id;
     }
     for (size_t i = 0; i < ids.size(); ++i) {
-        id_map[ids[i] - fusion_spec.last_fusion_id] = sources.size();
+        id_map[ids[i] - base_id] = sources.size();
         sources.push_back(_diskLayout.getFlushDir(ids[i]));
     }
 
@@ -115,16 +151,22 @@ FusionRunner::fuse(const FusionSpec &fusion_spec,
 
     const string selector_name = IndexDiskLayout::getSelectorFileName(_diskLayout.getFlushDir(fusion_id));
     SelectorArray selector_array;
-    readSelectorArray(selector_name, selector_array, id_map, fusion_spec.last_fusion_id, fusion_id);
+    readSelectorArray(selector_name, selector_array, id_map, base_id, fusion_id);
 
     if (!operations.runFusion(_schema, fusion_dir, sources, selector_array, lastSerialNum)) {
         return 0;
     }
 
-    const uint32_t highest_doc_id = selector_array.size() - 1;
     SerialNumFileHeaderContext fileHeaderContext(_fileHeaderContext, lastSerialNum);
-    if (!writeFusionSelector(_diskLayout, fusion_id, highest_doc_id, _tuneFileAttributes, fileHeaderContext)) {
-        return 0;
+    if (kept_id != 0) {
+        if (!writeTierSelector(_diskLayout, fusion_spec, fusion_id, _tuneFileAttributes, fileHeaderContext)) {
+            return 0;
+        }
+    } else {
+        const uint32_t highest_doc_id = selector_array.size() - 1;
+        if (!writeFusionSelector(_diskLayout, fusion_id, highest_doc_id, _tuneFileAttributes, fileHeaderContext)) {
+            return 0;
+        }
     }
 
     if (LOG_WOULD_LOG(event)) {
@@ -28,6 +28,8 @@ struct FusionSpec;
  * vector of ids. The disk indexes must be stored in directories named
  * "index.flush.<id>" within the base dir, and the fusioned indexes
  * will be stored similarly in directories named "index.fusion.<id>".
+ * When the fusion spec keeps some of the fusioned indexes, the output
+ * is a tier stored in "index.tier.<kept id>.<id>".
  **/
 class FusionRunner {
     const IndexDiskLayout _diskLayout;
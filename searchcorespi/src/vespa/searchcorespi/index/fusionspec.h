@@ -10,13 +10,54 @@ namespace searchcorespi::index {
 /**
  * Specifies a set of disk index ids for fusion.
  *
+ * The fusioned disk indexes form a chain, starting with the fusion
+ * index given by last_fusion_id, followed by the tiers in tier_ids
+ * (oldest first). Each tier contains the documents from the flushed
+ * indexes after the previous index in the chain. The flushed indexes
+ * in flush_ids are newer than all fusioned indexes.
+ *
+ * When running fusion, kept_tiers specifies how many of the indexes
+ * in the chain (counting from the start) that are left as they are.
+ * The remaining indexes in the chain and the flushed indexes are
+ * fusioned into a new tier. When kept_tiers is 0, all indexes are
+ * fusioned into a new fusion index.
+ *
  * Note: All ids in FusionSpec are absolute ids.
  **/
 struct FusionSpec {
     uint32_t last_fusion_id;
+    std::vector<uint32_t> tier_ids;
     std::vector<uint32_t> flush_ids;
+    uint32_t kept_tiers;
+
+    FusionSpec() : last_fusion_id(0), tier_ids(), flush_ids(), kept_tiers(0) {}
+
+    /**
+     * Returns the ids of the fusioned indexes in the chain, oldest first.
+     **/
+    std::vector<uint32_t> getFusionIds() const {
+        std::vector<uint32_t> ids;
+        if (last_fusion_id != 0) {
+            ids.push_back(last_fusion_id);
+        }
+        ids.insert(ids.end(), tier_ids.begin(), tier_ids.end());
+        return ids;
+    }
+
+    /**
+     * Returns the id of the newest fusioned index, or 0 if none.
+     **/
+    uint32_t getLastFusedId() const {
+        return tier_ids.empty() ? last_fusion_id : tier_ids.back();
+    }
 
-    FusionSpec() : last_fusion_id(0), flush_ids() {}
+    /**
+     * Returns the id of the newest index left as it is when running
+     * fusion, or 0 if all indexes are fusioned.
+     **/
+    uint32_t getKeptId() const {
+        return (kept_tiers != 0) ? getFusionIds()[kept_tiers - 1] : 0;
+    }
 };
 
 }
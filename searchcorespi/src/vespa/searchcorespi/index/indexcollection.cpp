@@ -59,6 +59,32 @@ IndexCollection::replaceAndRenumber(const ISourceSelector::SP & selector,
     return new_fsc;
 }
 
+ISearchableIndexCollection::UP
+IndexCollection::replaceAndMerge(const ISourceSelector::SP & selector,
+                                 const ISearchableIndexCollection &fsc,
+                                 uint32_t first_id,
+                                 uint32_t last_id,
+                                 const IndexSearchable::SP &new_source)
+{
+    ISearchableIndexCollection::UP new_fsc(new IndexCollection(selector));
+    bool appended = false;
+    for (size_t i = 0; i < fsc.getSourceCount(); ++i) {
+        uint32_t id = fsc.getSourceId(i);
+        if (id < first_id || id > last_id) {
+            if (id > last_id && !appended) {
+                new_fsc->append(last_id, new_source);
+                appended = true;
+            }
+            new_fsc->append(id, fsc.getSearchableSP(i));
+        }
+    }
+    if (!appended) {
+        new_fsc->append(last_id, new_source);
+    }
+    new_fsc->setCurrentIndex(fsc.getCurrentIndex());
+    return new_fsc;
+}
+
 void
 IndexCollection::append(uint32_t id, const IndexSearchable::SP &fs)
 {
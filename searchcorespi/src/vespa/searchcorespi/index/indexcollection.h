@@ -57,6 +57,15 @@ public:
     static ISearchableIndexCollection::UP
     replaceAndRenumber(const ISourceSelectorSP & selector, const ISearchableIndexCollection &fsc,
                        uint32_t id_diff, const IndexSearchable::SP &new_source);
+
+    /**
+     * Creates a copy of the collection where the sources with ids in
+     * the range [first_id, last_id] are replaced by new_source, using
+     * last_id as its id.
+     */
+    static ISearchableIndexCollection::UP
+    replaceAndMerge(const ISourceSelectorSP & selector, const ISearchableIndexCollection &fsc,
+                    uint32_t first_id, uint32_t last_id, const IndexSearchable::SP &new_source);
 };
 
 }  // namespace searchcorespi
@@ -11,6 +11,9 @@ IndexDiskLayout::FlushDirPrefix = vespalib::string("index.flush.");
 const vespalib::string
 IndexDiskLayout::FusionDirPrefix = vespalib::string("index.fusion.");
 
+const vespalib::string
+IndexDiskLayout::TierDirPrefix = vespalib::string("index.tier.");
+
 const vespalib::string
 IndexDiskLayout::SerialNumTag = vespalib::string("Serial num");
 
@@ -35,6 +38,20 @@ IndexDiskLayout::getFusionDir(uint32_t sourceId) const
     return ost.str();
 }
 
+vespalib::string
+IndexDiskLayout::getTierDir(uint32_t keptId, uint32_t sourceId) const
+{
+    std::ostringstream ost;
+    ost << _baseDir << "/" << TierDirPrefix << keptId << "." << sourceId;
+    return ost.str();
+}
+
+vespalib::string
+IndexDiskLayout::getFusionOutputDir(uint32_t keptId, uint32_t sourceId) const
+{
+    return (keptId != 0) ? getTierDir(keptId, sourceId) : getFusionDir(sourceId);
+}
+
 vespalib::string
 IndexDiskLayout::getSerialNumFileName(const vespalib::string &dir)
 {
@@ -14,6 +14,7 @@ class IndexDiskLayout {
 public:
     static const vespalib::string FlushDirPrefix;
     static const vespalib::string FusionDirPrefix;
+    static const vespalib::string TierDirPrefix;
     static const vespalib::string SerialNumTag;
 
 private:
@@ -23,6 +24,13 @@ public:
     IndexDiskLayout(const vespalib::string &baseDir);
     vespalib::string getFlushDir(uint32_t sourceId) const;
     vespalib::string getFusionDir(uint32_t sourceId) const;
+    vespalib::string getTierDir(uint32_t keptId, uint32_t sourceId) const;
+
+    /**
+     * Returns the directory for the output of a fusion. A fusion that
+     * leaves older indexes as they are (keptId != 0) produces a tier.
+     */
+    vespalib::string getFusionOutputDir(uint32_t keptId, uint32_t sourceId) const;
 
     static vespalib::string getSerialNumFileName(const vespalib::string &dir);
     static vespalib::string getSchemaFileName(const vespalib::string &dir);
@@ -99,7 +99,7 @@ IndexFusionTarget::initFlush(SerialNum serialNum)
 uint64_t
 IndexFusionTarget::getApproxBytesToWriteToDisk() const
 {
-    return _fusionStats.diskUsage;
+    return _fusionStats.bytesToWrite;
 }
 
 
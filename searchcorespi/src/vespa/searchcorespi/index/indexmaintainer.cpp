@@ -14,6 +14,7 @@
 #include <vespa/vespalib/util/autoclosurecaller.h>
 #include <vespa/vespalib/util/closuretask.h>
 #include <vespa/vespalib/util/lambdatask.h>
+#include <map>
 #include <sstream>
 #include <vespa/searchcorespi/flush/closureflushtask.h>
 #include <vespa/vespalib/io/fileutil.h>
@@ -161,6 +162,12 @@ IndexMaintainer::getFusionDir(uint32_t sourceId) const
     return _layout.getFusionDir(sourceId);
 }
 
+string
+IndexMaintainer::getFusionOutputDir(const FusionSpec &spec) const
+{
+    return _layout.getFusionOutputDir(spec.getKeptId(), spec.flush_ids.back());
+}
+
 bool
 IndexMaintainer::reopenDiskIndexes(ISearchableIndexCollection &coll)
 {
@@ -334,6 +341,11 @@ IndexMaintainer::loadDiskIndexes(const FusionSpec &spec, ISearchableIndexCollect
     if (fusion_id != 0) {
         sourceList->append(0, loadDiskIndex(getFusionDir(fusion_id)));
     }
+    uint32_t kept_id = fusion_id;
+    for (uint32_t id : spec.tier_ids) {
+        sourceList->append(id - fusion_id, loadDiskIndex(_layout.getTierDir(kept_id, id)));
+        kept_id = id;
+    }
     for (size_t i = 0; i < spec.flush_ids.size(); ++i) {
         const uint32_t id = spec.flush_ids[i];
         const uint32_t relative_id = id - fusion_id;
@@ -635,6 +647,40 @@ IndexMaintainer::canRunFusion(const FusionSpec &spec) const
         (spec.flush_ids.size() > 0 && spec.last_fusion_id != 0);
 }
 
+uint32_t
+IndexMaintainer::selectKeptTiers(const FusionSpec &spec, uint64_t &bytesToWrite) const
+{
+    ISearchableIndexCollection::SP source_list;
+    {
+        LockGuard lock(_new_search_lock);
+        source_list = _source_list;
+    }
+    std::map<uint32_t, uint64_t> sizes;
+    for (uint32_t i = 0; i < source_list->getSourceCount(); ++i) {
+        sizes[source_list->getSourceId(i)] = source_list->getSearchable(i).getSearchableStats().sizeOnDisk();
+    }
+    std::vector<uint64_t> tierSizes;
+    for (uint32_t id : spec.getFusionIds()) {
+        tierSizes.push_back(sizes[id - spec.last_fusion_id]);
+    }
+    uint64_t flushedSize = 0;
+    for (uint32_t id : spec.flush_ids) {
+        flushedSize += sizes[id - spec.last_fusion_id];
+    }
+    uint32_t keptTiers = _fusionPolicy.selectKeptTiers(tierSizes, flushedSize);
+    if (!spec.flush_ids.empty() &&
+        spec.flush_ids.back() - spec.last_fusion_id >= ISourceSelector::SOURCE_LIMIT / 2)
+    {
+        // Source ids are only renumbered by a full fusion
+        keptTiers = 0;
+    }
+    bytesToWrite = flushedSize;
+    for (size_t i = keptTiers; i < tierSizes.size(); ++i) {
+        bytesToWrite += tierSizes[i];
+    }
+    return keptTiers;
+}
+
 bool
 IndexMaintainer::doneFusion(FusionArgs *args, IDiskIndex::SP *new_index)
 {
@@ -648,6 +694,9 @@ IndexMaintainer::doneFusion(FusionArgs *args, IDiskIndex::SP *new_index)
         return false;    // Must retry operation
     }
     args->_old_source_list = _source_list; // delays destruction
+    if (args->_kept_id != 0) {
+        return doneTierFusion(args, new_index);
+    }
     uint32_t id_diff = args->_new_fusion_id - _last_fusion_id;
     ostringstream ost;
     ost << "sourceselector_fusion(" << args->_new_fusion_id << ")";
@@ -680,6 +729,39 @@ IndexMaintainer::doneFusion(FusionArgs *args, IDiskIndex::SP *new_index)
     return true;
 }
 
+bool
+IndexMaintainer::doneTierFusion(FusionArgs *args, IDiskIndex::SP *new_index)
+{
+    // Called by doneFusion, caller holds SL
+    uint32_t first_id = args->_kept_id - _last_fusion_id + 1;
+    uint32_t last_id = args->_new_fusion_id - _last_fusion_id;
+    ostringstream ost;
+    ost << "sourceselector_tier(" << args->_new_fusion_id << ")";
+    {
+        LockGuard lock(_index_update_lock);
+
+        // make new source selector where documents in the fusioned indexes select the new tier.
+        _selector.reset(getSourceSelector().cloneAndMerge(ost.str(), first_id, last_id).release());
+        _activeFusionSchema.reset();
+        _activeFusionPrunedSchema.reset();
+    }
+
+    ISearchableIndexCollection::SP currentLeaf;
+    {
+        LockGuard lock(_new_search_lock);
+        currentLeaf = getLeaf(lock, _source_list);
+    }
+    ISearchableIndexCollection::UP fsc =
+        IndexCollection::replaceAndMerge(_selector, *currentLeaf, first_id, last_id, *new_index);
+    fsc->setCurrentIndex(_current_index_id);
+
+    {
+        LockGuard lock(_new_search_lock);
+        swapInNewIndex(lock, std::move(fsc), **new_index);
+    }
+    return true;
+}
+
 bool
 IndexMaintainer::makeSureAllRemainingWarmupIsDone(ISearchableIndexCollection::SP keepAlive)
 {
@@ -827,6 +909,7 @@ IndexMaintainer::IndexMaintainer(const IndexMaintainerConfig &config,
       _remove_lock(),
       _fusion_spec(),
       _fusion_lock(),
+      _fusionPolicy(config.getMaxFusionTiers()),
       _maxFlushed(config.getMaxFlushed()),
       _maxFrozen(10),
       _changeGens(),
@@ -839,13 +922,19 @@ IndexMaintainer::IndexMaintainer(const IndexMaintainerConfig &config,
     _changeGens.bumpPruneGen();
     DiskIndexCleaner::clean(_base_dir, *_active_indexes);
     FusionSpec spec = IndexReadUtilities::readFusionSpec(_base_dir);
-    _next_id = 1 + (spec.flush_ids.empty() ? spec.last_fusion_id : spec.flush_ids.back());
+    _next_id = 1 + (spec.flush_ids.empty() ? spec.getLastFusedId() : spec.flush_ids.back());
     _last_fusion_id = spec.last_fusion_id;
 
     if (_next_id > 1) {
-        string latest_index_dir = spec.flush_ids.empty()
-                                  ? getFusionDir(_next_id - 1)
-                                  : getFlushDir(_next_id - 1);
+        string latest_index_dir;
+        if (!spec.flush_ids.empty()) {
+            latest_index_dir = getFlushDir(_next_id - 1);
+        } else if (!spec.tier_ids.empty()) {
+            std::vector<uint32_t> fusion_ids = spec.getFusionIds();
+            latest_index_dir = _layout.getTierDir(fusion_ids[fusion_ids.size() - 2], _next_id - 1);
+        } else {
+            latest_index_dir = getFusionDir(_next_id - 1);
+        }
 
         _flush_serial_num = IndexReadUtilities::readSerialNum(latest_index_dir);
         _lastFlushTime = search::FileKit::getModificationTime(latest_index_dir);
@@ -865,6 +954,15 @@ IndexMaintainer::IndexMaintainer(const IndexMaintainerConfig &config,
         _selector.reset(getSourceSelector().cloneAndSubtract(ost.str(), id_diff).release());
         assert(_last_fusion_id == _selector->getBaseId());
     }
+    uint32_t kept_id = _last_fusion_id;
+    for (uint32_t id : spec.tier_ids) {
+        // The selector might have been saved before the tier was fusioned
+        ostringstream ost;
+        ost << "sourceselector_tier(" << id << ")";
+        _selector.reset(getSourceSelector().cloneAndMerge(ost.str(), kept_id - _last_fusion_id + 1,
+                                                          id - _last_fusion_id).release());
+        kept_id = id;
+    }
     _current_index = operations.createMemoryIndex(_schema, _current_serial_num);
     _current_index_id = getNewAbsoluteId() - _last_fusion_id;
     assert(_current_index_id < ISourceSelector::SOURCE_LIMIT);
@@ -950,6 +1048,8 @@ IndexMaintainer::doFusion(SerialNum serialNum)
         spec = _fusion_spec;
         _fusion_spec.flush_ids.clear();
     }
+    uint64_t bytesToWrite = 0;
+    spec.kept_tiers = selectKeptTiers(spec, bytesToWrite);
 
     uint32_t new_fusion_id = runFusion(spec);
 
@@ -959,10 +1059,16 @@ IndexMaintainer::doFusion(SerialNum serialNum)
         // Restore fusion spec.
         copy(_fusion_spec.flush_ids.begin(), _fusion_spec.flush_ids.end(), back_inserter(spec.flush_ids));
         _fusion_spec.flush_ids.swap(spec.flush_ids);
-    } else {
+        return getFusionDir(new_fusion_id);
+    } else if (spec.kept_tiers == 0) {
         _fusion_spec.last_fusion_id = new_fusion_id;
+        _fusion_spec.tier_ids.clear();
+    } else {
+        // The fusion index itself is the first kept tier
+        _fusion_spec.tier_ids.resize(spec.kept_tiers - 1);
+        _fusion_spec.tier_ids.push_back(new_fusion_id);
     }
-    return getFusionDir(new_fusion_id);
+    return getFusionOutputDir(spec);
 }
 
 
@@ -988,14 +1094,15 @@ IndexMaintainer::runFusion(const FusionSpec &fusion_spec)
     }
     FusionRunner fusion_runner(_base_dir, args._schema, tuneFileAttributes, _ctx.getFileHeaderContext());
     uint32_t new_fusion_id = fusion_runner.fuse(fusion_spec, serialNum, _operations);
+    const string new_fusion_dir = getFusionOutputDir(fusion_spec);
     bool ok = (new_fusion_id != 0);
     if (ok) {
         ok = IndexWriteUtilities::copySerialNumFile(getFlushDir(fusion_spec.flush_ids.back()),
-                                                    getFusionDir(new_fusion_id));
+                                                    new_fusion_dir);
     }
     if (!ok) {
         LOG(error, "Fusion failed.");
-        string fail_dir = getFusionDir(fusion_spec.flush_ids.back());
+        string fail_dir = new_fusion_dir;
         FastOS_FileInterface::EmptyAndRemoveDirectory(fail_dir.c_str());
         {
             LockGuard slock(_state_lock);
@@ -1007,7 +1114,6 @@ IndexMaintainer::runFusion(const FusionSpec &fusion_spec)
         return fusion_spec.last_fusion_id;
     }
 
-    const string new_fusion_dir = getFusionDir(new_fusion_id);
     Schema::SP prunedSchema = getActiveFusionPrunedSchema();
     if (prunedSchema) {
         updateDiskIndexSchema(new_fusion_dir, *prunedSchema, noSerialNumHigh);
@@ -1019,6 +1125,7 @@ IndexMaintainer::runFusion(const FusionSpec &fusion_spec)
     // index has been opened.
 
     args._new_fusion_id = new_fusion_id;
+    args._kept_id = fusion_spec.getKeptId();
     args._changeGens = changeGens;
     args._prunedSchema = prunedSchema;
     for (;;) {
@@ -1093,11 +1200,15 @@ IndexMaintainer::getFusionStats() const
         stats.maxFlushed = _maxFlushed;
     }
     stats.diskUsage = source_list->getSearchableStats().sizeOnDisk();
+    FusionSpec spec;
     {
         LockGuard guard(_fusion_lock);
-        stats.numUnfused = _fusion_spec.flush_ids.size() + ((_fusion_spec.last_fusion_id != 0) ? 1 : 0);
-        stats._canRunFusion = canRunFusion(_fusion_spec);
+        spec = _fusion_spec;
     }
+    // Count the disk indexes that the next fusion would fusion, i.e. not the kept tiers
+    spec.kept_tiers = selectKeptTiers(spec, stats.bytesToWrite);
+    stats.numUnfused = spec.flush_ids.size() + spec.getFusionIds().size() - spec.kept_tiers;
+    stats._canRunFusion = canRunFusion(spec);
     LOG(debug, "Get fusion stats. Disk usage: %" PRIu64 ", maxflushed: %d", stats.diskUsage, stats.maxFlushed);
     return stats;
 }
@@ -14,6 +14,7 @@
 #include "ithreadingservice.h"
 #include "indexsearchable.h"
 #include "indexcollection.h"
+#include "tiered_fusion_policy.h"
 #include <vespa/searchcorespi/flush/iflushtarget.h>
 #include <vespa/searchcorespi/flush/flushstats.h>
 #include <vespa/searchlib/attribute/fixedsourceselector.h>
@@ -144,6 +145,7 @@ class IndexMaintainer : public IIndexManager,
     // Protected by SL + IUL
     FusionSpec     _fusion_spec;		// Protected by FL
     vespalib::Lock _fusion_lock;	// Fusion spec lock (FL)
+    const TieredFusionPolicy _fusionPolicy;
     uint32_t       _maxFlushed;
     uint32_t       _maxFrozen;
     ChangeGens     _changeGens; // Protected by SL + IUL
@@ -157,6 +159,7 @@ class IndexMaintainer : public IIndexManager,
     uint32_t getNewAbsoluteId();
     vespalib::string getFlushDir(uint32_t sourceId) const;
     vespalib::string getFusionDir(uint32_t sourceId) const;
+    vespalib::string getFusionOutputDir(const FusionSpec &spec) const;
 
     /**
      * Will reopen diskindexes if necessary due to schema changes.
@@ -233,6 +236,7 @@ class IndexMaintainer : public IIndexManager,
     {
     public:
         uint32_t   _new_fusion_id;
+        uint32_t   _kept_id;    // Newest index kept as it is, 0 for a full fusion
         ChangeGens _changeGens;
         Schema     _schema;
         Schema::SP _prunedSchema;
@@ -240,6 +244,7 @@ class IndexMaintainer : public IIndexManager,
 
         FusionArgs()
             : _new_fusion_id(0u),
+              _kept_id(0u),
               _changeGens(),
               _schema(),
               _prunedSchema(),
@@ -251,7 +256,9 @@ class IndexMaintainer : public IIndexManager,
     IFlushTarget::SP getFusionTarget();
     void scheduleFusion(const FlushIds &flushIds);
     bool canRunFusion(const FusionSpec &spec) const;
+    uint32_t selectKeptTiers(const FusionSpec &spec, uint64_t &bytesToWrite) const;
     bool doneFusion(FusionArgs *args, IDiskIndex::SP *new_index);
+    bool doneTierFusion(FusionArgs *args, IDiskIndex::SP *new_index);
 
     class SetSchemaArgs
     {
@@ -332,12 +339,14 @@ public:
             : diskUsage(0),
               maxFlushed(0),
               numUnfused(0),
+              bytesToWrite(0),
               _canRunFusion(false)
         { }
 
         uint64_t diskUsage;
         uint32_t maxFlushed;
         uint32_t numUnfused;
+        uint64_t bytesToWrite;
         bool _canRunFusion;
     };
 
@@ -3,7 +3,9 @@
 #include "indexreadutilities.h"
 #include "indexdisklayout.h"
 #include <vespa/fastlib/io/bufferedfile.h>
+#include <vespa/fastos/file.h>
 #include <vespa/vespalib/data/fileheader.h>
+#include <map>
 #include <set>
 #include <vector>
 
@@ -23,7 +25,8 @@ namespace {
 void
 scanForIndexes(const vespalib::string &baseDir,
                std::vector<vespalib::string> &flushDirs,
-               vespalib::string &fusionDir)
+               vespalib::string &fusionDir,
+               std::vector<vespalib::string> &tierDirs)
 {
     FastOS_DirectoryScan dirScan(baseDir.c_str());
     while (dirScan.ReadNext()) {
@@ -42,9 +45,45 @@ scanForIndexes(const vespalib::string &baseDir,
             }
             fusionDir = name;
         }
+        if (name.find(IndexDiskLayout::TierDirPrefix) == 0) {
+            tierDirs.push_back(name);
+        }
     }
 }
 
+bool
+isValidIndex(const vespalib::string &indexDir)
+{
+    FastOS_File serialFile(IndexDiskLayout::getSerialNumFileName(indexDir).c_str());
+    return serialFile.OpenReadOnlyExisting();
+}
+
+/**
+ * Returns the tiers following the fusion index, oldest first. Each
+ * tier dir is named by the id of the index below it and its own id.
+ * Tiers without a serial number file are incomplete and not used.
+ **/
+std::vector<uint32_t>
+selectTierIds(const vespalib::string &baseDir, uint32_t fusionId, const std::vector<vespalib::string> &tierDirs)
+{
+    std::map<uint32_t, uint32_t> tiers;
+    for (const auto &tierDir : tierDirs) {
+        if (!isValidIndex(baseDir + "/" + tierDir)) {
+            continue;
+        }
+        vespalib::string ids = tierDir.substr(IndexDiskLayout::TierDirPrefix.size());
+        uint32_t keptId = atoi(ids.c_str());
+        uint32_t id = atoi(ids.substr(ids.find('.') + 1).c_str());
+        uint32_t &newest = tiers[keptId];
+        newest = std::max(newest, id);
+    }
+    std::vector<uint32_t> tierIds;
+    for (auto itr = tiers.find(fusionId); itr != tiers.end(); itr = tiers.find(itr->second)) {
+        tierIds.push_back(itr->second);
+    }
+    return tierIds;
+}
+
 }
 
 FusionSpec
@@ -52,20 +91,23 @@ IndexReadUtilities::readFusionSpec(const vespalib::string &baseDir)
 {
     std::vector<vespalib::string> flushDirs;
     vespalib::string fusionDir;
-    scanForIndexes(baseDir, flushDirs, fusionDir);
+    std::vector<vespalib::string> tierDirs;
+    scanForIndexes(baseDir, flushDirs, fusionDir, tierDirs);
 
     uint32_t fusionId = 0;
     if (!fusionDir.empty()) {
         fusionId = atoi(fusionDir.substr(IndexDiskLayout::FusionDirPrefix.size()).c_str());
     }
+    FusionSpec fusionSpec;
+    fusionSpec.last_fusion_id = fusionId;
+    fusionSpec.tier_ids = selectTierIds(baseDir, fusionId, tierDirs);
     std::set<uint32_t> flushIds;
     for (size_t i = 0; i < flushDirs.size(); ++i) {
         uint32_t id = atoi(flushDirs[i].substr(IndexDiskLayout::FlushDirPrefix.size()).c_str());
-        flushIds.insert(id);
+        if (id > fusionSpec.getLastFusedId()) {
+            flushIds.insert(id);
+        }
     }
-
-    FusionSpec fusionSpec;
-    fusionSpec.last_fusion_id = fusionId;
     fusionSpec.flush_ids.assign(flushIds.begin(), flushIds.end());
     return fusionSpec;
 }
@@ -0,0 +1,33 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "tiered_fusion_policy.h"
+#include <algorithm>
+
+namespace searchcorespi::index {
+
+TieredFusionPolicy::TieredFusionPolicy(uint32_t maxTiers)
+    : _maxTiers()
+{
+    setMaxTiers(maxTiers);
+}
+
+void
+TieredFusionPolicy::setMaxTiers(uint32_t maxTiers)
+{
+    _maxTiers = std::max(maxTiers, 1u);
+}
+
+uint32_t
+TieredFusionPolicy::selectKeptTiers(const std::vector<uint64_t> &tierSizes, uint64_t flushedSize) const
+{
+    uint32_t keptTiers = tierSizes.size();
+    uint64_t fusionSize = flushedSize;
+    while (keptTiers > 0 && tierSizes[keptTiers - 1] <= fusionSize * SIZE_RATIO) {
+        --keptTiers;
+        fusionSize += tierSizes[keptTiers];
+    }
+    // The output of the fusion is a new tier on top of the kept ones
+    return std::min(keptTiers, _maxTiers - 1);
+}
+
+}
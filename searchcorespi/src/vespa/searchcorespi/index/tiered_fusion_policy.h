@@ -0,0 +1,40 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace searchcorespi::index {
+
+/**
+ * Policy selecting which of the fusioned disk indexes to include when
+ * running fusion, instead of always fusioning all disk indexes into one.
+ *
+ * Starting with the newest fusioned index, an index is included when
+ * it is no more than SIZE_RATIO times larger than the indexes to be
+ * fusioned on top of it. Indexes of similar size are thus fusioned
+ * together, while large old indexes are only rewritten when enough
+ * new data has been added. The number of fusioned indexes is bounded
+ * by max tiers, where 1 means that all indexes are always fusioned.
+ */
+class TieredFusionPolicy {
+    uint32_t _maxTiers;
+public:
+    static constexpr uint64_t SIZE_RATIO = 4;
+
+    TieredFusionPolicy(uint32_t maxTiers);
+
+    void setMaxTiers(uint32_t maxTiers);
+    uint32_t getMaxTiers() const { return _maxTiers; }
+
+    /**
+     * Returns the number of fusioned indexes (oldest first) to keep
+     * as they are when fusioning in flushed indexes.
+     *
+     * @param tierSizes disk size of the fusioned indexes, oldest first.
+     * @param flushedSize total disk size of the flushed indexes.
+     */
+    uint32_t selectKeptTiers(const std::vector<uint64_t> &tierSizes, uint64_t flushedSize) const;
+};
+
+}
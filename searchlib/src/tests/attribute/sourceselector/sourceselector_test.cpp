@@ -46,6 +46,7 @@ private:
     template <typename SelectorType>
     void requireThatSelectorCanCloneAndSubtract();
     void requireThatSelectorCanCloneAndSubtract();
+    void requireThatSelectorCanCloneAndMerge();
     template <typename SelectorType>
     void requireThatSelectorCanSaveAndLoad(bool compactLidSpace);
     void requireThatSelectorCanSaveAndLoad();
@@ -69,6 +70,7 @@ Test::Main()
     }
     testFixed(docs, arraysize(docs));
     TEST_DO(requireThatSelectorCanCloneAndSubtract());
+    TEST_DO(requireThatSelectorCanCloneAndMerge());
     TEST_DO(requireThatSelectorCanSaveAndLoad());
     TEST_DO(requireThatCompleteSourceRangeIsHandled());
     TEST_DO(requireThatSourcesAreCountedCorrectly());
@@ -148,6 +150,28 @@ Test::requireThatSelectorCanCloneAndSubtract()
     requireThatSelectorCanCloneAndSubtract<FixedSourceSelector>();
 }
 
+void
+Test::requireThatSelectorCanCloneAndMerge()
+{
+    FixedSourceSelector selector(default_source, base_file_name);
+    setSources(selector);
+    selector.setBaseId(base_id);
+
+    FixedSourceSelector::UP new_selector(selector.cloneAndMerge(base_file_name2, 2, 5));
+    EXPECT_EQUAL(default_source, new_selector->getDefaultSource());
+    EXPECT_EQUAL(base_id, new_selector->getBaseId());
+    EXPECT_EQUAL(maxDocId+1, new_selector->getDocIdLimit());
+
+    auto it(new_selector->createIterator());
+    for(size_t i = 0; i < arraysize(docs); ++i) {
+        if (docs[i].source >= 2 && docs[i].source < 5) {
+            EXPECT_EQUAL(5, it->getSource(docs[i].docId));
+        } else {
+            EXPECT_EQUAL(docs[i].source, it->getSource(docs[i].docId));
+        }
+    }
+}
+
 template <typename SelectorType>
 void
 Test::requireThatSelectorCanSaveAndLoad(bool compactLidSpace)
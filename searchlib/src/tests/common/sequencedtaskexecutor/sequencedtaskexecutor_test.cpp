@@ -3,6 +3,7 @@
 #include <vespa/searchlib/common/sequencedtaskexecutor.h>
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/test/insertion_operators.h>
+#include <vespa/vespalib/util/gate.h>
 
 #include <mutex>
 #include <condition_variable>
@@ -238,6 +239,108 @@ TEST("require that you get correct number of executors") {
     EXPECT_EQUAL(7u, seven.getNumExecutors());
 }
 
+namespace {
+
+using std::chrono::steady_clock;
+using std::chrono::milliseconds;
+
+// Task time is measured with a per thread fake clock that is only
+// advanced by the tasks themselves, so measured costs are exact.
+thread_local steady_clock::time_point fakeNow;
+
+steady_clock::time_point
+fakeClock()
+{
+    return fakeNow;
+}
+
+void
+registerComponents(SequencedTaskExecutor &threads, uint32_t numComponents)
+{
+    for (uint32_t componentId = 0; componentId < numComponents; ++componentId) {
+        threads.getExecutorId(componentId);
+    }
+}
+
+void
+runTasks(SequencedTaskExecutor &threads, uint64_t componentId, uint32_t numTasks, milliseconds cost)
+{
+    for (uint32_t i = 0; i < numTasks; ++i) {
+        threads.execute(componentId, [=]() { fakeNow += cost; });
+    }
+}
+
+}
+
+TEST("require that rebalance moves expensive components to different executors")
+{
+    SequencedTaskExecutor threads(2, 1000, fakeClock);
+    registerComponents(threads, 4);
+    EXPECT_EQUAL(threads.getExecutorId(0).getId(), threads.getExecutorId(2).getId());
+    EXPECT_EQUAL(threads.getExecutorId(1).getId(), threads.getExecutorId(3).getId());
+    runTasks(threads, 0, 10, milliseconds(5));
+    runTasks(threads, 2, 10, milliseconds(5));
+    runTasks(threads, 1, 10, milliseconds(0));
+    runTasks(threads, 3, 10, milliseconds(0));
+    threads.rebalance();
+    EXPECT_EQUAL(1u, threads.getRebalanceCount());
+    EXPECT_NOT_EQUAL(threads.getExecutorId(0).getId(), threads.getExecutorId(2).getId());
+}
+
+TEST("require that rebalance keeps mapping when load is even")
+{
+    SequencedTaskExecutor threads(2, 1000, fakeClock);
+    registerComponents(threads, 2);
+    runTasks(threads, 0, 10, milliseconds(5));
+    runTasks(threads, 1, 10, milliseconds(5));
+    threads.rebalance();
+    EXPECT_EQUAL(0u, threads.getRebalanceCount());
+    EXPECT_EQUAL(0u, threads.getExecutorId(0).getId());
+    EXPECT_EQUAL(1u, threads.getExecutorId(1).getId());
+}
+
+TEST("require that rebalance keeps mapping when too little task time is measured")
+{
+    SequencedTaskExecutor threads(2, 1000, fakeClock);
+    registerComponents(threads, 4);
+    runTasks(threads, 0, 10, milliseconds(2));
+    runTasks(threads, 2, 10, milliseconds(2));
+    threads.rebalance();
+    EXPECT_EQUAL(0u, threads.getRebalanceCount());
+    EXPECT_EQUAL(threads.getExecutorId(0).getId(), threads.getExecutorId(2).getId());
+}
+
+TEST("require that executor loads are tracked")
+{
+    SequencedTaskExecutor threads(2, 1000, fakeClock);
+    registerComponents(threads, 2);
+    runTasks(threads, 0, 3, milliseconds(1));
+    runTasks(threads, 1, 1, milliseconds(0));
+    threads.executeLambda(ISequencedTaskExecutor::ExecutorId(1), []() { });
+    threads.sync();
+    auto loads = threads.getExecutorLoads();
+    EXPECT_EQUAL(2u, loads.size());
+    EXPECT_EQUAL(3u, loads[0].executedTasks);
+    EXPECT_EQUAL(2u, loads[1].executedTasks);
+    EXPECT_EQUAL(milliseconds(3).count(), std::chrono::duration_cast<milliseconds>(loads[0].busyTime).count());
+    EXPECT_EQUAL(0, loads[1].busyTime.count());
+}
+
+TEST("require that executor loads only include completed tasks")
+{
+    SequencedTaskExecutor threads(2, 1000, fakeClock);
+    vespalib::Gate started;
+    vespalib::Gate proceed;
+    threads.executeLambda(ISequencedTaskExecutor::ExecutorId(0),
+                          [&]() { started.countDown(); proceed.await(); fakeNow += milliseconds(4); });
+    started.await();
+    EXPECT_EQUAL(0u, threads.getExecutorLoads()[0].executedTasks);
+    proceed.countDown();
+    threads.sync();
+    auto loads = threads.getExecutorLoads();
+    EXPECT_EQUAL(1u, loads[0].executedTasks);
+    EXPECT_EQUAL(milliseconds(4).count(), std::chrono::duration_cast<milliseconds>(loads[0].busyTime).count());
+}
 
 }
 
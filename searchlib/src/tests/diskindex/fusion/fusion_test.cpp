@@ -14,6 +14,7 @@
 #include <vespa/searchlib/memoryindex/documentinverter.h>
 #include <vespa/searchlib/memoryindex/postingiterator.h>
 #include <vespa/searchlib/diskindex/diskindex.h>
+#include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/searchlib/util/filekit.h>
 #include <vespa/searchlib/common/sequencedtaskexecutor.h>
@@ -430,6 +431,27 @@ Test::requireThatFusionIsWorking(const vespalib::string &prefix,
             break;
         TEST_DO(validateDiskIndex(dw6, true, true));
     } while (0);
+    do {
+        std::vector<vespalib::string> sources;
+        SelectorArray selector(numDocs, 0);
+        sources.push_back(prefix + "dump2");
+        const uint32_t numThreads = 4;
+        if (!EXPECT_TRUE(Fusion::merge(schema,
+                                       prefix + "dump7",
+                                       sources, selector,
+                                       dynamicKPosOcc,
+                                       tuneFileIndexing,
+                                       fileHeaderContext,
+                                       numThreads)))
+            return;
+        EXPECT_FALSE(vespalib::fileExists(prefix + "dump7/f0/tmpindex0"));
+    } while (0);
+    do {
+        DiskIndex dw7(prefix + "dump7");
+        if (!EXPECT_TRUE(dw7.setup(tuneFileSearch)))
+            break;
+        TEST_DO(validateDiskIndex(dw7, true, true));
+    } while (0);
     do {
         std::vector<vespalib::string> sources;
         SelectorArray selector(numDocs, 0);
@@ -3,8 +3,12 @@
 #include <vespa/searchlib/docstore/logdocumentstore.h>
 #include <vespa/searchlib/docstore/value.h>
 #include <vespa/searchlib/docstore/cachestats.h>
+#include <vespa/document/base/exceptions.h>
 #include <vespa/document/repo/documenttyperepo.h>
+#include <vespa/document/datatype/documenttype.h>
 #include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/fieldvalue/stringfieldvalue.h>
+#include <vespa/vespalib/objects/nbostream.h>
 
 using namespace search;
 using CompressionConfig = vespalib::compression::CompressionConfig;
@@ -148,4 +152,91 @@ TEST("require that Value can detect if output not equal to input") {
     EXPECT_FALSE(v.decompressed().second);
 }
 
+TEST("require that uncompressed data is not copied by decompressed") {
+    Value v = createValue(S1, CompressionConfig::NONE);
+    Value::Result result = v.decompressed();
+    ASSERT_TRUE(result.second);
+    EXPECT_EQUAL(v.get(), static_cast<const void *>(result.first.getData()));
+    EXPECT_EQUAL(S1, vespalib::stringref(result.first.getData(), result.first.getDataLen()));
+}
+
+struct SingleDocDataStore : NullDataStore {
+    vespalib::nbostream _serialized;
+    explicit SingleDocDataStore(const document::Document &doc) : NullDataStore(), _serialized() {
+        doc.serialize(_serialized);
+    }
+    ssize_t read(uint32_t lid, vespalib::DataBuffer &buf) const override {
+        if (lid != 1) {
+            return 0;
+        }
+        buf.clear();
+        buf.writeBytes(_serialized.peek(), _serialized.size());
+        return _serialized.size();
+    }
+    void read(const LidVector &lids, IBufferVisitor &visitor) const override {
+        for (uint32_t lid : lids) {
+            if (lid == 1) {
+                visitor.visit(lid, vespalib::ConstBufferRef(_serialized.peek(), _serialized.size()));
+            }
+        }
+    }
+};
+
+void
+verifyDocumentOutlivesStore(const DocumentStore::Config &config) {
+    document::DocumentType type("test", 42);
+    type.addField(document::Field("body", 43, *document::DataType::STRING, false));
+    document::DocumentTypeRepo typeRepo(type);
+    document::Document written(type, document::DocumentId("id:ns:test::1"));
+    written.setValue("body", document::StringFieldValue(S1));
+
+    std::unique_ptr<document::Document> read;
+    {
+        SingleDocDataStore backing(written);
+        DocumentStore store(config, backing);
+        read = store.read(1, typeRepo);
+        read = store.read(1, typeRepo); // served from the cache, if enabled
+    }
+    ASSERT_TRUE(read);
+    EXPECT_EQUAL(written.getId(), read->getId());
+    EXPECT_EQUAL(document::StringFieldValue(S1), *read->getValue("body"));
+}
+
+TEST("require that documents read with no compression outlive the store and its cache") {
+    TEST_DO(verifyDocumentOutlivesStore(DocumentStore::Config(CompressionConfig::NONE, 0, 0)));
+    TEST_DO(verifyDocumentOutlivesStore(DocumentStore::Config(CompressionConfig::NONE, 100000, 100)));
+}
+
+struct DocumentIdCollector : IDocumentIdVisitor {
+    std::vector<document::DocumentId> ids;
+    void visit(uint32_t, const document::DocumentId &id) override { ids.push_back(id); }
+    bool allowVisitCaching() const override { return true; }
+};
+
+struct DocumentCollector : IDocumentVisitor {
+    void visit(uint32_t, DocumentUP) override { }
+    bool allowVisitCaching() const override { return true; }
+};
+
+void
+verifyDocumentIdsAreVisitedWithoutDeserializing(const DocumentStore::Config &config) {
+    document::DocumentType type("test", 42);
+    document::Document written(type, document::DocumentId("id:ns:test::1"));
+    SingleDocDataStore backing(written);
+    DocumentStore store(config, backing);
+    // The repo does not know the document type, so deserializing the document fails.
+    DocumentCollector documents;
+    EXPECT_EXCEPTION(store.visit({1}, repo, documents), document::DocumentTypeNotFoundException, "test");
+    DocumentIdCollector collector;
+    store.visitDocumentIds({1, 2}, repo, collector);
+    ASSERT_EQUAL(1u, collector.ids.size());
+    EXPECT_EQUAL(written.getId(), collector.ids[0]);
+}
+
+TEST("require that document ids are visited without deserializing the documents") {
+    TEST_DO(verifyDocumentIdsAreVisitedWithoutDeserializing(DocumentStore::Config(CompressionConfig::NONE, 0, 0)));
+    TEST_DO(verifyDocumentIdsAreVisitedWithoutDeserializing(DocumentStore::Config(CompressionConfig::NONE, 100000, 100)
+                                                             .allowVisitCaching(true)));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
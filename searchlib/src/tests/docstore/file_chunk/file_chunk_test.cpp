@@ -27,11 +27,39 @@ struct MyFileHeaderContext : public FileHeaderContext {
     }
 };
 
+vespalib::string
+getData(uint32_t lid)
+{
+    std::ostringstream oss;
+    oss << "data_" << std::setw(5) << std::setfill('0') << lid;
+    return oss.str();
+}
+
 struct SetLidObserver : public ISetLid {
     std::vector<uint32_t> lids;
+    LidInfoWithLidV lidInfos;
     virtual void setLid(const vespalib::LockGuard &guard, uint32_t lid, const LidInfo &lidInfo) override {
         (void) guard;
-        (void) lidInfo;
+        lids.push_back(lid);
+        lidInfos.emplace_back(lidInfo, lid);
+    }
+};
+
+struct CountingRandRead : public FileRandRead {
+    std::unique_ptr<FileRandRead> file;
+    size_t numReads;
+    CountingRandRead(std::unique_ptr<FileRandRead> file_) : file(std::move(file_)), numReads(0) {}
+    FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) override {
+        ++numReads;
+        return file->read(offset, buffer, sz);
+    }
+    int64_t getSize() override { return file->getSize(); }
+};
+
+struct CollectingBufferVisitor : public IBufferVisitor {
+    std::vector<uint32_t> lids;
+    void visit(uint32_t lid, vespalib::ConstBufferRef buffer) override {
+        EXPECT_EQUAL(getData(lid), vespalib::string(buffer.c_str(), buffer.size()));
         lids.push_back(lid);
     }
 };
@@ -48,14 +76,6 @@ struct BucketizerObserver : public IBucketizer {
     }
 };
 
-vespalib::string
-getData(uint32_t lid)
-{
-    std::ostringstream oss;
-    oss << "data_" << std::setw(5) << std::setfill('0') << lid;
-    return oss.str();
-}
-
 struct FixtureBase {
     test::DirectoryHandler dir;
     ThreadStackExecutor executor;
@@ -212,6 +232,43 @@ TEST("require that entries with lid >= docIdLimit are skipped in updateLidMap()"
     }
 }
 
+template <typename FixtureType>
+void
+assertReadAsOneExtent(FixtureType &f)
+{
+    f.updateLidMap(std::numeric_limits<uint32_t>::max());
+    const LidInfoWithLidV &lidInfos = f.lidObserver.lidInfos;
+    ASSERT_EQUAL(2000u, lidInfos.size());
+    EXPECT_LESS(1u, lidInfos.back().getChunkId() - lidInfos.front().getChunkId());
+    f.chunk.enableRead();
+    auto file = std::make_unique<CountingRandRead>(f.chunk.replaceFile({}));
+    CountingRandRead &counter = *file;
+    f.chunk.replaceFile(std::move(file));
+    CollectingBufferVisitor visitor;
+    f.chunk.read(lidInfos.begin(), lidInfos.size(), visitor);
+    EXPECT_EQUAL(1u, counter.numReads);
+    EXPECT_EQUAL(f.lidObserver.lids, visitor.lids);
+}
+
+TEST("require that adjacent chunks on file are read with a single read")
+{
+    {
+        WriteFixture f("tmp", 0, false);
+        for (uint32_t lid = 1; lid <= 2000; ++lid) {
+            f.append(lid);
+        }
+        f.flush();
+    }
+    {
+        ReadFixture f("tmp", false);
+        TEST_DO(assertReadAsOneExtent(f));
+    }
+    {
+        WriteFixture f("tmp", 0);
+        TEST_DO(assertReadAsOneExtent(f));
+    }
+}
+
 using vespalib::compression::CompressionConfig;
 
 TEST("require that operator == detects inequality") {
@@ -14,6 +14,9 @@
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/test/insertion_operators.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/gate.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <iomanip>
 
@@ -771,6 +774,77 @@ TEST("requireThatFlushTimeIsAvailableAfterFlush") {
 }
 
 
+TEST("require that flush only waits for own chunks in shared executor") {
+    TmpDirectory testDir("flushshared");
+    DummyFileHeaderContext fileHeaderContext;
+    LogDataStore::Config config;
+    vespalib::ThreadStackExecutor executor(2, 128*1024);
+    MyTlSyncer tlSyncer;
+    vespalib::Gate unrelatedTaskGate;
+    executor.execute(vespalib::makeLambdaTask([&unrelatedTaskGate]() { unrelatedTaskGate.await(); }));
+    {
+        LogDataStore store(executor, testDir.getDir(), config, GrowStrategy(),
+                           TuneFileSummary(), fileHeaderContext, tlSyncer, nullptr);
+        const char data[] = "data";
+        store.write(1, 1, data, sizeof(data));
+        uint64_t flushToken = store.initFlush(1);
+        store.flush(flushToken);
+        EXPECT_EQUAL(1u, store.lastSyncToken());
+        fetchAndTest(store, 1, data, sizeof(data));
+        unrelatedTaskGate.countDown();
+    }
+}
+
+namespace {
+
+class CollectingBufferVisitor : public IBufferVisitor {
+public:
+    std::map<uint32_t, vespalib::string> _visited;
+    void visit(uint32_t lid, vespalib::ConstBufferRef buffer) override {
+        _visited[lid] = vespalib::string(buffer.c_str(), buffer.size());
+    }
+};
+
+vespalib::string
+makeBlob(uint32_t lid)
+{
+    return vespalib::make_string("blob for lid %u ", lid) + vespalib::string(lid % 200, 'x');
+}
+
+}
+
+TEST("require that visiting reads documents spread over many adjacent chunks") {
+    TmpDirectory testDir("visitextents");
+    DummyFileHeaderContext fileHeaderContext;
+    LogDataStore::Config config;
+    config.setFileConfig({{CompressionConfig::LZ4, 9, 60}, 1000});
+    vespalib::ThreadStackExecutor executor(4, 128*1024);
+    MyTlSyncer tlSyncer;
+    const uint32_t numLids = 5000;
+    {
+        LogDataStore store(executor, testDir.getDir(), config, GrowStrategy(),
+                           TuneFileSummary(), fileHeaderContext, tlSyncer, nullptr);
+        for (uint32_t lid = 1; lid <= numLids; ++lid) {
+            vespalib::string blob = makeBlob(lid);
+            store.write(lid, lid, blob.c_str(), blob.size());
+        }
+        store.flush(store.initFlush(numLids));
+    }
+    LogDataStore store(executor, testDir.getDir(), config, GrowStrategy(),
+                       TuneFileSummary(), fileHeaderContext, tlSyncer, nullptr);
+    IDataStore::LidVector lids;
+    for (uint32_t lid = 1; lid <= numLids; lid += 3) {
+        lids.push_back(lid);
+    }
+    std::reverse(lids.begin(), lids.end());
+    CollectingBufferVisitor visitor;
+    store.read(lids, visitor);
+    EXPECT_EQUAL(lids.size(), visitor._visited.size());
+    for (uint32_t lid : lids) {
+        EXPECT_TRUE(visitor._visited[lid] == makeBlob(lid));
+    }
+}
+
 class DummyBucketizer : public IBucketizer
 {
 public:
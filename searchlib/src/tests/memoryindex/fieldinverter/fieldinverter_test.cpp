@@ -2,9 +2,11 @@
 
 #include <vespa/searchlib/index/docbuilder.h>
 #include <vespa/searchlib/memoryindex/fieldinverter.h>
+#include <vespa/searchlib/common/sequencedtaskexecutor.h>
 #include <vespa/searchlib/test/memoryindex/ordereddocumentinserter.h>
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/document/repo/fixedtyperepo.h>
+#include <vespa/vespalib/util/stringfmt.h>
 
 namespace search {
 
@@ -88,6 +90,19 @@ makeDoc15(DocBuilder &b)
 }
 
 
+Document::UP
+makeBigDoc(DocBuilder &b, uint32_t docId, uint32_t numWords)
+{
+    b.startDocument(vespalib::make_string("doc::%u", docId));
+    b.startIndexField("f0");
+    for (uint32_t i = 0; i < numWords; ++i) {
+        b.addStr(vespalib::make_string("w%u", (i * 7919 + docId) % 5000));
+    }
+    b.endField();
+    return b.endDocument();
+}
+
+
 Document::UP
 makeDoc16(DocBuilder &b)
 {
@@ -144,12 +159,12 @@ struct Fixture
     }
 
     void
-    pushDocuments()
+    pushDocuments(ISequencedTaskExecutor *sortThreads = nullptr)
     {
         uint32_t fieldId = 0;
         for (auto &inverter : _inverters) {
             _inserter.setFieldId(fieldId);
-            inverter->pushDocuments(_inserter);
+            inverter->pushDocuments(_inserter, sortThreads);
             ++fieldId;
         }
     }
@@ -324,6 +339,41 @@ TEST_F("require that multiple words at same position works", Fixture)
 }
 
 
+TEST_F("require that push reports if field index is changed", Fixture)
+{
+    FieldInverter &inv = *f._inverters[0];
+    EXPECT_FALSE(inv.pushDocuments(f._inserter));
+    f.invertDocument(10, *makeDoc10(f._b));
+    EXPECT_TRUE(inv.pushDocuments(f._inserter));
+    EXPECT_FALSE(f._inverters[1]->pushDocuments(f._inserter));
+    inv.removeDocument(11);
+    EXPECT_FALSE(inv.pushDocuments(f._inserter));
+    inv.remove("a", 10);
+    EXPECT_TRUE(inv.pushDocuments(f._inserter));
+}
+
+
+TEST("require that large batch sorted in parallel gives same result as sequential sort")
+{
+    Fixture f1;
+    Fixture f2;
+    SequencedTaskExecutor sortThreads(4);
+    for (uint32_t docId = 1; docId <= 20; ++docId) {
+        Document::UP doc = makeBigDoc(f1._b, docId, 10000);
+        f1.invertDocument(docId, *doc);
+        f2.invertDocument(docId, *doc);
+    }
+    f1._inverters[0]->remove("w1", 30);
+    f2._inverters[0]->remove("w1", 30);
+    f1._inserter.setVerbose();
+    f2._inserter.setVerbose();
+    f1.pushDocuments();
+    f2.pushDocuments(&sortThreads);
+    vespalib::string expResult = f1._inserter.toStr();
+    EXPECT_FALSE(expResult.empty());
+    EXPECT_TRUE(expResult == f2._inserter.toStr()); // result too large to print on failure
+}
+
 } // namespace memoryindex
 } // namespace search
 
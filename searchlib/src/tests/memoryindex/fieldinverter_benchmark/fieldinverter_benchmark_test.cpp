@@ -0,0 +1,126 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/index/docbuilder.h>
+#include <vespa/searchlib/index/docidandfeatures.h>
+#include <vespa/searchlib/memoryindex/fieldinverter.h>
+#include <vespa/searchlib/memoryindex/iordereddocumentinserter.h>
+#include <vespa/searchlib/common/sequencedtaskexecutor.h>
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/log/log.h>
+LOG_SETUP("fieldinverter_benchmark_test");
+
+using document::Document;
+using search::ISequencedTaskExecutor;
+using search::SequencedTaskExecutor;
+using search::index::DocBuilder;
+using search::index::DocIdAndFeatures;
+using search::index::Schema;
+using search::index::schema::DataType;
+using search::memoryindex::FieldInverter;
+using search::memoryindex::IOrderedDocumentInserter;
+using vespalib::BenchmarkTimer;
+
+namespace {
+
+/*
+ * Inserter that only counts what is pushed, to measure the cost of
+ * sorting in the field inverter.
+ */
+class CountingInserter : public IOrderedDocumentInserter
+{
+public:
+    size_t _words;
+    size_t _adds;
+    size_t _removes;
+
+    CountingInserter() : _words(0), _adds(0), _removes(0) { }
+    void setNextWord(const vespalib::stringref) override { ++_words; }
+    void add(uint32_t, const DocIdAndFeatures &) override { ++_adds; }
+    void remove(uint32_t) override { ++_removes; }
+    void flush() override { }
+    void rewind() override { }
+};
+
+Schema
+makeSchema()
+{
+    Schema schema;
+    schema.addIndexField(Schema::IndexField("body", DataType::STRING));
+    return schema;
+}
+
+struct Fixture
+{
+    Schema _schema;
+    DocBuilder _b;
+    std::vector<Document::UP> _docs;
+
+    Fixture(uint32_t numDocs, uint32_t wordsPerDoc, uint32_t vocabularySize)
+        : _schema(makeSchema()),
+          _b(_schema),
+          _docs()
+    {
+        uint32_t seed = 1;
+        for (uint32_t docId = 1; docId <= numDocs; ++docId) {
+            _b.startDocument(vespalib::make_string("doc::%u", docId));
+            _b.startIndexField("body");
+            for (uint32_t i = 0; i < wordsPerDoc; ++i) {
+                seed = seed * 1103515245 + 12345;
+                _b.addStr(vespalib::make_string("word%u", (seed >> 8) % vocabularySize));
+            }
+            _b.endField();
+            _docs.push_back(_b.endDocument());
+        }
+    }
+
+    double
+    benchmarkPush(ISequencedTaskExecutor *sortThreads)
+    {
+        FieldInverter inverter(_schema, 0);
+        CountingInserter inserter;
+        BenchmarkTimer timer(5.0);
+        while (timer.has_budget()) {
+            uint32_t docId = 1;
+            for (const auto &doc : _docs) {
+                inverter.invertField(docId++, doc->getValue("body"));
+            }
+            timer.before();
+            inverter.pushDocuments(inserter, sortThreads);
+            timer.after();
+        }
+        return timer.min_time();
+    }
+};
+
+void
+runBenchmark(uint32_t numDocs, uint32_t wordsPerDoc)
+{
+    Fixture f(numDocs, wordsPerDoc, 100000);
+    double baseline = f.benchmarkPush(nullptr);
+    fprintf(stderr, "%u docs x %u words, no sort threads: %.3f ms\n",
+            numDocs, wordsPerDoc, baseline * 1000.0);
+    for (uint32_t threads : { 2u, 4u, 8u }) {
+        SequencedTaskExecutor sortThreads(threads);
+        double time = f.benchmarkPush(&sortThreads);
+        fprintf(stderr, "%u docs x %u words, %u sort threads: %.3f ms (speedup %.2f)\n",
+                numDocs, wordsPerDoc, threads, time * 1000.0, baseline / time);
+    }
+}
+
+}
+
+TEST("benchmark push of single large document") {
+    runBenchmark(1, 200000);
+}
+
+TEST("benchmark push of batch of large documents") {
+    runBenchmark(16, 20000);
+}
+
+TEST("benchmark push of batch of small documents") {
+    runBenchmark(1000, 100);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -400,6 +400,29 @@ TEST("requireThatWeUnderstandTheMemoryFootprint")
     }
 }
 
+TEST("require that memory on hold is freed for fields left unchanged by a commit")
+{
+    Index index(Setup().field(title).field(body));
+    for (uint32_t docId = 1; docId < 10; ++docId) {
+        index.doc(docId).field(title).add(foo).commit();
+    }
+    Blueprint::UP reader;
+    {
+        FakeRequestContext requestContext;
+        FieldSpecList fields;
+        fields.add(FieldSpec(title, 0, 0));
+        reader = index.index.createBlueprint(requestContext, fields, makeTerm(foo));
+    }
+    for (uint32_t docId = 1; docId < 10; ++docId) {
+        index.doc(docId).field(title).add(bar).commit();
+    }
+    EXPECT_LESS(0u, index.index.getMemoryUsage().allocatedBytesOnHold());
+    reader.reset();
+    // Only the body field is changed by this commit
+    index.doc(10).field(body).add(foo).commit();
+    EXPECT_EQUAL(0u, index.index.getMemoryUsage().allocatedBytesOnHold());
+}
+
 TEST("requireThatNumWordsIsReturned")
 {
     Index index(Setup().field(title));
@@ -0,0 +1,115 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/common/gatecallback.h>
+#include <vespa/searchlib/common/sequencedtaskexecutor.h>
+#include <vespa/searchlib/index/docbuilder.h>
+#include <vespa/searchlib/memoryindex/memoryindex.h>
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/util/gate.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
+#include <chrono>
+#include <vespa/log/log.h>
+LOG_SETUP("visibility_benchmark_test");
+
+using document::Document;
+using search::GateCallback;
+using search::SequencedTaskExecutor;
+using search::index::DocBuilder;
+using search::index::Schema;
+using search::index::schema::DataType;
+using search::memoryindex::MemoryIndex;
+
+namespace {
+
+using clock = std::chrono::steady_clock;
+
+Schema
+makeSchema(uint32_t numFields)
+{
+    Schema schema;
+    for (uint32_t i = 0; i < numFields; ++i) {
+        schema.addIndexField(Schema::IndexField(vespalib::make_string("f%u", i), DataType::STRING));
+    }
+    return schema;
+}
+
+/*
+ * Measures the visibility latency of a memory index, i.e. the time
+ * from commit until the committed documents are searchable, when
+ * committing after each document put (visibility delay 0).
+ */
+struct Fixture
+{
+    Schema _schema;
+    DocBuilder _b;
+    SequencedTaskExecutor _invertThreads;
+    SequencedTaskExecutor _pushThreads;
+    MemoryIndex _index;
+
+    Fixture(uint32_t numFields, uint32_t threads)
+        : _schema(makeSchema(numFields)),
+          _b(_schema),
+          _invertThreads(threads),
+          _pushThreads(threads),
+          _index(_schema, _invertThreads, _pushThreads)
+    {
+    }
+
+    Document::UP
+    makeDoc(uint32_t docId, uint32_t numTouchedFields)
+    {
+        _b.startDocument(vespalib::make_string("doc::%u", docId));
+        for (uint32_t i = 0; i < numTouchedFields; ++i) {
+            _b.startIndexField(vespalib::make_string("f%u", i));
+            _b.addStr("common").addStr(vespalib::make_string("w%u", docId % 1000));
+            _b.endField();
+        }
+        return _b.endDocument();
+    }
+
+    std::vector<double>
+    measure(uint32_t numDocs, uint32_t numTouchedFields)
+    {
+        std::vector<double> latencies;
+        for (uint32_t docId = 1; docId <= numDocs; ++docId) {
+            Document::UP doc = makeDoc(docId, numTouchedFields);
+            _index.insertDocument(docId, *doc);
+            vespalib::Gate gate;
+            clock::time_point start = clock::now();
+            _index.commit(std::make_shared<GateCallback>(gate));
+            gate.await();
+            std::chrono::duration<double, std::micro> elapsed = clock::now() - start;
+            latencies.push_back(elapsed.count());
+        }
+        std::sort(latencies.begin(), latencies.end());
+        return latencies;
+    }
+};
+
+void
+runBenchmark(uint32_t numFields, uint32_t numTouchedFields)
+{
+    const uint32_t numDocs = 10000;
+    Fixture f(numFields, 4);
+    std::vector<double> latencies = f.measure(numDocs, numTouchedFields);
+    fprintf(stderr, "%u fields, %u touched per doc: visibility latency median %.1f us, 99%% %.1f us, max %.1f us\n",
+            numFields, numTouchedFields,
+            latencies[numDocs / 2], latencies[(numDocs * 99) / 100], latencies.back());
+}
+
+}
+
+TEST("benchmark visibility latency of single field index") {
+    runBenchmark(1, 1);
+}
+
+TEST("benchmark visibility latency of many field index with few fields touched") {
+    runBenchmark(32, 1);
+}
+
+TEST("benchmark visibility latency of many field index with all fields touched") {
+    runBenchmark(32, 32);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
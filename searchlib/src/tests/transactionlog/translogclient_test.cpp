@@ -54,6 +54,7 @@ private:
     void testSync();
     void testTruncateOnShortRead();
     void testTruncateOnVersionMismatch();
+    void testTwoPartEntry();
 };
 
 TEST_APPHOOK(Test);
@@ -871,6 +872,30 @@ Test::testTruncateOnShortRead()
     }
 }
 
+void
+Test::testTwoPartEntry()
+{
+    Packet::Entry e1(1, 1, vespalib::ConstBufferRef("Content in buffer A", 20));
+    Packet a;
+    ASSERT_TRUE(a.add(e1));
+    Packet b;
+    ASSERT_TRUE(b.add(1, 1, vespalib::ConstBufferRef("Content in ", 11), vespalib::ConstBufferRef("buffer A", 9)));
+    ASSERT_TRUE(!b.add(1, 1, vespalib::ConstBufferRef("Content", 7), vespalib::ConstBufferRef()));
+    ASSERT_TRUE(b.add(2, 2, vespalib::ConstBufferRef("Head only", 10), vespalib::ConstBufferRef()));
+    EXPECT_EQUAL(2u, b.size());
+    EXPECT_EQUAL(1u, b.range().from());
+    EXPECT_EQUAL(2u, b.range().to());
+
+    Packet::Entry e;
+    vespalib::nbostream h(b.getHandle().c_str(), b.getHandle().size());
+    e.deserialize(h);
+    EXPECT_EQUAL(1u, e.serial());
+    EXPECT_EQUAL(myhex(a.getHandle().c_str() + a.getHandle().size() - 20, 20), myhex(e.data().c_str(), e.data().size()));
+    e.deserialize(h);
+    EXPECT_EQUAL(2u, e.serial());
+    EXPECT_EQUAL(vespalib::string("Head only"), vespalib::string(e.data().c_str()));
+    EXPECT_EQUAL(0u, h.size());
+}
 
 int Test::Main()
 {
@@ -893,6 +918,8 @@ int Test::Main()
     testTruncateOnVersionMismatch();
 
     testCrcVersions();
+
+    testTwoPartEntry();
     
     TEST_DONE();
 }
@@ -65,6 +65,25 @@ FixedSourceSelector::cloneAndSubtract(const vespalib::string & attrBaseFileName,
     return selector;
 }
 
+FixedSourceSelector::UP
+FixedSourceSelector::cloneAndMerge(const vespalib::string & attrBaseFileName,
+                                   uint32_t firstSource, uint32_t lastSource)
+{
+    assert(lastSource < SOURCE_LIMIT);
+    FixedSourceSelector::UP selector(new FixedSourceSelector(getDefaultSource(), attrBaseFileName, _source.getNumDocs()-1));
+    for (uint32_t docId = 0; docId < _source.getNumDocs(); ++docId) {
+        queryeval::Source src = _source.get(docId);
+        if (src >= firstSource && src < lastSource) {
+            src = lastSource;
+        }
+        selector->_source.set(docId, src);
+    }
+    selector->_source.commit();
+    selector->setBaseId(getBaseId());
+    selector->_source.setCommittedDocIdLimit(_source.getCommittedDocIdLimit());
+    return selector;
+}
+
 FixedSourceSelector::UP
 FixedSourceSelector::load(const vespalib::string & baseFileName, uint32_t currentId)
 {
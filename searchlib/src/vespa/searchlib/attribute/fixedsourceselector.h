@@ -33,6 +33,12 @@ public:
     ~FixedSourceSelector();
 
     FixedSourceSelector::UP cloneAndSubtract(const vespalib::string & attrBaseFileName, uint32_t diff);
+    /**
+     * Clone the selector, moving documents selecting a source in the
+     * range [firstSource, lastSource) to lastSource.
+     */
+    FixedSourceSelector::UP cloneAndMerge(const vespalib::string & attrBaseFileName,
+                                          uint32_t firstSource, uint32_t lastSource);
     static FixedSourceSelector::UP load(const vespalib::string & baseFileName, uint32_t currentId);
 
     // Inherit doc from ISourceSelector
@@ -48,5 +48,10 @@ ForegroundTaskExecutor::sync()
 {
 }
 
+void
+ForegroundTaskExecutor::rebalance()
+{
+}
+
 
 } // namespace search
@@ -29,6 +29,7 @@ public:
     ExecutorId getExecutorId(uint64_t componentId) override;
     void executeTask(ExecutorId id, vespalib::Executor::Task::UP task) override;
     void sync() override;
+    void rebalance() override;
 };
 
 } // namespace search
@@ -63,11 +63,32 @@ public:
     void executeLambda(ExecutorId id, FunctionType &&function) {
         executeTask(id, vespalib::makeLambdaTask(std::forward<FunctionType>(function)));
     }
+    /**
+     * Schedule a task to run after all previously scheduled tasks with
+     * same component id. Implementations can use the component id to
+     * track the cost of each component.
+     *
+     * @param componentId   component id
+     * @param task          unique pointer to the task to be executed
+     */
+    virtual void executeComponentTask(uint64_t componentId, vespalib::Executor::Task::UP task) {
+        executeTask(getExecutorId(componentId), std::move(task));
+    }
+
     /**
      * Wait for all scheduled tasks to complete.
      */
     virtual void sync() = 0;
 
+    /**
+     * Wait for all scheduled tasks to complete, then let the
+     * implementation move component ids between internal executors
+     * to even out the load. Must be called from the thread scheduling
+     * tasks, and executor ids returned earlier must not be used
+     * afterwards.
+     */
+    virtual void rebalance() = 0;
+
     /**
      * Wrap lambda function into a task and schedule it to be run.
      * Caller must ensure that pointers and references are valid and
@@ -79,8 +100,7 @@ public:
      */
     template <class FunctionType>
     void execute(uint64_t componentId, FunctionType &&function) {
-        ExecutorId id = getExecutorId(componentId);
-        executeTask(id, vespalib::makeLambdaTask(std::forward<FunctionType>(function)));
+        executeComponentTask(componentId, vespalib::makeLambdaTask(std::forward<FunctionType>(function)));
     }
 
     /**
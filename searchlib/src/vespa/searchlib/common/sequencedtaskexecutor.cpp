@@ -3,8 +3,15 @@
 #include "sequencedtaskexecutor.h"
 #include <vespa/vespalib/util/blockingthreadstackexecutor.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
+#include <algorithm>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".searchlib.common.sequencedtaskexecutor");
 
 using vespalib::BlockingThreadStackExecutor;
+using std::chrono::steady_clock;
+using std::chrono::nanoseconds;
+using std::chrono::duration_cast;
 
 namespace search {
 
@@ -12,15 +19,50 @@ namespace {
 
 constexpr uint32_t stackSize = 128 * 1024;
 
+// Don't move components around before this much task time has been measured
+constexpr uint64_t minRebalanceCost = 50 * 1000 * 1000;
+
 }
 
+class SequencedTaskExecutor::TimedTask : public vespalib::Executor::Task
+{
+    vespalib::Executor::Task::UP _task;
+    Counters                    &_counters;
+    std::atomic<uint64_t>       *_cost;
+    Clock                        _clock;
+public:
+    TimedTask(vespalib::Executor::Task::UP task, Counters &counters, std::atomic<uint64_t> *cost, Clock clock)
+        : _task(std::move(task)),
+          _counters(counters),
+          _cost(cost),
+          _clock(clock)
+    {
+    }
 
-SequencedTaskExecutor::SequencedTaskExecutor(uint32_t threads, uint32_t taskLimit)
-    : _executors()
+    void run() override {
+        steady_clock::time_point start = _clock();
+        _task->run();
+        uint64_t elapsed = duration_cast<nanoseconds>(_clock() - start).count();
+        _counters._executedTasks.fetch_add(1, std::memory_order_relaxed);
+        _counters._busyTime.fetch_add(elapsed, std::memory_order_relaxed);
+        if (_cost != nullptr) {
+            _cost->fetch_add(elapsed, std::memory_order_relaxed);
+        }
+    }
+};
+
+SequencedTaskExecutor::SequencedTaskExecutor(uint32_t threads, uint32_t taskLimit, Clock clock)
+    : _executors(),
+      _counters(),
+      _ids(),
+      _components(),
+      _rebalanceCount(0),
+      _clock(clock)
 {
     for (uint32_t id = 0; id < threads; ++id) {
         auto executor = std::make_unique<BlockingThreadStackExecutor>(1, stackSize, taskLimit);
         _executors.push_back(std::move(executor));
+        _counters.push_back(std::make_unique<Counters>());
     }
 }
 
@@ -37,28 +79,48 @@ SequencedTaskExecutor::setTaskLimit(uint32_t taskLimit)
     }
 }
 
-ISequencedTaskExecutor::ExecutorId
-SequencedTaskExecutor::getExecutorId(uint64_t componentId)
+uint32_t
+SequencedTaskExecutor::getComponentIdx(uint64_t componentId)
 {
     auto itr = _ids.find(componentId);
     if (itr == _ids.end()) {
-        auto insarg = std::make_pair(componentId, ExecutorId(_ids.size() % _executors.size()));
-        auto insres = _ids.insert(insarg);
+        uint32_t componentIdx = _components.size();
+        _components.emplace_back(ExecutorId(componentIdx % _executors.size()));
+        auto insres = _ids.insert(std::make_pair(componentId, componentIdx));
         assert(insres.second);
         itr = insres.first;
     }
     return itr->second;
 }
 
+ISequencedTaskExecutor::ExecutorId
+SequencedTaskExecutor::getExecutorId(uint64_t componentId)
+{
+    return _components[getComponentIdx(componentId)]._executorId;
+}
+
 void
-SequencedTaskExecutor::executeTask(ExecutorId id, vespalib::Executor::Task::UP task)
+SequencedTaskExecutor::executeTask(ExecutorId id, vespalib::Executor::Task::UP task, std::atomic<uint64_t> *cost)
 {
     assert(id.getId() < _executors.size());
     vespalib::ThreadStackExecutorBase &executor(*_executors[id.getId()]);
-    auto rejectedTask = executor.execute(std::move(task));
+    auto timedTask = std::make_unique<TimedTask>(std::move(task), *_counters[id.getId()], cost, _clock);
+    auto rejectedTask = executor.execute(std::move(timedTask));
     assert(!rejectedTask);
 }
 
+void
+SequencedTaskExecutor::executeTask(ExecutorId id, vespalib::Executor::Task::UP task)
+{
+    executeTask(id, std::move(task), nullptr);
+}
+
+void
+SequencedTaskExecutor::executeComponentTask(uint64_t componentId, vespalib::Executor::Task::UP task)
+{
+    Component &component = _components[getComponentIdx(componentId)];
+    executeTask(component._executorId, std::move(task), &component._cost);
+}
 
 void
 SequencedTaskExecutor::sync()
@@ -68,6 +130,54 @@ SequencedTaskExecutor::sync()
     }
 }
 
+void
+SequencedTaskExecutor::rebalance()
+{
+    sync();
+    uint32_t numExecutors = _executors.size();
+    if (numExecutors < 2 || _components.size() < 2) {
+        return;
+    }
+    std::vector<uint64_t> oldLoads(numExecutors, 0);
+    std::vector<uint32_t> order;
+    uint64_t totalCost = 0;
+    for (uint32_t i = 0; i < _components.size(); ++i) {
+        uint64_t cost = _components[i]._cost.load(std::memory_order_relaxed);
+        oldLoads[_components[i]._executorId.getId()] += cost;
+        totalCost += cost;
+        order.push_back(i);
+    }
+    if (totalCost < minRebalanceCost) {
+        return;
+    }
+    // Place the most expensive components first, each on the currently least loaded executor
+    std::stable_sort(order.begin(), order.end(), [this](uint32_t lhs, uint32_t rhs)
+                     { return _components[lhs]._cost.load(std::memory_order_relaxed) >
+                              _components[rhs]._cost.load(std::memory_order_relaxed); });
+    std::vector<uint64_t> newLoads(numExecutors, 0);
+    std::vector<ExecutorId> newExecutorIds(_components.size());
+    for (uint32_t componentIdx : order) {
+        uint32_t executorId = std::min_element(newLoads.begin(), newLoads.end()) - newLoads.begin();
+        newLoads[executorId] += _components[componentIdx]._cost.load(std::memory_order_relaxed);
+        newExecutorIds[componentIdx] = ExecutorId(executorId);
+    }
+    uint64_t oldMaxLoad = *std::max_element(oldLoads.begin(), oldLoads.end());
+    uint64_t newMaxLoad = *std::max_element(newLoads.begin(), newLoads.end());
+    // Only move components when it gives a significant improvement
+    if (newMaxLoad * 10 < oldMaxLoad * 9) {
+        for (uint32_t i = 0; i < _components.size(); ++i) {
+            _components[i]._executorId = newExecutorIds[i];
+        }
+        _rebalanceCount.fetch_add(1, std::memory_order_relaxed);
+        LOG(debug, "rebalance(): moved components, max executor load %.1f%% -> %.1f%% of total",
+            100.0 * oldMaxLoad / totalCost, 100.0 * newMaxLoad / totalCost);
+    }
+    // Decay measured cost, to adapt to changes in feed
+    for (auto &component : _components) {
+        component._cost.store(component._cost.load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
+    }
+}
+
 SequencedTaskExecutor::Stats
 SequencedTaskExecutor::getStats()
 {
@@ -81,4 +191,15 @@ SequencedTaskExecutor::getStats()
     return accumulatedStats;
 }
 
+std::vector<SequencedTaskExecutor::ExecutorLoad>
+SequencedTaskExecutor::getExecutorLoads() const
+{
+    std::vector<ExecutorLoad> loads(_counters.size());
+    for (size_t i = 0; i < _counters.size(); ++i) {
+        loads[i].executedTasks = _counters[i]->_executedTasks.load(std::memory_order_relaxed);
+        loads[i].busyTime = nanoseconds(_counters[i]->_busyTime.load(std::memory_order_relaxed));
+    }
+    return loads;
+}
+
 } // namespace search
@@ -3,6 +3,9 @@
 
 #include "isequencedtaskexecutor.h"
 #include <vespa/vespalib/stllike/hash_map.h>
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <vector>
 
 namespace vespalib {
@@ -15,24 +18,73 @@ namespace search {
 /**
  * Class to run multiple tasks in parallel, but tasks with same
  * id has to be run in sequence.
+ *
+ * The time spent running tasks is tracked per internal executor and
+ * per component id (for tasks scheduled by component id). When
+ * rebalance() is called, component ids are moved between executors
+ * to even out the measured load.
  */
 class SequencedTaskExecutor : public ISequencedTaskExecutor
 {
+public:
+    /**
+     * Load for a single internal executor, accumulated since creation.
+     */
+    struct ExecutorLoad {
+        uint64_t                 executedTasks;
+        std::chrono::nanoseconds busyTime;
+        ExecutorLoad() : executedTasks(0), busyTime(0) { }
+    };
+
+    /**
+     * Clock used to time tasks. It is called from the executor threads.
+     */
+    using Clock = std::chrono::steady_clock::time_point (*)();
+
+private:
     using Stats = vespalib::ExecutorStats;
+    class TimedTask;
+
+    struct Counters {
+        std::atomic<uint64_t> _executedTasks;
+        std::atomic<uint64_t> _busyTime;
+        Counters() : _executedTasks(0), _busyTime(0) { }
+    };
+
+    struct Component {
+        ExecutorId            _executorId;
+        std::atomic<uint64_t> _cost; // nanoseconds since last rebalance, decayed
+        explicit Component(ExecutorId executorId) : _executorId(executorId), _cost(0) { }
+    };
+
     std::vector<std::shared_ptr<vespalib::BlockingThreadStackExecutor>> _executors;
-    vespalib::hash_map<size_t, ExecutorId> _ids;
+    std::vector<std::unique_ptr<Counters>> _counters;
+    // Component ids are mapped to an index into _components. A deque is
+    // used since running tasks keep pointers to the cost counters.
+    vespalib::hash_map<size_t, uint32_t> _ids;
+    std::deque<Component>                _components;
+    std::atomic<uint32_t>                _rebalanceCount;
+    const Clock                          _clock;
+
+    uint32_t getComponentIdx(uint64_t componentId);
+    void executeTask(ExecutorId id, vespalib::Executor::Task::UP task, std::atomic<uint64_t> *cost);
 public:
     using ISequencedTaskExecutor::getExecutorId;
 
-    SequencedTaskExecutor(uint32_t threads, uint32_t taskLimit = 1000);
+    SequencedTaskExecutor(uint32_t threads, uint32_t taskLimit = 1000,
+                          Clock clock = std::chrono::steady_clock::now);
     ~SequencedTaskExecutor();
 
     void setTaskLimit(uint32_t taskLimit);
     uint32_t getNumExecutors() const override { return _executors.size(); }
     ExecutorId getExecutorId(uint64_t componentId) override;
     void executeTask(ExecutorId id, vespalib::Executor::Task::UP task) override;
+    void executeComponentTask(uint64_t componentId, vespalib::Executor::Task::UP task) override;
     void sync() override;
+    void rebalance() override;
     Stats getStats();
+    std::vector<ExecutorLoad> getExecutorLoads() const;
+    uint32_t getRebalanceCount() const { return _rebalanceCount.load(std::memory_order_relaxed); }
 };
 
 } // namespace search
@@ -39,6 +39,13 @@ SequencedTaskExecutorObserver::sync()
     _executor.sync();
 }
 
+void
+SequencedTaskExecutorObserver::rebalance()
+{
+    ++_syncCnt;
+    _executor.rebalance();
+}
+
 std::vector<uint32_t>
 SequencedTaskExecutorObserver::getExecuteHistory()
 {
@@ -9,6 +9,9 @@
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/searchlib/common/documentsummary.h>
 #include <vespa/vespalib/util/error.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <atomic>
 #include <sstream>
 
 #include <vespa/log/log.h>
@@ -40,17 +43,13 @@ Fusion::Fusion(bool dynamicKPosIndexFormat,
     : _schema(nullptr),
       _oldIndexes(),
       _docIdLimit(0u),
-      _numWordIds(0u),
       _dynamicKPosIndexFormat(dynamicKPosIndexFormat),
       _outDir("merged"),
       _tuneFileIndexing(tuneFileIndexing),
       _fileHeaderContext(fileHeaderContext)
 { }
 
-Fusion::~Fusion()
-{
-    ReleaseMappingTables();
-}
+Fusion::~Fusion() = default;
 
 void
 Fusion::setSchema(const Schema *schema)
@@ -69,23 +68,29 @@ Fusion::SetOldIndexList(const std::vector<vespalib::string> &oldIndexList)
 {
     _oldIndexes.resize(oldIndexList.size());
     OldIndexIterator oldIndexIt = _oldIndexes.begin();
-    uint32_t i = 0;
     for (std::vector<vespalib::string>::const_iterator
              it = oldIndexList.begin(), ite = oldIndexList.end();
          it != ite;
-         ++it, ++oldIndexIt, ++i) {
+         ++it, ++oldIndexIt) {
         oldIndexIt->reset(allocOldIndex());
         OldIndex &oi = **oldIndexIt;
         oi.setPath(*it);
-        std::ostringstream tmpindexpath0;
-        tmpindexpath0 << _outDir;
-        tmpindexpath0 << "/tmpindex";
-        tmpindexpath0 << i;
-        oi.setTmpPath(tmpindexpath0.str());
     }
 }
 
 
+vespalib::string
+Fusion::getTmpPath(const SchemaUtil::IndexIterator &index, uint32_t oldIndexId) const
+{
+    std::ostringstream tmpindexpath0;
+    tmpindexpath0 << _outDir;
+    tmpindexpath0 << "/" << index.getName();
+    tmpindexpath0 << "/tmpindex";
+    tmpindexpath0 << oldIndexId;
+    return tmpindexpath0.str();
+}
+
+
 bool
 Fusion::openInputWordReaders(const SchemaUtil::IndexIterator &index,
                              std::vector<
@@ -93,10 +98,11 @@ Fusion::openInputWordReaders(const SchemaUtil::IndexIterator &index,
                              readers,
                              PostingPriorityQueue<DictionaryWordReader> &heap)
 {
+    uint32_t oldIndexId = 0;
     for (auto &i : getOldIndexes()) {
         OldIndex &oi = *i;
         auto reader(std::make_unique<DictionaryWordReader>());
-        const vespalib::string &tmpindexpath = oi.getTmpPath();
+        const vespalib::string tmpindexpath = getTmpPath(index, oldIndexId++);
         const vespalib::string &oldindexpath = oi.getPath();
         vespalib::string wordMapName = tmpindexpath + "/old2new.dat";
         vespalib::string fieldDir(oldindexpath + "/" + index.getName());
@@ -124,7 +130,9 @@ Fusion::openInputWordReaders(const SchemaUtil::IndexIterator &index,
 
 
 bool
-Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index)
+Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index,
+                             WordNumMappingList &wordNumMappings,
+                             uint64_t &numWordIds)
 {
     vespalib::string indexName = index.getName();
     LOG(debug, "Renumber word IDs for field %s", indexName.c_str());
@@ -139,7 +147,7 @@ Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index)
 
     heap.merge(out, 4);
     assert(heap.empty());
-    _numWordIds = out.getWordNum();
+    numWordIds = out.getWordNum();
 
     // Close files
     for (auto &i : readers) {
@@ -148,7 +156,7 @@ Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index)
 
     // Now read mapping files back into an array
     // XXX: avoid this, and instead make the array here
-    if (!ReadMappingFiles(&index))
+    if (!ReadMappingFiles(index, wordNumMappings))
         return false;
 
     LOG(debug, "Finished renumbering words IDs for field %s",
@@ -159,16 +167,33 @@ Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index)
 
 
 bool
-Fusion::mergeFields()
+Fusion::mergeFields(uint32_t numThreads)
 {
-   typedef SchemaUtil::IndexIterator IndexIterator;
+    typedef SchemaUtil::IndexIterator IndexIterator;
 
     const Schema &schema = getSchema();
+    numThreads = std::min(numThreads, schema.getNumIndexFields());
+    if (numThreads <= 1) {
+        for (IndexIterator index(schema); index.isValid(); ++index) {
+            if (!mergeField(index.getIndex()))
+                return false;
+        }
+        return true;
+    }
+    LOG(debug, "Merging %u fields using %u threads",
+        schema.getNumIndexFields(), numThreads);
+    std::atomic<bool> failed(false);
+    vespalib::ThreadStackExecutor executor(numThreads, 128 * 1024);
     for (IndexIterator index(schema); index.isValid(); ++index) {
-        if (!mergeField(index.getIndex()))
-            return false;
+        uint32_t id = index.getIndex();
+        executor.execute(vespalib::makeLambdaTask([this, id, &failed]() {
+            if (!failed.load(std::memory_order_relaxed) && !mergeField(id)) {
+                failed = true;
+            }
+        }));
     }
-    return true;
+    executor.sync();
+    return !failed;
 }
 
 
@@ -194,16 +219,18 @@ Fusion::mergeField(uint32_t id)
     LOG(debug, "mergeField for field %s dir %s",
         indexName.c_str(), indexDir.c_str());
 
-    makeTmpDirs();
+    makeTmpDirs(index);
 
-    if (!renumberFieldWordIds(index)) {
+    WordNumMappingList wordNumMappings(_oldIndexes.size());
+    uint64_t numWordIds = 0;
+    if (!renumberFieldWordIds(index, wordNumMappings, numWordIds)) {
         LOG(error, "Could not renumber field word ids for field %s dir %s",
             indexName.c_str(), indexDir.c_str());
         return false;
     }
 
     // Tokamak
-    bool res = mergeFieldPostings(index);
+    bool res = mergeFieldPostings(index, wordNumMappings, numWordIds);
     if (!res) {
         LOG(error, "Could not merge field postings for field %s dir %s",
             indexName.c_str(), indexDir.c_str());
@@ -213,7 +240,7 @@ Fusion::mergeField(uint32_t id)
         return false;
     vespalib::File::sync(indexDir);
 
-    if (!CleanTmpDirs())
+    if (!CleanTmpDirs(index))
         return false;
 
     LOG(debug, "Finished mergeField for field %s dir %s",
@@ -279,18 +306,19 @@ Fusion::selectCookedOrRawFeatures(Reader &reader, Writer &writer)
 
 bool
 Fusion::openInputFieldReaders(const SchemaUtil::IndexIterator &index,
+                              const WordNumMappingList &wordNumMappings,
                               std::vector<std::unique_ptr<FieldReader> > &
                               readers)
 {
     vespalib::string indexName = index.getName();
-    for (auto &i : _oldIndexes) {
-        OldIndex &oi = *i;
+    for (uint32_t i = 0; i < _oldIndexes.size(); ++i) {
+        OldIndex &oi = *_oldIndexes[i];
         const Schema &oldSchema = oi.getSchema();
         if (!index.hasOldFields(oldSchema, false)) {
             continue; // drop data
         }
         auto reader = FieldReader::allocFieldReader(index, oldSchema);
-        reader->setup(oi.getWordNumMapping(),
+        reader->setup(wordNumMappings[i],
                       oi.getDocIdMapping());
         if (!reader->open(oi.getPath() + "/" +
                           indexName + "/",
@@ -344,15 +372,17 @@ Fusion::setupMergeHeap(const std::vector<std::unique_ptr<FieldReader> > &
 
 
 bool
-Fusion::mergeFieldPostings(const SchemaUtil::IndexIterator &index)
+Fusion::mergeFieldPostings(const SchemaUtil::IndexIterator &index,
+                           const WordNumMappingList &wordNumMappings,
+                           uint64_t numWordIds)
 {
     std::vector<std::unique_ptr<FieldReader>> readers;
     PostingPriorityQueue<FieldReader> heap;
     /* OUTPUT */
-    FieldWriter fieldWriter(_docIdLimit, _numWordIds);
+    FieldWriter fieldWriter(_docIdLimit, numWordIds);
     vespalib::string indexName = index.getName();
 
-    if (!openInputFieldReaders(index, readers))
+    if (!openInputFieldReaders(index, wordNumMappings, readers))
         return false;
     if (!openFieldWriter(index, fieldWriter))
         return false;
@@ -376,15 +406,15 @@ Fusion::mergeFieldPostings(const SchemaUtil::IndexIterator &index)
 
 
 bool
-Fusion::ReadMappingFiles(const SchemaUtil::IndexIterator *index)
+Fusion::ReadMappingFiles(const SchemaUtil::IndexIterator &index,
+                         WordNumMappingList &wordNumMappings)
 {
-    ReleaseMappingTables();
-
     size_t numberOfOldIndexes = _oldIndexes.size();
     for (uint32_t i = 0; i < numberOfOldIndexes; i++)
     {
         OldIndex &oi = *_oldIndexes[i];
-        WordNumMapping &wordNumMapping = oi.getWordNumMapping();
+        WordNumMapping &wordNumMapping = wordNumMappings[i];
+        wordNumMapping.clear();
         std::vector<uint32_t> oldIndexes;
         const Schema &oldSchema = oi.getSchema();
         if (!SchemaUtil::getIndexIds(oldSchema,
@@ -395,12 +425,12 @@ Fusion::ReadMappingFiles(const SchemaUtil::IndexIterator *index)
             wordNumMapping.noMappingFile();
             continue;
         }
-        if (index && !index->hasOldFields(oldSchema, false)) {
+        if (!index.hasOldFields(oldSchema, false)) {
             continue; // drop data
         }
 
         // Open word mapping file
-        vespalib::string old2newname = oi.getTmpPath() + "/old2new.dat";
+        vespalib::string old2newname = getTmpPath(index, i) + "/old2new.dat";
         wordNumMapping.readMappingFile(old2newname, _tuneFileIndexing._read);
     }
 
@@ -408,40 +438,21 @@ Fusion::ReadMappingFiles(const SchemaUtil::IndexIterator *index)
 }
 
 
-bool
-Fusion::ReleaseMappingTables()
-{
-    size_t numberOfOldIndexes = _oldIndexes.size();
-    for (uint32_t i = 0; i < numberOfOldIndexes; i++)
-    {
-        OldIndex &oi = *_oldIndexes[i];
-        oi.getWordNumMapping().clear();
-    }
-    return true;
-}
-
-
 void
-Fusion::makeTmpDirs()
+Fusion::makeTmpDirs(const SchemaUtil::IndexIterator &index)
 {
-    for (auto &i : getOldIndexes()) {
-        OldIndex &oi = *i;
+    for (uint32_t i = 0; i < _oldIndexes.size(); ++i) {
         // Make tmpindex directories
-        const vespalib::string &tmpindexpath = oi.getTmpPath();
-        vespalib::mkdir(tmpindexpath, false);
+        vespalib::mkdir(getTmpPath(index, i), false);
     }
 }
 
 bool
-Fusion::CleanTmpDirs()
+Fusion::CleanTmpDirs(const SchemaUtil::IndexIterator &index)
 {
     uint32_t i = 0;
     for (;;) {
-        std::ostringstream tmpindexpath0;
-        tmpindexpath0 << _outDir;
-        tmpindexpath0 << "/tmpindex";
-        tmpindexpath0 << i;
-        const vespalib::string &tmpindexpath = tmpindexpath0.str();
+        const vespalib::string tmpindexpath = getTmpPath(index, i);
         FastOS_StatInfo statInfo;
         if (!FastOS_File::Stat(tmpindexpath.c_str(), &statInfo)) {
             if (statInfo._error == FastOS_StatInfo::FileNotFound)
@@ -454,11 +465,7 @@ Fusion::CleanTmpDirs()
     while (i > 0) {
         i--;
         // Remove tmpindex directories
-        std::ostringstream tmpindexpath0;
-        tmpindexpath0 << _outDir;
-        tmpindexpath0 << "/tmpindex";
-        tmpindexpath0 << i;
-        const vespalib::string &tmpindexpath = tmpindexpath0.str();
+        const vespalib::string tmpindexpath = getTmpPath(index, i);
         search::DirectoryTraverse dt(tmpindexpath.c_str());
         if (!dt.RemoveTree()) {
             LOG(error, "Failed to clean tmpdir %s", tmpindexpath.c_str());
@@ -508,7 +515,8 @@ Fusion::merge(const Schema &schema,
               const SelectorArray &selector,
               bool dynamicKPosOccFormat,
               const TuneFileIndexing &tuneFileIndexing,
-              const FileHeaderContext &fileHeaderContext)
+              const FileHeaderContext &fileHeaderContext,
+              uint32_t numThreads)
 {
     assert(sources.size() <= 255);
     uint32_t docIdLimit = selector.size();
@@ -563,9 +571,6 @@ Fusion::merge(const Schema &schema,
     for (OldIndexIterator i = oldIndexes.begin(), ie = oldIndexes.end();
          i != ie; ++i, ++idx) {
         OldIndex &oi = **i;
-        // Make tmpindex directories
-        const vespalib::string &tmpindexpath = oi.getTmpPath();
-        vespalib::mkdir(tmpindexpath, false);
         DocIdMapping &docIdMapping = oi.getDocIdMapping();
         if (!docIdMapping.readDocIdLimit(oi.getPath())) {
             LOG(error, "Cannot determine docIdLimit for old index \"%s\"",
@@ -577,7 +582,7 @@ Fusion::merge(const Schema &schema,
                            idx);
     }
     fusion->setDocIdLimit(trimmedDocIdLimit);
-    if (!fusion->mergeFields())
+    if (!fusion->mergeFields(numThreads))
         return false;
     return true;
 }
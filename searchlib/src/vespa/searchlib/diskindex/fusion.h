@@ -29,21 +29,16 @@ class DictionaryWordReader;
 class FusionInputIndex
 {
 public:
-    typedef diskindex::WordNumMapping WordNumMapping;
     typedef diskindex::DocIdMapping DocIdMapping;
 private:
     vespalib::string _path;
-    WordNumMapping _wordNumMapping;
     DocIdMapping _docIdMapping;
-    vespalib::string _tmpPath;
     index::Schema::SP _schema;
 
 public:
     FusionInputIndex()
         : _path(),
-          _wordNumMapping(),
           _docIdMapping(),
-          _tmpPath(),
           _schema()
     {
     }
@@ -52,10 +47,6 @@ public:
 
     void setPath(const vespalib::string &path) { _path = path; }
     const vespalib::string & getPath() const { return _path; }
-    void setTmpPath(const vespalib::string &tmpPath) { _tmpPath = tmpPath; }
-    const vespalib::string &getTmpPath() const { return _tmpPath; }
-    const WordNumMapping & getWordNumMapping() const { return _wordNumMapping; }
-    WordNumMapping & getWordNumMapping() { return _wordNumMapping; }
     const DocIdMapping & getDocIdMapping() const { return _docIdMapping; }
 
     DocIdMapping & getDocIdMapping() { return _docIdMapping; }
@@ -69,11 +60,20 @@ public:
 };
 
 
+/**
+ * Merges a set of disk indexes into a new disk index.
+ *
+ * Each index field is merged independently of the others, with its own
+ * word number mappings and temporary directories below the output field
+ * directory. This allows fields to be merged in parallel by multiple
+ * threads.
+ */
 class Fusion
 {
 public:
     typedef search::index::Schema Schema;
     typedef search::index::SchemaUtil SchemaUtil;
+    typedef std::vector<WordNumMapping> WordNumMappingList;
 
 private:
     Fusion(const Fusion &);
@@ -87,23 +87,34 @@ public:
     virtual ~Fusion();
 
     void SetOldIndexList(const std::vector<vespalib::string> &oldIndexList);
-    bool mergeFields();
+    /**
+     * Merges all index fields, using up to numThreads threads to
+     * merge different fields concurrently.
+     */
+    bool mergeFields(uint32_t numThreads);
+    bool mergeFields() { return mergeFields(1); }
     bool mergeField(uint32_t id);
     bool openInputFieldReaders(const SchemaUtil::IndexIterator &index,
+                               const WordNumMappingList &wordNumMappings,
                                std::vector<std::unique_ptr<FieldReader> > &
                                readers);
     bool openFieldWriter(const SchemaUtil::IndexIterator &index, FieldWriter & writer);
     bool setupMergeHeap(const std::vector<std::unique_ptr<FieldReader> > & readers,
                         FieldWriter &writer, PostingPriorityQueue<FieldReader> &heap);
-    bool mergeFieldPostings(const SchemaUtil::IndexIterator &index);
+    bool mergeFieldPostings(const SchemaUtil::IndexIterator &index,
+                            const WordNumMappingList &wordNumMappings,
+                            uint64_t numWordIds);
     bool openInputWordReaders(const SchemaUtil::IndexIterator &index,
                               std::vector<std::unique_ptr<DictionaryWordReader> > &readers,
                               PostingPriorityQueue<DictionaryWordReader> &heap);
-    bool renumberFieldWordIds(const SchemaUtil::IndexIterator &index);
+    bool renumberFieldWordIds(const SchemaUtil::IndexIterator &index,
+                              WordNumMappingList &wordNumMappings,
+                              uint64_t &numWordIds);
     void setSchema(const Schema *schema);
     void setOutDir(const vespalib::string &outDir);
-    void makeTmpDirs();
-    bool CleanTmpDirs();
+    vespalib::string getTmpPath(const SchemaUtil::IndexIterator &index, uint32_t oldIndexId) const;
+    void makeTmpDirs(const SchemaUtil::IndexIterator &index);
+    bool CleanTmpDirs(const SchemaUtil::IndexIterator &index);
     bool readSchemaFiles();
     bool checkSchemaCompat();
 
@@ -112,8 +123,8 @@ public:
     selectCookedOrRawFeatures(Reader &reader, Writer &writer);
 
 protected:
-    bool ReadMappingFiles(const SchemaUtil::IndexIterator *index);
-    bool ReleaseMappingTables();
+    bool ReadMappingFiles(const SchemaUtil::IndexIterator &index,
+                          WordNumMappingList &wordNumMappings);
 protected:
 
     typedef FusionInputIndex OldIndex;
@@ -126,7 +137,6 @@ protected:
     // OUTPUT:
 
     uint32_t _docIdLimit;
-    uint64_t _numWordIds;
 
     // Index format parameters.
     bool _dynamicKPosIndexFormat;
@@ -153,6 +163,7 @@ public:
 
     /**
      * This method is used by new indexing pipeline to merge indexes.
+     * Up to numThreads threads are used to merge fields concurrently.
      */
     static bool merge(const Schema &schema,
                       const vespalib::string &dir,
@@ -160,7 +171,20 @@ public:
                       const SelectorArray &docIdSelector,
                       bool dynamicKPosOccFormat,
                       const TuneFileIndexing &tuneFileIndexing,
-                      const common::FileHeaderContext &fileHeaderContext);
+                      const common::FileHeaderContext &fileHeaderContext,
+                      uint32_t numThreads);
+
+    static bool merge(const Schema &schema,
+                      const vespalib::string &dir,
+                      const std::vector<vespalib::string> &sources,
+                      const SelectorArray &docIdSelector,
+                      bool dynamicKPosOccFormat,
+                      const TuneFileIndexing &tuneFileIndexing,
+                      const common::FileHeaderContext &fileHeaderContext)
+    {
+        return merge(schema, dir, sources, docIdSelector, dynamicKPosOccFormat,
+                     tuneFileIndexing, fileHeaderContext, 1);
+    }
 };
 
 }
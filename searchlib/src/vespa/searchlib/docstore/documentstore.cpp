@@ -42,10 +42,39 @@ DocumentVisitorAdapter::visit(uint32_t lid, vespalib::ConstBufferRef buf) {
     }
 }
 
+class DocumentIdVisitorAdapter : public IBufferVisitor
+{
+public:
+    DocumentIdVisitorAdapter(IDocumentIdVisitor & visitor) : _visitor(visitor) { }
+    void visit(uint32_t lid, vespalib::ConstBufferRef buf) override;
+private:
+    IDocumentIdVisitor & _visitor;
+};
+
+void
+DocumentIdVisitorAdapter::visit(uint32_t lid, vespalib::ConstBufferRef buf) {
+    if (buf.size() > 0) {
+        // Only the document header is decoded, the fields are left untouched.
+        document::ByteBuffer header(buf.c_str(), buf.size());
+        _visitor.visit(lid, document::Document::getIdFromSerialized(header));
+    }
+}
+
 document::Document::UP
-deserializeDocument(const vespalib::DataBuffer & uncompressed, const DocumentTypeRepo &repo) {
-    vespalib::nbostream is(uncompressed.getData(), uncompressed.getDataLen());
-    return std::make_unique<document::Document>(repo, is);
+deserializeDocument(vespalib::DataBuffer && uncompressed, const DocumentTypeRepo &repo) {
+    // The document takes ownership of the buffer and decodes fields from it on demand.
+    return std::make_unique<document::Document>(repo, std::move(uncompressed));
+}
+
+vespalib::DataBuffer
+ownedBuffer(vespalib::DataBuffer && uncompressed, const docstore::Value &value) {
+    if (uncompressed.getData() != value.get()) {
+        return std::move(uncompressed);
+    }
+    // Uncompressed data refers into the value, which is gone before the document.
+    vespalib::DataBuffer owned(uncompressed.getDataLen());
+    owned.writeBytes(uncompressed.getData(), uncompressed.getDataLen());
+    return owned;
 }
 
 }
@@ -63,6 +92,7 @@ public:
 
     bool read(DocumentIdT key, Value &value) const;
     void visit(const IDocumentStore::LidVector &lids, const DocumentTypeRepo &repo, IDocumentVisitor &visitor) const;
+    void visitDocumentIds(const IDocumentStore::LidVector &lids, IDocumentIdVisitor &visitor) const;
     void write(DocumentIdT, const Value &);
     void erase(DocumentIdT) {}
     const CompressionConfig &getCompression() const { return _compression; }
@@ -79,6 +109,12 @@ BackingStore::visit(const IDocumentStore::LidVector &lids, const DocumentTypeRep
     _backingStore.read(lids, adapter);
 }
 
+void
+BackingStore::visitDocumentIds(const IDocumentStore::LidVector &lids, IDocumentIdVisitor &visitor) const {
+    DocumentIdVisitorAdapter adapter(visitor);
+    _backingStore.read(lids, adapter);
+}
+
 bool
 BackingStore::read(DocumentIdT key, Value &value) const {
     bool found(false);
@@ -172,6 +208,20 @@ DocumentStore::visit(const LidVector & lids, const DocumentTypeRepo &repo, IDocu
     }
 }
 
+void
+DocumentStore::visitDocumentIds(const LidVector & lids, const DocumentTypeRepo &, IDocumentIdVisitor & visitor) const
+{
+    DocumentIdVisitorAdapter adapter(visitor);
+    if (useCache() && _config.allowVisitCaching() && visitor.allowVisitCaching()) {
+        docstore::BlobSet blobSet = _visitCache->read(lids).getBlobSet();
+        for (DocumentIdT lid : lids) {
+            adapter.visit(lid, blobSet.get(lid));
+        }
+    } else {
+        _store->visitDocumentIds(lids, visitor);
+    }
+}
+
 std::unique_ptr<document::Document>
 DocumentStore::read(DocumentIdT lid, const DocumentTypeRepo &repo) const
 {
@@ -183,7 +233,7 @@ DocumentStore::read(DocumentIdT lid, const DocumentTypeRepo &repo) const
         }
         Value::Result result = value.decompressed();
         if ( result.second ) {
-            return deserializeDocument(result.first, repo);
+            return deserializeDocument(ownedBuffer(std::move(result.first), value), repo);
         } else {
             LOG(warning, "Summary cache for lid %u is corrupt. Invalidating and reading directly from backing store", lid);
             _cache->invalidate(lid);
@@ -191,11 +241,11 @@ DocumentStore::read(DocumentIdT lid, const DocumentTypeRepo &repo) const
     }
 
     _uncached_lookups.fetch_add(1);
-    _store->read(lid, value);
-    if ( ! value.empty() ) {
-        Value::Result result = value.decompressed();
-        assert(result.second);
-        return deserializeDocument(result.first, repo);
+    // The backing store hands out uncompressed data in a buffer the document can own.
+    vespalib::DataBuffer buf(4096);
+    ssize_t len = _backingStore.read(lid, buf);
+    if (len > 0) {
+        return deserializeDocument(std::move(buf), repo);
     }
     return std::unique_ptr<document::Document>();
 }
@@ -360,16 +410,10 @@ template <class Visitor>
 void
 DocumentStore::WrapVisitor<Visitor>::visit(uint32_t lid, const void *buffer, size_t sz)
 {
-    Value value;
-    vespalib::DataBuffer buf(4096);
-    buf.clear();
-    buf.writeBytes(buffer, sz);
-    ssize_t len = sz;
-    if (len > 0) {
-        value.set(std::move(buf), len);
-    }
-    if (! value.empty()) {
-        std::shared_ptr<document::Document> doc(deserializeDocument(value.decompressed().first, _repo));
+    if (sz > 0) {
+        vespalib::DataBuffer buf(sz);
+        buf.writeBytes(buffer, sz);
+        std::shared_ptr<document::Document> doc(deserializeDocument(std::move(buf), _repo));
         _visitor.visit(lid, doc);
         rewrite(lid, *doc);
     } else {
@@ -27,6 +27,8 @@ namespace search {
 namespace {
 
 constexpr size_t ALIGNMENT=0x1000;
+// Max bytes read at once when visiting chunks that are adjacent on disk
+constexpr size_t MAX_READ_AHEAD=0x100000;
 constexpr size_t ENTRY_BIAS_SIZE=8;
 const vespalib::string DOC_ID_LIMIT_KEY("docIdLimit");
 
@@ -363,33 +365,58 @@ FileChunk::appendTo(vespalib::ThreadExecutor & executor, const IGetLid & db, IWr
 void
 FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const
 {
-    if (count == 0) { return; }
+    readExtents(begin, begin + count, [this](uint32_t chunkId) -> const ChunkInfo & { return _chunkInfo[chunkId]; },
+                visitor);
+}
+
+/*
+ * The lids are ordered by chunk. Chunks that are adjacent within this
+ * file are read as one extent with a single read instead of one read per
+ * chunk. Chunks are never merged across files.
+ */
+void
+FileChunk::readExtents(LidInfoWithLidV::const_iterator begin, LidInfoWithLidV::const_iterator end,
+                       const ChunkInfoLookup & chunkInfo, IBufferVisitor & visitor) const
+{
+    if (begin == end) { return; }
+    LidInfoWithLidV::const_iterator extentBegin = begin;
     uint32_t prevChunk = begin->getChunkId();
-    uint32_t start(0);
-    for (size_t i(0); i < count; i++) {
-        const LidInfoWithLid & li = *(begin + i);
-        if (li.getChunkId() != prevChunk) {
-            ChunkInfo ci = _chunkInfo[prevChunk];
-            read(begin + start, i - start, ci, visitor);
-            prevChunk = li.getChunkId();
-            start = i;
+    uint64_t startOffset = chunkInfo(prevChunk).getOffset();
+    uint64_t endOffset = startOffset + chunkInfo(prevChunk).getSize();
+    for (LidInfoWithLidV::const_iterator it = begin; it != end; ++it) {
+        if (it->getChunkId() == prevChunk) {
+            continue;
+        }
+        prevChunk = it->getChunkId();
+        const ChunkInfo & ci = chunkInfo(prevChunk);
+        // Chunks are padded to alignment when using direct io, so allow a gap below the alignment.
+        bool adjacent = (ci.getOffset() >= endOffset) && (ci.getOffset() - endOffset < ALIGNMENT);
+        if (!adjacent || (ci.getOffset() + ci.getSize() - startOffset > MAX_READ_AHEAD)) {
+            readExtent(extentBegin, it, startOffset, endOffset, chunkInfo, visitor);
+            extentBegin = it;
+            startOffset = ci.getOffset();
         }
+        endOffset = ci.getOffset() + ci.getSize();
     }
-    ChunkInfo ci = _chunkInfo[prevChunk];
-    read(begin + start, count - start, ci, visitor);
+    readExtent(extentBegin, end, startOffset, endOffset, chunkInfo, visitor);
 }
 
 void
-FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const
+FileChunk::readExtent(LidInfoWithLidV::const_iterator begin, LidInfoWithLidV::const_iterator end,
+                      uint64_t startOffset, uint64_t endOffset, const ChunkInfoLookup & chunkInfo,
+                      IBufferVisitor & visitor) const
 {
     vespalib::DataBuffer whole(0ul, ALIGNMENT);
-    FileRandRead::FSP keepAlive = _file->read(ci.getOffset(), whole, ci.getSize());
-    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen(), _skipCrcOnRead);
-    for (size_t i(0); i < count; i++) {
-        const LidInfoWithLid & li = *(begin + i);
-        vespalib::ConstBufferRef buf = chunk.getLid(li.getLid());
-        if (buf.size() != 0) {
-            visitor.visit(li.getLid(), buf);
+    FileRandRead::FSP keepAlive = _file->read(startOffset, whole, endOffset - startOffset);
+    for (LidInfoWithLidV::const_iterator it = begin; it != end;) {
+        uint32_t chunkId = it->getChunkId();
+        const ChunkInfo & ci = chunkInfo(chunkId);
+        Chunk chunk(chunkId, whole.getData() + (ci.getOffset() - startOffset), ci.getSize(), _skipCrcOnRead);
+        for (; (it != end) && (it->getChunkId() == chunkId); ++it) {
+            vespalib::ConstBufferRef buf = chunk.getLid(it->getLid());
+            if (buf.size() != 0) {
+                visitor.visit(it->getLid(), buf);
+            }
         }
     }
 }
@@ -589,4 +616,11 @@ FileChunk::getStats() const
                                    serialNum, serialNum, docIdLimit, nameId);
 }
 
+std::unique_ptr<FileRandRead>
+FileChunk::replaceFile(std::unique_ptr<FileRandRead> file)
+{
+    std::swap(_file, file);
+    return file;
+}
+
 } // namespace search
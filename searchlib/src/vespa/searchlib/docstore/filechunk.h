@@ -13,6 +13,7 @@
 #include <vespa/vespalib/stllike/hash_map.h>
 #include <vespa/vespalib/util/generationhandler.h>
 #include <vespa/fastos/timestamp.h>
+#include <functional>
 
 class FastOS_FileInterface;
 
@@ -188,6 +189,9 @@ public:
 
     virtual DataStoreFileChunkStats getStats() const;
 
+    // for testing, replaces the file used for reads and returns the previous one
+    std::unique_ptr<FileRandRead> replaceFile(std::unique_ptr<FileRandRead> file);
+
     /**
      * Read header and return number of bytes it consist of.
      */
@@ -234,7 +238,12 @@ protected:
 
     void setNumUniqueBuckets(size_t numUniqueBuckets) { _numUniqueBuckets = numUniqueBuckets; }
     ssize_t read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo, vespalib::DataBuffer & buffer) const;
-    void read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const;
+    using ChunkInfoLookup = std::function<const ChunkInfo &(uint32_t chunkId)>;
+    void readExtents(LidInfoWithLidV::const_iterator begin, LidInfoWithLidV::const_iterator end,
+                     const ChunkInfoLookup & chunkInfo, IBufferVisitor & visitor) const;
+    void readExtent(LidInfoWithLidV::const_iterator begin, LidInfoWithLidV::const_iterator end,
+                    uint64_t startOffset, uint64_t endOffset, const ChunkInfoLookup & chunkInfo,
+                    IBufferVisitor & visitor) const;
     static uint32_t readDocIdLimit(vespalib::GenericHeader &header);
     static void writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit);
 
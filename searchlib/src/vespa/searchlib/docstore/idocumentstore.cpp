@@ -15,4 +15,14 @@ void IDocumentStore::visit(const LidVector & lids, const document::DocumentTypeR
     }
 }
 
+void IDocumentStore::visitDocumentIds(const LidVector & lids, const document::DocumentTypeRepo &repo,
+                                      IDocumentIdVisitor & visitor) const {
+    for (uint32_t lid : lids) {
+        DocumentUP doc = read(lid, repo);
+        if (doc) {
+            visitor.visit(lid, doc->getId());
+        }
+    }
+}
+
 } // namespace search
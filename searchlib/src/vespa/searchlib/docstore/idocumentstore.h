@@ -9,6 +9,7 @@
 
 namespace document {
     class Document;
+    class DocumentId;
     class DocumentTypeRepo;
 }
 
@@ -53,6 +54,14 @@ public:
 private:
 };
 
+class IDocumentIdVisitor
+{
+public:
+    virtual ~IDocumentIdVisitor() { }
+    virtual void visit(uint32_t lid, const document::DocumentId &id) = 0;
+    virtual bool allowVisitCaching() const = 0;
+};
+
 /**
  * Simple document store that contains serialized Document instances.
  * updates will be held in memory until flush() is called.
@@ -86,6 +95,12 @@ public:
      **/
     virtual DocumentUP read(DocumentIdT lid, const document::DocumentTypeRepo &repo) const = 0;
     virtual void visit(const LidVector & lidVector, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const;
+    /**
+     * Visit the ids of the stored documents. The ids are decoded from the
+     * document headers, without deserializing the documents.
+     **/
+    virtual void visitDocumentIds(const LidVector & lidVector, const document::DocumentTypeRepo &repo,
+                                  IDocumentIdVisitor & visitor) const;
 
     /**
      * Serialize and store a document.
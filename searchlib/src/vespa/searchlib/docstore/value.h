@@ -38,6 +38,11 @@ public:
     // Keep buffer uncompressed
     void set(vespalib::DataBuffer &&buf, ssize_t len);
 
+    /**
+     * Returns the uncompressed data and whether its crc matches. When the
+     * data is not compressed the returned buffer refers to the data in this
+     * value, and must not outlive it.
+     */
     Result decompressed() const;
 
     size_t size() const { return _compressedSize; }
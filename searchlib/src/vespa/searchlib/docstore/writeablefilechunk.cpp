@@ -191,28 +191,13 @@ WriteableFileChunk::restart(uint32_t nextChunkId)
     _executor.execute(makeTask(makeClosure(this, &WriteableFileChunk::fileWriter, nextChunkId)));
 }
 
-namespace {
-
-LidInfoWithLidV::const_iterator
-find_first(LidInfoWithLidV::const_iterator begin, uint32_t chunkId) {
-   for ( ; begin->getChunkId() != chunkId; ++begin);
-   return begin;
-}
-
-LidInfoWithLidV::const_iterator
-seek_past(LidInfoWithLidV::const_iterator begin, LidInfoWithLidV::const_iterator end, uint32_t chunkId) {
-   for ( ; (begin < end) && (begin->getChunkId() == chunkId); begin++);
-   return begin;
-}
-
-}
-
 void
 WriteableFileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const
 {
     if (count == 0) { return; }
     if (!frozen()) {
         vespalib::hash_map<uint32_t, ChunkInfo> chunksOnFile;
+        LidInfoWithLidV lidsOnFile;
         {
             LockGuard guard(_lock);
             for (size_t i(0); i < count; i++) {
@@ -230,14 +215,14 @@ WriteableFileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IB
                     visitor.visit(li.getLid(), buffer);
                 } else {
                     chunksOnFile[chunk] = _chunkInfo[chunk];
+                    lidsOnFile.push_back(li);
                 }
             }
         }
-        for (auto & it : chunksOnFile) {
-            LidInfoWithLidV::const_iterator first = find_first(begin, it.first);
-            LidInfoWithLidV::const_iterator last = seek_past(first, begin + count, it.first);
-            FileChunk::read(first, last - first, it.second, visitor);
-        }
+        // The chunks already on file are read outside the lock, merging adjacent chunks into extents.
+        readExtents(lidsOnFile.begin(), lidsOnFile.end(),
+                    [&chunksOnFile](uint32_t chunkId) -> const ChunkInfo & { return chunksOnFile.find(chunkId)->second; },
+                    visitor);
     } else {
         FileChunk::read(begin, count, visitor);
     }
@@ -541,7 +526,6 @@ WriteableFileChunk::freeze()
     if (!frozen()) {
         waitForAllChunksFlushedToDisk();
         enque(ProcessedChunk::UP());
-        _executor.sync();
         {
             MonitorGuard guard(_writeMonitor);
             while (_writeTaskIsRunning) {
@@ -656,7 +640,7 @@ WriteableFileChunk::flush(bool block, uint64_t syncToken)
         }
     }
     if (block) {
-        _executor.sync();
+        // The executor is shared, so wait for the chunks of this file only
         waitForChunkFlushedToDisk(chunkId);
     }
 }
@@ -187,12 +187,20 @@ DocumentInverter::pushDocuments(Dictionary &dict,
         MemoryFieldIndex &fieldIndex(**indexFieldIterator);
         DocumentRemover &remover(fieldIndex.getDocumentRemover());
         OrderedDocumentInserter &inserter(fieldIndex.getInserter());
+        // Large batches are sorted in parallel using the invert threads.
+        // Fields left unchanged skip the commit, keeping their frozen
+        // view and generation, so a commit only costs as much as the
+        // fields it actually touches. Their hold lists are still trimmed,
+        // freeing memory once readers of older generations are gone.
         _pushThreads.execute(fieldId,
                              [inverter(inverter.get()), &remover, &inserter,
-                              &fieldIndex, onWriteDone]()
+                              &fieldIndex, onWriteDone, sortThreads(&_invertThreads)]()
                              { inverter->applyRemoves(remover);
-                                 inverter->pushDocuments(inserter);
-                                 fieldIndex.commit(); });
+                                 if (inverter->pushDocuments(inserter, sortThreads)) {
+                                     fieldIndex.commit();
+                                 } else {
+                                     fieldIndex.trimHoldLists();
+                                 } });
         ++indexFieldIterator;
         ++fieldId;
     }
@@ -12,6 +12,8 @@
 #include <vespa/vespalib/text/lowercase.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/searchlib/common/sort.h>
+#include <vespa/searchlib/common/isequencedtaskexecutor.h>
+#include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/searchlib/bitcompression/compression.h>
 #include <vespa/searchlib/bitcompression/posocccompression.h>
 #include <vespa/document/annotation/annotation.h>
@@ -104,6 +106,76 @@ getSpan(const SpanNode &span_node)
     return finder.span();
 }
 
+// Minimum number of entries in each chunk when sorting in parallel
+constexpr size_t minParallelSortChunkSize = 32 * 1024;
+
+/*
+ * Run func(i) for i in [0, numParts), using executor ids 1 .. numParts-1
+ * for all but the first part, which is run by the calling thread.
+ */
+template <typename Func>
+void
+runParallel(ISequencedTaskExecutor &threads, uint32_t numParts, Func func)
+{
+    vespalib::CountDownLatch latch(numParts - 1);
+    for (uint32_t i = 1; i < numParts; ++i) {
+        threads.executeLambda(ISequencedTaskExecutor::ExecutorId(i % threads.getNumExecutors()),
+                              [&func, &latch, i]() { func(i); latch.countDown(); });
+    }
+    func(0);
+    latch.await();
+}
+
+/*
+ * Sort array by splitting it in chunks that are sorted in parallel,
+ * then merge sorted runs pairwise, also in parallel, until a single
+ * sorted run remains.
+ */
+template <typename T, typename ChunkSorter, typename Less>
+void
+parallelSort(T *data, size_t size, ChunkSorter sortChunk, Less less,
+             ISequencedTaskExecutor *threads)
+{
+    uint32_t numChunks = (threads != nullptr) ?
+                         std::min(static_cast<size_t>(threads->getNumExecutors()),
+                                  size / minParallelSortChunkSize) : 0u;
+    if (numChunks < 2) {
+        sortChunk(data, size);
+        return;
+    }
+    std::vector<size_t> bounds;
+    for (uint32_t i = 0; i <= numChunks; ++i) {
+        bounds.push_back(size * i / numChunks);
+    }
+    runParallel(*threads, numChunks, [&](uint32_t i)
+                { sortChunk(data + bounds[i], bounds[i + 1] - bounds[i]); });
+    std::vector<T> scratch(size);
+    T *src = data;
+    T *dst = &scratch[0];
+    while (bounds.size() > 2) {
+        uint32_t numRuns = bounds.size() - 1;
+        runParallel(*threads, (numRuns + 1) / 2, [&](uint32_t i)
+                    {
+                        size_t start = bounds[2 * i];
+                        size_t mid = bounds[std::min(2 * i + 1, numRuns)];
+                        size_t end = bounds[std::min(2 * i + 2, numRuns)];
+                        std::merge(src + start, src + mid, src + mid, src + end, dst + start, less);
+                    });
+        std::vector<size_t> newBounds;
+        for (size_t i = 0; i < bounds.size(); i += 2) {
+            newBounds.push_back(bounds[i]);
+        }
+        if (newBounds.back() != size) {
+            newBounds.push_back(size);
+        }
+        bounds.swap(newBounds);
+        std::swap(src, dst);
+    }
+    if (src != data) {
+        std::copy(src, src + size, data);
+    }
+}
+
 }
 
 void
@@ -185,7 +257,7 @@ struct WordRefRadix {
 };
 
 void
-FieldInverter::sortWords()
+FieldInverter::sortWords(ISequencedTaskExecutor *sortThreads)
 {
     assert(_wordRefs.size() > 1);
 
@@ -196,8 +268,14 @@ FieldInverter::sortWords()
             uint64_t firstFour = ntohl(*reinterpret_cast<const uint32_t *>(getWordFromRef(_wordRefs[i])));
             firstFourBytes[i] = (firstFour << 32) | _wordRefs[i];
         }
-        ShiftBasedRadixSorter<uint64_t, WordRefRadix, CompareWordRef, 24, true>::
-           radix_sort(WordRefRadix(), CompareWordRef(_words), &firstFourBytes[1], firstFourBytes.size()-1, 16);
+        CompareWordRef compareWordRef(_words);
+        auto sortChunk = [&compareWordRef](uint64_t *chunk, size_t chunkSize)
+                         { ShiftBasedRadixSorter<uint64_t, WordRefRadix, CompareWordRef, 24, true>::
+                                   radix_sort(WordRefRadix(), compareWordRef, chunk, chunkSize, 16); };
+        auto less = [&compareWordRef](uint64_t lhs, uint64_t rhs)
+                    { return ((lhs >> 32) != (rhs >> 32)) ? ((lhs >> 32) < (rhs >> 32)) :
+                                                            compareWordRef(static_cast<uint32_t>(lhs), static_cast<uint32_t>(rhs)); };
+        parallelSort(&firstFourBytes[1], firstFourBytes.size() - 1, sortChunk, less, sortThreads);
         for (size_t i(1); i < firstFourBytes.size(); i++) {
             _wordRefs[i] = firstFourBytes[i] & 0xffffffffl;
         }
@@ -490,21 +568,24 @@ FieldInverter::applyRemoves(DocumentRemover &remover)
 }
 
 
-void
-FieldInverter::pushDocuments(IOrderedDocumentInserter &inserter)
+bool
+FieldInverter::pushDocuments(IOrderedDocumentInserter &inserter,
+                             ISequencedTaskExecutor *sortThreads)
 {
     trimAbortedDocs();
 
     if (_positions.empty()) {
         reset();
-        return;             // All documents with words aborted
+        return false;       // All documents with words aborted
     }
 
-    sortWords();
+    sortWords(sortThreads);
 
     // Sort for terms.
-    ShiftBasedRadixSorter<PosInfo, FullRadix, std::less<PosInfo>, 56, true>::
-        radix_sort(FullRadix(), std::less<PosInfo>(), &_positions[0], _positions.size(), 16);
+    auto sortChunk = [](PosInfo *chunk, size_t chunkSize)
+                     { ShiftBasedRadixSorter<PosInfo, FullRadix, std::less<PosInfo>, 56, true>::
+                               radix_sort(FullRadix(), std::less<PosInfo>(), chunk, chunkSize, 16); };
+    parallelSort(&_positions[0], _positions.size(), sortChunk, std::less<PosInfo>(), sortThreads);
 
     constexpr uint32_t NO_ELEMENT_ID = std::numeric_limits<uint32_t>::max();
     constexpr uint32_t NO_WORD_POS = std::numeric_limits<uint32_t>::max();
@@ -566,6 +647,7 @@ FieldInverter::pushDocuments(IOrderedDocumentInserter &inserter)
     }
     inserter.flush();
     reset();
+    return true;
 }
 
 
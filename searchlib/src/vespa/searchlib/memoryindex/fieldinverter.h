@@ -16,6 +16,8 @@
 namespace search
 {
 
+class ISequencedTaskExecutor;
+
 namespace memoryindex
 {
 
@@ -343,9 +345,11 @@ private:
     /**
      * Calculate word numbers and replace word references with word
      * numbers in internal memory structures.
+     *
+     * @param sortThreads  optional executor used to sort in parallel
      */
     void
-    sortWords();
+    sortWords(ISequencedTaskExecutor *sortThreads);
 
     void
     moveNotAbortedDocs(uint32_t &dstIdx, uint32_t srcIdx, uint32_t nextTrimIdx);
@@ -385,10 +389,21 @@ public:
      * Temporary restriction: Currently only one document at a time is
      * supported.
      *
-     * @param inserter  ordered document inserter
+     * When an executor is given and the batch is large, words and
+     * word occurrences are sorted in chunks by tasks on the executor,
+     * and the sorted chunks are merged before being pushed in order.
+     * Tasks are scheduled with explicit executor ids, so the executor
+     * can be used by other threads at the same time. It must not be
+     * the executor running the caller.
+     *
+     * @param inserter     ordered document inserter
+     * @param sortThreads  optional executor used to sort in parallel
+     * @return             false if nothing was pushed to the inserter,
+     *                     i.e. the field index is left unchanged
      */
-    void
-    pushDocuments(IOrderedDocumentInserter &inserter);
+    bool
+    pushDocuments(IOrderedDocumentInserter &inserter,
+                  ISequencedTaskExecutor *sortThreads = nullptr);
 
     /*
      * Invert a normal text field, based on annotations.
@@ -116,16 +116,6 @@ private:
         _dict.getAllocator().freeze();
     }
 
-    void
-    trimHoldLists()
-    {
-        GenerationHandler::generation_t usedGen =
-            _generationHandler.getFirstUsedGeneration();
-        _postingListStore.trimHoldLists(usedGen);
-        _dict.getAllocator().trimHoldLists(usedGen);
-        _featureStore.trimHoldLists(usedGen);
-    }
-
     void
     transferHoldLists()
     {
@@ -143,6 +133,20 @@ private:
     }
 
 public:
+    /**
+     * Frees memory held for generations no longer used by readers.
+     * Called by commit(), and for fields left unchanged by a commit.
+     */
+    void
+    trimHoldLists()
+    {
+        GenerationHandler::generation_t usedGen =
+            _generationHandler.getFirstUsedGeneration();
+        _postingListStore.trimHoldLists(usedGen);
+        _dict.getAllocator().trimHoldLists(usedGen);
+        _featureStore.trimHoldLists(usedGen);
+    }
+
     GenerationHandler::Guard takeGenerationGuard() {
         return _generationHandler.takeGuard();
     }
@@ -111,8 +111,8 @@ MemoryIndex::removeDocument(uint32_t docId)
 void
 MemoryIndex::commit(const std::shared_ptr<IDestructorCallback> &onWriteDone)
 {
-    _invertThreads.sync(); // drain inverting into this inverter
-    _pushThreads.sync(); // drain use of other inverter
+    _invertThreads.rebalance(); // drain inverting into this inverter
+    _pushThreads.rebalance(); // drain use of other inverter
     _inverter->pushDocuments(*_dictionary, onWriteDone);
     flipInverter();
 }
@@ -89,14 +89,21 @@ Packet::Entry::Entry(SerialNum u, Type t, const vespalib::ConstBufferRef & d) :
 
 bool Packet::add(const Packet::Entry & e)
 {
-    bool retval((_buf.size() < _limit) && (_range.to() < e.serial()));
+    return add(e.serial(), e.type(), e.data(), vespalib::ConstBufferRef());
+}
+
+bool Packet::add(SerialNum serial, Type type, const vespalib::ConstBufferRef & head, const vespalib::ConstBufferRef & tail)
+{
+    bool retval((_buf.size() < _limit) && (_range.to() < serial));
     if (retval) {
         if (_buf.empty()) {
-            _range.from(e.serial());
+            _range.from(serial);
         }
-        e.serialize(_buf);
+        _buf << serial << type << static_cast<uint32_t>(head.size() + tail.size());
+        _buf.write(head.c_str(), head.size());
+        _buf.write(tail.c_str(), tail.size());
         _count++;
-        _range.to(e.serial());
+        _range.to(serial);
     }
     return retval;
 }
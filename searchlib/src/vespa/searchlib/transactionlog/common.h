@@ -72,6 +72,11 @@ public:
     Packet(size_t m=0xf000) : _count(0), _range(), _limit(m), _buf(m) { }
     Packet(const void * buf, size_t sz);
     bool add(const Entry & data);
+    /**
+     * Add an entry with its data given in two parts, e.g. a header and a
+     * body serialized ahead of time, without joining them first.
+     */
+    bool add(SerialNum serial, Type type, const vespalib::ConstBufferRef & head, const vespalib::ConstBufferRef & tail);
     void close() { }
     void clear() { _buf.clear(); _count = 0; _range.from(0); _range.to(0); }
     const SerialNumRange & range() const { return _range; }
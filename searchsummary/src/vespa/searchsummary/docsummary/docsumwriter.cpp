@@ -320,11 +320,11 @@ DynamicDocsumWriter::InitState(IAttributeManager & attrMan, GetDocsumsState *sta
 uint32_t
 DynamicDocsumWriter::WriteDocsum(uint32_t docid, GetDocsumsState *state, IDocsumStore *docinfos, search::RawBuf *target)
 {
-    vespalib::Slime slime;
-    vespalib::slime::SlimeInserter inserter(slime);
+    auto slime = vespalib::slime::SlimeArena::lease();
+    vespalib::slime::SlimeInserter inserter(*slime);
     ResolveClassInfo rci = resolveClassInfo(state->_args.getResultClassName(), docinfos->getSummaryClassId());
-    insertDocsum(rci, docid, state, docinfos, slime, inserter);
-    return slime2RawBuf(slime, *target);
+    insertDocsum(rci, docid, state, docinfos, *slime, inserter);
+    return slime2RawBuf(*slime, *target);
 }
 
 }
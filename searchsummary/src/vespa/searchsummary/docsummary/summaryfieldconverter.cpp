@@ -493,13 +493,13 @@ public:
     {}
 
     FieldValue::UP convert(const FieldValue &input) override {
-        vespalib::Slime slime;
-        SlimeInserter inserter(slime);
+        auto slime = vespalib::slime::SlimeArena::lease();
+        SlimeInserter inserter(*slime);
         SlimeFiller visitor(inserter, _tokenize);
         input.accept(visitor);
         search::RawBuf rbuf(4096);
         search::SlimeOutputRawBufAdapter adapter(rbuf);
-        vespalib::slime::BinaryFormat::encode(slime, adapter);
+        vespalib::slime::BinaryFormat::encode(*slime, adapter);
         return std::make_unique<RawFieldValue>(rbuf.GetDrainPos(), rbuf.GetUsedLen());
     }
 };
@@ -0,0 +1,108 @@
+// Copyright 2019 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vdstestlib/cppunit/macros.h>
+#include <vespa/storage/distributor/distributor_stripe_router.h>
+#include <vespa/storageapi/message/bucket.h>
+#include <vespa/storageapi/message/persistence.h>
+#include <vespa/storageapi/message/state.h>
+#include <vespa/document/base/documentid.h>
+#include <vespa/document/bucket/bucketidfactory.h>
+#include <vespa/document/test/make_document_bucket.h>
+#include <vespa/vdslib/state/clusterstate.h>
+#include <vespa/vespalib/util/exceptions.h>
+
+namespace storage::distributor {
+
+using document::BucketId;
+using document::DocumentId;
+using document::test::makeDocumentBucket;
+
+class DistributorStripeRouterTest : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE(DistributorStripeRouterTest);
+    CPPUNIT_TEST(stripe_bits_are_calculated_from_stripe_count);
+    CPPUNIT_TEST(invalid_stripe_counts_are_rejected);
+    CPPUNIT_TEST(buckets_are_routed_by_least_significant_bucket_id_bits);
+    CPPUNIT_TEST(buckets_with_too_few_used_bits_have_no_stripe);
+    CPPUNIT_TEST(split_buckets_stay_in_parent_stripe);
+    CPPUNIT_TEST(document_operations_are_routed_by_document_bucket);
+    CPPUNIT_TEST(bucket_less_messages_have_no_stripe);
+    CPPUNIT_TEST_SUITE_END();
+
+    void stripe_bits_are_calculated_from_stripe_count();
+    void invalid_stripe_counts_are_rejected();
+    void buckets_are_routed_by_least_significant_bucket_id_bits();
+    void buckets_with_too_few_used_bits_have_no_stripe();
+    void split_buckets_stay_in_parent_stripe();
+    void document_operations_are_routed_by_document_bucket();
+    void bucket_less_messages_have_no_stripe();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(DistributorStripeRouterTest);
+
+void DistributorStripeRouterTest::stripe_bits_are_calculated_from_stripe_count() {
+    CPPUNIT_ASSERT_EQUAL(uint8_t(0), DistributorStripeRouter::calcStripeBits(1));
+    CPPUNIT_ASSERT_EQUAL(uint8_t(1), DistributorStripeRouter::calcStripeBits(2));
+    CPPUNIT_ASSERT_EQUAL(uint8_t(2), DistributorStripeRouter::calcStripeBits(4));
+    CPPUNIT_ASSERT_EQUAL(uint8_t(8), DistributorStripeRouter::calcStripeBits(256));
+}
+
+void DistributorStripeRouterTest::invalid_stripe_counts_are_rejected() {
+    for (uint32_t numStripes : {0u, 3u, 6u, 512u}) {
+        try {
+            DistributorStripeRouter router(numStripes);
+            CPPUNIT_FAIL("expected exception");
+        } catch (vespalib::IllegalArgumentException&) {
+        }
+    }
+}
+
+void DistributorStripeRouterTest::buckets_are_routed_by_least_significant_bucket_id_bits() {
+    DistributorStripeRouter router(4);
+    CPPUNIT_ASSERT_EQUAL(0u, router.stripeOf(BucketId(16, 0)));
+    CPPUNIT_ASSERT_EQUAL(2u, router.stripeOf(BucketId(16, 1)));
+    CPPUNIT_ASSERT_EQUAL(1u, router.stripeOf(BucketId(16, 2)));
+    CPPUNIT_ASSERT_EQUAL(3u, router.stripeOf(BucketId(16, 3)));
+    CPPUNIT_ASSERT_EQUAL(2u, router.stripeOf(BucketId(16, 0x8001)));
+
+    DistributorStripeRouter single(1);
+    CPPUNIT_ASSERT_EQUAL(0u, single.stripeOf(BucketId(16, 3)));
+    CPPUNIT_ASSERT_EQUAL(0u, single.stripeOf(BucketId(1, 1)));
+}
+
+void DistributorStripeRouterTest::buckets_with_too_few_used_bits_have_no_stripe() {
+    DistributorStripeRouter router(4);
+    CPPUNIT_ASSERT_EQUAL(DistributorStripeRouter::NO_STRIPE, router.stripeOf(BucketId(1, 1)));
+    CPPUNIT_ASSERT_EQUAL(1u, router.stripeOf(BucketId(2, 2)));
+}
+
+void DistributorStripeRouterTest::split_buckets_stay_in_parent_stripe() {
+    DistributorStripeRouter router(8);
+    BucketId parent(16, 0x1235);
+    const uint32_t stripe = router.stripeOf(parent);
+    CPPUNIT_ASSERT_EQUAL(stripe, router.stripeOf(BucketId(17, 0x1235)));
+    CPPUNIT_ASSERT_EQUAL(stripe, router.stripeOf(BucketId(17, 0x11235)));
+}
+
+void DistributorStripeRouterTest::document_operations_are_routed_by_document_bucket() {
+    DistributorStripeRouter router(16);
+    document::BucketIdFactory factory;
+    for (const char* id : {"id:foo:test::abcd", "id:foo:test::efgh", "id:foo:test:n=1234:x"}) {
+        DocumentId docId(id);
+        const uint32_t expected = router.stripeOf(factory.getBucketId(docId));
+        CPPUNIT_ASSERT(expected < 16u);
+        api::RemoveCommand remove(makeDocumentBucket(BucketId(0)), docId, 1234);
+        CPPUNIT_ASSERT_EQUAL(expected, router.stripeOf(remove));
+        api::GetCommand get(makeDocumentBucket(BucketId(0)), docId, "[all]");
+        CPPUNIT_ASSERT_EQUAL(expected, router.stripeOf(get));
+    }
+    api::DeleteBucketCommand deleteBucket(makeDocumentBucket(BucketId(16, 3)));
+    CPPUNIT_ASSERT_EQUAL(router.stripeOf(BucketId(16, 3)), router.stripeOf(deleteBucket));
+}
+
+void DistributorStripeRouterTest::bucket_less_messages_have_no_stripe() {
+    DistributorStripeRouter router(4);
+    api::SetSystemStateCommand cmd(lib::ClusterState("distributor:1 storage:1"));
+    CPPUNIT_ASSERT_EQUAL(DistributorStripeRouter::NO_STRIPE, router.stripeOf(cmd));
+}
+
+}
@@ -14,6 +14,7 @@
 #include <vespa/storage/config/config-stor-distributormanager.h>
 #include <tests/common/dummystoragelink.h>
 #include <vespa/storage/distributor/distributor.h>
+#include <vespa/storage/distributor/distributor_stripe_router.h>
 #include <vespa/vespalib/text/stringtokenizer.h>
 
 using document::test::makeDocumentBucket;
@@ -60,6 +61,7 @@ class Distributor_Test : public CppUnit::TestFixture,
     CPPUNIT_TEST(external_client_requests_are_handled_individually_in_priority_order);
     CPPUNIT_TEST(internal_messages_are_started_in_fifo_order_batch);
     CPPUNIT_TEST(closing_aborts_priority_queued_client_requests);
+    CPPUNIT_TEST(client_requests_to_different_stripes_are_started_in_priority_order);
     CPPUNIT_TEST(entering_recovery_mode_resets_bucket_space_stats);
     CPPUNIT_TEST(leaving_recovery_mode_immediately_sends_getnodestate_replies);
     CPPUNIT_TEST(pending_to_no_pending_default_merges_edge_immediately_sends_getnodestate_replies);
@@ -99,6 +101,7 @@ protected:
     void external_client_requests_are_handled_individually_in_priority_order();
     void internal_messages_are_started_in_fifo_order_batch();
     void closing_aborts_priority_queued_client_requests();
+    void client_requests_to_different_stripes_are_started_in_priority_order();
     void entering_recovery_mode_resets_bucket_space_stats();
     void leaving_recovery_mode_immediately_sends_getnodestate_replies();
     void pending_to_no_pending_default_merges_edge_immediately_sends_getnodestate_replies();
@@ -1012,6 +1015,42 @@ void Distributor_Test::closing_aborts_priority_queued_client_requests() {
 
 namespace {
 
+std::shared_ptr<api::GetCommand> make_get_command(const vespalib::string& id, api::StorageMessage::Priority pri) {
+    auto cmd = std::make_shared<api::GetCommand>(makeDocumentBucket(document::BucketId()), document::DocumentId(id), "");
+    cmd->setPriority(pri);
+    return cmd;
+}
+
+}
+
+void Distributor_Test::client_requests_to_different_stripes_are_started_in_priority_order() {
+    setupDistributor(Redundancy(1), NodeCount(1), "storage:1 distributor:1");
+    addNodesToBucketDB(document::BucketId(16, 1), "0=1/1/1/t/a");
+    addNodesToBucketDB(document::BucketId(16, 2), "0=1/1/1/t/a");
+    // The two buckets are in different stripes of the bucket key space
+    DistributorStripeRouter router(2);
+    CPPUNIT_ASSERT(router.stripeOf(document::BucketId(16, 1)) != router.stripeOf(document::BucketId(16, 2)));
+
+    _distributor->onDown(make_get_command("id:foo:testdoctype1:n=1:a", 30));
+    _distributor->onDown(make_get_command("id:foo:testdoctype1:n=1:b", 10));
+    _distributor->onDown(make_get_command("id:foo:testdoctype1:n=2:c", 40));
+    _distributor->onDown(make_get_command("id:foo:testdoctype1:n=2:d", 20));
+
+    // A single client request is started per tick, regardless of stripe.
+    std::vector<int> expected({10, 20, 30, 40});
+    for (size_t i = 1; i <= expected.size(); ++i) {
+        tickDistributorNTimes(1);
+        CPPUNIT_ASSERT_EQUAL(i, _sender.commands.size());
+    }
+    std::vector<int> actual;
+    for (auto& msg : _sender.commands) {
+        actual.emplace_back(static_cast<int>(msg->getPriority()));
+    }
+    CPPUNIT_ASSERT_EQUAL(expected, actual);
+}
+
+namespace {
+
 void assert_invalid_stats_for_all_spaces(
         const BucketSpacesStatsProvider::PerNodeBucketSpacesStats& stats,
         uint16_t node_index) {
@@ -18,6 +18,7 @@ class NodeMaintenanceStatsTrackerTest : public CppUnit::TestFixture
     CPPUNIT_TEST(requestingNonExistingNodeGivesEmptyStats);
     CPPUNIT_TEST(statsAreTrackedPerNode);
     CPPUNIT_TEST(statsAreTrackedPerBucketSpace);
+    CPPUNIT_TEST(mergedStatsAreSummedPerNodeAndBucketSpace);
     CPPUNIT_TEST_SUITE_END();
 
     void emptyStatsInstancesAreEqual();
@@ -25,6 +26,7 @@ class NodeMaintenanceStatsTrackerTest : public CppUnit::TestFixture
     void requestingNonExistingNodeGivesEmptyStats();
     void statsAreTrackedPerNode();
     void statsAreTrackedPerBucketSpace();
+    void mergedStatsAreSummedPerNodeAndBucketSpace();
     void assertEmptyBucketStats(BucketSpace bucketSpace, const NodeMaintenanceStatsTracker& tracker);
     void assertBucketStats(uint64_t expMovingOut, uint64_t expSyncing, uint64_t expCopyingIn, uint64_t expCopyingOut, uint64_t expTotal,
                            BucketSpace bucketSpace, const NodeMaintenanceStatsTracker& tracker);
@@ -138,6 +140,30 @@ NodeMaintenanceStatsTrackerTest::statsAreTrackedPerBucketSpace()
     assertBucketStats(1, 0, 0, 0, 1, barSpace, tracker);
 }
 
+void
+NodeMaintenanceStatsTrackerTest::mergedStatsAreSummedPerNodeAndBucketSpace()
+{
+    NodeMaintenanceStatsTracker tracker;
+    NodeMaintenanceStatsTracker other;
+    BucketSpace fooSpace(3);
+    BucketSpace barSpace(5);
+
+    tracker.incTotal(0, fooSpace);
+    tracker.incMovingOut(0, fooSpace);
+    other.incTotal(0, fooSpace);
+    other.incSyncing(0, fooSpace);
+    other.incTotal(0, barSpace);
+    other.incCopyingOut(0, barSpace);
+    other.incCopyingIn(1, fooSpace);
+
+    tracker.merge(other);
+    assertBucketStats(1, 1, 0, 0, 2, fooSpace, tracker);
+    assertBucketStats(0, 0, 0, 1, 1, barSpace, tracker);
+    NodeMaintenanceStats wanted;
+    wanted.copyingIn = 1;
+    CPPUNIT_ASSERT_EQUAL(wanted, tracker.forNode(1, fooSpace));
+}
+
 void
 NodeMaintenanceStatsTrackerTest::assertEmptyBucketStats(BucketSpace bucketSpace,
                                                         const NodeMaintenanceStatsTracker& tracker)
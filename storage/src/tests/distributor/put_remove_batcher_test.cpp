@@ -0,0 +1,227 @@
+// Copyright 2019 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vdstestlib/cppunit/macros.h>
+#include <vespa/storage/distributor/put_remove_batcher.h>
+#include <vespa/storageapi/message/batch.h>
+#include <vespa/storageapi/message/persistence.h>
+#include <vespa/document/base/testdocman.h>
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/test/make_document_bucket.h>
+#include <vespa/documentapi/messagebus/messages/testandsetcondition.h>
+#include <vespa/vdslib/state/nodetype.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <cinttypes>
+
+namespace storage::distributor {
+
+using document::BucketId;
+using document::DocumentId;
+using document::test::makeDocumentBucket;
+
+class PutRemoveBatcherTest : public CppUnit::TestFixture {
+    CPPUNIT_TEST_SUITE(PutRemoveBatcherTest);
+    CPPUNIT_TEST(nothing_is_batched_with_max_batch_size_1);
+    CPPUNIT_TEST(operations_are_grouped_by_node_and_bucket);
+    CPPUNIT_TEST(conditional_operations_are_not_batched);
+    CPPUNIT_TEST(groups_are_split_by_max_batch_size);
+    CPPUNIT_TEST(batch_reply_is_split_into_operation_replies);
+    CPPUNIT_TEST(failed_batch_fails_all_operations);
+    CPPUNIT_TEST(unknown_batch_reply_gives_no_replies);
+    CPPUNIT_TEST_SUITE_END();
+
+    document::TestDocMan _testDocMan;
+
+    std::shared_ptr<api::PutCommand> makePut(uint16_t node, uint32_t location, api::Timestamp ts);
+    std::shared_ptr<api::RemoveCommand> makeRemove(uint16_t node, uint32_t location, api::Timestamp ts);
+    std::shared_ptr<api::BatchPutRemoveCommand> flushSingleBatch(PutRemoveBatcher& batcher);
+
+    void nothing_is_batched_with_max_batch_size_1();
+    void operations_are_grouped_by_node_and_bucket();
+    void conditional_operations_are_not_batched();
+    void groups_are_split_by_max_batch_size();
+    void batch_reply_is_split_into_operation_replies();
+    void failed_batch_fails_all_operations();
+    void unknown_batch_reply_gives_no_replies();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(PutRemoveBatcherTest);
+
+namespace {
+
+void setAddress(api::StorageCommand& cmd, uint16_t node) {
+    cmd.setAddress(api::StorageMessageAddress("storage", lib::NodeType::STORAGE, node));
+}
+
+}
+
+std::shared_ptr<api::PutCommand>
+PutRemoveBatcherTest::makePut(uint16_t node, uint32_t location, api::Timestamp ts)
+{
+    std::shared_ptr<document::Document> doc(_testDocMan.createRandomDocumentAtLocation(location, ts));
+    auto cmd = std::make_shared<api::PutCommand>(makeDocumentBucket(BucketId(16, location)), doc, ts);
+    setAddress(*cmd, node);
+    return cmd;
+}
+
+std::shared_ptr<api::RemoveCommand>
+PutRemoveBatcherTest::makeRemove(uint16_t node, uint32_t location, api::Timestamp ts)
+{
+    DocumentId id(vespalib::make_string("id:test:testdoctype1:n=%u:%" PRIu64, location, ts));
+    auto cmd = std::make_shared<api::RemoveCommand>(makeDocumentBucket(BucketId(16, location)), id, ts);
+    setAddress(*cmd, node);
+    return cmd;
+}
+
+std::shared_ptr<api::BatchPutRemoveCommand>
+PutRemoveBatcherTest::flushSingleBatch(PutRemoveBatcher& batcher)
+{
+    auto cmds = batcher.flush();
+    CPPUNIT_ASSERT_EQUAL(size_t(1), cmds.size());
+    auto batch = std::dynamic_pointer_cast<api::BatchPutRemoveCommand>(cmds[0]);
+    CPPUNIT_ASSERT(batch.get() != nullptr);
+    return batch;
+}
+
+void
+PutRemoveBatcherTest::nothing_is_batched_with_max_batch_size_1()
+{
+    PutRemoveBatcher batcher(1);
+    CPPUNIT_ASSERT(!batcher.add(makePut(0, 1, 10)));
+    CPPUNIT_ASSERT(!batcher.add(makeRemove(0, 1, 11)));
+    CPPUNIT_ASSERT_EQUAL(size_t(0), batcher.numHeldBackCommands());
+    CPPUNIT_ASSERT(batcher.flush().empty());
+}
+
+void
+PutRemoveBatcherTest::operations_are_grouped_by_node_and_bucket()
+{
+    PutRemoveBatcher batcher(16);
+    auto put1 = makePut(0, 1, 10);
+    auto remove1 = makeRemove(0, 1, 11);
+    auto otherNode = makePut(1, 1, 12);
+    auto otherBucket = makeRemove(0, 2, 13);
+    remove1->setPriority(50);
+    put1->setPriority(120);
+    for (const auto& cmd : std::vector<std::shared_ptr<api::StorageCommand>>({put1, otherNode, remove1, otherBucket})) {
+        CPPUNIT_ASSERT(batcher.add(cmd));
+    }
+    CPPUNIT_ASSERT_EQUAL(size_t(4), batcher.numHeldBackCommands());
+
+    auto cmds = batcher.flush();
+    CPPUNIT_ASSERT_EQUAL(size_t(3), cmds.size());
+    CPPUNIT_ASSERT_EQUAL(size_t(0), batcher.numHeldBackCommands());
+    CPPUNIT_ASSERT_EQUAL(size_t(1), batcher.numPendingBatches());
+
+    auto& batch = dynamic_cast<api::BatchPutRemoveCommand&>(*cmds[0]);
+    CPPUNIT_ASSERT_EQUAL(2u, batch.getOperationCount());
+    CPPUNIT_ASSERT_EQUAL(put1->getDocumentId(), batch.getOperation(0).getDocumentId());
+    CPPUNIT_ASSERT_EQUAL(remove1->getDocumentId(), batch.getOperation(1).getDocumentId());
+    CPPUNIT_ASSERT_EQUAL(BucketId(16, 1), batch.getBucketId());
+    CPPUNIT_ASSERT_EQUAL(uint16_t(0), batch.getAddress()->getIndex());
+    CPPUNIT_ASSERT_EQUAL(api::StorageMessage::Priority(50), batch.getPriority());
+
+    CPPUNIT_ASSERT(cmds[1] == otherNode);
+    CPPUNIT_ASSERT(cmds[2] == otherBucket);
+}
+
+void
+PutRemoveBatcherTest::conditional_operations_are_not_batched()
+{
+    PutRemoveBatcher batcher(16);
+    auto put = makePut(0, 1, 10);
+    put->setCondition(documentapi::TestAndSetCondition("testdoctype1.hstringval==\"foo\""));
+    auto remove = makeRemove(0, 1, 11);
+    remove->setCondition(documentapi::TestAndSetCondition("testdoctype1.hstringval==\"foo\""));
+    auto updateTimestampPut = makePut(0, 1, 12);
+    updateTimestampPut->setUpdateTimestamp(9);
+    CPPUNIT_ASSERT(!batcher.add(put));
+    CPPUNIT_ASSERT(!batcher.add(remove));
+    CPPUNIT_ASSERT(!batcher.add(updateTimestampPut));
+}
+
+void
+PutRemoveBatcherTest::groups_are_split_by_max_batch_size()
+{
+    PutRemoveBatcher batcher(2);
+    for (api::Timestamp ts = 10; ts < 15; ++ts) {
+        CPPUNIT_ASSERT(batcher.add(makeRemove(0, 1, ts)));
+    }
+    auto cmds = batcher.flush();
+    CPPUNIT_ASSERT_EQUAL(size_t(3), cmds.size());
+    CPPUNIT_ASSERT_EQUAL(2u, dynamic_cast<api::BatchPutRemoveCommand&>(*cmds[0]).getOperationCount());
+    CPPUNIT_ASSERT_EQUAL(2u, dynamic_cast<api::BatchPutRemoveCommand&>(*cmds[1]).getOperationCount());
+    CPPUNIT_ASSERT_EQUAL(api::MessageType::REMOVE, cmds[2]->getType());
+    CPPUNIT_ASSERT_EQUAL(size_t(2), batcher.numPendingBatches());
+}
+
+void
+PutRemoveBatcherTest::batch_reply_is_split_into_operation_replies()
+{
+    PutRemoveBatcher batcher(16);
+    auto put = makePut(0, 1, 10);
+    auto found = makeRemove(0, 1, 11);
+    auto notFound = makeRemove(0, 1, 12);
+    batcher.add(put);
+    batcher.add(found);
+    batcher.add(notFound);
+    auto batch = flushSingleBatch(batcher);
+
+    api::BatchPutRemoveReply reply(*batch);
+    reply.addOperationResult(api::ReturnCode(api::ReturnCode::TIMESTAMP_EXIST, "exists"), false);
+    reply.addOperationResult(api::ReturnCode(api::ReturnCode::OK), true);
+    reply.addOperationResult(api::ReturnCode(api::ReturnCode::OK), false);
+    reply.setBucketInfo(api::BucketInfo(1, 2, 3));
+
+    auto replies = batcher.splitReply(reply);
+    CPPUNIT_ASSERT_EQUAL(size_t(3), replies.size());
+    CPPUNIT_ASSERT_EQUAL(size_t(0), batcher.numPendingBatches());
+
+    CPPUNIT_ASSERT_EQUAL(put->getMsgId(), replies[0]->getMsgId());
+    CPPUNIT_ASSERT_EQUAL(api::MessageType::PUT_REPLY, replies[0]->getType());
+    CPPUNIT_ASSERT_EQUAL(api::ReturnCode(api::ReturnCode::TIMESTAMP_EXIST, "exists"), replies[0]->getResult());
+
+    auto& foundReply = dynamic_cast<api::RemoveReply&>(*replies[1]);
+    CPPUNIT_ASSERT_EQUAL(found->getMsgId(), foundReply.getMsgId());
+    CPPUNIT_ASSERT(foundReply.getResult().success());
+    CPPUNIT_ASSERT(foundReply.wasFound());
+    CPPUNIT_ASSERT_EQUAL(api::BucketInfo(1, 2, 3), foundReply.getBucketInfo());
+
+    auto& notFoundReply = dynamic_cast<api::RemoveReply&>(*replies[2]);
+    CPPUNIT_ASSERT_EQUAL(notFound->getMsgId(), notFoundReply.getMsgId());
+    CPPUNIT_ASSERT(notFoundReply.getResult().success());
+    CPPUNIT_ASSERT(!notFoundReply.wasFound());
+}
+
+void
+PutRemoveBatcherTest::failed_batch_fails_all_operations()
+{
+    PutRemoveBatcher batcher(16);
+    batcher.add(makePut(0, 1, 10));
+    batcher.add(makeRemove(0, 1, 11));
+    auto batch = flushSingleBatch(batcher);
+
+    api::BatchPutRemoveReply reply(*batch);
+    reply.setResult(api::ReturnCode(api::ReturnCode::BUCKET_NOT_FOUND, "no such bucket"));
+    auto replies = batcher.splitReply(reply);
+    CPPUNIT_ASSERT_EQUAL(size_t(2), replies.size());
+    for (const auto& opReply : replies) {
+        CPPUNIT_ASSERT_EQUAL(api::ReturnCode(api::ReturnCode::BUCKET_NOT_FOUND, "no such bucket"), opReply->getResult());
+    }
+}
+
+void
+PutRemoveBatcherTest::unknown_batch_reply_gives_no_replies()
+{
+    PutRemoveBatcher batcher(16);
+    api::BatchPutRemoveCommand batch(makeDocumentBucket(BucketId(16, 1)));
+    api::BatchPutRemoveReply reply(batch);
+    CPPUNIT_ASSERT(batcher.splitReply(reply).empty());
+
+    batcher.add(makeRemove(0, 1, 10));
+    batcher.add(makeRemove(0, 1, 11));
+    auto sent = flushSingleBatch(batcher);
+    batcher.clear();
+    CPPUNIT_ASSERT(batcher.splitReply(api::BatchPutRemoveReply(*sent)).empty());
+}
+
+}
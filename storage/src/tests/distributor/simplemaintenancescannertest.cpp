@@ -8,6 +8,7 @@
 #include <vespa/storage/distributor/maintenance/simplemaintenancescanner.h>
 #include <vespa/vdstestlib/cppunit/macros.h>
 #include <vespa/vespalib/text/stringtokenizer.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
 
 namespace storage::distributor {
 
@@ -23,6 +24,9 @@ class SimpleMaintenanceScannerTest : public CppUnit::TestFixture {
     CPPUNIT_TEST(testPendingMaintenanceOperationStatistics);
     CPPUNIT_TEST(perNodeMaintenanceStatsAreTracked);
     CPPUNIT_TEST(testReset);
+    CPPUNIT_TEST(shardedScanPrioritizesAllBuckets);
+    CPPUNIT_TEST(shardedScanTracksSameStatsAsSerialScan);
+    CPPUNIT_TEST(changingShardingRestartsScan);
     CPPUNIT_TEST_SUITE_END();
 
     using PendingStats = SimpleMaintenanceScanner::PendingMaintenanceStats;
@@ -48,6 +52,9 @@ public:
     void testPendingMaintenanceOperationStatistics();
     void perNodeMaintenanceStatsAreTracked();
     void testReset();
+    void shardedScanPrioritizesAllBuckets();
+    void shardedScanTracksSameStatsAsSerialScan();
+    void changingShardingRestartsScan();
 
     void setUp() override;
 };
@@ -241,4 +248,93 @@ SimpleMaintenanceScannerTest::perNodeMaintenanceStatsAreTracked()
     }
 }
 
+
+void
+SimpleMaintenanceScannerTest::shardedScanPrioritizesAllBuckets()
+{
+    vespalib::SimpleThreadBundle threadBundle(3);
+    _scanner->setThreadBundle(&threadBundle, 2);
+    for (int i = 1; i <= 5; ++i) {
+        addBucketToDb(i);
+    }
+    std::vector<uint64_t> scanned;
+    for (;;) {
+        auto scanResult = _scanner->scanNext();
+        if (scanResult.isDone()) {
+            break;
+        }
+        scanned.push_back(scanResult.getEntry().getBucketId().getRawId());
+    }
+    // Buckets are returned in database order across batch boundaries.
+    std::vector<uint64_t> expectedScanned({0x4000000000000001, 0x4000000000000002, 0x4000000000000003,
+                                           0x4000000000000004, 0x4000000000000005});
+    CPPUNIT_ASSERT(expectedScanned == scanned);
+    CPPUNIT_ASSERT(_scanner->scanNext().isDone());
+
+    std::string expected("PrioritizedBucket(Bucket(BucketSpace(0x0000000000000001), BucketId(0x4000000000000001)), pri VERY_HIGH)\n"
+                         "PrioritizedBucket(Bucket(BucketSpace(0x0000000000000001), BucketId(0x4000000000000002)), pri VERY_HIGH)\n"
+                         "PrioritizedBucket(Bucket(BucketSpace(0x0000000000000001), BucketId(0x4000000000000003)), pri VERY_HIGH)\n"
+                         "PrioritizedBucket(Bucket(BucketSpace(0x0000000000000001), BucketId(0x4000000000000004)), pri VERY_HIGH)\n"
+                         "PrioritizedBucket(Bucket(BucketSpace(0x0000000000000001), BucketId(0x4000000000000005)), pri VERY_HIGH)\n");
+    CPPUNIT_ASSERT_EQUAL(sortLines(expected), sortLines(_priorityDb->toString()));
+
+    _scanner->setThreadBundle(nullptr, 0);
+}
+
+void
+SimpleMaintenanceScannerTest::shardedScanTracksSameStatsAsSerialScan()
+{
+    vespalib::SimpleThreadBundle threadBundle(4);
+    _scanner->setThreadBundle(&threadBundle, 16);
+    for (int i = 1; i <= 10; ++i) {
+        addBucketToDb(i);
+    }
+    CPPUNIT_ASSERT(scanEntireDatabase(10));
+    auto stats(_scanner->getPendingMaintenanceStats());
+    std::string expected("delete bucket: 0, merge bucket: 10, "
+                         "split bucket: 0, join bucket: 0, "
+                         "set bucket state: 0, garbage collection: 0");
+    CPPUNIT_ASSERT_EQUAL(expected, stringifyGlobalPendingStats(stats));
+    {
+        NodeMaintenanceStats wantedNode1Stats;
+        wantedNode1Stats.movingOut = 10;
+        CPPUNIT_ASSERT_EQUAL(wantedNode1Stats, stats.perNodeStats.forNode(1, makeBucketSpace()));
+    }
+    {
+        NodeMaintenanceStats wantedNode2Stats;
+        wantedNode2Stats.copyingIn = 10;
+        CPPUNIT_ASSERT_EQUAL(wantedNode2Stats, stats.perNodeStats.forNode(2, makeBucketSpace()));
+    }
+    _scanner->setThreadBundle(nullptr, 0);
+}
+
+void
+SimpleMaintenanceScannerTest::changingShardingRestartsScan()
+{
+    vespalib::SimpleThreadBundle threadBundle(2);
+    _scanner->setThreadBundle(&threadBundle, 4);
+    for (int i = 1; i <= 5; ++i) {
+        addBucketToDb(i);
+    }
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0x4000000000000001), _scanner->scanNext().getEntry().getBucketId().getRawId());
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0x4000000000000002), _scanner->scanNext().getEntry().getBucketId().getRawId());
+
+    // Same settings do not disturb the scan in progress.
+    _scanner->setThreadBundle(&threadBundle, 4);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0x4000000000000003), _scanner->scanNext().getEntry().getBucketId().getRawId());
+
+    // A new batch size drops the rest of the old batch and starts over.
+    _scanner->setThreadBundle(&threadBundle, 2);
+    CPPUNIT_ASSERT(scanEntireDatabase(5));
+    auto stats(_scanner->getPendingMaintenanceStats());
+    std::string expected("delete bucket: 0, merge bucket: 5, "
+                         "split bucket: 0, join bucket: 0, "
+                         "set bucket state: 0, garbage collection: 0");
+    CPPUNIT_ASSERT_EQUAL(expected, stringifyGlobalPendingStats(stats));
+
+    // Going back to serial scanning starts over as well.
+    _scanner->setThreadBundle(nullptr, 0);
+    CPPUNIT_ASSERT(scanEntireDatabase(5));
+}
+
 }
@@ -0,0 +1,129 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vdstestlib/cppunit/macros.h>
+#include <vespa/storage/persistence/persistencethread.h>
+#include <vespa/storageapi/message/batch.h>
+#include <vespa/persistence/spi/test.h>
+#include <tests/persistence/persistencetestutils.h>
+#include <tests/persistence/common/persistenceproviderwrapper.h>
+#include <vespa/document/test/make_document_bucket.h>
+#include <vespa/vespalib/util/exceptions.h>
+
+using storage::spi::test::makeSpiBucket;
+using document::test::makeDocumentBucket;
+
+namespace storage {
+
+struct PersistenceThread_BatchTest : public SingleDiskPersistenceTestUtils
+{
+    const document::BucketId BUCKET_ID{16, 4};
+    std::unique_ptr<PersistenceProviderWrapper> _provider;
+    std::unique_ptr<PersistenceThread> _thread;
+
+    void setUp() override {
+        SingleDiskPersistenceTestUtils::setUp();
+        createBucket(BUCKET_ID);
+        spi::Context context(spi::LoadType(0, "default"), spi::Priority(0), spi::Trace::TraceLevel(0));
+        getPersistenceProvider().createBucket(makeSpiBucket(BUCKET_ID), context);
+        _provider = std::make_unique<PersistenceProviderWrapper>(getPersistenceProvider());
+        _thread = std::make_unique<PersistenceThread>(getNode().getComponentRegister(), _env->_config.getConfigId(),
+                                                      *_provider, getEnv()._fileStorHandler, getEnv()._metrics, 0);
+    }
+
+    void tearDown() override {
+        _thread.reset();
+        _provider.reset();
+        SingleDiskPersistenceTestUtils::tearDown();
+    }
+
+    std::shared_ptr<api::BatchPutRemoveReply> handleBatch(api::BatchPutRemoveCommand& cmd) {
+        auto tracker = _thread->handleBatchPutRemove(cmd);
+        CPPUNIT_ASSERT_EQUAL(api::ReturnCode(api::ReturnCode::OK), tracker->getResult());
+        auto reply = std::dynamic_pointer_cast<api::BatchPutRemoveReply>(tracker->getReply());
+        CPPUNIT_ASSERT(reply.get() != nullptr);
+        return reply;
+    }
+
+    bool hasDocument(const document::DocumentId& id) {
+        return doGet(BUCKET_ID, id, false).hasDocument();
+    }
+
+    void failing_operation_does_not_stop_rest_of_batch();
+    void remove_of_missing_document_is_reported_as_not_found();
+    void document_outside_bucket_fails_batch_before_applying_anything();
+
+    CPPUNIT_TEST_SUITE(PersistenceThread_BatchTest);
+    CPPUNIT_TEST(failing_operation_does_not_stop_rest_of_batch);
+    CPPUNIT_TEST(remove_of_missing_document_is_reported_as_not_found);
+    CPPUNIT_TEST(document_outside_bucket_fails_batch_before_applying_anything);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(PersistenceThread_BatchTest);
+
+void
+PersistenceThread_BatchTest::failing_operation_does_not_stop_rest_of_batch()
+{
+    auto existing = doPut(4, spi::Timestamp(1));
+    std::shared_ptr<document::Document> first(createRandomDocumentAtLocation(4, 10, 0, 128));
+    std::shared_ptr<document::Document> last(createRandomDocumentAtLocation(4, 12, 0, 128));
+
+    _provider->setResult(spi::Result(spi::Result::TRANSIENT_ERROR, "remove failed"));
+    _provider->setFailureMask(PersistenceProviderWrapper::FAIL_REMOVE_IF_FOUND);
+
+    api::BatchPutRemoveCommand cmd(makeDocumentBucket(BUCKET_ID));
+    cmd.addPut(first, 10);
+    cmd.addRemove(existing->getId(), 11);
+    cmd.addPut(last, 12);
+    auto reply = handleBatch(cmd);
+
+    const auto& results = reply->getOperationResults();
+    CPPUNIT_ASSERT_EQUAL(size_t(3), results.size());
+    CPPUNIT_ASSERT(results[0].result.success());
+    CPPUNIT_ASSERT(results[1].result.failed());
+    CPPUNIT_ASSERT_EQUAL(vespalib::string("remove failed"), results[1].result.getMessage());
+    CPPUNIT_ASSERT(results[2].result.success());
+    CPPUNIT_ASSERT_EQUAL(1u, reply->getFailedOperationCount());
+
+    CPPUNIT_ASSERT(hasDocument(first->getId()));
+    CPPUNIT_ASSERT(hasDocument(existing->getId()));
+    CPPUNIT_ASSERT(hasDocument(last->getId()));
+}
+
+void
+PersistenceThread_BatchTest::remove_of_missing_document_is_reported_as_not_found()
+{
+    auto existing = doPut(4, spi::Timestamp(1));
+    std::shared_ptr<document::Document> doc(createRandomDocumentAtLocation(4, 10, 0, 128));
+    document::DocumentId missing("id:mail:testdoctype1:n=4:missing");
+
+    api::BatchPutRemoveCommand cmd(makeDocumentBucket(BUCKET_ID));
+    cmd.addPut(doc, 10);
+    cmd.addRemove(existing->getId(), 11);
+    cmd.addRemove(missing, 12);
+    auto reply = handleBatch(cmd);
+
+    const auto& results = reply->getOperationResults();
+    CPPUNIT_ASSERT_EQUAL(size_t(3), results.size());
+    CPPUNIT_ASSERT_EQUAL(0u, reply->getFailedOperationCount());
+    CPPUNIT_ASSERT(results[1].found);
+    CPPUNIT_ASSERT(!results[2].found);
+
+    CPPUNIT_ASSERT(hasDocument(doc->getId()));
+    CPPUNIT_ASSERT(!hasDocument(existing->getId()));
+}
+
+void
+PersistenceThread_BatchTest::document_outside_bucket_fails_batch_before_applying_anything()
+{
+    std::shared_ptr<document::Document> doc(createRandomDocumentAtLocation(4, 10, 0, 128));
+    std::shared_ptr<document::Document> outside(createRandomDocumentAtLocation(5, 11, 0, 128));
+
+    api::BatchPutRemoveCommand cmd(makeDocumentBucket(BUCKET_ID));
+    cmd.addPut(doc, 10);
+    cmd.addPut(outside, 11);
+    CPPUNIT_ASSERT_THROW(_thread->handleBatchPutRemove(cmd), vespalib::IllegalStateException);
+    CPPUNIT_ASSERT(!hasDocument(doc->getId()));
+}
+
+}
@@ -16,6 +16,7 @@
 #include <vespa/storageapi/message/state.h>
 #include <vespa/storageapi/message/bucketsplitting.h>
 #include <vespa/storageapi/message/stat.h>
+#include <vespa/storageapi/message/batch.h>
 #include <vespa/document/bucket/fixed_bucket_spaces.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
@@ -813,6 +814,24 @@ BucketManager::onPutReply(const api::PutReply::SP& reply)
     return enqueueIfBucketHasConflicts(reply);
 }
 
+bool
+BucketManager::onBatchPutRemove(const api::BatchPutRemoveCommand::SP& cmd)
+{
+    if (!verifyAndUpdateLastModified(*cmd,
+                                     cmd->getBucket(),
+                                     cmd->getMaxTimestamp())) {
+        return true;
+    }
+
+    return false;
+}
+
+bool
+BucketManager::onBatchPutRemoveReply(const api::BatchPutRemoveReply::SP& reply)
+{
+    return enqueueIfBucketHasConflicts(reply);
+}
+
 bool
 BucketManager::onUpdate(const api::UpdateCommand::SP& cmd)
 {
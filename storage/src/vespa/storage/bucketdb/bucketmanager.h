@@ -224,6 +224,10 @@ private:
             const std::shared_ptr<api::PutCommand>&) override;
     bool onPutReply(
             const std::shared_ptr<api::PutReply>&) override;
+    bool onBatchPutRemove(
+            const std::shared_ptr<api::BatchPutRemoveCommand>&) override;
+    bool onBatchPutRemoveReply(
+            const std::shared_ptr<api::BatchPutRemoveReply>&) override;
     bool onUpdate(
             const std::shared_ptr<api::UpdateCommand>&) override;
     bool onUpdateReply(
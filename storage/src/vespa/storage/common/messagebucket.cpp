@@ -7,6 +7,7 @@
 #include <vespa/storageapi/message/bucketsplitting.h>
 #include <vespa/storageapi/message/persistence.h>
 #include <vespa/storageapi/message/removelocation.h>
+#include <vespa/storageapi/message/batch.h>
 #include <vespa/storage/persistence/messages.h>
 #include <vespa/storageapi/message/stat.h>
 
@@ -28,6 +29,8 @@ getStorageMessageBucket(const api::StorageMessage& msg)
         return static_cast<const api::RemoveCommand&>(msg).getBucket();
     case api::MessageType::REVERT_ID:
         return static_cast<const api::RevertCommand&>(msg).getBucket();
+    case api::MessageType::BATCHPUTREMOVE_ID:
+        return static_cast<const api::BatchPutRemoveCommand&>(msg).getBucket();
     case api::MessageType::STATBUCKET_ID:
         return static_cast<const api::StatBucketCommand&>(msg).getBucket();
     case api::MessageType::REMOVELOCATION_ID:
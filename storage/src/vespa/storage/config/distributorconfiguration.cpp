@@ -3,6 +3,7 @@
 #include <vespa/document/select/parser.h>
 #include <vespa/document/select/traversingvisitor.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <algorithm>
 #include <sstream>
 
 #include <vespa/log/log.h>
@@ -26,6 +27,9 @@ DistributorConfiguration::DistributorConfiguration(StorageComponent& component)
       _maxPendingMaintenanceOps(1000),
       _maxVisitorsPerNodePerClientVisitor(4),
       _minBucketsPerVisitor(5),
+      _maintenanceScanThreads(1),
+      _maintenanceScanBatchSize(1000),
+      _maxPutRemoveBatchSize(1),
       _maxClusterClockSkew(0),
       _inhibitMergeSendingOnBusyNodeDuration(std::chrono::seconds(60)),
       _doInlineSplit(true),
@@ -157,6 +161,9 @@ DistributorConfiguration::configure(const vespa::config::content::core::StorDist
     if (config.inhibitMergeSendingOnBusyNodeDurationSec >= 0) {
         _inhibitMergeSendingOnBusyNodeDuration = std::chrono::seconds(config.inhibitMergeSendingOnBusyNodeDurationSec);
     }
+    _maintenanceScanThreads = std::max(config.maintenanceScanThreads, 1);
+    _maintenanceScanBatchSize = std::max(config.maintenanceScanBatchSize, 1);
+    _maxPutRemoveBatchSize = std::max(config.maxPutRemoveBatchSize, 1);
     
     LOG(debug,
         "Distributor now using new configuration parameters. Split limits: %d docs/%d bytes. "
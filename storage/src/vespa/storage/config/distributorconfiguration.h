@@ -242,6 +242,22 @@ public:
     void setAllowStaleReadsDuringClusterStateTransitions(bool allow) noexcept {
         _allowStaleReadsDuringClusterStateTransitions = allow;
     }
+
+    uint32_t getMaintenanceScanThreads() const noexcept {
+        return _maintenanceScanThreads;
+    }
+    void setMaintenanceScanThreads(uint32_t threads) noexcept {
+        _maintenanceScanThreads = threads;
+    }
+    uint32_t getMaintenanceScanBatchSize() const noexcept {
+        return _maintenanceScanBatchSize;
+    }
+    uint32_t getMaxPutRemoveBatchSize() const noexcept {
+        return _maxPutRemoveBatchSize;
+    }
+    void setMaxPutRemoveBatchSize(uint32_t maxBatchSize) noexcept {
+        _maxPutRemoveBatchSize = maxBatchSize;
+    }
     
 private:
     DistributorConfiguration(const DistributorConfiguration& other);
@@ -270,6 +286,9 @@ private:
 
     uint32_t _maxVisitorsPerNodePerClientVisitor;
     uint32_t _minBucketsPerVisitor;
+    uint32_t _maintenanceScanThreads;
+    uint32_t _maintenanceScanBatchSize;
+    uint32_t _maxPutRemoveBatchSize;
 
     MaintenancePriorities _maintenancePriorities;
     std::chrono::seconds _maxClusterClockSkew;
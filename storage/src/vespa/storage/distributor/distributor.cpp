@@ -11,8 +11,10 @@
 #include <vespa/storage/common/nodestateupdater.h>
 #include <vespa/storage/common/hostreporter/hostinfo.h>
 #include <vespa/storage/common/global_bucket_space_distribution_converter.h>
+#include <vespa/storageapi/message/batch.h>
 #include <vespa/storageframework/generic/status/xmlstatusreporter.h>
 #include <vespa/document/bucket/fixed_bucket_spaces.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".distributor-main");
@@ -77,6 +79,7 @@ Distributor::Distributor(DistributorComponentRegister& compReg,
       _bucketDBStatusDelegate(compReg, *this, _bucketDBUpdater),
       _idealStateManager(*this, *_bucketSpaceRepo, *_readOnlyBucketSpaceRepo, compReg, manageActiveBucketCopies),
       _externalOperationHandler(*this, *_bucketSpaceRepo, *_readOnlyBucketSpaceRepo, _idealStateManager, compReg),
+      _putRemoveBatcher(1),
       _threadPool(threadPool),
       _initializingIsUp(true),
       _doneInitializeHandler(doneInitHandler),
@@ -84,11 +87,13 @@ Distributor::Distributor(DistributorComponentRegister& compReg,
       _messageSender(messageSender),
       _bucketPriorityDb(new SimpleBucketPriorityDatabase()),
       _scanner(new SimpleMaintenanceScanner(*_bucketPriorityDb, _idealStateManager, *_bucketSpaceRepo)),
+      _scanThreadBundle(),
       _throttlingStarter(new ThrottlingOperationStarter(_maintenanceOperationOwner)),
       _blockingStarter(new BlockingOperationStarter(_pendingMessageTracker, *_throttlingStarter)),
       _scheduler(new MaintenanceScheduler(_idealStateManager, *_bucketPriorityDb, *_blockingStarter)),
       _schedulingMode(MaintenanceScheduler::NORMAL_SCHEDULING_MODE),
       _recoveryTimeStarted(_component.getClock()),
+      _scanTimeStarted(_component.getClock()),
       _tickResult(framework::ThreadWaitInfo::NO_MORE_CRITICAL_WORK_KNOWN),
       _clusterName(_component.getClusterName()),
       _bucketIdHasher(new BucketGcTimeCalculator::BucketIdIdentityHasher()),
@@ -150,6 +155,11 @@ Distributor::sendCommand(const std::shared_ptr<api::StorageCommand>& cmd)
         api::MergeBucketCommand& merge(static_cast<api::MergeBucketCommand&>(*cmd));
         _idealStateManager.getMetrics().nodesPerMerge.addValue(merge.getNodes().size());
     }
+    if (_putRemoveBatcher.add(cmd)) {
+        // Sent, possibly as part of a batch, when flushed at the end of the tick
+        _pendingMessageTracker.insert(cmd);
+        return;
+    }
     sendUp(cmd);
 }
 
@@ -205,6 +215,7 @@ void Distributor::onClose() {
     }
 
     LOG(debug, "Distributor::onClose invoked");
+    _putRemoveBatcher.clear();
     _bucketDBUpdater.flush();
     _operationOwner.onClose();
     _maintenanceOperationOwner.onClose();
@@ -214,6 +225,12 @@ void
 Distributor::sendUp(const std::shared_ptr<api::StorageMessage>& msg)
 {
     _pendingMessageTracker.insert(msg);
+    forwardUp(msg);
+}
+
+void
+Distributor::forwardUp(const std::shared_ptr<api::StorageMessage>& msg)
+{
     if (_messageSender != 0) {
         _messageSender->sendUp(msg);
     } else {
@@ -271,6 +288,14 @@ Distributor::isMaintenanceReply(const api::StorageReply& reply) const
 bool
 Distributor::handleReply(const std::shared_ptr<api::StorageReply>& reply)
 {
+    if (reply->getType().getId() == api::MessageType::BATCHPUTREMOVE_REPLY_ID) {
+        // Hand each operation its own reply. Replies to batches no longer
+        // known (e.g. after close) are swallowed.
+        for (const auto& opReply : _putRemoveBatcher.splitReply(static_cast<const api::BatchPutRemoveReply&>(*reply))) {
+            handleReply(opReply);
+        }
+        return true;
+    }
     document::Bucket bucket = _pendingMessageTracker.reply(*reply);
 
     if (reply->getResult().getResult() == api::ReturnCode::BUCKET_NOT_FOUND &&
@@ -407,6 +432,7 @@ Distributor::enterRecoveryMode()
     LOG(debug, "Entering recovery mode");
     _schedulingMode = MaintenanceScheduler::RECOVERY_SCHEDULING_MODE;
     _scanner->reset();
+    _scanTimeStarted = framework::MilliSecTimer(_component.getClock());
     _bucketDBMetricUpdater.reset();
     // TODO reset _bucketDbStats?
     invalidate_bucket_spaces_stats();
@@ -763,10 +789,12 @@ Distributor::scanNextBucket()
 {
     MaintenanceScanner::ScanResult scanResult(_scanner->scanNext());
     if (scanResult.isDone()) {
+        _metrics->maintenanceScanTime.addValue(_scanTimeStarted.getElapsedTimeAsDouble());
         updateInternalMetricsForCompletedScan();
         leaveRecoveryMode();
         send_updated_host_info_if_required();
         _scanner->reset();
+        _scanTimeStarted = framework::MilliSecTimer(_component.getClock());
     } else {
         const auto &distribution(_bucketSpaceRepo->get(scanResult.getBucketSpace()).getDistribution());
         _bucketDBMetricUpdater.visit(
@@ -816,6 +844,7 @@ Distributor::doNonCriticalTick(framework::ThreadIndex)
         }
     }
     _bucketDBUpdater.resendDelayedMessages();
+    flushPutRemoveBatches();
     return _tickResult;
 }
 
@@ -826,6 +855,37 @@ Distributor::enableNextConfig()
     _bucketDBMetricUpdater.setMinimumReplicaCountingMode(getConfig().getMinimumReplicaCountingMode());
     _ownershipSafeTimeCalc->setMaxClusterClockSkew(getConfig().getMaxClusterClockSkew());
     _pendingMessageTracker.setNodeBusyDuration(getConfig().getInhibitMergesOnBusyNodeDuration());
+    configureMaintenanceScanThreads();
+    _putRemoveBatcher.setMaxBatchSize(getConfig().getMaxPutRemoveBatchSize());
+}
+
+void
+Distributor::flushPutRemoveBatches()
+{
+    if (_putRemoveBatcher.numHeldBackCommands() == 0) {
+        return;
+    }
+    // Held back commands are already tracked as pending. Batches are not, as
+    // their replies are split into a reply per held back command.
+    for (const auto& cmd : _putRemoveBatcher.flush()) {
+        forwardUp(cmd);
+    }
+}
+
+void
+Distributor::configureMaintenanceScanThreads()
+{
+    const uint32_t wantedThreads = getConfig().getMaintenanceScanThreads();
+    const uint32_t currentThreads = _scanThreadBundle ? _scanThreadBundle->size() : 1;
+    if (wantedThreads != currentThreads) {
+        LOG(debug, "Scanning bucket database for maintenance using %u thread(s)", wantedThreads);
+        _scanner->setThreadBundle(nullptr, 1);
+        _scanThreadBundle.reset();
+        if (wantedThreads > 1) {
+            _scanThreadBundle = std::make_unique<vespalib::SimpleThreadBundle>(wantedThreads);
+        }
+    }
+    _scanner->setThreadBundle(_scanThreadBundle.get(), getConfig().getMaintenanceScanBatchSize());
 }
 
 void
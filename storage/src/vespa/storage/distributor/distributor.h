@@ -10,6 +10,7 @@
 #include "idealstatemanager.h"
 #include "min_replica_provider.h"
 #include "pendingmessagetracker.h"
+#include "put_remove_batcher.h"
 #include "statusreporterdelegate.h"
 #include <vespa/config/config.h>
 #include <vespa/storage/common/distributorcomponent.h>
@@ -24,6 +25,8 @@
 #include <queue>
 #include <unordered_map>
 
+namespace vespalib { class SimpleThreadBundle; }
+
 namespace storage {
 
 struct DoneInitializeHandler;
@@ -221,6 +224,9 @@ private:
     void scanAllBuckets();
     MaintenanceScanner::ScanResult scanNextBucket();
     void enableNextConfig();
+    void configureMaintenanceScanThreads();
+    void forwardUp(const std::shared_ptr<api::StorageMessage>& msg);
+    void flushPutRemoveBatches();
     void fetchStatusRequests();
     void fetchExternalMessages();
     void startNextMaintenanceOperation();
@@ -284,6 +290,7 @@ private:
     >;
     MessageQueue _messageQueue;
     ClientRequestPriorityQueue _client_request_priority_queue;
+    PutRemoveBatcher _putRemoveBatcher;
     MessageQueue _fetchedMessages;
     framework::TickingThreadPool& _threadPool;
     vespalib::Monitor _statusMonitor;
@@ -301,11 +308,13 @@ private:
 
     std::unique_ptr<BucketPriorityDatabase> _bucketPriorityDb;
     std::unique_ptr<SimpleMaintenanceScanner> _scanner;
+    std::unique_ptr<vespalib::SimpleThreadBundle> _scanThreadBundle;
     std::unique_ptr<ThrottlingOperationStarter> _throttlingStarter;
     std::unique_ptr<BlockingOperationStarter> _blockingStarter;
     std::unique_ptr<MaintenanceScheduler> _scheduler;
     MaintenanceScheduler::SchedulingMode _schedulingMode;
     framework::MilliSecTimer _recoveryTimeStarted;
+    framework::MilliSecTimer _scanTimeStarted;
     framework::ThreadWaitInfo _tickResult;
     const std::string _clusterName;
     BucketDBMetricUpdater _bucketDBMetricUpdater;
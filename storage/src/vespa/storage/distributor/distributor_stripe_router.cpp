@@ -0,0 +1,74 @@
+// Copyright 2019 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "distributor_stripe_router.h"
+#include <vespa/storageapi/message/persistence.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/stringfmt.h>
+
+namespace storage::distributor {
+
+DistributorStripeRouter::DistributorStripeRouter(uint32_t numStripes)
+    : _bucketIdFactory(),
+      _numStripes(numStripes),
+      _stripeBits(calcStripeBits(numStripes))
+{
+}
+
+DistributorStripeRouter::~DistributorStripeRouter() = default;
+
+uint8_t
+DistributorStripeRouter::calcStripeBits(uint32_t numStripes)
+{
+    if ((numStripes == 0) || (numStripes > MAX_STRIPES) || ((numStripes & (numStripes - 1)) != 0)) {
+        throw vespalib::IllegalArgumentException(
+                vespalib::make_string("Number of distributor stripes must be a power of two in [1, %u], was %u",
+                                      MAX_STRIPES, numStripes), VESPA_STRLOC);
+    }
+    uint8_t bits = 0;
+    while ((1u << bits) < numStripes) {
+        ++bits;
+    }
+    return bits;
+}
+
+uint32_t
+DistributorStripeRouter::stripeOfBucketKey(uint64_t key, uint8_t stripeBits) noexcept
+{
+    if (stripeBits == 0) {
+        return 0;
+    }
+    return static_cast<uint32_t>(key >> (64 - stripeBits));
+}
+
+uint32_t
+DistributorStripeRouter::stripeOf(const document::BucketId& bucketId) const noexcept
+{
+    if (bucketId.getUsedBits() < _stripeBits) {
+        return NO_STRIPE;
+    }
+    return stripeOfBucketKey(bucketId.toKey(), _stripeBits);
+}
+
+uint32_t
+DistributorStripeRouter::stripeOf(const api::StorageMessage& msg) const
+{
+    switch (msg.getType().getId()) {
+    case api::MessageType::PUT_ID:
+    case api::MessageType::UPDATE_ID:
+    case api::MessageType::REMOVE_ID:
+        return stripeOf(_bucketIdFactory.getBucketId(
+                static_cast<const api::TestAndSetCommand&>(msg).getDocumentId()));
+    case api::MessageType::GET_ID:
+        return stripeOf(_bucketIdFactory.getBucketId(
+                static_cast<const api::GetCommand&>(msg).getDocumentId()));
+    default:
+        break;
+    }
+    document::BucketId bucketId(msg.getBucketId());
+    if (bucketId.getRawId() == 0) {
+        return NO_STRIPE;
+    }
+    return stripeOf(bucketId);
+}
+
+}
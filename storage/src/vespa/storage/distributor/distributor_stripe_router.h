@@ -0,0 +1,60 @@
+// Copyright 2019 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/document/bucket/bucketid.h>
+#include <vespa/document/bucket/bucketidfactory.h>
+#include <limits>
+
+namespace storage::api { class StorageMessage; }
+
+namespace storage::distributor {
+
+/**
+ * Partitions the bucket key space of a distributor into a power of two number
+ * of stripes, each of which can be owned by a separate thread with its own
+ * bucket database shard and pending message tracker.
+ *
+ * A bucket is assigned to a stripe by the most significant bits of its bucket
+ * key (i.e. the least significant bits of its bucket id). Since bucket
+ * databases are ordered by key, each stripe owns a contiguous key range, and a
+ * bucket stays in the same stripe across splits and joins as long as it uses
+ * at least as many bits as there are stripe bits.
+ */
+class DistributorStripeRouter {
+    document::BucketIdFactory _bucketIdFactory;
+    uint32_t _numStripes;
+    uint8_t  _stripeBits;
+public:
+    static constexpr uint32_t NO_STRIPE = std::numeric_limits<uint32_t>::max();
+    static constexpr uint32_t MAX_STRIPES = 256;
+
+    /**
+     * Number of stripes must be a power of two in [1, MAX_STRIPES].
+     */
+    explicit DistributorStripeRouter(uint32_t numStripes);
+    ~DistributorStripeRouter();
+
+    uint32_t numStripes() const noexcept { return _numStripes; }
+    uint8_t stripeBits() const noexcept { return _stripeBits; }
+
+    /**
+     * Returns the stripe owning the given bucket, or NO_STRIPE if the bucket
+     * uses too few bits to be contained within a single stripe.
+     */
+    uint32_t stripeOf(const document::BucketId& bucketId) const noexcept;
+
+    /**
+     * Returns the stripe that should process the given message. Document
+     * operations are routed by the bucket of their document id, other bucket
+     * messages by their bucket. Messages not bound to a single stripe (e.g.
+     * cluster state changes, bucket-less visitors or status requests) give
+     * NO_STRIPE, and must be handled by the top-level distributor or be
+     * broadcast to all stripes.
+     */
+    uint32_t stripeOf(const api::StorageMessage& msg) const;
+
+    static uint8_t calcStripeBits(uint32_t numStripes);
+    static uint32_t stripeOfBucketKey(uint64_t key, uint8_t stripeBits) noexcept;
+};
+
+}
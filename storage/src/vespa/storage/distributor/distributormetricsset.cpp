@@ -27,6 +27,9 @@ DistributorMetricSet::DistributorMetricSet(const metrics::LoadTypeSet& lt)
       recoveryModeTime("recoverymodeschedulingtime", {},
               "Time spent scheduling operations in recovery mode "
               "after receiving new cluster state", this),
+      maintenanceScanTime("maintenance_scan_time", {},
+              "Time (in ms) spent on a complete scan of the bucket database "
+              "checking buckets for pending maintenance", this),
       docsStored("docsstored",
               {{"logdefault"},{"yamasdefault"}},
               "Number of documents stored in all buckets controlled by "
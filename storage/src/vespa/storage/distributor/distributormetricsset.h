@@ -24,6 +24,7 @@ public:
     metrics::LoadMetric<VisitorMetricSet> visits;
     metrics::DoubleAverageMetric stateTransitionTime;
     metrics::DoubleAverageMetric recoveryModeTime;
+    metrics::DoubleAverageMetric maintenanceScanTime;
     metrics::LongValueMetric docsStored;
     metrics::LongValueMetric bytesStored;
 
@@ -23,5 +23,16 @@ operator<<(std::ostream& os, const NodeMaintenanceStats& stats)
 NodeMaintenanceStatsTracker::NodeMaintenanceStatsTracker() {}
 NodeMaintenanceStatsTracker::~NodeMaintenanceStatsTracker() {}
 
+void
+NodeMaintenanceStatsTracker::merge(const NodeMaintenanceStatsTracker& rhs)
+{
+    for (const auto& nodeEntry : rhs._stats) {
+        auto& bucketSpacesStats = _stats[nodeEntry.first];
+        for (const auto& bucketSpaceEntry : nodeEntry.second) {
+            bucketSpacesStats[bucketSpaceEntry.first].merge(bucketSpaceEntry.second);
+        }
+    }
+}
+
 }
 
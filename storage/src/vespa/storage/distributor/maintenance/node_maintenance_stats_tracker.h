@@ -32,6 +32,14 @@ struct NodeMaintenanceStats
                 && copyingOut == other.copyingOut
                 && total == other.total);
     }
+
+    void merge(const NodeMaintenanceStats& rhs) noexcept {
+        movingOut += rhs.movingOut;
+        syncing += rhs.syncing;
+        copyingIn += rhs.copyingIn;
+        copyingOut += rhs.copyingOut;
+        total += rhs.total;
+    }
 };
 
 std::ostream& operator<<(std::ostream&, const NodeMaintenanceStats&);
@@ -87,6 +95,11 @@ public:
     const PerNodeStats& perNodeStats() const {
         return _stats;
     }
+
+    /**
+     * Adds all statistics recorded by rhs to the statistics of this tracker.
+     */
+    void merge(const NodeMaintenanceStatsTracker& rhs);
 };
 
 } // distributor
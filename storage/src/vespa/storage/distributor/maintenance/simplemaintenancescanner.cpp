@@ -1,9 +1,38 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include "simplemaintenancescanner.h"
 #include <vespa/storage/distributor/distributor_bucket_space.h>
+#include <vespa/vespalib/util/thread_bundle.h>
 
 namespace storage::distributor {
 
+/**
+ * Runs the priority generator for a contiguous range of a scan batch. Each
+ * shard keeps its own per-node statistics, which are merged into the pending
+ * maintenance stats by the scanner once all shards are done.
+ */
+class SimpleMaintenanceScanner::PrioritizeShard : public vespalib::Runnable
+{
+    const MaintenancePriorityGenerator& _priorityGenerator;
+    BatchEntry* _begin;
+    BatchEntry* _end;
+    NodeMaintenanceStatsTracker _stats;
+public:
+    PrioritizeShard(const MaintenancePriorityGenerator& priorityGenerator, BatchEntry* begin, BatchEntry* end)
+        : _priorityGenerator(priorityGenerator),
+          _begin(begin),
+          _end(end),
+          _stats()
+    { }
+
+    void run() override {
+        for (BatchEntry* itr = _begin; itr != _end; ++itr) {
+            itr->priority = _priorityGenerator.prioritize(document::Bucket(itr->bucketSpace, itr->entry.getBucketId()), _stats);
+        }
+    }
+
+    const NodeMaintenanceStatsTracker& getStats() const { return _stats; }
+};
+
 SimpleMaintenanceScanner::SimpleMaintenanceScanner(BucketPriorityDatabase& bucketPriorityDb,
                                                    const MaintenancePriorityGenerator& priorityGenerator,
                                                    const DistributorBucketSpaceRepo& bucketSpaceRepo)
@@ -11,24 +40,31 @@ SimpleMaintenanceScanner::SimpleMaintenanceScanner(BucketPriorityDatabase& bucke
       _priorityGenerator(priorityGenerator),
       _bucketSpaceRepo(bucketSpaceRepo),
       _bucketSpaceItr(_bucketSpaceRepo.begin()),
-      _bucketCursor()
+      _bucketCursor(),
+      _pendingMaintenance(),
+      _threadBundle(nullptr),
+      _batchSize(1),
+      _batch(),
+      _batchPos(0)
 {
 }
 
 SimpleMaintenanceScanner::~SimpleMaintenanceScanner() {}
 
+SimpleMaintenanceScanner::BatchEntry::~BatchEntry() = default;
+
 SimpleMaintenanceScanner::PendingMaintenanceStats::PendingMaintenanceStats() {}
 SimpleMaintenanceScanner::PendingMaintenanceStats::~PendingMaintenanceStats() {}
 SimpleMaintenanceScanner::PendingMaintenanceStats::PendingMaintenanceStats(const PendingMaintenanceStats &) = default;
 SimpleMaintenanceScanner::PendingMaintenanceStats &
 SimpleMaintenanceScanner::PendingMaintenanceStats::operator = (const PendingMaintenanceStats &) = default;
 
-MaintenanceScanner::ScanResult
-SimpleMaintenanceScanner::scanNext()
+BucketDatabase::Entry
+SimpleMaintenanceScanner::fetchNext()
 {
     for (;;) {
         if (_bucketSpaceItr == _bucketSpaceRepo.end()) {
-            return ScanResult::createDone();
+            return BucketDatabase::Entry();
         }
         const auto &bucketDb(_bucketSpaceItr->second->getBucketDatabase());
         BucketDatabase::Entry entry(bucketDb.getNext(_bucketCursor));
@@ -37,10 +73,78 @@ SimpleMaintenanceScanner::scanNext()
             _bucketCursor = document::BucketId();
             continue;
         }
-        countBucket(_bucketSpaceItr->first, entry.getBucketInfo());
-        prioritizeBucket(document::Bucket(_bucketSpaceItr->first, entry.getBucketId()));
         _bucketCursor = entry.getBucketId();
-        return ScanResult::createNotDone(_bucketSpaceItr->first, entry);
+        return entry;
+    }
+}
+
+MaintenanceScanner::ScanResult
+SimpleMaintenanceScanner::scanNext()
+{
+    if (_threadBundle != nullptr) {
+        return scanNextInBatch();
+    }
+    BucketDatabase::Entry entry(fetchNext());
+    if (!entry.valid()) {
+        return ScanResult::createDone();
+    }
+    countBucket(_bucketSpaceItr->first, entry.getBucketInfo());
+    prioritizeBucket(document::Bucket(_bucketSpaceItr->first, entry.getBucketId()));
+    return ScanResult::createNotDone(_bucketSpaceItr->first, entry);
+}
+
+MaintenanceScanner::ScanResult
+SimpleMaintenanceScanner::scanNextInBatch()
+{
+    if (_batchPos == _batch.size()) {
+        fillBatch();
+        if (_batch.empty()) {
+            return ScanResult::createDone();
+        }
+        prioritizeBatch();
+    }
+    const BatchEntry &batchEntry(_batch[_batchPos++]);
+    return ScanResult::createNotDone(batchEntry.bucketSpace, batchEntry.entry);
+}
+
+void
+SimpleMaintenanceScanner::fillBatch()
+{
+    _batch.clear();
+    _batchPos = 0;
+    while (_batch.size() < _batchSize) {
+        BucketDatabase::Entry entry(fetchNext());
+        if (!entry.valid()) {
+            break;
+        }
+        countBucket(_bucketSpaceItr->first, entry.getBucketInfo());
+        _batch.emplace_back(_bucketSpaceItr->first, entry);
+    }
+}
+
+void
+SimpleMaintenanceScanner::prioritizeBatch()
+{
+    const size_t numShards = std::min(_threadBundle->size(), _batch.size());
+    std::vector<PrioritizeShard> shards;
+    std::vector<vespalib::Runnable *> targets;
+    shards.reserve(numShards);
+    targets.reserve(numShards);
+    BatchEntry *batchStart = _batch.data();
+    for (size_t i = 0; i < numShards; ++i) {
+        shards.emplace_back(_priorityGenerator,
+                            batchStart + (_batch.size() * i) / numShards,
+                            batchStart + (_batch.size() * (i + 1)) / numShards);
+    }
+    for (auto &shard : shards) {
+        targets.push_back(&shard);
+    }
+    _threadBundle->run(targets);
+    for (const auto &shard : shards) {
+        _pendingMaintenance.perNodeStats.merge(shard.getStats());
+    }
+    for (const auto &batchEntry : _batch) {
+        updatePriority(document::Bucket(batchEntry.bucketSpace, batchEntry.entry.getBucketId()), batchEntry.priority);
     }
 }
 
@@ -50,6 +154,27 @@ SimpleMaintenanceScanner::reset()
     _bucketCursor = document::BucketId();
     _bucketSpaceItr = _bucketSpaceRepo.begin();
     _pendingMaintenance = PendingMaintenanceStats();
+    _batch.clear();
+    _batchPos = 0;
+}
+
+void
+SimpleMaintenanceScanner::setThreadBundle(vespalib::ThreadBundle* threadBundle, uint32_t batchSize)
+{
+    if ((threadBundle == nullptr) || (threadBundle->size() <= 1)) {
+        threadBundle = nullptr;
+        batchSize = 1;
+    }
+    batchSize = std::max(batchSize, 1u);
+    if ((threadBundle == _threadBundle) && (batchSize == _batchSize)) {
+        return;
+    }
+    _threadBundle = threadBundle;
+    _batchSize = batchSize;
+    // Entries left in the current batch were fetched, counted and prioritized
+    // under the old configuration. Restart the scan rather than handing them
+    // out later or skipping them.
+    reset();
 }
 
 void
@@ -66,7 +191,12 @@ SimpleMaintenanceScanner::countBucket(document::BucketSpace bucketSpace, const B
 void
 SimpleMaintenanceScanner::prioritizeBucket(const document::Bucket &bucket)
 {
-    MaintenancePriorityAndType pri(_priorityGenerator.prioritize(bucket, _pendingMaintenance.perNodeStats));
+    updatePriority(bucket, _priorityGenerator.prioritize(bucket, _pendingMaintenance.perNodeStats));
+}
+
+void
+SimpleMaintenanceScanner::updatePriority(const document::Bucket &bucket, const MaintenancePriorityAndType &pri)
+{
     if (pri.requiresMaintenance()) {
         _bucketPriorityDb.setPriority(PrioritizedBucket(bucket, pri.getPriority().getPriority()));
         assert(pri.getType() != MaintenanceOperation::OPERATION_COUNT);
@@ -7,6 +7,8 @@
 #include "node_maintenance_stats_tracker.h"
 #include <vespa/storage/distributor/distributor_bucket_space_repo.h>
 
+namespace vespalib { struct ThreadBundle; }
+
 namespace storage {
 namespace distributor {
 
@@ -29,14 +31,37 @@ public:
         NodeMaintenanceStatsTracker perNodeStats;
     };
 private:
+    struct BatchEntry {
+        document::BucketSpace bucketSpace;
+        BucketDatabase::Entry entry;
+        MaintenancePriorityAndType priority;
+
+        BatchEntry(document::BucketSpace bucketSpace_, const BucketDatabase::Entry& entry_)
+            : bucketSpace(bucketSpace_),
+              entry(entry_),
+              priority(MaintenancePriority(), MaintenanceOperation::OPERATION_COUNT)
+        { }
+        ~BatchEntry();
+    };
+    class PrioritizeShard;
+
     BucketPriorityDatabase& _bucketPriorityDb;
     const MaintenancePriorityGenerator& _priorityGenerator;
     const DistributorBucketSpaceRepo &_bucketSpaceRepo;
     DistributorBucketSpaceRepo::BucketSpaceMap::const_iterator _bucketSpaceItr;
     document::BucketId _bucketCursor;
     PendingMaintenanceStats _pendingMaintenance;
+    vespalib::ThreadBundle* _threadBundle;
+    uint32_t _batchSize;
+    std::vector<BatchEntry> _batch;
+    size_t _batchPos;
 
     void countBucket(document::BucketSpace bucketSpace, const BucketInfo &info);
+    BucketDatabase::Entry fetchNext();
+    ScanResult scanNextInBatch();
+    void fillBatch();
+    void prioritizeBatch();
+    void updatePriority(const document::Bucket &bucket, const MaintenancePriorityAndType &pri);
 public:
     SimpleMaintenanceScanner(BucketPriorityDatabase& bucketPriorityDb,
                              const MaintenancePriorityGenerator& priorityGenerator,
@@ -48,6 +73,22 @@ public:
     ScanResult scanNext() override;
     void reset() override;
 
+    /**
+     * Enables sharded scanning, where the bucket database is scanned in
+     * batches of up to batchSize buckets, and the state checkers for the
+     * buckets in a batch are run in parallel by the threads in the given
+     * bundle. The bucket database is not modified while a batch is being
+     * prioritized, as the distributor thread participates in the work and
+     * does not return until all shards are done. Priorities are fed into the
+     * bucket priority database in bucket order after the batch completes.
+     *
+     * A nullptr bundle (or a bundle of size 1) restores one-bucket-at-a-time
+     * scanning. The bundle must outlive the scanner or be reset before
+     * being destroyed. Changing the bundle or the batch size restarts the
+     * current scan, so no batch built under the old settings is used.
+     */
+    void setThreadBundle(vespalib::ThreadBundle* threadBundle, uint32_t batchSize);
+
     // TODO: move out into own interface!
     void prioritizeBucket(const document::Bucket &id);
 
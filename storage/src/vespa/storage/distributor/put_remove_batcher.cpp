@@ -0,0 +1,149 @@
+// Copyright 2019 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "put_remove_batcher.h"
+#include <vespa/storageapi/message/batch.h>
+#include <vespa/storageapi/message/persistence.h>
+#include <cassert>
+
+namespace storage::distributor {
+
+PutRemoveBatcher::PutRemoveBatcher(uint32_t maxBatchSize)
+    : _maxBatchSize(std::max(maxBatchSize, 1u)),
+      _numHeldBack(0),
+      _groupIndex(),
+      _groups(),
+      _pendingBatches()
+{
+}
+
+PutRemoveBatcher::~PutRemoveBatcher() = default;
+
+bool
+PutRemoveBatcher::isBatchable(const api::StorageCommand& cmd)
+{
+    const api::StorageMessageAddress* address = cmd.getAddress();
+    if ((address == nullptr) || (address->getProtocol() != api::StorageMessageAddress::STORAGE)) {
+        return false;
+    }
+    switch (cmd.getType().getId()) {
+    case api::MessageType::PUT_ID: {
+        const auto& put = static_cast<const api::PutCommand&>(cmd);
+        return !put.getCondition().isPresent() && (put.getUpdateTimestamp() == 0);
+    }
+    case api::MessageType::REMOVE_ID:
+        return !static_cast<const api::RemoveCommand&>(cmd).getCondition().isPresent();
+    default:
+        return false;
+    }
+}
+
+bool
+PutRemoveBatcher::add(const CommandSP& cmd)
+{
+    if ((_maxBatchSize <= 1) || !isBatchable(*cmd)) {
+        return false;
+    }
+    const auto& bucket = static_cast<const api::BucketInfoCommand&>(*cmd).getBucket();
+    GroupKey key(cmd->getAddress()->getIndex(), bucket.getBucketSpace().getId(), bucket.getBucketId().getId());
+    auto itr = _groupIndex.find(key);
+    if (itr == _groupIndex.end()) {
+        itr = _groupIndex.emplace(key, _groups.size()).first;
+        _groups.emplace_back();
+    }
+    _groups[itr->second].push_back(cmd);
+    ++_numHeldBack;
+    return true;
+}
+
+PutRemoveBatcher::CommandSP
+PutRemoveBatcher::makeBatch(std::vector<CommandSP> cmds)
+{
+    const api::StorageCommand& first = *cmds.front();
+    auto batch = std::make_shared<api::BatchPutRemoveCommand>(static_cast<const api::BucketInfoCommand&>(first).getBucket());
+    batch->setAddress(*first.getAddress());
+    batch->setSourceIndex(first.getSourceIndex());
+    batch->setLoadType(first.getLoadType());
+    api::StorageMessage::Priority priority = first.getPriority();
+    uint32_t timeout = first.getTimeout();
+    for (const auto& cmd : cmds) {
+        priority = std::min(priority, cmd->getPriority());
+        timeout = std::min(timeout, cmd->getTimeout());
+        if (cmd->getType().getId() == api::MessageType::PUT_ID) {
+            const auto& put = static_cast<const api::PutCommand&>(*cmd);
+            batch->addPut(put.getDocument(), put.getTimestamp());
+        } else {
+            const auto& remove = static_cast<const api::RemoveCommand&>(*cmd);
+            batch->addRemove(remove.getDocumentId(), remove.getTimestamp());
+        }
+    }
+    batch->setPriority(priority);
+    batch->setTimeout(timeout);
+    _pendingBatches.emplace(batch->getMsgId(), std::move(cmds));
+    return batch;
+}
+
+std::vector<PutRemoveBatcher::CommandSP>
+PutRemoveBatcher::flush()
+{
+    std::vector<CommandSP> result;
+    for (auto& group : _groups) {
+        for (size_t start = 0; start < group.size(); start += _maxBatchSize) {
+            size_t end = std::min(group.size(), start + _maxBatchSize);
+            if (end - start == 1) {
+                result.push_back(std::move(group[start]));
+            } else {
+                result.push_back(makeBatch(std::vector<CommandSP>(std::make_move_iterator(group.begin() + start),
+                                                                  std::make_move_iterator(group.begin() + end))));
+            }
+        }
+    }
+    _groups.clear();
+    _groupIndex.clear();
+    _numHeldBack = 0;
+    return result;
+}
+
+std::vector<PutRemoveBatcher::ReplySP>
+PutRemoveBatcher::splitReply(const api::BatchPutRemoveReply& reply)
+{
+    std::vector<ReplySP> result;
+    auto itr = _pendingBatches.find(reply.getMsgId());
+    if (itr == _pendingBatches.end()) {
+        return result;
+    }
+    std::vector<CommandSP> cmds(std::move(itr->second));
+    _pendingBatches.erase(itr);
+
+    const auto& opResults = reply.getOperationResults();
+    const bool batchFailed = reply.getResult().failed() || (opResults.size() != cmds.size());
+    result.reserve(cmds.size());
+    for (size_t i = 0; i < cmds.size(); ++i) {
+        std::shared_ptr<api::StorageReply> opReply(cmds[i]->makeReply().release());
+        if (batchFailed) {
+            opReply->setResult(reply.getResult().failed()
+                               ? reply.getResult()
+                               : api::ReturnCode(api::ReturnCode::INTERNAL_FAILURE,
+                                                 "Batch reply does not have a result per operation"));
+        } else {
+            opReply->setResult(opResults[i].result);
+            static_cast<api::BucketInfoReply&>(*opReply).setBucketInfo(reply.getBucketInfo());
+            if (cmds[i]->getType().getId() == api::MessageType::REMOVE_ID) {
+                auto& removeReply = static_cast<api::RemoveReply&>(*opReply);
+                removeReply.setOldTimestamp(opResults[i].found ? removeReply.getTimestamp() : 0);
+            }
+        }
+        result.push_back(std::move(opReply));
+    }
+    return result;
+}
+
+void
+PutRemoveBatcher::clear()
+{
+    _groups.clear();
+    _groupIndex.clear();
+    _numHeldBack = 0;
+    _pendingBatches.clear();
+}
+
+}
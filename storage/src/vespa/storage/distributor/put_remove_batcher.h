@@ -0,0 +1,82 @@
+// Copyright 2019 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/document/bucket/bucket.h>
+#include <vespa/storageapi/messageapi/storagemessage.h>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace storage::api {
+class StorageCommand;
+class StorageReply;
+class BatchPutRemoveReply;
+}
+
+namespace storage::distributor {
+
+/**
+ * Coalesces puts and removes sent by the distributor to the same bucket on the
+ * same content node into BatchPutRemoveCommands, and splits the reply of a
+ * batch back into one reply per original command.
+ *
+ * Commands are held back from the time they are added until the next flush,
+ * which the distributor does once per tick. Groups with a single command are
+ * sent as is. Conditional (test-and-set) puts and removes and puts with an
+ * update timestamp are never batched, as the batch command cannot carry them.
+ *
+ * Batching is disabled with a max batch size of 1. It must only be enabled
+ * when all content nodes understand the batch command.
+ */
+class PutRemoveBatcher {
+public:
+    using CommandSP = std::shared_ptr<api::StorageCommand>;
+    using ReplySP = std::shared_ptr<api::StorageReply>;
+
+    explicit PutRemoveBatcher(uint32_t maxBatchSize);
+    ~PutRemoveBatcher();
+
+    void setMaxBatchSize(uint32_t maxBatchSize) { _maxBatchSize = std::max(maxBatchSize, 1u); }
+    uint32_t getMaxBatchSize() const noexcept { return _maxBatchSize; }
+
+    /**
+     * Returns true if the command was held back for batching, in which case it
+     * is sent (batched or not) by a later flush().
+     */
+    bool add(const CommandSP& cmd);
+
+    /**
+     * Returns the commands to send for everything added since the last flush,
+     * in the order the groups were first added to.
+     */
+    std::vector<CommandSP> flush();
+
+    /**
+     * Returns the replies to the commands of the batch the given reply belongs
+     * to, in batch order. Returns an empty vector if the batch is not known.
+     */
+    std::vector<ReplySP> splitReply(const api::BatchPutRemoveReply& reply);
+
+    /** Forgets all held back commands and pending batches. */
+    void clear();
+
+    size_t numHeldBackCommands() const noexcept { return _numHeldBack; }
+    size_t numPendingBatches() const noexcept { return _pendingBatches.size(); }
+
+    static bool isBatchable(const api::StorageCommand& cmd);
+private:
+    using GroupKey = std::tuple<uint16_t, document::BucketSpace::Type, document::BucketId::Type>;
+
+    uint32_t _maxBatchSize;
+    size_t _numHeldBack;
+    std::map<GroupKey, size_t> _groupIndex;
+    std::vector<std::vector<CommandSP>> _groups;
+    std::unordered_map<api::StorageMessage::Id, std::vector<CommandSP>> _pendingBatches;
+
+    CommandSP makeBatch(std::vector<CommandSP> cmds);
+};
+
+}
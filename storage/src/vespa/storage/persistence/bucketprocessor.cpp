@@ -42,12 +42,25 @@ BucketProcessor::iterateAll(spi::PersistenceProvider& provider,
                             EntryProcessor& processor,
                             spi::IncludedVersions versions,
                             spi::Context& context)
+{
+    iterateAll(provider, bucket, documentSelection, document::HeaderFields(),
+               processor, versions, context);
+}
+
+void
+BucketProcessor::iterateAll(spi::PersistenceProvider& provider,
+                            const spi::Bucket& bucket,
+                            const std::string& documentSelection,
+                            const document::FieldSet& fields,
+                            EntryProcessor& processor,
+                            spi::IncludedVersions versions,
+                            spi::Context& context)
 {
     spi::Selection sel
         = spi::Selection(spi::DocumentSelection(documentSelection));
     spi::CreateIteratorResult createIterResult(provider.createIterator(
                                                        bucket,
-                                                       document::HeaderFields(),
+                                                       fields,
                                                        sel,
                                                        versions,
                                                        context));
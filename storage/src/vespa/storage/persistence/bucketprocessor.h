@@ -8,6 +8,8 @@
 
 #include <vespa/persistence/spi/persistenceprovider.h>
 
+namespace document { class FieldSet; }
+
 namespace storage {
 
 class BucketProcessor
@@ -25,6 +27,19 @@ public:
                            EntryProcessor&,
                            spi::IncludedVersions,
                            spi::Context&);
+
+    /**
+     * As above, but only the given fields are fetched for each entry. Use
+     * document::DocIdOnly when only document ids are needed, which lets the
+     * provider avoid materializing full documents.
+     */
+    static void iterateAll(spi::PersistenceProvider&,
+                           const spi::Bucket&,
+                           const std::string& documentSelection,
+                           const document::FieldSet& fields,
+                           EntryProcessor&,
+                           spi::IncludedVersions,
+                           spi::Context&);
 };
 
 }
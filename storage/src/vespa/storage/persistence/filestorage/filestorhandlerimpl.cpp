@@ -240,6 +240,7 @@ FileStorHandlerImpl::messageMayBeAborted(const api::StorageMessage& msg)
     case api::MessageType::PUT_ID:
     case api::MessageType::REMOVE_ID:
     case api::MessageType::REVERT_ID:
+    case api::MessageType::BATCHPUTREMOVE_ID:
     case api::MessageType::MERGEBUCKET_ID:
     case api::MessageType::GETBUCKETDIFF_ID:
     case api::MessageType::APPLYBUCKETDIFF_ID:
@@ -584,6 +585,7 @@ FileStorHandlerImpl::remapMessage(api::StorageMessage& msg, const document::Buck
     }
     case api::MessageType::STAT_ID:
     case api::MessageType::REVERT_ID:
+    case api::MessageType::BATCHPUTREMOVE_ID:
     case api::MessageType::REMOVELOCATION_ID:
     case api::MessageType::SETBUCKETSTATE_ID:
     {
@@ -8,6 +8,7 @@
 #include <vespa/storage/common/content_bucket_space_repo.h>
 #include <vespa/vdslib/state/cluster_state_bundle.h>
 #include <vespa/storage/common/messagebucket.h>
+#include <vespa/storageapi/message/batch.h>
 #include <vespa/storage/config/config-stor-server.h>
 #include <vespa/storage/persistence/bucketownershipnotifier.h>
 #include <vespa/storage/persistence/persistencethread.h>
@@ -311,6 +312,27 @@ FileStorManager::onRemove(const shared_ptr<api::RemoveCommand>& cmd)
     return true;
 }
 
+bool
+FileStorManager::onBatchPutRemove(const shared_ptr<api::BatchPutRemoveCommand>& cmd)
+{
+    for (uint32_t i = 0; i < cmd->getOperationCount(); ++i) {
+        if (cmd->getOperation(i).timestamp == 0) {
+            shared_ptr<api::StorageReply> reply = cmd->makeReply();
+            std::string msg("Batch put/remove command received with an operation "
+                            "without timestamp set. Distributor need to set timestamp "
+                            "to ensure equal timestamps between storage nodes. Rejecting.");
+            reply->setResult(api::ReturnCode(api::ReturnCode::REJECTED, msg));
+            sendUp(reply);
+            return true;
+        }
+    }
+    StorBucketDatabase::WrappedEntry entry(mapOperationToBucketAndDisk(*cmd, 0));
+    if (entry.exist()) {
+        handlePersistenceMessage(cmd, entry->disk);
+    }
+    return true;
+}
+
 bool
 FileStorManager::onRevert(const shared_ptr<api::RevertCommand>& cmd)
 {
@@ -5,6 +5,7 @@
 #include "bucketownershipnotifier.h"
 #include "testandsethelper.h"
 #include <vespa/storageapi/message/bucketsplitting.h>
+#include <vespa/storageapi/message/batch.h>
 #include <vespa/storage/common/bucketoperationlogger.h>
 #include <vespa/document/fieldset/fieldsetrepo.h>
 #include <vespa/document/update/documentupdate.h>
@@ -81,6 +82,16 @@ PersistenceThread::checkForError(const spi::Result& response, MessageTracker& tr
 }
 
 
+api::ReturnCode
+PersistenceThread::toReturnCode(const spi::Result& response) const
+{
+    uint32_t code = _env.convertErrorCode(response);
+    if (code != 0) {
+        return api::ReturnCode(static_cast<api::ReturnCode::Result>(code), response.getErrorMessage());
+    }
+    return api::ReturnCode(api::ReturnCode::OK);
+}
+
 bool PersistenceThread::tasConditionExists(const api::TestAndSetCommand & cmd) {
     return cmd.getCondition().isPresent();
 }
@@ -143,6 +154,39 @@ PersistenceThread::handleRemove(api::RemoveCommand& cmd)
     return tracker;
 }
 
+MessageTracker::UP
+PersistenceThread::handleBatchPutRemove(api::BatchPutRemoveCommand& cmd)
+{
+    auto& metrics = _env._metrics.multiOp[cmd.getLoadType()];
+    auto tracker = std::make_unique<MessageTracker>(metrics, _env._component.getClock());
+    metrics.request_size.addValue(cmd.getApproxByteSize());
+
+    // Verify that all documents belong in the bucket before applying anything,
+    // so that the batch either fails as a whole or has a result per operation.
+    for (uint32_t i = 0; i < cmd.getOperationCount(); ++i) {
+        getBucket(cmd.getOperation(i).getDocumentId(), cmd.getBucket());
+    }
+    spi::Bucket bucket(cmd.getBucket(), spi::PartitionId(_env._partition));
+    auto reply = std::make_shared<api::BatchPutRemoveReply>(cmd);
+    for (uint32_t i = 0; i < cmd.getOperationCount(); ++i) {
+        const api::BatchPutRemoveCommand::Operation& op = cmd.getOperation(i);
+        if (op.type == api::BatchPutRemoveCommand::Operation::PUT) {
+            const auto& put = static_cast<const api::BatchPutRemoveCommand::PutOperation&>(op);
+            spi::Result response = _spi.put(bucket, spi::Timestamp(op.timestamp), put.document, _context);
+            reply->addOperationResult(toReturnCode(response), false);
+        } else {
+            spi::RemoveResult response = _spi.removeIfFound(bucket, spi::Timestamp(op.timestamp),
+                                                            op.getDocumentId(), _context);
+            reply->addOperationResult(toReturnCode(response), response.wasFound());
+            if (!response.hasError() && !response.wasFound()) {
+                _env._metrics.remove[cmd.getLoadType()].notFound.inc();
+            }
+        }
+    }
+    tracker->setReply(reply);
+    return tracker;
+}
+
 MessageTracker::UP
 PersistenceThread::handleUpdate(api::UpdateCommand& cmd)
 {
@@ -725,6 +769,8 @@ PersistenceThread::handleCommandSplitByType(api::StorageCommand& msg)
         return handleRemove(static_cast<api::RemoveCommand&>(msg));
     case api::MessageType::UPDATE_ID:
         return handleUpdate(static_cast<api::UpdateCommand&>(msg));
+    case api::MessageType::BATCHPUTREMOVE_ID:
+        return handleBatchPutRemove(static_cast<api::BatchPutRemoveCommand&>(msg));
     case api::MessageType::REVERT_ID:
         return handleRevert(static_cast<api::RevertCommand&>(msg));
     case api::MessageType::CREATEBUCKET_ID:
@@ -872,7 +918,8 @@ bool isBatchable(const api::StorageMessage& msg)
     return (msg.getType().getId() == api::MessageType::PUT_ID ||
             msg.getType().getId() == api::MessageType::REMOVE_ID ||
             msg.getType().getId() == api::MessageType::UPDATE_ID ||
-            msg.getType().getId() == api::MessageType::REVERT_ID);
+            msg.getType().getId() == api::MessageType::REVERT_ID ||
+            msg.getType().getId() == api::MessageType::BATCHPUTREMOVE_ID);
 }
 
 bool hasBucketInfo(const api::StorageMessage& msg)
@@ -30,6 +30,7 @@ public:
 
     MessageTracker::UP handlePut(api::PutCommand& cmd);
     MessageTracker::UP handleRemove(api::RemoveCommand& cmd);
+    MessageTracker::UP handleBatchPutRemove(api::BatchPutRemoveCommand& cmd);
     MessageTracker::UP handleUpdate(api::UpdateCommand& cmd);
     MessageTracker::UP handleGet(api::GetCommand& cmd);
     MessageTracker::UP handleRevert(api::RevertCommand& cmd);
@@ -81,6 +82,7 @@ private:
     // Thread main loop
     void run(framework::ThreadHandle&) override;
     bool checkForError(const spi::Result& response, MessageTracker& tracker);
+    api::ReturnCode toReturnCode(const spi::Result& response) const;
     spi::Bucket getBucket(const DocumentId& id, const document::Bucket &bucket) const;
 
     void flushAllReplies(const document::Bucket& bucket, std::vector<MessageTracker::UP>& trackers);
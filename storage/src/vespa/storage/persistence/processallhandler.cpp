@@ -2,6 +2,7 @@
 
 #include "processallhandler.h"
 #include "bucketprocessor.h"
+#include <vespa/document/fieldset/fieldsets.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 
 #include <vespa/log/log.h>
@@ -89,9 +90,12 @@ ProcessAllHandler::handleRemoveLocation(api::RemoveLocationCommand& cmd,
 
     spi::Bucket bucket(cmd.getBucket(), spi::PartitionId(_env._partition));
     UnrevertableRemoveEntryProcessor processor(_spi, bucket, context);
+    // Only document ids are needed to remove the matching documents, which
+    // lets the provider evaluate the selection without fetching full documents.
     BucketProcessor::iterateAll(_spi,
                                 bucket,
                                 cmd.getDocumentSelection(),
+                                document::DocIdOnly(),
                                 processor,
                                 spi::NEWEST_DOCUMENT_ONLY,
                                 context);
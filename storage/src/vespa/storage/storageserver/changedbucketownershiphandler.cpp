@@ -336,6 +336,7 @@ ChangedBucketOwnershipHandler::isMutatingExternalOperation(
     case api::MessageType::REMOVE_ID:
     case api::MessageType::UPDATE_ID:
     case api::MessageType::REVERT_ID:
+    case api::MessageType::BATCHPUTREMOVE_ID:
         return true;
     default:
         return false;
@@ -6,6 +6,7 @@
 #include <vespa/documentapi/messagebus/messages/wrongdistributionreply.h>
 #include <vespa/messagebus/emptyreply.h>
 #include <vespa/messagebus/network/rpcnetworkparams.h>
+#include <vespa/messagebus/network/rpctargetpool.h>
 #include <vespa/messagebus/rpcmessagebus.h>
 #include <vespa/storage/common/bucket_resolver.h>
 #include <vespa/storage/common/nodestateupdater.h>
@@ -412,6 +413,11 @@ void CommunicationManager::configure(std::unique_ptr<CommunicationManagerConfig>
         LOG(debug, "setting up slobrok config from id: '%s", _configUri.getConfigId().c_str());
         mbus::RPCNetworkParams params(_configUri);
         params.setConnectionExpireSecs(config->mbus.rpctargetcache.ttl);
+        params.setNumTargetsPerSpec(std::max(1, config->mbus.rpctargetcache.numTargetsPerSpec));
+        params.setTargetSelection((config->mbus.rpctargetcache.targetSelection
+                                   == CommunicationManagerConfig::Mbus::Rpctargetcache::TargetSelection::LEAST_LOADED)
+                                  ? mbus::RPCTargetSelection::LEAST_LOADED
+                                  : mbus::RPCTargetSelection::ROUND_ROBIN);
         params.setNumThreads(std::max(1, config->mbus.numThreads));
         params.setDispatchOnDecode(config->mbus.dispatchOnDecode);
         params.setDispatchOnEncode(config->mbus.dispatchOnEncode);
@@ -426,6 +432,8 @@ void CommunicationManager::configure(std::unique_ptr<CommunicationManagerConfig>
                 CommunicationManagerConfig::Mbus::Compress::getTypeName(config->mbus.compress.type).c_str());
         params.setCompressionConfig(CompressionConfig(compressionType, config->mbus.compress.level,
                                                       90, config->mbus.compress.limit));
+        params.setAdaptiveCompression(config->mbus.compress.adaptive);
+        params.setWireNanosPerByte(config->mbus.compress.wireNanosPerByte);
         // Configure messagebus here as we for legacy reasons have
         // config here.
         _mbus = std::make_unique<mbus::RPCMessageBus>(
@@ -757,10 +765,49 @@ CommunicationManager::run(framework::ThreadHandle& thread)
     }
 }
 
+namespace {
+
+void
+updateTargetMetrics(CommunicationManagerMetrics &metrics, const std::vector<mbus::RPCTargetPool::TargetStats> &targets)
+{
+    uint64_t pending = 0;
+    uint32_t maxPending = 0;
+    uint64_t completed = 0;
+    double totalLatencyMs = 0.0;
+    uint64_t compressed = 0;
+    uint64_t inputBytes = 0;
+    uint64_t outputBytes = 0;
+    uint64_t compressNanos = 0;
+    for (const auto &target : targets) {
+        pending += target.stats.pending;
+        maxPending = std::max(maxPending, target.stats.pending);
+        completed += target.stats.completed;
+        totalLatencyMs += target.stats.avgLatencyMs * target.stats.completed;
+        const auto &compression = target.stats.compression;
+        compressed += compression.payloads - compression.selected[0];
+        inputBytes += compression.inputBytes;
+        outputBytes += compression.outputBytes;
+        compressNanos += compression.compressNanos;
+    }
+    metrics.mbusTargets.set(targets.size());
+    metrics.mbusTargetPending.set(pending);
+    metrics.mbusTargetMaxPending.set(maxPending);
+    metrics.mbusTargetLatency.set((completed > 0) ? (totalLatencyMs / completed) : 0.0);
+    metrics.mbusAdaptiveCompressed.set(compressed);
+    metrics.mbusAdaptiveInputBytes.set(inputBytes);
+    metrics.mbusAdaptiveOutputBytes.set(outputBytes);
+    metrics.mbusAdaptiveCompressTime.set(compressNanos / 1000000.0);
+}
+
+}
+
 void
 CommunicationManager::updateMetrics(const MetricLockGuard &)
 {
     _metrics.queueSize.addValue(_eventQueue.size());
+    if (_mbus) {
+        updateTargetMetrics(_metrics, _mbus->getRPCNetwork().getTargetPool().getStats());
+    }
 }
 
 void
@@ -24,7 +24,22 @@ CommunicationManagerMetrics::CommunicationManagerMetrics(const LoadTypeSet& load
       bucketSpaceMappingFailures("bucket_space_mapping_failures", {},
                                  "Number of messages that could not be resolved to a known bucket space", this),
       sendCommandLatency("sendcommandlatency", {}, "Average ms used to send commands to MBUS", this),
-      sendReplyLatency("sendreplylatency", {}, "Average ms used to send replies to MBUS", this)
+      sendReplyLatency("sendreplylatency", {}, "Average ms used to send replies to MBUS", this),
+      mbusTargets("mbus_targets", {}, "Number of open connections to other MBUS services", this),
+      mbusTargetPending("mbus_target_pending", {},
+                        "Number of requests sent on MBUS connections that have not yet completed", this),
+      mbusTargetMaxPending("mbus_target_max_pending", {},
+                           "Highest number of pending requests on a single MBUS connection", this),
+      mbusTargetLatency("mbus_target_latency", {},
+                        "Average ms from sending a request on an MBUS connection until it completes", this),
+      mbusAdaptiveCompressed("mbus_adaptive_compressed", {},
+                             "Number of payloads adaptive compression chose to compress on open MBUS connections", this),
+      mbusAdaptiveInputBytes("mbus_adaptive_input_bytes", {},
+                             "Bytes given to adaptive compression on open MBUS connections", this),
+      mbusAdaptiveOutputBytes("mbus_adaptive_output_bytes", {},
+                              "Bytes sent after adaptive compression on open MBUS connections", this),
+      mbusAdaptiveCompressTime("mbus_adaptive_compress_time", {},
+                               "Total ms spent by adaptive compression on open MBUS connections", this)
 {
 }
 
@@ -21,6 +21,14 @@ struct CommunicationManagerMetrics : public metrics::MetricSet {
     metrics::LongCountMetric bucketSpaceMappingFailures;
     metrics::DoubleAverageMetric sendCommandLatency;
     metrics::DoubleAverageMetric sendReplyLatency;
+    metrics::LongValueMetric mbusTargets;
+    metrics::LongValueMetric mbusTargetPending;
+    metrics::LongValueMetric mbusTargetMaxPending;
+    metrics::DoubleValueMetric mbusTargetLatency;
+    metrics::LongValueMetric mbusAdaptiveCompressed;
+    metrics::LongValueMetric mbusAdaptiveInputBytes;
+    metrics::LongValueMetric mbusAdaptiveOutputBytes;
+    metrics::DoubleValueMetric mbusAdaptiveCompressTime;
 
     CommunicationManagerMetrics(const metrics::LoadTypeSet& loadTypes, metrics::MetricSet* owner = 0);
     ~CommunicationManagerMetrics();
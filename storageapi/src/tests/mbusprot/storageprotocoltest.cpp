@@ -5,6 +5,7 @@
 #include <vespa/storageapi/message/bucketsplitting.h>
 #include <vespa/storageapi/message/internal.h>
 #include <vespa/storageapi/message/removelocation.h>
+#include <vespa/storageapi/message/batch.h>
 #include <vespa/storageapi/mbusprot/storageprotocol.h>
 #include <vespa/storageapi/mbusprot/storagecommand.h>
 #include <vespa/storageapi/mbusprot/storagereply.h>
@@ -44,6 +45,7 @@ struct StorageProtocolTest : public CppUnit::TestFixture {
     vespalib::Version _version5_1{5, 1, 0};
     vespalib::Version _version5_2{5, 93, 30};
     vespalib::Version _version6_0{6, 240, 0};
+    vespalib::Version _version7_0{7, 41, 0};
     documentapi::LoadTypeSet _loadTypes;
     mbusprot::StorageProtocol _protocol;
     static std::vector<std::string> _nonVerboseMessageStrings;
@@ -65,6 +67,8 @@ struct StorageProtocolTest : public CppUnit::TestFixture {
     std::shared_ptr<Command> copyCommand(const std::shared_ptr<Command>&, vespalib::Version);
     template<typename Reply>
     std::shared_ptr<Reply> copyReply(const std::shared_ptr<Reply>&);
+    template<typename Reply>
+    std::shared_ptr<Reply> copyReply(const std::shared_ptr<Reply>&, vespalib::Version);
     void recordOutput(const api::StorageMessage& msg);
 
     void recordSerialization50();
@@ -102,6 +106,9 @@ struct StorageProtocolTest : public CppUnit::TestFixture {
     void testCreateVisitorWithBucketSpace6_0();
     void testRequestBucketInfoWithBucketSpace6_0();
 
+    void testBatchPutRemove7_0();
+    void testBatchPutRemoveNotSupportedBefore7_0();
+
     void serialized_size_is_used_to_set_approx_size_of_storage_message();
 
     CPPUNIT_TEST_SUITE(StorageProtocolTest);
@@ -144,6 +151,10 @@ struct StorageProtocolTest : public CppUnit::TestFixture {
     CPPUNIT_TEST(testCreateVisitorWithBucketSpace6_0);
     CPPUNIT_TEST(testRequestBucketInfoWithBucketSpace6_0);
 
+    // 7.0 tests
+    CPPUNIT_TEST(testBatchPutRemove7_0);
+    CPPUNIT_TEST(testBatchPutRemoveNotSupportedBefore7_0);
+
     CPPUNIT_TEST(serialized_size_is_used_to_set_approx_size_of_storage_message);
 
     CPPUNIT_TEST_SUITE_END();
@@ -218,10 +229,16 @@ StorageProtocolTest::copyCommand(const std::shared_ptr<Command>& m, vespalib::Ve
 
 template<typename Reply> std::shared_ptr<Reply>
 StorageProtocolTest::copyReply(const std::shared_ptr<Reply>& m)
+{
+    return copyReply(m, _version5_1);
+}
+
+template<typename Reply> std::shared_ptr<Reply>
+StorageProtocolTest::copyReply(const std::shared_ptr<Reply>& m, vespalib::Version version)
 {
     mbus::Reply::UP mbusMessage(new mbusprot::StorageReply(m));
-    mbus::Blob blob = _protocol.encode(_version5_1, *mbusMessage);
-    mbus::Routable::UP copy(_protocol.decode(_version5_1, blob));
+    mbus::Blob blob = _protocol.encode(version, *mbusMessage);
+    mbus::Routable::UP copy(_protocol.decode(version, blob));
     CPPUNIT_ASSERT(copy.get());
     mbusprot::StorageReply* copy2(
             dynamic_cast<mbusprot::StorageReply*>(copy.get()));
@@ -918,6 +935,56 @@ StorageProtocolTest::testRequestBucketInfoWithBucketSpace6_0()
     CPPUNIT_ASSERT_EQUAL(ids, cmd2->getBuckets());
 }
 
+void
+StorageProtocolTest::testBatchPutRemove7_0()
+{
+    ScopedName test("testBatchPutRemove7_0");
+
+    document::Bucket bucket(document::BucketSpace(5), _bucket.getBucketId());
+    auto cmd = std::make_shared<BatchPutRemoveCommand>(bucket);
+    cmd->addPut(_testDoc, 14);
+    cmd->addRemove(DocumentId("id:ns:testdoctype1::removed"), 15);
+
+    auto cmd2 = copyCommand(cmd, _version7_0);
+    CPPUNIT_ASSERT_EQUAL(bucket, cmd2->getBucket());
+    CPPUNIT_ASSERT_EQUAL(2u, cmd2->getOperationCount());
+    CPPUNIT_ASSERT_EQUAL(Timestamp(15), cmd2->getMaxTimestamp());
+
+    const auto& put = cmd2->getOperation(0);
+    CPPUNIT_ASSERT_EQUAL(BatchPutRemoveCommand::Operation::PUT, put.type);
+    CPPUNIT_ASSERT_EQUAL(Timestamp(14), put.timestamp);
+    CPPUNIT_ASSERT_EQUAL(*_testDoc, *static_cast<const BatchPutRemoveCommand::PutOperation&>(put).document);
+
+    const auto& remove = cmd2->getOperation(1);
+    CPPUNIT_ASSERT_EQUAL(BatchPutRemoveCommand::Operation::REMOVE, remove.type);
+    CPPUNIT_ASSERT_EQUAL(Timestamp(15), remove.timestamp);
+    CPPUNIT_ASSERT_EQUAL(DocumentId("id:ns:testdoctype1::removed"), remove.getDocumentId());
+
+    auto reply = std::make_shared<BatchPutRemoveReply>(*cmd2);
+    reply->addOperationResult(ReturnCode(ReturnCode::TIMEOUT, "put timed out"), true);
+    reply->addOperationResult(ReturnCode(ReturnCode::OK), false);
+    reply->setBucketInfo(BucketInfo(1,2,3,4,5, true, false, 48));
+    auto reply2 = copyReply(reply, _version7_0);
+    CPPUNIT_ASSERT_EQUAL(size_t(2), reply2->getOperationResults().size());
+    CPPUNIT_ASSERT_EQUAL(ReturnCode(ReturnCode::TIMEOUT, "put timed out"), reply2->getOperationResults()[0].result);
+    CPPUNIT_ASSERT(reply2->getOperationResults()[0].found);
+    CPPUNIT_ASSERT_EQUAL(ReturnCode(ReturnCode::OK), reply2->getOperationResults()[1].result);
+    CPPUNIT_ASSERT(!reply2->getOperationResults()[1].found);
+    CPPUNIT_ASSERT_EQUAL(1u, reply2->getFailedOperationCount());
+    CPPUNIT_ASSERT_EQUAL(BucketInfo(1,2,3,4,5, true, false, 48), reply2->getBucketInfo());
+}
+
+void
+StorageProtocolTest::testBatchPutRemoveNotSupportedBefore7_0()
+{
+    ScopedName test("testBatchPutRemoveNotSupportedBefore7_0");
+
+    auto cmd = std::make_shared<BatchPutRemoveCommand>(_bucket);
+    cmd->addRemove(_testDocId, 15);
+    mbusprot::StorageCommand mbusMessage(cmd);
+    CPPUNIT_ASSERT_EQUAL(size_t(0), _protocol.encode(_version6_0, mbusMessage).size());
+}
+
 void
 StorageProtocolTest::serialized_size_is_used_to_set_approx_size_of_storage_message()
 {
@@ -7,6 +7,7 @@
 #include <vespa/storageapi/message/bucketsplitting.h>
 #include <vespa/storageapi/message/visitor.h>
 #include <vespa/storageapi/message/removelocation.h>
+#include <vespa/storageapi/message/batch.h>
 #include <vespa/vespalib/util/exceptions.h>
 
 
@@ -137,6 +138,12 @@ ProtocolSerialization::encode(const api::StorageMessage& msg) const
     case api::MessageType::SETBUCKETSTATE_REPLY_ID:
         onEncode(buf, static_cast<const api::SetBucketStateReply&>(msg));
         break;
+    case api::MessageType::BATCHPUTREMOVE_ID:
+        onEncode(buf, static_cast<const api::BatchPutRemoveCommand&>(msg));
+        break;
+    case api::MessageType::BATCHPUTREMOVE_REPLY_ID:
+        onEncode(buf, static_cast<const api::BatchPutRemoveReply&>(msg));
+        break;
     default:
         LOG(error, "Trying to encode unhandled type %s",
             msg.getType().toString().c_str());
@@ -200,6 +207,8 @@ ProtocolSerialization::decodeCommand(mbus::BlobRef data) const
         cmd = onDecodeRemoveLocationCommand(buf); break;
     case api::MessageType::SETBUCKETSTATE_ID:
         cmd = onDecodeSetBucketStateCommand(buf); break;
+    case api::MessageType::BATCHPUTREMOVE_ID:
+        cmd = onDecodeBatchPutRemoveCommand(buf); break;
     default:
     {
         std::ostringstream ost;
@@ -262,6 +271,8 @@ ProtocolSerialization::decodeReply(mbus::BlobRef data, const api::StorageCommand
         reply = onDecodeRemoveLocationReply(cmd, buf); break;
     case api::MessageType::SETBUCKETSTATE_REPLY_ID:
         reply = onDecodeSetBucketStateReply(cmd, buf); break;
+    case api::MessageType::BATCHPUTREMOVE_REPLY_ID:
+        reply = onDecodeBatchPutRemoveReply(cmd, buf); break;
     default:
     {
         std::ostringstream ost;
@@ -272,4 +283,40 @@ ProtocolSerialization::decodeReply(mbus::BlobRef data, const api::StorageCommand
     return std::make_unique<StorageReply>(std::move(reply));
 }
 
+namespace {
+
+[[noreturn]] void
+throwUnsupported(const api::MessageType& type)
+{
+    throw vespalib::IllegalArgumentException(
+            "Message type " + type.toString() + " is not supported in this protocol version",
+            VESPA_STRLOC);
+}
+
+}
+
+void
+ProtocolSerialization::onEncode(GBBuf&, const api::BatchPutRemoveCommand&) const
+{
+    throwUnsupported(api::MessageType::BATCHPUTREMOVE);
+}
+
+void
+ProtocolSerialization::onEncode(GBBuf&, const api::BatchPutRemoveReply&) const
+{
+    throwUnsupported(api::MessageType::BATCHPUTREMOVE_REPLY);
+}
+
+api::StorageCommand::UP
+ProtocolSerialization::onDecodeBatchPutRemoveCommand(BBuf&) const
+{
+    throwUnsupported(api::MessageType::BATCHPUTREMOVE);
+}
+
+api::StorageReply::UP
+ProtocolSerialization::onDecodeBatchPutRemoveReply(const SCmd&, BBuf&) const
+{
+    throwUnsupported(api::MessageType::BATCHPUTREMOVE_REPLY);
+}
+
 }
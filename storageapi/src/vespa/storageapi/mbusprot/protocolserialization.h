@@ -50,6 +50,8 @@ class SetBucketStateReply;
 class CreateVisitorCommand;
 class RemoveLocationCommand;
 class RemoveLocationReply;
+class BatchPutRemoveCommand;
+class BatchPutRemoveReply;
 }
 
 namespace storage::mbusprot {
@@ -121,6 +123,9 @@ protected:
     virtual void onEncode(GBBuf&, const api::DestroyVisitorReply&) const = 0;
     virtual void onEncode(GBBuf&, const api::RemoveLocationCommand&) const = 0;
     virtual void onEncode(GBBuf&, const api::RemoveLocationReply&) const = 0;
+    // Only supported from protocol version 7.0 and onwards; older versions throw.
+    virtual void onEncode(GBBuf&, const api::BatchPutRemoveCommand&) const;
+    virtual void onEncode(GBBuf&, const api::BatchPutRemoveReply&) const;
 
     virtual SCmd::UP onDecodePutCommand(BBuf&) const = 0;
     virtual SRep::UP onDecodePutReply(const SCmd&, BBuf&) const = 0;
@@ -160,6 +165,8 @@ protected:
     virtual SRep::UP onDecodeDestroyVisitorReply(const SCmd&, BBuf&) const = 0;
     virtual SCmd::UP onDecodeRemoveLocationCommand(BBuf&) const = 0;
     virtual SRep::UP onDecodeRemoveLocationReply(const SCmd&, BBuf&) const = 0;
+    virtual SCmd::UP onDecodeBatchPutRemoveCommand(BBuf&) const;
+    virtual SRep::UP onDecodeBatchPutRemoveReply(const SCmd&, BBuf&) const;
 
     virtual document::Bucket getBucket(document::ByteBuffer& buf) const = 0;
     virtual void putBucket(const document::Bucket& bucket, vespalib::GrowableByteBuffer& buf) const = 0;
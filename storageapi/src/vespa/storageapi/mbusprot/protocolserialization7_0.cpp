@@ -0,0 +1,89 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "protocolserialization7_0.h"
+#include "serializationhelper.h"
+#include <vespa/storageapi/message/batch.h>
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/stringfmt.h>
+
+namespace storage::mbusprot {
+
+ProtocolSerialization7_0::ProtocolSerialization7_0(const std::shared_ptr<const document::DocumentTypeRepo> &repo,
+                                                   const documentapi::LoadTypeSet &loadTypes)
+    : ProtocolSerialization6_0(repo, loadTypes)
+{
+}
+
+void
+ProtocolSerialization7_0::onEncode(GBBuf& buf, const api::BatchPutRemoveCommand& msg) const
+{
+    putBucket(msg.getBucket(), buf);
+    buf.putInt(msg.getOperationCount());
+    for (uint32_t i = 0; i < msg.getOperationCount(); ++i) {
+        const api::BatchPutRemoveCommand::Operation& op = msg.getOperation(i);
+        buf.putByte(op.type);
+        buf.putLong(op.timestamp);
+        switch (op.type) {
+        case api::BatchPutRemoveCommand::Operation::PUT:
+            SH::putDocument(static_cast<const api::BatchPutRemoveCommand::PutOperation&>(op).document.get(), buf);
+            break;
+        case api::BatchPutRemoveCommand::Operation::REMOVE:
+            buf.putString(op.getDocumentId().toString());
+            break;
+        }
+    }
+    onEncodeBucketInfoCommand(buf, msg);
+}
+
+api::StorageCommand::UP
+ProtocolSerialization7_0::onDecodeBatchPutRemoveCommand(BBuf& buf) const
+{
+    document::Bucket bucket = getBucket(buf);
+    auto msg = std::make_unique<api::BatchPutRemoveCommand>(bucket);
+    uint32_t count = SH::getInt(buf);
+    for (uint32_t i = 0; i < count; ++i) {
+        uint8_t type = SH::getByte(buf);
+        api::Timestamp ts(SH::getLong(buf));
+        switch (type) {
+        case api::BatchPutRemoveCommand::Operation::PUT:
+            msg->addPut(SH::getDocument(buf, getTypeRepo()), ts);
+            break;
+        case api::BatchPutRemoveCommand::Operation::REMOVE:
+            msg->addRemove(document::DocumentId(SH::getString(buf)), ts);
+            break;
+        default:
+            throw vespalib::IllegalArgumentException(
+                    vespalib::make_string("Unknown batch operation type %u", type), VESPA_STRLOC);
+        }
+    }
+    onDecodeBucketInfoCommand(buf, *msg);
+    return msg;
+}
+
+void
+ProtocolSerialization7_0::onEncode(GBBuf& buf, const api::BatchPutRemoveReply& msg) const
+{
+    buf.putInt(msg.getOperationResults().size());
+    for (const auto& op : msg.getOperationResults()) {
+        SH::putReturnCode(op.result, buf);
+        buf.putBoolean(op.found);
+    }
+    onEncodeBucketInfoReply(buf, msg);
+}
+
+api::StorageReply::UP
+ProtocolSerialization7_0::onDecodeBatchPutRemoveReply(const SCmd& cmd, BBuf& buf) const
+{
+    auto msg = std::make_unique<api::BatchPutRemoveReply>(static_cast<const api::BatchPutRemoveCommand&>(cmd));
+    uint32_t count = SH::getInt(buf);
+    for (uint32_t i = 0; i < count; ++i) {
+        api::ReturnCode result(SH::getReturnCode(buf));
+        bool found = SH::getBoolean(buf);
+        msg->addOperationResult(result, found);
+    }
+    onDecodeBucketInfoReply(buf, *msg);
+    return msg;
+}
+
+}
@@ -0,0 +1,27 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "protocolserialization6_0.h"
+
+namespace storage::mbusprot {
+
+/**
+ * Protocol serialization version adding batched put/remove commands,
+ * allowing many small operations to the same bucket to share a single
+ * message between distributor and content node.
+ */
+class ProtocolSerialization7_0 : public ProtocolSerialization6_0
+{
+public:
+    ProtocolSerialization7_0(const std::shared_ptr<const document::DocumentTypeRepo> &repo,
+                             const documentapi::LoadTypeSet &loadTypes);
+
+protected:
+    void onEncode(GBBuf&, const api::BatchPutRemoveCommand&) const override;
+    void onEncode(GBBuf&, const api::BatchPutRemoveReply&) const override;
+    SCmd::UP onDecodeBatchPutRemoveCommand(BBuf&) const override;
+    SRep::UP onDecodeBatchPutRemoveReply(const SCmd&, BBuf&) const override;
+};
+
+}
@@ -0,0 +1,106 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "batch.h"
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/vespalib/stllike/asciistream.h>
+#include <algorithm>
+#include <ostream>
+
+namespace storage::api {
+
+IMPLEMENT_COMMAND(BatchPutRemoveCommand, BatchPutRemoveReply)
+IMPLEMENT_REPLY(BatchPutRemoveReply)
+
+BatchPutRemoveCommand::PutOperation::PutOperation(std::shared_ptr<document::Document> doc, Timestamp ts)
+    : Operation(PUT, ts),
+      document(std::move(doc))
+{}
+
+BatchPutRemoveCommand::PutOperation::~PutOperation() = default;
+
+const document::DocumentId&
+BatchPutRemoveCommand::PutOperation::getDocumentId() const
+{
+    return document->getId();
+}
+
+BatchPutRemoveCommand::RemoveOperation::RemoveOperation(const document::DocumentId& docId, Timestamp ts)
+    : Operation(REMOVE, ts),
+      documentId(docId)
+{}
+
+BatchPutRemoveCommand::RemoveOperation::~RemoveOperation() = default;
+
+BatchPutRemoveCommand::BatchPutRemoveCommand(const document::Bucket &bucket)
+    : BucketInfoCommand(MessageType::BATCHPUTREMOVE, bucket),
+      _operations(),
+      _maxTimestamp(0)
+{}
+
+BatchPutRemoveCommand::~BatchPutRemoveCommand() = default;
+
+void
+BatchPutRemoveCommand::addPut(std::shared_ptr<document::Document> document, Timestamp ts)
+{
+    _operations.push_back(std::make_unique<PutOperation>(std::move(document), ts));
+    _maxTimestamp = std::max(_maxTimestamp, ts);
+}
+
+void
+BatchPutRemoveCommand::addRemove(const document::DocumentId& docId, Timestamp ts)
+{
+    _operations.push_back(std::make_unique<RemoveOperation>(docId, ts));
+    _maxTimestamp = std::max(_maxTimestamp, ts);
+}
+
+vespalib::string
+BatchPutRemoveCommand::getSummary() const
+{
+    vespalib::asciistream stream;
+    stream << "BatchPutRemove(" << getBucketId() << ", " << _operations.size() << " operations)";
+    return stream.str();
+}
+
+void
+BatchPutRemoveCommand::print(std::ostream& out, bool verbose, const std::string& indent) const
+{
+    out << "BatchPutRemove(" << getBucketId() << ", " << _operations.size() << " operations";
+    if (verbose) {
+        for (const auto& op : _operations) {
+            out << "\n" << indent << "  " << (op->type == Operation::PUT ? "Put" : "Remove")
+                << "(" << op->getDocumentId() << ", " << op->timestamp << ")";
+        }
+    }
+    out << ")";
+    if (verbose) {
+        out << " : ";
+        BucketInfoCommand::print(out, verbose, indent);
+    }
+}
+
+BatchPutRemoveReply::BatchPutRemoveReply(const BatchPutRemoveCommand& cmd)
+    : BucketInfoReply(cmd),
+      _operationResults()
+{}
+
+BatchPutRemoveReply::~BatchPutRemoveReply() = default;
+
+uint32_t
+BatchPutRemoveReply::getFailedOperationCount() const
+{
+    return std::count_if(_operationResults.begin(), _operationResults.end(),
+                         [](const OperationResult& op) { return op.result.failed(); });
+}
+
+void
+BatchPutRemoveReply::print(std::ostream& out, bool verbose, const std::string& indent) const
+{
+    out << "BatchPutRemoveReply(" << getBucketId() << ", " << _operationResults.size() << " operations, "
+        << getFailedOperationCount() << " failed)";
+    if (verbose) {
+        out << " : ";
+        BucketInfoReply::print(out, verbose, indent);
+    }
+}
+
+}
@@ -0,0 +1,125 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+/**
+ * @file batch.h
+ *
+ * Batching of small put and remove operations targeting the same bucket, to
+ * amortize per-message overhead between distributor and content nodes.
+ */
+#pragma once
+
+#include <vespa/storageapi/messageapi/bucketinforeply.h>
+#include <vespa/storageapi/defs.h>
+#include <vespa/document/base/documentid.h>
+#include <vector>
+
+namespace document { class Document; }
+
+namespace storage::api {
+
+/**
+ * @class BatchPutRemoveCommand
+ * @ingroup message
+ *
+ * @brief Command containing a number of puts and removes to a single bucket.
+ *
+ * Operations are applied in the order they were added. A failing operation
+ * does not stop the following ones from being applied, and the reply holds
+ * the result of each operation.
+ */
+class BatchPutRemoveCommand : public BucketInfoCommand {
+public:
+    class Operation {
+    public:
+        enum Type {
+            PUT = 0,
+            REMOVE
+        };
+
+        Operation(Type type_, Timestamp ts) : type(type_), timestamp(ts) {}
+        virtual ~Operation() = default;
+
+        virtual const document::DocumentId& getDocumentId() const = 0;
+
+        Type type;
+        Timestamp timestamp;
+    };
+
+    class PutOperation : public Operation {
+    public:
+        PutOperation(std::shared_ptr<document::Document> document, Timestamp ts);
+        ~PutOperation() override;
+
+        const document::DocumentId& getDocumentId() const override;
+
+        std::shared_ptr<document::Document> document;
+    };
+
+    class RemoveOperation : public Operation {
+    public:
+        RemoveOperation(const document::DocumentId& docId, Timestamp ts);
+        ~RemoveOperation() override;
+
+        const document::DocumentId& getDocumentId() const override { return documentId; }
+
+        document::DocumentId documentId;
+    };
+
+    explicit BatchPutRemoveCommand(const document::Bucket &bucket);
+    ~BatchPutRemoveCommand() override;
+
+    void addPut(std::shared_ptr<document::Document> document, Timestamp ts);
+    void addRemove(const document::DocumentId& docId, Timestamp ts);
+
+    uint32_t getOperationCount() const { return _operations.size(); }
+    const Operation& getOperation(uint32_t index) const { return *_operations[index]; }
+    Operation& getOperation(uint32_t index) { return *_operations[index]; }
+
+    /** Highest timestamp of any contained operation, or 0 if empty. */
+    Timestamp getMaxTimestamp() const { return _maxTimestamp; }
+
+    vespalib::string getSummary() const override;
+    void print(std::ostream& out, bool verbose, const std::string& indent) const override;
+
+    DECLARE_STORAGECOMMAND(BatchPutRemoveCommand, onBatchPutRemove);
+private:
+    std::vector<std::unique_ptr<Operation>> _operations;
+    Timestamp _maxTimestamp;
+};
+
+/**
+ * @class BatchPutRemoveReply
+ * @ingroup message
+ *
+ * @brief Reply of a batch put/remove command.
+ *
+ * Holds one result per operation of the command, in command order. The result
+ * of the reply itself is only set to a failure if the batch as a whole could
+ * not be processed, in which case no operation has been applied and there are
+ * no operation results. Otherwise the bucket info reflects all operations that
+ * succeeded.
+ */
+class BatchPutRemoveReply : public BucketInfoReply {
+public:
+    struct OperationResult {
+        ReturnCode result;
+        // Whether a document existed with the given id. Only set for removes.
+        bool found;
+
+        OperationResult(const ReturnCode& result_, bool found_) : result(result_), found(found_) {}
+    };
+
+    explicit BatchPutRemoveReply(const BatchPutRemoveCommand& cmd);
+    ~BatchPutRemoveReply() override;
+
+    const std::vector<OperationResult>& getOperationResults() const { return _operationResults; }
+    void addOperationResult(const ReturnCode& result, bool found) { _operationResults.emplace_back(result, found); }
+    uint32_t getFailedOperationCount() const;
+
+    void print(std::ostream& out, bool verbose, const std::string& indent) const override;
+
+    DECLARE_STORAGEREPLY(BatchPutRemoveReply, onBatchPutRemoveReply)
+private:
+    std::vector<OperationResult> _operationResults;
+};
+
+}
@@ -105,6 +105,9 @@ class EmptyBucketsReply;
 class RemoveLocationCommand;
 class RemoveLocationReply;
 
+class BatchPutRemoveCommand;
+class BatchPutRemoveReply;
+
 #define _INTERNAL_DEF_ON_MC(m, c) bool m(const std::shared_ptr<storage::api::c> & ) override
 #define _INTERNAL_DEF_IMPL_ON_MC(m, c) bool m(const std::shared_ptr<storage::api::c> & ) override { return false; }
 #define _INTERNAL_IMPL_ON_MC(cl, m, c, p) bool cl::m(const std::shared_ptr<storage::api::c> & p)
@@ -325,6 +328,14 @@ public:
             const std::shared_ptr<api::RemoveLocationReply>&)
         { return false; }
 
+    virtual bool onBatchPutRemove(
+            const std::shared_ptr<api::BatchPutRemoveCommand>&)
+        { return false; }
+
+    virtual bool onBatchPutRemoveReply(
+            const std::shared_ptr<api::BatchPutRemoveReply>&)
+        { return false; }
+
     virtual ~MessageHandler() {}
 };
 
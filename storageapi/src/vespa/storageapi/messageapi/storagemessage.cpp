@@ -109,6 +109,8 @@ const MessageType MessageType::QUERYRESULT("QueryResult", QUERYRESULT_ID);
 const MessageType MessageType::QUERYRESULT_REPLY("QueryResult reply", QUERYRESULT_REPLY_ID, &MessageType::QUERYRESULT);
 const MessageType MessageType::SETBUCKETSTATE("SetBucketState", SETBUCKETSTATE_ID);
 const MessageType MessageType::SETBUCKETSTATE_REPLY("SetBucketStateReply", SETBUCKETSTATE_REPLY_ID, &MessageType::SETBUCKETSTATE);
+const MessageType MessageType::BATCHPUTREMOVE("BatchPutRemove", BATCHPUTREMOVE_ID);
+const MessageType MessageType::BATCHPUTREMOVE_REPLY("BatchPutRemoveReply", BATCHPUTREMOVE_REPLY_ID, &MessageType::BATCHPUTREMOVE);
 
 const MessageType&
 MessageType::MessageType::get(Id id)
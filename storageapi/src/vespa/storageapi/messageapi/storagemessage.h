@@ -151,6 +151,8 @@ public:
         SETBUCKETSTATE_REPLY_ID = 95,
         ACTIVATE_CLUSTER_STATE_VERSION_ID = 96,
         ACTIVATE_CLUSTER_STATE_VERSION_REPLY_ID = 97,
+        BATCHPUTREMOVE_ID = 98,
+        BATCHPUTREMOVE_REPLY_ID = 99,
         MESSAGETYPE_MAX_ID
     };
 
@@ -235,6 +237,8 @@ public:
     static const MessageType QUERYRESULT_REPLY;
     static const MessageType SETBUCKETSTATE;
     static const MessageType SETBUCKETSTATE_REPLY;
+    static const MessageType BATCHPUTREMOVE;
+    static const MessageType BATCHPUTREMOVE_REPLY;
 
     static const MessageType& get(Id id);
 
@@ -61,7 +61,14 @@ void drain(CryptoSocket &socket, SmartBuffer &buffer) {
 
 void write(CryptoSocket &socket, SmartBuffer &buffer) {
     auto chunk = buffer.obtain();
-    auto res = socket.write(chunk.data, chunk.size);
+    // exercise gathering writes by splitting the pending data in two
+    size_t first = chunk.size / 2;
+    struct iovec iov[2];
+    iov[0].iov_base = const_cast<char *>(chunk.data);
+    iov[0].iov_len = first;
+    iov[1].iov_base = const_cast<char *>(chunk.data + first);
+    iov[1].iov_len = chunk.size - first;
+    auto res = (first > 0) ? socket.writev(iov, 2) : socket.write(chunk.data, chunk.size);
     if (res > 0) {
         buffer.evict(res);
     } else {
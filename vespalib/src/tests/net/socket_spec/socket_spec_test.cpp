@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/net/socket_spec.h>
+#include <vespa/vespalib/util/host_name.h>
 
 using namespace vespalib;
 
@@ -123,4 +124,25 @@ TEST("require that replace_host gives invalid spec when used with less than 2 ho
     TEST_DO(verify_invalid(SocketSpec("ipc/name:my_socket").replace_host("foo")));
 }
 
+TEST("require that local equivalent is an ipc path derived from the port") {
+    EXPECT_EQUAL(SocketSpec("tcp/123").local_equivalent("/my/dir").spec(), "ipc/file:/my/dir/vespa-local-tcp-123");
+    EXPECT_EQUAL(SocketSpec("tcp/host:123").local_equivalent("/my/dir").spec(), "ipc/file:/my/dir/vespa-local-tcp-123");
+    EXPECT_FALSE(SocketSpec("tcp/123").local_equivalent("").valid());
+    EXPECT_FALSE(SocketSpec("tcp/0").local_equivalent("/my/dir").valid());
+    EXPECT_FALSE(SocketSpec("ipc/file:my_socket").local_equivalent("/my/dir").valid());
+    EXPECT_FALSE(SocketSpec("invalid").local_equivalent("/my/dir").valid());
+}
+
+TEST("require that local specs can be detected without host name lookup") {
+    EXPECT_TRUE(SocketSpec("tcp/123").is_local());
+    EXPECT_TRUE(SocketSpec("tcp/localhost:123").is_local());
+    EXPECT_TRUE(SocketSpec("tcp/127.0.0.1:123").is_local());
+    EXPECT_TRUE(SocketSpec("tcp/[::1]:123").is_local());
+    EXPECT_TRUE(SocketSpec::from_host_port(HostName::get(), 123).is_local());
+    EXPECT_TRUE(SocketSpec("ipc/file:my_socket").is_local());
+    EXPECT_TRUE(SocketSpec("ipc/name:my_socket").is_local());
+    EXPECT_FALSE(SocketSpec("tcp/some.other.host.invalid:123").is_local());
+    EXPECT_FALSE(SocketSpec("invalid").is_local());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -669,4 +669,55 @@ TEST("require that decode failure results in 0 return value") {
     EXPECT_EQUAL(BinaryFormat::decode(buf.get(), slime), 0u);
 }
 
+TEST("require that stream encoder produces the same bytes as encoding a slime") {
+    Slime slime;
+    Cursor &top = slime.setObject();
+    top.setLong("a", -5);
+    top.setString("b", "foo");
+    Cursor &c = top.setArray("c");
+    c.addDouble(2.5);
+    c.addBool(true);
+    c.addNix();
+    c.addData(Memory("bar"));
+    c.addArray();
+    Cursor &d = c.addObject();
+    d.setLong("a", 1000000);
+    d.setObject("d");
+    SimpleBuffer expect;
+    BinaryFormat::encode(slime, expect);
+
+    SymbolTable symbols;
+    symbols.insert("a");
+    symbols.insert("b");
+    symbols.insert("c");
+    symbols.insert("d");
+    SimpleBuffer actual;
+    {
+        BinaryStreamEncoder encoder(actual, symbols);
+        encoder.startObject(3);
+        encoder.key(Memory("a"));
+        encoder.addLong(-5);
+        encoder.key(Symbol(1));
+        encoder.addString("foo");
+        encoder.key(Memory("c"));
+        encoder.startArray(6);
+        encoder.addDouble(2.5);
+        encoder.addBool(true);
+        encoder.addNix();
+        encoder.addData(Memory("bar"));
+        encoder.startArray(0);
+        EXPECT_FALSE(encoder.done());
+        encoder.startObject(2);
+        encoder.key(Memory("a"));
+        encoder.addLong(1000000);
+        encoder.key(Memory("d"));
+        encoder.startObject(0);
+        EXPECT_TRUE(encoder.done());
+    }
+    EXPECT_EQUAL(MemCmp(expect.get()), MemCmp(actual.get()));
+    Slime decoded;
+    EXPECT_EQUAL(BinaryFormat::decode(actual.get(), decoded), actual.get().size);
+    EXPECT_EQUAL(slime, decoded);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,95 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+// Benchmark of per-request slime construction and binary encoding.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vespalib/util/stringfmt.h>
+
+using namespace vespalib;
+using namespace vespalib::slime::convenience;
+using vespalib::slime::BinaryStreamEncoder;
+using vespalib::slime::SlimeArena;
+using vespalib::slime::SymbolTable;
+
+constexpr size_t num_fields = 16;
+constexpr size_t num_docsums = 1000;
+constexpr double budget = 2.0;
+
+struct Fixture {
+    std::vector<vespalib::string> names;
+    std::vector<vespalib::string> values;
+    SymbolTable symbols;
+    SimpleBuffer buffer;
+    Fixture() : names(), values(), symbols(), buffer() {
+        for (size_t i = 0; i < num_fields; ++i) {
+            names.push_back(make_string("field_%zu", i));
+            values.push_back(make_string("some field content that is not too short %zu", i));
+            symbols.insert(names.back());
+        }
+    }
+    void clear() { buffer.evict(buffer.get().size); }
+    void fill(Slime &slime, size_t docid) const {
+        Cursor &docsum = slime.setObject();
+        for (size_t i = 0; i < num_fields; ++i) {
+            if ((i % 2) == 0) {
+                docsum.setLong(names[i], docid * i);
+            } else {
+                docsum.setString(names[i], values[i]);
+            }
+        }
+    }
+    void stream(size_t docid) {
+        BinaryStreamEncoder encoder(buffer, symbols);
+        encoder.startObject(num_fields);
+        for (size_t i = 0; i < num_fields; ++i) {
+            encoder.key(Symbol(i));
+            if ((i % 2) == 0) {
+                encoder.addLong(docid * i);
+            } else {
+                encoder.addString(values[i]);
+            }
+        }
+    }
+    void encode_fresh() {
+        for (size_t docid = 0; docid < num_docsums; ++docid) {
+            Slime slime;
+            fill(slime, docid);
+            slime::BinaryFormat::encode(slime, buffer);
+        }
+    }
+    void encode_arena() {
+        for (size_t docid = 0; docid < num_docsums; ++docid) {
+            auto slime = SlimeArena::lease();
+            fill(*slime, docid);
+            slime::BinaryFormat::encode(*slime, buffer);
+        }
+    }
+    void encode_stream() {
+        for (size_t docid = 0; docid < num_docsums; ++docid) {
+            stream(docid);
+        }
+    }
+};
+
+TEST_F("require that all encoding strategies produce the same bytes", Fixture) {
+    f1.encode_fresh();
+    vespalib::string expect = f1.buffer.get().make_string();
+    f1.clear();
+    f1.encode_arena();
+    EXPECT_EQUAL(expect, f1.buffer.get().make_string());
+    f1.clear();
+    f1.encode_stream();
+    EXPECT_EQUAL(expect, f1.buffer.get().make_string());
+}
+
+TEST_F("benchmark per-request slime encoding", Fixture) {
+    double fresh = BenchmarkTimer::benchmark([&](){ f1.clear(); f1.encode_fresh(); }, budget);
+    double arena = BenchmarkTimer::benchmark([&](){ f1.clear(); f1.encode_arena(); }, budget);
+    double stream = BenchmarkTimer::benchmark([&](){ f1.clear(); f1.encode_stream(); }, budget);
+    fprintf(stderr, "new slime per docsum:   %g us/docsum\n", fresh * 1000000.0 / num_docsums);
+    fprintf(stderr, "slime arena:            %g us/docsum\n", arena * 1000000.0 / num_docsums);
+    fprintf(stderr, "binary stream encoder:  %g us/docsum\n", stream * 1000000.0 / num_docsums);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -3,6 +3,8 @@
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/data/input.h>
 #include <vespa/vespalib/data/memory_input.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <cinttypes>
 #include <iostream>
 #include <fstream>
 
@@ -114,6 +116,24 @@ TEST_F("encode double", Slime) {
     EXPECT_EQUAL("0.5\n", make_json(f, false));
 }
 
+TEST("encode numbers the same way as printf") {
+    std::vector<int64_t> longs({0, 1, -1, 9, 10, -10, 1234567890123ll,
+                                std::numeric_limits<int64_t>::max(),
+                                std::numeric_limits<int64_t>::min()});
+    for (int64_t l: longs) {
+        Slime slime;
+        slime.setLong(l);
+        EXPECT_EQUAL(vespalib::make_string("%" PRId64, l), make_json(slime, true));
+    }
+    std::vector<double> doubles({0.0, -0.0, 1.0, -1.0, 0.5, 42.0, 123456.0, 999999.0, -999999.0,
+                                 1e6, 1234567.0, 1e-7, 3.14159265, 1e300, -2.5e-300});
+    for (double d: doubles) {
+        Slime slime;
+        slime.setDouble(d);
+        EXPECT_EQUAL(vespalib::make_string("%g", d), make_json(slime, true));
+    }
+}
+
 TEST_F("encode double nan", Slime) {
     f.setDouble(std::numeric_limits<double>::quiet_NaN());
     EXPECT_EQUAL("null", make_json(f, true));
@@ -132,6 +152,30 @@ TEST_F("encode string", Slime) {
     EXPECT_EQUAL("\"foo\"\n", make_json(f, false));
 }
 
+TEST("encode and decode strings with special characters at all positions") {
+    for (size_t len = 1; len < 100; ++len) {
+        for (size_t pos = 0; pos < len; ++pos) {
+            for (char special: {'"', '\'', '\\', '\n', '\x01'}) {
+                std::string str(len, 'x');
+                str[pos] = special;
+                std::string expect(str.substr(0, pos));
+                switch (special) {
+                case '"':    expect.append("\\\""); break;
+                case '\\':   expect.append("\\\\"); break;
+                case '\n':   expect.append("\\n"); break;
+                case '\x01': expect.append("\\u0001"); break;
+                default:     expect.push_back(special);
+                }
+                expect.append(str.substr(pos + 1));
+                Slime slime;
+                slime.setString(str);
+                EXPECT_EQUAL("\"" + expect + "\"", make_json(slime, true));
+                EXPECT_EQUAL(str, json_string(expect));
+            }
+        }
+    }
+}
+
 TEST_F("encode data", Slime) {
     char buf[8];
     for (int i = 0; i < 8; ++i) {
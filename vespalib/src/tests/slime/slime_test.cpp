@@ -452,4 +452,38 @@ TEST("require that top-level convenience accessors work as expected for arrays")
     EXPECT_EQUAL(const_array["c"].asLong(), 0);
 }
 
+TEST("require that reset slime is empty and reusable") {
+    Slime slime;
+    slime.setObject().setArray("foo").addLong(5);
+    EXPECT_EQUAL(1u, slime.symbols());
+    slime.reset();
+    EXPECT_EQUAL(0u, slime.symbols());
+    EXPECT_EQUAL(vespalib::slime::NIX::ID, slime.get().type().getId());
+    slime.setObject().setLong("bar", 7);
+    EXPECT_EQUAL(1u, slime.symbols());
+    EXPECT_EQUAL(7, slime["bar"].asLong());
+    EXPECT_FALSE(slime["foo"].valid());
+}
+
+TEST("require that slime arena reuses reset slime objects on the same thread") {
+    using vespalib::slime::SlimeArena;
+    size_t initial = SlimeArena::cached();
+    Slime *first = nullptr;
+    {
+        auto lease = SlimeArena::lease();
+        first = &lease.get();
+        lease->setObject().setLong("foo", 1);
+        {
+            auto nested = SlimeArena::lease();
+            EXPECT_NOT_EQUAL(first, &nested.get());
+            EXPECT_EQUAL(0u, nested->symbols());
+        }
+    }
+    EXPECT_EQUAL(std::max(initial, size_t(2)), SlimeArena::cached());
+    auto lease = SlimeArena::lease();
+    EXPECT_EQUAL(first, &lease.get());
+    EXPECT_EQUAL(0u, lease->symbols());
+    EXPECT_EQUAL(vespalib::slime::NIX::ID, lease->get().type().getId());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
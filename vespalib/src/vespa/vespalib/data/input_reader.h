@@ -59,6 +59,22 @@ public:
         return obtain_slow();
     }
 
+    /**
+     * Look at the input data that can be read next, without consuming
+     * it. Like obtain, this requests more data from the underlying
+     * Input if all obtained data has been read, which evicts the data
+     * already read (so it can no longer be unread). The returned
+     * memory is valid until the next operation on this reader. Use
+     * read to consume bytes after inspecting them.
+     *
+     * @return the available input data. Empty if and only if there
+     *         is no more input data available.
+     **/
+    Memory peek() {
+        size_t bytes = obtain();
+        return Memory(data(), bytes);
+    }
+
     /**
      * Read a single byte. Reading past the end of the input will
      * result in the reader failing with input underflow.
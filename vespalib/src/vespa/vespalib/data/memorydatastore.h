@@ -36,7 +36,12 @@ public:
     Reference push_back(const void * data, const size_t sz);
     void swap(MemoryDataStore & rhs) { _buffers.swap(rhs._buffers); }
     void clear() {
-        _buffers.clear();
+        // Keep the largest buffer around for reuse
+        if (_buffers.size() > 1) {
+            _buffers.front() = std::move(_buffers.back());
+            _buffers.erase(_buffers.begin() + 1, _buffers.end());
+        }
+        _writePos = 0;
     }
 private:
     std::vector<alloc::Alloc> _buffers;
@@ -0,0 +1,143 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "binary_stream_encoder.h"
+#include "binary_format.h"
+#include "symbol_table.h"
+#include "type.h"
+#include <cassert>
+
+namespace vespalib {
+namespace slime {
+
+using namespace binary_format;
+
+void
+BinaryStreamEncoder::before_value()
+{
+    if (_stack.empty()) {
+        assert(!_done);
+        return;
+    }
+    Frame &frame = _stack.back();
+    assert(frame.remaining > 0);
+    assert(!frame.object || frame.has_key);
+    frame.has_key = false;
+    --frame.remaining;
+}
+
+void
+BinaryStreamEncoder::after_value()
+{
+    while (!_stack.empty() && (_stack.back().remaining == 0)) {
+        _stack.pop_back();
+    }
+    _done = _stack.empty();
+}
+
+void
+BinaryStreamEncoder::start_container(uint32_t type, uint64_t children)
+{
+    before_value();
+    write_type_and_size(_out, type, children);
+    _stack.emplace_back(children, (type == OBJECT::ID));
+    after_value();
+}
+
+BinaryStreamEncoder::BinaryStreamEncoder(Output &output, const SymbolTable &symbols)
+    : _out(output, 8000),
+      _symbols(symbols),
+      _stack(),
+      _done(false)
+{
+    size_t numSymbols = _symbols.symbols();
+    write_cmpr_ulong(_out, numSymbols);
+    for (size_t i = 0; i < numSymbols; ++i) {
+        Memory image = _symbols.inspect(Symbol(i));
+        write_cmpr_ulong(_out, image.size);
+        _out.write(image.data, image.size);
+    }
+}
+
+BinaryStreamEncoder::~BinaryStreamEncoder() = default;
+
+void
+BinaryStreamEncoder::key(const Symbol &symbol)
+{
+    assert(!_stack.empty() && _stack.back().object && !_stack.back().has_key);
+    assert(symbol.getValue() < _symbols.symbols());
+    _stack.back().has_key = true;
+    write_cmpr_ulong(_out, symbol.getValue());
+}
+
+void
+BinaryStreamEncoder::key(Memory name)
+{
+    Symbol symbol = _symbols.lookup(name);
+    assert(!symbol.undefined());
+    key(symbol);
+}
+
+void
+BinaryStreamEncoder::addNix()
+{
+    before_value();
+    _out.write(NIX::ID);
+    after_value();
+}
+
+void
+BinaryStreamEncoder::addBool(bool bit)
+{
+    before_value();
+    _out.write(encode_type_and_meta(BOOL::ID, bit ? 1 : 0));
+    after_value();
+}
+
+void
+BinaryStreamEncoder::addLong(int64_t l)
+{
+    before_value();
+    write_type_and_bytes<false>(_out, LONG::ID, encode_zigzag(l));
+    after_value();
+}
+
+void
+BinaryStreamEncoder::addDouble(double d)
+{
+    before_value();
+    write_type_and_bytes<true>(_out, DOUBLE::ID, encode_double(d));
+    after_value();
+}
+
+void
+BinaryStreamEncoder::addString(Memory str)
+{
+    before_value();
+    write_type_and_size(_out, STRING::ID, str.size);
+    _out.write(str.data, str.size);
+    after_value();
+}
+
+void
+BinaryStreamEncoder::addData(Memory data)
+{
+    before_value();
+    write_type_and_size(_out, DATA::ID, data.size);
+    _out.write(data.data, data.size);
+    after_value();
+}
+
+void
+BinaryStreamEncoder::startArray(size_t children)
+{
+    start_container(ARRAY::ID, children);
+}
+
+void
+BinaryStreamEncoder::startObject(size_t fields)
+{
+    start_container(OBJECT::ID, fields);
+}
+
+} // namespace vespalib::slime
+} // namespace vespalib
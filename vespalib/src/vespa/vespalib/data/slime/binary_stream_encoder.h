@@ -0,0 +1,79 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "symbol.h"
+#include <vespa/vespalib/data/memory.h>
+#include <vespa/vespalib/data/output_writer.h>
+#include <vector>
+
+namespace vespalib {
+
+struct Output;
+
+namespace slime {
+
+class SymbolTable;
+
+/**
+ * Writes a value in the slime binary format directly to an output
+ * without building a Slime tree first. The produced bytes are
+ * identical to what BinaryFormat::encode produces for the equivalent
+ * Slime object using the same symbol table.
+ *
+ * Since the format places the symbol table in front of the value, all
+ * object field names must be known up front; they are taken from the
+ * symbol table given to the constructor and written right away.
+ * Arrays and objects are length prefixed, so their number of children
+ * must be given when they are started. A container is closed
+ * implicitly when its last child has been written. Inside an object,
+ * each value must be preceded by a call to one of the 'key' functions.
+ *
+ * All bytes are flushed to the output when the encoder is destructed.
+ **/
+class BinaryStreamEncoder
+{
+private:
+    struct Frame {
+        uint64_t remaining;
+        bool     object;
+        bool     has_key;
+        Frame(uint64_t remaining_in, bool object_in)
+            : remaining(remaining_in), object(object_in), has_key(false) {}
+    };
+
+    OutputWriter       _out;
+    const SymbolTable &_symbols;
+    std::vector<Frame> _stack;
+    bool               _done;
+
+    void before_value();
+    void after_value();
+    void start_container(uint32_t type, uint64_t children);
+
+public:
+    BinaryStreamEncoder(Output &output, const SymbolTable &symbols);
+    BinaryStreamEncoder(const BinaryStreamEncoder &) = delete;
+    BinaryStreamEncoder &operator=(const BinaryStreamEncoder &) = delete;
+    ~BinaryStreamEncoder();
+
+    void key(const Symbol &symbol);
+    void key(Memory name); // must be present in the symbol table
+
+    void addNix();
+    void addBool(bool bit);
+    void addLong(int64_t l);
+    void addDouble(double d);
+    void addString(Memory str);
+    void addData(Memory data);
+    void startArray(size_t children);
+    void startObject(size_t fields);
+
+    /**
+     * @return true when a complete top-level value has been written
+     **/
+    bool done() const { return _done; }
+};
+
+} // namespace vespalib::slime
+} // namespace vespalib
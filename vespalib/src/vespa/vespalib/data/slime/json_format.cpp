@@ -5,6 +5,7 @@
 #include "inserter.h"
 #include "slime.h"
 #include <vespa/vespalib/data/memory_input.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
 #include <vespa/vespalib/locale/c.h>
 #include <cmath>
 #include <sstream>
@@ -16,16 +17,44 @@ namespace vespalib::slime {
 
 namespace {
 
+const hwaccelrated::IAccelrated &
+accelrator()
+{
+    static hwaccelrated::IAccelrated::UP accel = hwaccelrated::IAccelrated::getAccelrator();
+    return *accel;
+}
+
+// Same output as printf("%" PRId64), without the format parsing.
+void writeLong(OutputWriter &out, int64_t value) {
+    char tmp[20];
+    char *end = tmp + sizeof(tmp);
+    char *p = end;
+    uint64_t abs = (value < 0) ? (0 - uint64_t(value)) : uint64_t(value);
+    do {
+        *--p = '0' + (abs % 10);
+        abs /= 10;
+    } while (abs != 0);
+    size_t len = end - p;
+    char *dst = out.reserve(len + 1);
+    if (value < 0) {
+        *dst++ = '-';
+        ++len;
+    }
+    memcpy(dst, p, end - p);
+    out.commit(len);
+}
+
 template <bool COMPACT>
 struct JsonEncoder : public ArrayTraverser,
                      public ObjectTraverser
 {
     OutputWriter &out;
+    const hwaccelrated::IAccelrated &accel;
     int level;
     bool head;
 
     JsonEncoder(OutputWriter &out_in)
-        : out(out_in), level(0), head(true) {}
+        : out(out_in), accel(accelrator()), level(0), head(true) {}
 
     void openScope(char c) {
         out.write(c);
@@ -61,44 +90,55 @@ struct JsonEncoder : public ArrayTraverser,
         }
     }
     void encodeLONG(int64_t value) {
-        out.printf("%" PRId64, value);
+        writeLong(out, value);
     }
     void encodeDOUBLE(double value) {
         if (std::isnan(value) || std::isinf(value)) {
             out.write("null", 4);
+        } else if ((value == std::trunc(value)) && (std::fabs(value) < 1e6) &&
+                   !((value == 0.0) && std::signbit(value)))
+        {
+            // "%g" prints integral values with at most 6 digits as plain integers
+            writeLong(out, int64_t(value));
         } else {
             out.printf("%g", value);
         }
     }
     void encodeSTRING(const Memory &memory) {
         const char *hex = "0123456789ABCDEF";
-        char *p = out.reserve(memory.size * 6 + 2);
-        size_t len = 2;
+        char *start = out.reserve(memory.size * 6 + 2);
+        char *p = start;
         *p++ = '"';
         const char *pos = memory.data;
         const char *end = memory.data + memory.size;
-        for (; pos < end; ++pos) {
-            uint8_t c = *pos;
+        while (pos < end) {
+            size_t plain = accel.skipPlainJsonChars(pos, end - pos);
+            memcpy(p, pos, plain);
+            p += plain;
+            pos += plain;
+            if (pos == end) {
+                break;
+            }
+            uint8_t c = *pos++;
             switch(c) {
-            case '"':  *p++ = '\\'; *p++ = '"';  len += 2; break;
-            case '\\': *p++ = '\\'; *p++ = '\\'; len += 2; break;
-            case '\b': *p++ = '\\'; *p++ = 'b';  len += 2; break;
-            case '\f': *p++ = '\\'; *p++ = 'f';  len += 2; break;
-            case '\n': *p++ = '\\'; *p++ = 'n';  len += 2; break;
-            case '\r': *p++ = '\\'; *p++ = 'r';  len += 2; break;
-            case '\t': *p++ = '\\'; *p++ = 't';  len += 2; break;
+            case '"':  *p++ = '\\'; *p++ = '"';  break;
+            case '\\': *p++ = '\\'; *p++ = '\\'; break;
+            case '\b': *p++ = '\\'; *p++ = 'b';  break;
+            case '\f': *p++ = '\\'; *p++ = 'f';  break;
+            case '\n': *p++ = '\\'; *p++ = 'n';  break;
+            case '\r': *p++ = '\\'; *p++ = 'r';  break;
+            case '\t': *p++ = '\\'; *p++ = 't';  break;
             default:
                 if (c > 0x1f) {
-                    *p++ = c; ++len;
+                    *p++ = c;
                 } else { // requires escaping according to RFC 4627
                     *p++ = '\\'; *p++ = 'u'; *p++ = '0'; *p++ = '0';
                     *p++ = hex[(c >> 4) & 0xf]; *p++ = hex[c & 0xf];
-                    len += 6;
                 }
             }
         }
-        *p = '"';
-        out.commit(len);
+        *p++ = '"';
+        out.commit(p - start);
     }
     void encodeDATA(const Memory &memory) {
         const char *hex = "0123456789ABCDEF";
@@ -176,11 +216,12 @@ JsonEncoder<COMPACT>::field(const Memory &symbol_name, const Inspector &inspecto
 
 struct JsonDecoder {
     InputReader &in;
+    const hwaccelrated::IAccelrated &accel;
     char c;
     vespalib::string key;
     vespalib::string value;
 
-    JsonDecoder(InputReader &reader) : in(reader), c(in.read()), key(), value() {}
+    JsonDecoder(InputReader &reader) : in(reader), accel(accelrator()), c(in.read()), key(), value() {}
 
     void next() {
         c = in.try_read();
@@ -214,6 +255,15 @@ struct JsonDecoder {
         }
     }
 
+    void readPlain(vespalib::string &str) {
+        Memory avail = in.peek();
+        size_t plain = accel.skipPlainJsonChars(avail.data, avail.size);
+        if (plain > 0) {
+            str.append(avail.data, plain);
+            in.read(plain);
+        }
+    }
+
     uint32_t readHexValue(uint32_t len);
     uint32_t dequoteUtf16();
     void readString(vespalib::string &str);
@@ -345,6 +395,7 @@ JsonDecoder::readString(vespalib::string &str)
             return;
         default:
             str.push_back(c);
+            readPlain(str);
             next();
             break;
         }
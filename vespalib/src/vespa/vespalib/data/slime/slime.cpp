@@ -6,6 +6,14 @@ namespace vespalib {
 
 Slime::~Slime() { }
 
+void
+Slime::reset()
+{
+    _root = RootValue(_stash.get());
+    _stash->clear();
+    _names->clear();
+}
+
 bool operator == (const Slime & a, const Slime & b)
 {
     return a.get() == b.get();
@@ -7,6 +7,7 @@
 #include "basic_value.h"
 #include "basic_value_factory.h"
 #include "binary_format.h"
+#include "binary_stream_encoder.h"
 #include "convenience.h"
 #include "cursor.h"
 #include "empty_value_factory.h"
@@ -21,6 +22,7 @@
 #include "object_value.h"
 #include "resolved_symbol.h"
 #include "root_value.h"
+#include "slime_arena.h"
 #include "symbol.h"
 #include "symbol_inserter.h"
 #include "symbol_lookup.h"
@@ -110,6 +112,13 @@ public:
         return *this;
     }
 
+    /**
+     * Drop all values and symbols while keeping the allocated memory
+     * for reuse. The object ends up in the same state as a newly
+     * constructed one.
+     **/
+    void reset();
+
     size_t symbols() const {
         return _names->symbols();
     }
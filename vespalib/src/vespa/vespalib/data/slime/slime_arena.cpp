@@ -0,0 +1,44 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "slime_arena.h"
+#include "slime.h"
+#include <vector>
+
+namespace vespalib {
+namespace slime {
+
+namespace {
+
+thread_local std::vector<std::unique_ptr<Slime>> _tlPool;
+
+}
+
+SlimeArena::Lease::~Lease()
+{
+    if (_slime && (_tlPool.size() < MAX_CACHED)) {
+        _slime->reset();
+        _tlPool.push_back(std::move(_slime));
+    }
+}
+
+SlimeArena::Lease
+SlimeArena::lease()
+{
+    if (_tlPool.empty()) {
+        Slime::Params params;
+        params.setChunkSize(CHUNK_SIZE);
+        return Lease(std::make_unique<Slime>(std::move(params)));
+    }
+    std::unique_ptr<Slime> slime = std::move(_tlPool.back());
+    _tlPool.pop_back();
+    return Lease(std::move(slime));
+}
+
+size_t
+SlimeArena::cached()
+{
+    return _tlPool.size();
+}
+
+} // namespace vespalib::slime
+} // namespace vespalib
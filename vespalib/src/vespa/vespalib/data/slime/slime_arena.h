@@ -0,0 +1,57 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <memory>
+
+namespace vespalib {
+
+class Slime;
+
+namespace slime {
+
+/**
+ * Per-thread pool of Slime objects for structures that live only
+ * for the duration of a single request, like docsums that are built
+ * and then encoded right away. A leased Slime is reset rather than
+ * destroyed when the lease ends, so the next lease on the same
+ * thread reuses its value stash and symbol table instead of
+ * allocating them again. Leases may be nested; each nesting level
+ * gets its own Slime object.
+ **/
+class SlimeArena
+{
+public:
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+    static constexpr size_t MAX_CACHED = 4;
+
+    class Lease
+    {
+    private:
+        std::unique_ptr<Slime> _slime;
+    public:
+        explicit Lease(std::unique_ptr<Slime> slime) : _slime(std::move(slime)) {}
+        Lease(Lease &&rhs) = default;
+        Lease(const Lease &) = delete;
+        Lease &operator=(const Lease &) = delete;
+        ~Lease();
+        Slime &get() { return *_slime; }
+        Slime &operator*() { return *_slime; }
+        Slime *operator->() { return _slime.get(); }
+    };
+
+    /**
+     * Obtain an empty Slime object owned by the calling thread. It
+     * is returned to the thread's pool when the lease is destructed,
+     * which must happen on the same thread.
+     **/
+    static Lease lease();
+
+    /**
+     * @return the number of idle Slime objects pooled for the calling thread
+     **/
+    static size_t cached();
+};
+
+} // namespace vespalib::slime
+} // namespace vespalib
@@ -2,6 +2,7 @@
 
 #include "avx2.h"
 #include "avxprivate.hpp"
+#include "jsonscan.hpp"
 
 namespace vespalib::hwaccelrated {
 
@@ -17,4 +18,10 @@ Avx2Accelrator::dotProduct(const double * af, const double * bf, size_t sz) cons
     return avx::dotProductSelectAlignment<double, 32>(af, bf, sz);
 }
 
+size_t
+Avx2Accelrator::skipPlainJsonChars(const char * s, size_t sz) const
+{
+    return json::skipPlainJsonChars<32>(s, sz);
+}
+
 }
@@ -14,6 +14,7 @@ class Avx2Accelrator : public AvxAccelrator
 public:
     float dotProduct(const float * a, const float * b, size_t sz) const override;
     double dotProduct(const double * a, const double * b, size_t sz) const override;
+    size_t skipPlainJsonChars(const char * s, size_t sz) const override;
 };
 
 }
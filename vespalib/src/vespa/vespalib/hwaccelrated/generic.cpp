@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "generic.h"
+#include "jsonscan.hpp"
 
 namespace vespalib::hwaccelrated {
 
@@ -113,4 +114,10 @@ GenericAccelrator::notBit(void * aOrg, size_t bytes) const
     }
 }
 
+size_t
+GenericAccelrator::skipPlainJsonChars(const char * s, size_t sz) const
+{
+    return json::skipPlainJsonChars<8>(s, sz);
+}
+
 }
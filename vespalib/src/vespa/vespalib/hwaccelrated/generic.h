@@ -20,6 +20,7 @@ public:
     void andBit(void * a, const void * b, size_t bytes) const override;
     void andNotBit(void * a, const void * b, size_t bytes) const override;
     void notBit(void * a, size_t bytes) const override;
+    size_t skipPlainJsonChars(const char * s, size_t sz) const override;
 };
 
 }
@@ -6,6 +6,7 @@
 #include "avx.h"
 #include "avx2.h"
 #include "avx512.h"
+#include <cstring>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".vespalib.hwaccelrated");
@@ -67,6 +68,22 @@ void verifyAccelrator(const IAccelrated & accel)
     delete [] b;
 }
 
+void verifyJsonScan(const IAccelrated & accel)
+{
+    char buf[128];
+    memset(buf, 'a', sizeof(buf));
+    for (size_t i(0); i < sizeof(buf); i++) {
+        buf[i] = '"';
+        if ((accel.skipPlainJsonChars(buf, sizeof(buf)) != i) ||
+            (accel.skipPlainJsonChars(buf, i) != i))
+        {
+            fprintf(stderr, "Accelrator is not scanning json strings correctly.\n");
+            LOG_ABORT("should not be reached");
+        }
+        buf[i] = 'a';
+    }
+}
+
 class RuntimeVerificator
 {
 public:
@@ -80,12 +97,14 @@ RuntimeVerificator::RuntimeVerificator()
    verifyAccelrator<double>(generic); 
    verifyAccelrator<int32_t>(generic); 
    verifyAccelrator<int64_t>(generic); 
+   verifyJsonScan(generic);
 
    IAccelrated::UP thisCpu(IAccelrated::getAccelrator());
    verifyAccelrator<float>(*thisCpu); 
    verifyAccelrator<double>(*thisCpu); 
    verifyAccelrator<int32_t>(*thisCpu); 
    verifyAccelrator<int64_t>(*thisCpu); 
+   verifyJsonScan(*thisCpu);
    
 }
 
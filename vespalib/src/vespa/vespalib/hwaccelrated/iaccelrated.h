@@ -24,6 +24,12 @@ public:
     virtual void andBit(void * a, const void * b, size_t bytes) const = 0;
     virtual void andNotBit(void * a, const void * b, size_t bytes) const = 0;
     virtual void notBit(void * a, size_t bytes) const = 0;
+    /**
+     * Count the leading bytes that can be copied verbatim into or out
+     * of a JSON string, stopping at the first quote, apostrophe,
+     * backslash or control character.
+     */
+    virtual size_t skipPlainJsonChars(const char * s, size_t sz) const = 0;
 
     static IAccelrated::UP getAccelrator() __attribute__((noinline));
 };
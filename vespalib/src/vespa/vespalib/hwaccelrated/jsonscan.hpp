@@ -0,0 +1,50 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstring>
+#include <cstdint>
+
+namespace vespalib::hwaccelrated::json {
+
+inline bool isSpecial(uint8_t c) {
+    return (c < 0x20) || (c == '"') || (c == '\'') || (c == '\\');
+}
+
+/**
+ * Skip VLEN bytes at a time past characters that need no special
+ * handling inside a JSON string; the exact position of the first
+ * special character is then found byte by byte. The comparisons are
+ * done on gcc vector types, so the code generated depends on the
+ * instruction set the including file is compiled for.
+ */
+template <size_t VLEN>
+size_t
+skipPlainJsonChars(const char * s, size_t sz)
+{
+    typedef uint8_t V __attribute__ ((vector_size (VLEN)));
+    constexpr size_t WORDS = VLEN / sizeof(uint64_t);
+    size_t i(0);
+    for (; i + VLEN <= sz; i += VLEN) {
+        V v;
+        memcpy(&v, s + i, VLEN);
+        V special = (V)((v < 0x20) | (v == '"') | (v == '\'') | (v == '\\'));
+        uint64_t words[WORDS];
+        memcpy(words, &special, VLEN);
+        uint64_t any(0);
+        for (size_t w(0); w < WORDS; w++) {
+            any |= words[w];
+        }
+        if (__builtin_expect(any != 0, false)) {
+            break;
+        }
+    }
+    for (; i < sz; i++) {
+        if (isSpecial(s[i])) {
+            return i;
+        }
+    }
+    return sz;
+}
+
+}
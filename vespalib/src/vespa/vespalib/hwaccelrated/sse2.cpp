@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "sse2.h"
+#include "jsonscan.hpp"
 
 namespace vespalib::hwaccelrated {
 
@@ -76,4 +77,10 @@ Sse2Accelrator::dotProduct(const double * af, const double * bf, size_t sz) cons
     return sum; 
 }
 
+size_t
+Sse2Accelrator::skipPlainJsonChars(const char * s, size_t sz) const
+{
+    return json::skipPlainJsonChars<16>(s, sz);
+}
+
 }
@@ -49,6 +49,7 @@ public:
     ssize_t read(char *buf, size_t len) override { return _socket.read(buf, len); }
     ssize_t drain(char *, size_t) override { return 0; }
     ssize_t write(const char *buf, size_t len) override { return _socket.write(buf, len); }
+    ssize_t writev(const struct iovec *iov, int iovcnt) override { return _socket.writev(iov, iovcnt); }
     ssize_t flush() override { return 0; }
     ssize_t half_close() override { return _socket.half_close(); }
 };
@@ -6,4 +6,21 @@ namespace vespalib {
 
 CryptoSocket::~CryptoSocket() = default;
 
+ssize_t
+CryptoSocket::writev(const struct iovec *iov, int iovcnt)
+{
+    ssize_t total = 0;
+    for (int i = 0; i < iovcnt; ++i) {
+        ssize_t res = write(static_cast<const char *>(iov[i].iov_base), iov[i].iov_len);
+        if (res < 0) {
+            return (total > 0) ? total : res;
+        }
+        total += res;
+        if (size_t(res) < iov[i].iov_len) {
+            break;
+        }
+    }
+    return total;
+}
+
 } // namespace vespalib
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <memory>
+#include <sys/uio.h>
 
 namespace vespalib {
 
@@ -84,6 +85,15 @@ struct CryptoSocket {
      **/
     virtual ssize_t write(const char *buf, size_t len) = 0;
 
+    /**
+     * Gathering version of write. The semantics are the same as with
+     * a normal socket writev. Sockets that need to transform written
+     * data will copy it anyway; the default implementation simply
+     * writes the buffers one by one until one is only partially
+     * accepted.
+     **/
+    virtual ssize_t writev(const struct iovec *iov, int iovcnt);
+
     /**
      * Try to flush data in the write pipeline that is not dependent
      * on data not yet written by the application into the underlying
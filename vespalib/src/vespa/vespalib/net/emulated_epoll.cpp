@@ -22,7 +22,7 @@ Epoll::Epoll()
 Epoll::~Epoll() = default;
 
 void
-Epoll::add(int fd, void *ctx, bool read, bool write)
+Epoll::add(int fd, void *ctx, bool read, bool write, bool)
 {
     epoll_event evt;
     evt.events = maybe(EPOLLIN, read) | maybe(EPOLLOUT, write);
@@ -33,7 +33,7 @@ Epoll::add(int fd, void *ctx, bool read, bool write)
 }
 
 void
-Epoll::update(int fd, void *ctx, bool read, bool write)
+Epoll::update(int fd, void *ctx, bool read, bool write, bool)
 {
     epoll_event evt;
     evt.events = maybe(EPOLLIN, read) | maybe(EPOLLOUT, write);
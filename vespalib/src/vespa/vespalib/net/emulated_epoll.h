@@ -36,8 +36,9 @@ private:
 public:
     Epoll();
     ~Epoll();
-    void add(int fd, void *ctx, bool read, bool write);
-    void update(int fd, void *ctx, bool read, bool write);
+    // edge triggering is not emulated; events are always level triggered
+    void add(int fd, void *ctx, bool read, bool write, bool edge_triggered = false);
+    void update(int fd, void *ctx, bool read, bool write, bool edge_triggered = false);
     void remove(int fd);
     size_t wait(epoll_event *events, size_t max_events, int timeout_ms);
 };
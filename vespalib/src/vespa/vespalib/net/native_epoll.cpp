@@ -34,19 +34,19 @@ Epoll::~Epoll()
 }
 
 void
-Epoll::add(int fd, void *ctx, bool read, bool write)
+Epoll::add(int fd, void *ctx, bool read, bool write, bool edge_triggered)
 {
     epoll_event evt;
-    evt.events = maybe(EPOLLIN, read) | maybe(EPOLLOUT, write);
+    evt.events = maybe(EPOLLIN, read) | maybe(EPOLLOUT, write) | maybe(EPOLLET, edge_triggered);
     evt.data.ptr = ctx;
     check(epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &evt));
 }
 
 void
-Epoll::update(int fd, void *ctx, bool read, bool write)
+Epoll::update(int fd, void *ctx, bool read, bool write, bool edge_triggered)
 {
     epoll_event evt;
-    evt.events = maybe(EPOLLIN, read) | maybe(EPOLLOUT, write);
+    evt.events = maybe(EPOLLIN, read) | maybe(EPOLLOUT, write) | maybe(EPOLLET, edge_triggered);
     evt.data.ptr = ctx;
     check(epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, fd, &evt));
 }
@@ -17,8 +17,8 @@ private:
 public:
     Epoll();
     ~Epoll();
-    void add(int fd, void *ctx, bool read, bool write);
-    void update(int fd, void *ctx, bool read, bool write);
+    void add(int fd, void *ctx, bool read, bool write, bool edge_triggered = false);
+    void update(int fd, void *ctx, bool read, bool write, bool edge_triggered = false);
     void remove(int fd);
     size_t wait(epoll_event *events, size_t max_events, int timeout_ms);
 };
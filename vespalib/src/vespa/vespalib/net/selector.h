@@ -39,17 +39,23 @@ private:
     Epoll       _epoll;
     WakeupPipe  _wakeup_pipe;
     EpollEvents _events;
+    bool        _edge_triggered;
 public:
     Selector()
-        : _epoll(), _wakeup_pipe(), _events(4096)
+        : _epoll(), _wakeup_pipe(), _events(4096), _edge_triggered(false)
     {
         _epoll.add(_wakeup_pipe.get_read_fd(), nullptr, true, false);    
     }
     ~Selector() {
         _epoll.remove(_wakeup_pipe.get_read_fd());
     }
-    void add(int fd, Context &ctx, bool read, bool write) { _epoll.add(fd, &ctx, read, write); }
-    void update(int fd, Context &ctx, bool read, bool write) { _epoll.update(fd, &ctx, read, write); }
+    // Edge triggered selection only reports readiness changes; the
+    // handler must read/write until EAGAIN or call update to re-arm
+    // the file descriptor. Affects subsequent calls to add/update.
+    void set_edge_triggered(bool value) { _edge_triggered = value; }
+    bool edge_triggered() const { return _edge_triggered; }
+    void add(int fd, Context &ctx, bool read, bool write) { _epoll.add(fd, &ctx, read, write, _edge_triggered); }
+    void update(int fd, Context &ctx, bool read, bool write) { _epoll.update(fd, &ctx, read, write, _edge_triggered); }
     void remove(int fd) { _epoll.remove(fd); }
     void wakeup() { _wakeup_pipe.write_token(); }
     void poll(int timeout_ms) { _events.extract(_epoll, timeout_ms); }
@@ -4,6 +4,7 @@
 
 #include "socket_options.h"
 #include <unistd.h>
+#include <sys/uio.h>
 
 namespace vespalib {
 
@@ -57,6 +58,7 @@ public:
 
     ssize_t read(char *buf, size_t len);
     ssize_t write(const char *buf, size_t len);
+    ssize_t writev(const struct iovec *iov, int iovcnt);
     SocketHandle accept();
     void shutdown();
     int half_close();
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "socket_spec.h"
+#include <vespa/vespalib/util/host_name.h>
 #include <vespa/vespalib/util/stringfmt.h>
 
 namespace vespalib {
@@ -10,6 +11,7 @@ namespace {
 const vespalib::string tcp_prefix("tcp/");
 const vespalib::string ipc_path_prefix("ipc/file:");
 const vespalib::string ipc_name_prefix("ipc/name:");
+const vespalib::string local_name_prefix("vespa-local-tcp-");
 
 SocketAddress make_address(const char *node, int port, bool server) {
     if (server) {
@@ -108,4 +110,31 @@ SocketSpec::replace_host(const vespalib::string &new_host) const
     return SocketSpec();
 }
 
+SocketSpec
+SocketSpec::local_equivalent(const vespalib::string &dir) const
+{
+    if (((_type == Type::HOST_PORT) || (_type == Type::PORT)) && (_port > 0) && !dir.empty()) {
+        return from_path(make_string("%s/%s%d", dir.c_str(), local_name_prefix.c_str(), _port));
+    }
+    return SocketSpec();
+}
+
+bool
+SocketSpec::is_local() const
+{
+    switch (_type) {
+    case Type::PATH:
+    case Type::NAME:
+    case Type::PORT:
+        return true;
+    case Type::HOST_PORT:
+        return ((_node == "localhost") ||
+                starts_with(_node, "127.") ||
+                (_node == "::1") ||
+                (_node == HostName::get()));
+    case Type::INVALID: ;
+    }
+    return false;
+}
+
 } // namespace vespalib
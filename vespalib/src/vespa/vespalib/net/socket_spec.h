@@ -27,6 +27,21 @@ public:
     explicit SocketSpec(const vespalib::string &spec);
     vespalib::string spec() const;
     SocketSpec replace_host(const vespalib::string &new_host) const;
+    /**
+     * The path of a unix domain socket in the given directory that a
+     * server listening on the tcp port of this spec may also listen
+     * on, so that clients on the same host can bypass the tcp
+     * stack. Gives an invalid spec if this spec does not have a port
+     * or the directory is empty.
+     **/
+    SocketSpec local_equivalent(const vespalib::string &dir) const;
+    /**
+     * Whether this spec is known to refer to the local host. Only
+     * cheap checks are performed (ipc specs, port only specs,
+     * 'localhost', loopback addresses and the name of this host); no
+     * host name lookup is done.
+     **/
+    bool is_local() const;
     static SocketSpec from_path(const vespalib::string &path) {
         return SocketSpec(Type::PATH, path, -1);
     }
@@ -3,9 +3,45 @@
 #include "wakeup_pipe.h"
 #include "socket_utils.h"
 #include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <cassert>
+#include <cstdint>
+#endif
 
 namespace vespalib {
 
+#ifdef __linux__
+
+WakeupPipe::WakeupPipe()
+    : _pipe()
+{
+    _pipe[0] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    assert(_pipe[0] != -1);
+    _pipe[1] = _pipe[0];
+}
+
+WakeupPipe::~WakeupPipe()
+{
+    close(_pipe[0]);
+}
+
+void
+WakeupPipe::write_token()
+{
+    uint64_t token = 1;
+    [[maybe_unused]] ssize_t res = write(_pipe[1], &token, sizeof(token));
+}
+
+void
+WakeupPipe::read_tokens()
+{
+    uint64_t token_cnt;
+    [[maybe_unused]] ssize_t res = read(_pipe[0], &token_cnt, sizeof(token_cnt));
+}
+
+#else
+
 WakeupPipe::WakeupPipe()
     : _pipe()
 {
@@ -32,4 +68,6 @@ WakeupPipe::read_tokens()
     [[maybe_unused]] ssize_t res = read(_pipe[0], token_trash, sizeof(token_trash));
 }
 
+#endif
+
 }
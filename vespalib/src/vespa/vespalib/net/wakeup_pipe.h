@@ -12,6 +12,10 @@ namespace vespalib {
  * selection set and a wakeup is triggered by writing to the
  * pipe. When a wakeup is detected, pending tokens will be read and
  * discarded to avoid spurious wakeups in the future.
+ *
+ * On Linux an eventfd is used instead of a pipe. Tokens are then
+ * accumulated in a single counter, so any number of wakeups is
+ * cleared by one read and only one file descriptor is needed.
  **/
 class WakeupPipe {
 private: